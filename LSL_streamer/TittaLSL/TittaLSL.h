@@ -2,12 +2,15 @@
 #include <vector>
 #include <deque>
 #include <map>
+#include <array>
 #include <string>
 #include <optional>
 #include <atomic>
 #include <variant>
 #include <memory>
 #include <thread>
+#include <mutex>
+#include <chrono>
 #include <tobii_research.h>
 #include <tobii_research_streams.h>
 #pragma comment(lib, "lsl.lib")
@@ -32,6 +35,23 @@ namespace TittaLSL
     TobiiResearchSDKVersion getTobiiSDKVersion();
     int32_t getLSLVersion();
 
+    // channel layout of a gaze stream:
+    // full:    all gaze data as double values, and the device time stamp in s (43 channels). The default
+    // float32: all gaze data as float values, which halves the bandwidth. The device time stamp is sent in us
+    //          split over two channels (the value above and below 2^24), so that it remains exact (44 channels)
+    // compact: only the gaze point on the display area and the pupil diameter with their validity, as float
+    //          values, and the device time stamp as for float32 (12 channels)
+    enum class GazeLayout
+    {
+        Full,
+        Float32,
+        Compact,
+        Last    // NB: must be last value, not a valid layout
+    };
+    GazeLayout stringToGazeLayout(std::string layout_);
+    std::string gazeLayoutToString(GazeLayout layout_);
+    std::string getAllGazeLayoutsString(const char* quoteChar_ = "\"");
+
     class Sender
     {
     public:
@@ -44,9 +64,56 @@ namespace TittaLSL
         std::string getStreamSourceID(std::string   stream_, bool snake_case_on_stream_not_found = false) const;
         std::string getStreamSourceID(Titta::Stream stream_) const;
 
-        bool start(std::string   stream_, bool snake_case_on_stream_not_found = false);
-        bool start(Titta::Stream stream_);
+        // chunkSize_: number of samples to collect and then push to the outlet together. Default 1, i.e., each
+        // sample is pushed as soon as it arrives. Pushing in chunks costs less CPU at high sampling rates.
+        // chunkMaxLatency_: us, a partial chunk is pushed once its oldest sample has waited this long, so that
+        // samples are not held back indefinitely when they arrive slowly. Default 10 ms, 0: no maximum
+        // gazeLayout_: channel layout of the gaze stream (see GazeLayout), default full. Only for the gaze stream
+        bool start(std::string   stream_, std::optional<size_t> chunkSize_ = std::nullopt, std::optional<int64_t> chunkMaxLatency_ = std::nullopt, std::optional<GazeLayout> gazeLayout_ = std::nullopt, bool snake_case_on_stream_not_found = false);
+        bool start(Titta::Stream stream_, std::optional<size_t> chunkSize_ = std::nullopt, std::optional<int64_t> chunkMaxLatency_ = std::nullopt, std::optional<GazeLayout> gazeLayout_ = std::nullopt);
         void setIncludeEyeOpennessInGaze(bool include_);    // can be set before or after opening stream
+
+        // eye image stream options:
+        // asGif: send the images as GIF instead of raw. Can only be changed while eye images are not being sent
+        // downscaleFactor: shrink raw images by this integer factor in each dimension (averaging blocks of
+        // pixels) before sending, 1: send at full size. Does not apply to GIF images
+        // maxFrameRate: Hz, per camera and image region send at most this many images per second, dropping
+        // the others. 0: no maximum
+        // downscaleFactor and maxFrameRate can be changed while sending
+        struct EyeImageOptions
+        {
+            bool    asGif           = false;
+            int     downscaleFactor = 1;
+            double  maxFrameRate    = 0.;
+        };
+        void setEyeImageOptions(std::optional<bool> asGif_ = std::nullopt, std::optional<int> downscaleFactor_ = std::nullopt, std::optional<double> maxFrameRate_ = std::nullopt);
+        EyeImageOptions getEyeImageOptions() const;
+
+        // send queue mode: if enabled, the Tobii SDK callbacks only put incoming samples in a lock-free
+        // single-producer queue per stream, and a separate thread pushes them to the outlets, so that
+        // backpressure from the network or a slow inlet never holds up the callbacks. Can only be changed
+        // when no streams are being sent
+        // The queues have a fixed capacity that is allocated up front, so that the callbacks never allocate
+        // queue memory and memory use stays bounded. If a queue is full because sending is held up, further
+        // samples are discarded (see SendQueueStats::numDropped)
+        static constexpr size_t sendQueueCapacityGaze       = 1<<13;    // gaze and eye openness queues, samples
+        static constexpr size_t sendQueueCapacityEyeImage   = 1<<6;     // eye image queue, images
+        static constexpr size_t sendQueueCapacity           = 1<<10;    // queues of the other streams, samples
+        bool setUseSendQueue(bool useQueue_);       // returns previous state
+        bool getUseSendQueue() const;
+        // state of a stream's send queue, and how long its Tobii SDK callbacks took (also when not in send
+        // queue mode, for comparison)
+        struct SendQueueStats
+        {
+            size_t      depth               = 0;    // samples currently waiting to be sent
+            size_t      highWaterMark       = 0;    // largest depth seen
+            uint64_t    numQueued           = 0;    // total number of samples put in the queue
+            uint64_t    numDropped          = 0;    // samples discarded because the queue was full
+            uint64_t    numCallbacks        = 0;
+            double      maxCallbackDuration = 0.;   // microseconds
+        };
+        SendQueueStats getSendQueueStats(std::string   stream_, bool snake_case_on_stream_not_found = false) const;
+        SendQueueStats getSendQueueStats(Titta::Stream stream_) const;
         bool isStreaming(std::string   stream_, bool snake_case_on_stream_not_found = false) const;
         bool isStreaming(Titta::Stream stream_) const;
         void stop(std::string    stream_, bool snake_case_on_stream_not_found = false);
@@ -56,12 +123,18 @@ namespace TittaLSL
         void connect(std::string address_);
         void connect(TobiiResearchEyeTracker* et_);
         static void CheckClocks();
+        void refreshEyeTrackerInfo();
         // Tobii callbacks need to be friends
         friend void GazeCallback(TobiiResearchGazeData* gaze_data_, void* user_data);
         friend void EyeOpennessCallback(TobiiResearchEyeOpennessData* openness_data_, void* user_data);
         friend void ExtSignalCallback(TobiiResearchExternalSignalData* ext_signal_, void* user_data);
         friend void TimeSyncCallback(TobiiResearchTimeSynchronizationData* time_sync_data_, void* user_data);
         friend void PositioningCallback(TobiiResearchUserPositionGuide* position_data_, void* user_data);
+        friend void EyeImageCallback(TobiiResearchEyeImage* eye_image_, void* user_data);
+        friend void EyeImageGifCallback(TobiiResearchEyeImageGif* eye_image_, void* user_data);
+        // eye image receiver, applies the frame rate cap
+        template <typename T>
+        void receiveSample(const T* eye_image_);
         // gaze + eye openness receiver
         void receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiResearchEyeOpennessData* openness_data_);
         // data pushers
@@ -69,27 +142,89 @@ namespace TittaLSL
         void pushSample(const Titta::extSignal& sample_);
         void pushSample(const Titta::timeSync& sample_);
         void pushSample(const Titta::positioning& sample_);
+        void pushSample(const Titta::eyeImage& sample_);
+        template <typename T>
+        void pushToOutlet(Titta::Stream stream_, const T* sample_, double timeStamp_);
+        struct OutletChunk;
+        void flushChunk(OutletChunk& chunk_);    // NB: caller must hold chunk_.mutex
+        void chunkFlushThread();
         // callback registration and deregistration
         bool attachCallback(Titta::Stream stream_);
         bool removeCallback(Titta::Stream stream_);
+        // send queues
+        struct sendQueueCounters
+        {
+            std::atomic<size_t>     highWaterMark           = 0;
+            std::atomic<uint64_t>   numQueued               = 0;
+            std::atomic<uint64_t>   numDropped              = 0;
+            std::atomic<uint64_t>   numCallbacks            = 0;
+            std::atomic<uint64_t>   maxCallbackDurationNs   = 0;
+
+            void addCallback(std::chrono::steady_clock::time_point start_);     // only to be called from the callback thread
+        };
+        template <typename T>
+        void enqueueSample(Titta::Stream stream_, moodycamel::ReaderWriterQueue<T>& queue_, T sample_);
+        void sendThread();
+        void drainSendQueues();                 // !NB: caller must hold _sendDrainMutex
 
     private:
         TobiiTypes::eyeTracker          _localEyeTracker;
+        // set when connected to a simulated eye tracker (see Titta/simulator.h), _localEyeTracker.et is then nullptr
+        std::unique_ptr<TittaSimulator::tracker> _simulator;
 
         std::map<Titta::Stream,
                  lsl::stream_outlet>    _outStreams;
 
+        // samples collected for pushing to an outlet as one chunk
+        struct OutletChunk
+        {
+            std::mutex                  mutex;
+            lsl::stream_outlet*         outlet      = nullptr;  // set while the stream is sent in chunks
+            size_t                      size        = 1;        // number of samples in a full chunk
+            int64_t                     maxLatency  = 0;        // us
+            size_t                      numChannels = 0;
+            std::variant<std::vector<double>, std::vector<int64_t>, std::vector<float>> values;    // multiplexed
+            std::vector<double>         timeStamps;
+            size_t                      numSamples  = 0;
+            std::chrono::steady_clock::time_point firstArrival;
+        };
+        std::array<OutletChunk, static_cast<size_t>(Titta::Stream::Last)> _outChunks;
+        std::thread                     _chunkFlushThread;      // pushes partial chunks whose max latency has passed
+        std::atomic<bool>               _chunkFlushShouldStop = false;
+
+        // send queues, filled by the Tobii SDK callbacks if in send queue mode
+        std::atomic<bool>               _useSendQueue = false;
+        moodycamel::ReaderWriterQueue<TobiiResearchGazeData>        _gazeSendQueue          {sendQueueCapacityGaze};
+        moodycamel::ReaderWriterQueue<TobiiResearchEyeOpennessData> _eyeOpennessSendQueue   {sendQueueCapacityGaze};
+        moodycamel::ReaderWriterQueue<Titta::extSignal>             _extSignalSendQueue     {sendQueueCapacity};
+        moodycamel::ReaderWriterQueue<Titta::timeSync>              _timeSyncSendQueue      {sendQueueCapacity};
+        moodycamel::ReaderWriterQueue<Titta::positioning>           _positioningSendQueue   {sendQueueCapacity};
+        moodycamel::ReaderWriterQueue<Titta::eyeImage>              _eyeImageSendQueue      {sendQueueCapacityEyeImage};
+        std::array<sendQueueCounters, static_cast<size_t>(Titta::Stream::Last)> _sendQueueCounters;
+        std::mutex                      _sendDrainMutex;        // queues are single consumer, serialize draining. Also held when adding or removing outlets
+        std::thread                     _sendThread;
+        std::atomic<bool>               _sendThreadShouldStop = false;
+
         // staging area to merge gaze and eye openness
         std::deque<Titta::gaze>         _gazeStaging;
         std::atomic<bool>               _gazeStagingEmpty = true;
         bool                            _includeEyeOpennessInGaze = false;
-        mutex_type                      _gazeStageMutex;
+        GazeLayout                      _gazeLayout = GazeLayout::Full;
+        mutex_type                      _gazeStageMutex{"LSL gaze staging"};
 
         bool                            _streamingGaze = false;
         bool                            _streamingEyeOpenness = false;
         bool                            _streamingExtSignal = false;
         bool                            _streamingTimeSync = false;
         bool                            _streamingPositioning = false;
+        bool                            _streamingEyeImage = false;
+
+        // eye images
+        bool                            _eyeImageAsGif = false;
+        bool                            _eyeImageIsGif = false;         // type of the current subscription
+        std::atomic<int>                _eyeImageDownscaleFactor = 1;
+        std::atomic<double>             _eyeImageMaxFrameRate = 0.;
+        std::map<std::pair<int, int>, int64_t> _eyeImageNextDue;       // per camera and region, device time stamp (us) from which the next image is sent. Only accessed from the callback
     };
 
     class Receiver
@@ -105,7 +240,7 @@ namespace TittaLSL
 
             lsl::stream_inlet               _lsl_inlet;
             std::vector<DataType>           _buffer;
-            mutex_type                      _mutex;
+            mutex_type                      _mutex{"LSL inlet"};
             std::unique_ptr<std::thread>    _recorder;
             std::atomic<bool>               _recorder_should_stop;
         };
@@ -115,11 +250,13 @@ namespace TittaLSL
         using extSignal     = LSLTypes::extSignal;  // getType() -> Titta::Stream::ExtSignal
         using timeSync      = LSLTypes::timeSync;   // getType() -> Titta::Stream::TimeSync
         using positioning   = LSLTypes::positioning;// getType() -> Titta::Stream::Positioning
+        using eyeImage      = LSLTypes::eyeImage;   // getType() -> Titta::Stream::EyeImage
         using AllInlets = std::variant<
             Inlet<gaze>,
             Inlet<extSignal>,
             Inlet<timeSync>,
-            Inlet<positioning>
+            Inlet<positioning>,
+            Inlet<eyeImage>
         >;
 
         // subscribe to stream, allocate buffer resources
@@ -134,6 +271,7 @@ namespace TittaLSL
         // info about inlet (desc is set now)
         lsl::stream_info getInfo() const;
         Titta::Stream    getType() const;
+        GazeLayout       getGazeLayout() const;     // channel layout of a gaze stream, determined from its info
 
         // actually start pulling samples from it
         void start();
@@ -173,10 +311,11 @@ namespace TittaLSL
         template <typename DataType>
         Inlet<DataType>& getInlet() const;
         // worker function
-        template <typename DataType>
+        template <typename DataType, GazeLayout Layout = GazeLayout::Full>
         void recorderThreadFunc();
 
     private:
         std::unique_ptr<AllInlets>  _inlet;
+        GazeLayout                  _gazeLayout = GazeLayout::Full;     // of the stream, if a gaze stream
     };
 }
@@ -16,6 +16,7 @@ namespace LSLTypes
         Titta::eyeImage eyeImageData;
         int64_t remoteSystemTimeStamp;   // copy of eyeImageData.system_time_stamp, for easy and uniform access
         int64_t localSystemTimeStamp;
+        int     downscaleFactor;         // factor by which the sender shrank the image, 1 if sent at full size
     };
 
     struct extSignal
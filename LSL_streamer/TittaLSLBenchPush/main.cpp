@@ -0,0 +1,339 @@
+// Benchmark of pushing gaze samples to an LSL outlet with TittaLSL::Sender, for different chunk sizes and gaze
+// channel layouts (see TittaLSL::GazeLayout), no eye
+// tracker needed: samples are driven through the Sender by replaying a synthetic recording (see TittaSimulator)
+// in real time at a given sampling rate, or as fast as possible. A receiver in the same process pulls the stream, so
+// that the outlet actually transmits. Measured per chunk size and rate, with the samples pushed directly from
+// the callback or through the send queue (see TittaLSL::Sender::setUseSendQueue()), are:
+// 1. throughput: samples/s arriving at the receiver, and the payload bytes per sample of the layout;
+// 2. CPU use: process CPU time (sender and receiver together), as a percentage of one core and per sample;
+// 3. latency: from the sample's time stamp until its arrival at the receiver (not when pushing as fast as
+//    possible, as samples are then pushed well ahead of their time stamps);
+// 4. callback duration: the longest time a callback took, and the send queue's high-water mark.
+// The results are written as JSON (to stdout, or to the file given with --out), so that they can be tracked
+// over time. Progress is shown on stderr.
+//
+// usage: TittaLSLBenchPush [--chunk-sizes 1,4,16,64] [--rates 600,1200,0] [--duration 3]
+//                          [--max-latency 10000] [--send-queue 0,1] [--layouts full,float32,compact]
+//                          [--out file]
+// a rate of 0 means as fast as possible
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <filesystem>
+#include <cmath>
+#include <cstdlib>
+
+#ifdef _WIN32
+#   define NOMINMAX
+#   include <windows.h>
+#else
+#   include <sys/resource.h>
+#endif
+
+#include "TittaLSL/TittaLSL.h"
+#include "Titta/session.h"
+#include "Titta/convert.h"
+#include <lsl_cpp.h>
+
+
+void DoExitWithMsg(std::string errMsg_);
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    struct config
+    {
+        std::vector<size_t> chunkSizes      = {1, 4, 16, 64};
+        std::vector<size_t> rates           = {600, 1200, 0};   // Hz, 0: as fast as possible
+        double              duration        = 3.;               // s, of each run
+        int64_t             maxLatency      = 10'000;           // us
+        std::vector<size_t> sendQueue       = {0, 1};           // 0: push from callback, 1: through send queue
+        std::vector<TittaLSL::GazeLayout> layouts = {TittaLSL::GazeLayout::Full};
+        std::string         outFile;
+    };
+
+    std::vector<size_t> parseList(const std::string& str_)
+    {
+        std::vector<size_t> out;
+        std::stringstream ss(str_);
+        std::string item;
+        while (std::getline(ss, item, ','))
+            out.push_back(std::stoull(item));
+        return out;
+    }
+
+    config parseArgs(const int argc_, char** argv_)
+    {
+        config cfg;
+        for (int i = 1; i < argc_; i++)
+        {
+            const std::string arg = argv_[i];
+            if (i + 1 == argc_)
+                throw "missing value for argument " + arg;
+            const std::string val = argv_[++i];
+            if (arg == "--chunk-sizes")
+                cfg.chunkSizes = parseList(val);
+            else if (arg == "--rates")
+                cfg.rates = parseList(val);
+            else if (arg == "--duration")
+                cfg.duration = std::stod(val);
+            else if (arg == "--max-latency")
+                cfg.maxLatency = std::stoll(val);
+            else if (arg == "--send-queue")
+                cfg.sendQueue = parseList(val);
+            else if (arg == "--layouts")
+            {
+                cfg.layouts.clear();
+                std::stringstream ss(val);
+                std::string item;
+                while (std::getline(ss, item, ','))
+                    cfg.layouts.push_back(TittaLSL::stringToGazeLayout(item));
+            }
+            else if (arg == "--out")
+                cfg.outFile = val;
+            else
+                throw "unknown argument " + arg + ", possible arguments are --chunk-sizes, --rates, --duration, --max-latency, --send-queue, --layouts and --out";
+        }
+        return cfg;
+    }
+
+    // CPU time (user and kernel) used so far by all threads of this process, in s
+    double processCpuTime()
+    {
+#ifdef _WIN32
+        FILETIME creation, exit, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+            return 0.;
+        const auto toSeconds = [](const FILETIME& t_) { return static_cast<double>((static_cast<uint64_t>(t_.dwHighDateTime) << 32) | t_.dwLowDateTime) / 1e7; };
+        return toSeconds(kernel) + toSeconds(user);
+#else
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage))
+            return 0.;
+        const auto toSeconds = [](const timeval& t_) { return static_cast<double>(t_.tv_sec) + static_cast<double>(t_.tv_usec) / 1e6; };
+        return toSeconds(usage.ru_utime) + toSeconds(usage.ru_stime);
+#endif
+    }
+
+    // minimal JSON writer: objects and arrays are opened and closed explicitly, commas are inserted as needed
+    class json
+    {
+    public:
+        json& beginObject(const std::string& key_ = {}) { prefix(key_); _out << '{'; _first = true; return *this; }
+        json& endObject()                               { _out << '}'; _first = false; return *this; }
+        json& beginArray(const std::string& key_)       { prefix(key_); _out << '['; _first = true; return *this; }
+        json& endArray()                                { _out << ']'; _first = false; return *this; }
+        json& value(const std::string& key_, const std::string& val_)   { prefix(key_); _out << '"' << val_ << '"'; return *this; }
+        json& value(const std::string& key_, const char* val_)          { return value(key_, std::string(val_)); }
+        json& value(const std::string& key_, const size_t val_)         { prefix(key_); _out << val_; return *this; }
+        json& value(const std::string& key_, const double val_)
+        {
+            prefix(key_);
+            if (std::isfinite(val_))
+                _out << std::setprecision(6) << val_;
+            else
+                _out << "null";
+            return *this;
+        }
+        std::string str() const { return _out.str(); }
+
+    private:
+        void prefix(const std::string& key_)
+        {
+            if (!_first)
+                _out << ',';
+            _first = false;
+            if (!key_.empty())
+                _out << '"' << key_ << "\":";
+        }
+
+        std::ostringstream  _out;
+        bool                _first = true;
+    };
+
+    TobiiResearchEyeData makeEye(std::mt19937& rng_)
+    {
+        std::uniform_real_distribution<float> pos(0.f, 1.f);
+        const auto validity = [&]() { return rng_()%10 ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID; };
+        TobiiResearchEyeData e;
+        e.gaze_point.position_on_display_area           = {pos(rng_), pos(rng_)};
+        e.gaze_point.position_in_user_coordinates       = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_point.validity                           = validity();
+        e.pupil_data.diameter                           = pos(rng_)*4.f;
+        e.pupil_data.validity                           = validity();
+        e.gaze_origin.position_in_user_coordinates      = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_origin.position_in_track_box_coordinates = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_origin.validity                          = validity();
+        return e;
+    }
+
+    // 10 s of synthetic gaze data at the given sampling rate, replayed in a loop to drive the Sender
+    void writeRecording(const std::string& filePath_, const size_t rate_)
+    {
+        const auto nSamples = 10*rate_;
+        const auto interval = 1'000'000. / static_cast<double>(rate_);     // us
+        std::mt19937 rng(1);
+        std::vector<Titta::gaze> samples(nSamples);
+        for (size_t i = 0; i < nSamples; i++)
+        {
+            TittaConvert::toEyeData(samples[i].left_eye , makeEye(rng));
+            TittaConvert::toEyeData(samples[i].right_eye, makeEye(rng));
+            samples[i].device_time_stamp = static_cast<int64_t>(static_cast<double>(i)*interval);
+            samples[i].system_time_stamp = samples[i].device_time_stamp+1000;
+        }
+        TittaSession::writer writer(filePath_);
+        writer.writeStream(samples);
+        writer.finish();
+    }
+
+    // push the recording at rate_ (0: as fast as possible) in chunks of chunkSize_ samples, for duration_ s
+    void benchPush(json& j_, const std::string& recording_, const size_t chunkSize_, const size_t rate_, const bool sendQueue_, const TittaLSL::GazeLayout layout_, const double duration_, const int64_t maxLatency_)
+    {
+        const auto address = std::string(TittaSimulator::replayAddressPrefix) + recording_ + (rate_ ? "?speed=1" : "?speed=0") + "&delay=0.2&loop=1";
+        TittaLSL::Sender sender(address);
+        sender.setUseSendQueue(sendQueue_);
+        sender.start(Titta::Stream::Gaze, chunkSize_, maxLatency_, layout_);
+
+        const auto info = lsl::resolve_stream("source_id", sender.getStreamSourceID(Titta::Stream::Gaze), 1, 5.);
+        if (info.empty())
+            throw std::string("could not resolve the gaze stream");
+        const auto bytesPerSample = static_cast<size_t>(info[0].channel_count()) * static_cast<size_t>(info[0].channel_bytes());
+        // large buffer (in s at the nominal rate), so that no samples are lost when pushing as fast as possible
+        lsl::stream_inlet inlet(info[0], 3600);
+        inlet.open_stream(5.);
+
+        std::atomic<bool> stop = false;
+        std::atomic<size_t> numReceived = 0;
+        std::vector<double> latencies;      // us
+        latencies.reserve(rate_ ? 1'000'000 : 0);
+        std::thread receiver([&]()
+        {
+            std::vector<double> values, timeStamps;
+            while (!stop)
+            {
+                if (!inlet.pull_chunk_multiplexed(values, &timeStamps, 0.05))
+                    continue;
+                const auto now = lsl::local_clock();
+                numReceived += timeStamps.size();
+                // first million samples, so that memory stays bounded
+                for (size_t i = 0; i < timeStamps.size() && latencies.size() < latencies.capacity(); i++)
+                    latencies.push_back((now - timeStamps[i]) * 1e6);
+            }
+        });
+
+        // skip the warm-up (stream setup, start of replay) before measuring
+        std::this_thread::sleep_for(std::chrono::milliseconds{500});
+        const auto startReceived = numReceived.load();     // a rough boundary suffices, the run is long
+        const auto startCpu = processCpuTime();
+        const auto start = clock::now();
+        std::this_thread::sleep_for(std::chrono::duration<double>(duration_));
+        const auto elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        const auto cpu = processCpuTime() - startCpu;
+        const auto received = numReceived - startReceived;
+        stop = true;
+        receiver.join();
+        const auto queueStats = sender.getSendQueueStats(Titta::Stream::Gaze);
+        sender.stop(Titta::Stream::Gaze);
+
+        std::ranges::sort(latencies);
+        const auto percentile = [&](const double q_) { return latencies.empty() ? std::nan("") : latencies[std::min(latencies.size()-1, static_cast<size_t>(q_*static_cast<double>(latencies.size())))]; };
+        const auto samplesPerS = static_cast<double>(received) / elapsed;
+
+        j_.beginObject()
+            .value("chunk_size", chunkSize_)
+            .value("rate_hz", rate_)
+            .value("send_queue", sendQueue_ ? "on" : "off")
+            .value("layout", TittaLSL::gazeLayoutToString(layout_))
+            .value("bytes_per_sample", bytesPerSample)
+            .value("elapsed_s", elapsed)
+            .value("samples_received", received)
+            .value("samples_per_s", samplesPerS)
+            .value("cpu_percent", cpu / elapsed * 100.)
+            .value("cpu_per_sample_us", received ? cpu / static_cast<double>(received) * 1e6 : std::nan(""))
+            .value("latency_median_us", percentile(.5))
+            .value("latency_p99_us", percentile(.99))
+            .value("callback_max_us", queueStats.maxCallbackDuration)
+            .value("queue_high_water_mark", queueStats.highWaterMark)
+            .value("queue_dropped", queueStats.numDropped)
+          .endObject();
+        std::cerr << TittaLSL::gazeLayoutToString(layout_) << ", chunk size " << chunkSize_ << ", rate " << (rate_ ? std::to_string(rate_) + " Hz" : std::string("max")) << (sendQueue_ ? ", send queue" : "") << ": "
+                  << std::fixed << std::setprecision(0) << samplesPerS << " samples/s, CPU " << std::setprecision(1) << cpu / elapsed * 100.
+                  << "% (" << std::setprecision(2) << (received ? cpu / static_cast<double>(received) * 1e6 : 0.) << " us/sample), latency "
+                  << std::setprecision(0) << percentile(.5) << " us (p99 " << percentile(.99) << " us), callback max "
+                  << std::setprecision(1) << queueStats.maxCallbackDuration << " us" << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const auto cfg = parseArgs(argc, argv);
+
+        const auto recording = (std::filesystem::temp_directory_path() / "TittaLSLBenchPush.session").string();
+
+        json j;
+        j.beginObject()
+            .beginObject("system")
+                .value("lsl_library_version", static_cast<size_t>(lsl::library_version()))
+                .value("hardware_threads", static_cast<size_t>(std::thread::hardware_concurrency()))
+            .endObject()
+            .beginObject("config")
+                .value("duration_s", cfg.duration)
+                .value("chunk_max_latency_us", static_cast<double>(cfg.maxLatency))
+            .endObject();
+
+        j.beginArray("push");
+        for (const auto r : cfg.rates)
+        {
+            writeRecording(recording, r ? r : 600);
+            for (const auto l : cfg.layouts)
+                for (const auto q : cfg.sendQueue)
+                    for (const auto c : cfg.chunkSizes)
+                        benchPush(j, recording, c, r, q != 0, l, cfg.duration, cfg.maxLatency);
+        }
+        j.endArray();
+        j.endObject();
+
+        std::filesystem::remove(recording);
+
+        if (cfg.outFile.empty())
+            std::cout << j.str() << std::endl;
+        else
+            std::ofstream(cfg.outFile) << j.str() << std::endl;
+    }
+    catch (const std::string& e)
+    {
+        DoExitWithMsg(e);
+    }
+    catch (const char* e)
+    {
+        DoExitWithMsg(e);
+    }
+    catch (const std::exception& e)
+    {
+        DoExitWithMsg(e.what());
+    }
+    catch (...)
+    {
+        DoExitWithMsg("Some exception occurred");
+    }
+
+    return 0;
+}
+
+void DoExitWithMsg(std::string errMsg_)
+{
+    // incomplete results are of no use, stop
+    std::cerr << "Error: " << errMsg_ << std::endl;
+    std::exit(EXIT_FAILURE);
+}
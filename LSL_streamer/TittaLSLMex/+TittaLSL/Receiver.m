@@ -1,6 +1,7 @@
 classdef Receiver < TittaLSL.detail.Base
     properties (Dependent, SetAccess=private)
         stream
+        gazeLayout
         isRecording
     end
 
@@ -47,6 +48,9 @@ classdef Receiver < TittaLSL.detail.Base
         function stream = get.stream(this)
             stream = this.cppmethod('getType');
         end
+        function layout = get.gazeLayout(this)
+            layout = this.cppmethod('getGazeLayout');
+        end
         function status = get.isRecording(this)
             status = this.cppmethod('isRecording');
         end
@@ -5,6 +5,7 @@ classdef Sender < TittaLSL.detail.Base
         streamingExternalSignal
         streamingTimeSync
         streamingPositioning
+        streamingEyeImage
     end
     
     methods
@@ -31,6 +32,7 @@ classdef Sender < TittaLSL.detail.Base
             this.stop('externalSignal');
             this.stop('timeSync');
             this.stop('positioning');
+            this.stop('eyeImage');
         end
         
         
@@ -51,6 +53,9 @@ classdef Sender < TittaLSL.detail.Base
         function state = get.streamingPositioning(this)
             state = this.isStreaming('positioning');
         end
+        function state = get.streamingEyeImage(this)
+            state = this.isStreaming('eyeImage');
+        end
         
         
         %% member functions
@@ -63,15 +68,73 @@ classdef Sender < TittaLSL.detail.Base
             end
             name = this.cppmethod('getStreamSourceID',ensureStringIsChar(stream));
         end
-        function success = start(this,stream)
+        function success = start(this,stream,chunkSize,chunkMaxLatency,gazeLayout)
             if nargin<2
                 error('TittaLSL::Sender::start: provide stream argument. \nSupported streams are: %s.',this.GetAllStreamsString());
             end
-            success = this.cppmethod('start',ensureStringIsChar(stream));
+            % optional chunking inputs
+            if nargin<3
+                chunkSize = [];
+            end
+            if nargin<4
+                chunkMaxLatency = [];
+            end
+            % optional channel layout of gaze stream
+            if nargin<5
+                gazeLayout = [];
+            end
+            if ~isempty(chunkSize)
+                chunkSize = uint64(chunkSize);
+            end
+            if ~isempty(chunkMaxLatency)
+                chunkMaxLatency = int64(chunkMaxLatency);
+            end
+            if ~isempty(gazeLayout)
+                gazeLayout = ensureStringIsChar(gazeLayout);
+            end
+            success = this.cppmethod('start',ensureStringIsChar(stream),chunkSize,chunkMaxLatency,gazeLayout);
         end
         function setIncludeEyeOpennessInGaze(this,include)
             this.cppmethod('setIncludeEyeOpennessInGaze',include);
         end
+        function setEyeImageOptions(this,asGif,downscaleFactor,maxFrameRate)
+            % all inputs are optional, pass empty to leave a setting
+            % unchanged
+            if nargin<2
+                asGif = [];
+            end
+            if nargin<3
+                downscaleFactor = [];
+            end
+            if nargin<4
+                maxFrameRate = [];
+            end
+            if ~isempty(asGif)
+                asGif = logical(asGif);
+            end
+            if ~isempty(downscaleFactor)
+                downscaleFactor = int32(downscaleFactor);
+            end
+            if ~isempty(maxFrameRate)
+                maxFrameRate = double(maxFrameRate);
+            end
+            this.cppmethod('setEyeImageOptions',asGif,downscaleFactor,maxFrameRate);
+        end
+        function options = getEyeImageOptions(this)
+            options = this.cppmethod('getEyeImageOptions');
+        end
+        function previousState = setUseSendQueue(this,useQueue)
+            previousState = this.cppmethod('setUseSendQueue',useQueue);
+        end
+        function useQueue = getUseSendQueue(this)
+            useQueue = this.cppmethod('getUseSendQueue');
+        end
+        function stats = getSendQueueStats(this,stream)
+            if nargin<2
+                error('TittaLSL::Sender::getSendQueueStats: provide stream argument. \nSupported streams are: %s.',this.GetAllStreamsString());
+            end
+            stats = this.cppmethod('getSendQueueStats',ensureStringIsChar(stream));
+        end
         function status = isStreaming(this,stream)
             if nargin<2
                 error('TittaLSL::Sender::isStreaming: provide stream argument. \nSupported streams are: %s.',this.GetAllStreamsString());
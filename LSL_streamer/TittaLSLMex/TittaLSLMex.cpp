@@ -54,6 +54,8 @@
 #include <string>
 #include <atomic>
 #include <cinttypes>
+#include <cstring>
+#include <algorithm>
 
 #include "cpp_mex_helpers/include_matlab.h"
 
@@ -96,8 +98,11 @@ namespace mxTypes
     mxArray* ToMatlab(TobiiResearchCapabilities                                 data_);
     mxArray* ToMatlab(lsl::channel_format_t                                     data_);
     mxArray* ToMatlab(Titta::Stream                                             data_);
+    mxArray* ToMatlab(TittaLSL::Sender::SendQueueStats                          data_);
+    mxArray* ToMatlab(TittaLSL::Sender::EyeImageOptions                         data_);
 
     mxArray* ToMatlab(std::vector<TittaLSL::Receiver::gaze           >          data_);
+    mxArray* ToMatlab(std::vector<TittaLSL::Receiver::eyeImage       >          data_);
     mxArray* FieldToMatlab(const std::vector<TittaLSL::Receiver::gaze>&         data_, bool rowVector_, TobiiTypes::eyeData Titta::gaze::* field_);
     mxArray* ToMatlab(std::vector<TittaLSL::Receiver::extSignal      >          data_);
     mxArray* ToMatlab(std::vector<TittaLSL::Receiver::timeSync       >          data_);
@@ -171,6 +176,11 @@ namespace {
         GetStreamSourceID,
         Start,
         SetIncludeEyeOpennessInGaze,
+        SetEyeImageOptions,
+        GetEyeImageOptions,
+        SetUseSendQueue,
+        GetUseSendQueue,
+        GetSendQueueStats,
         IsStreaming,
         Stop,
 
@@ -178,6 +188,7 @@ namespace {
         GetStreams,
         GetInfo,
         GetType,
+        GetGazeLayout,
         // Start,
         IsRecording,
         ConsumeN,
@@ -209,6 +220,11 @@ namespace {
         { "getStreamSourceID",              Action::GetStreamSourceID },
         { "start",                          Action::Start },
         { "setIncludeEyeOpennessInGaze",    Action::SetIncludeEyeOpennessInGaze },
+        { "setEyeImageOptions",             Action::SetEyeImageOptions },
+        { "getEyeImageOptions",             Action::GetEyeImageOptions },
+        { "setUseSendQueue",                Action::SetUseSendQueue },
+        { "getUseSendQueue",                Action::GetUseSendQueue },
+        { "getSendQueueStats",              Action::GetSendQueueStats },
         { "isStreaming",                    Action::IsStreaming },
         { "stop",                           Action::Stop },
 
@@ -216,6 +232,7 @@ namespace {
         { "GetStreams",                     Action::GetStreams },
         { "getInfo",                        Action::GetInfo },
         { "getType",                        Action::GetType },
+        { "getGazeLayout",                  Action::GetGazeLayout },
         { "start",                          Action::Start },
         { "isRecording",                    Action::IsRecording },
         { "consumeN",                       Action::ConsumeN },
@@ -495,9 +512,38 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
                                     throw std::string("start: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'", false, true) + ").");
 
+                                // get optional input arguments
+                                std::optional<size_t> chunkSize;
+                                if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+                                {
+                                    if (!mxIsUint64(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                                        throw "start: Expected second argument to be a uint64 scalar.";
+                                    auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[3]));
+                                    if (temp > SIZE_MAX)
+                                        throw "start: Requesting chunk size larger than is possible on a 32bit platform.";
+                                    chunkSize = static_cast<size_t>(temp);
+                                }
+                                std::optional<int64_t> chunkMaxLatency;
+                                if (nrhs_ > 4 && !mxIsEmpty(prhs_[4]))
+                                {
+                                    if (!mxIsInt64(prhs_[4]) || mxIsComplex(prhs_[4]) || !mxIsScalar(prhs_[4]))
+                                        throw "start: Expected third argument to be an int64 scalar.";
+                                    chunkMaxLatency = *static_cast<int64_t*>(mxGetData(prhs_[4]));
+                                }
+                                std::optional<TittaLSL::GazeLayout> gazeLayout;
+                                if (nrhs_ > 5 && !mxIsEmpty(prhs_[5]))
+                                {
+                                    if (!mxIsChar(prhs_[5]))
+                                        throw "start: Fourth input must be a gaze layout identifier string (" + TittaLSL::getAllGazeLayoutsString("'") + ").";
+                                    char* bufferCstr = mxArrayToString(prhs_[5]);
+                                    gazeLayout = TittaLSL::stringToGazeLayout(bufferCstr);
+                                    mxFree(bufferCstr);
+                                }
+
                                 char* bufferCstr = mxArrayToString(prhs_[2]);
-                                plhs_[0] = mxCreateLogicalScalar(senderInstance->start(bufferCstr));
+                                std::string stream = bufferCstr;
                                 mxFree(bufferCstr);
+                                plhs_[0] = mxCreateLogicalScalar(senderInstance->start(stream, chunkSize, chunkMaxLatency, gazeLayout));
                                 return;
                             }
                             case Action::SetIncludeEyeOpennessInGaze:
@@ -509,6 +555,63 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 senderInstance->setIncludeEyeOpennessInGaze(include);
                                 break;
                             }
+                            case Action::SetEyeImageOptions:
+                            {
+                                // all inputs are optional, empty leaves the setting unchanged
+                                std::optional<bool> asGif;
+                                if (nrhs_ > 2 && !mxIsEmpty(prhs_[2]))
+                                {
+                                    if (!mxIsScalar(prhs_[2]) || !mxIsLogicalScalar(prhs_[2]))
+                                        throw "setEyeImageOptions: First argument must be a logical scalar.";
+                                    asGif = mxIsLogicalScalarTrue(prhs_[2]);
+                                }
+                                std::optional<int> downscaleFactor;
+                                if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+                                {
+                                    if (!mxIsInt32(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                                        throw "setEyeImageOptions: Expected second argument to be an int32 scalar.";
+                                    downscaleFactor = *static_cast<int32_t*>(mxGetData(prhs_[3]));
+                                }
+                                std::optional<double> maxFrameRate;
+                                if (nrhs_ > 4 && !mxIsEmpty(prhs_[4]))
+                                {
+                                    if (!mxIsDouble(prhs_[4]) || mxIsComplex(prhs_[4]) || !mxIsScalar(prhs_[4]))
+                                        throw "setEyeImageOptions: Expected third argument to be a double scalar.";
+                                    maxFrameRate = *static_cast<double*>(mxGetData(prhs_[4]));
+                                }
+
+                                senderInstance->setEyeImageOptions(asGif, downscaleFactor, maxFrameRate);
+                                break;
+                            }
+                            case Action::GetEyeImageOptions:
+                            {
+                                plhs_[0] = mxTypes::ToMatlab(senderInstance->getEyeImageOptions());
+                                return;
+                            }
+                            case Action::SetUseSendQueue:
+                            {
+                                if (nrhs_ < 3 || mxIsEmpty(prhs_[2]) || !mxIsScalar(prhs_[2]) || !mxIsLogicalScalar(prhs_[2]))
+                                    throw "setUseSendQueue: First argument must be a logical scalar.";
+
+                                bool useQueue = mxIsLogicalScalarTrue(prhs_[2]);
+                                plhs_[0] = mxCreateLogicalScalar(senderInstance->setUseSendQueue(useQueue));
+                                return;
+                            }
+                            case Action::GetUseSendQueue:
+                            {
+                                plhs_[0] = mxCreateLogicalScalar(senderInstance->getUseSendQueue());
+                                return;
+                            }
+                            case Action::GetSendQueueStats:
+                            {
+                                if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+                                    throw std::string("getSendQueueStats: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'", false, true) + ").");
+
+                                char* bufferCstr = mxArrayToString(prhs_[2]);
+                                plhs_[0] = mxTypes::ToMatlab(senderInstance->getSendQueueStats(bufferCstr));
+                                mxFree(bufferCstr);
+                                return;
+                            }
                             case Action::IsStreaming:
                             {
                                 if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
@@ -569,6 +672,11 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 plhs_[0] = mxTypes::ToMatlab(receiverInstance->getType());
                                 return;
                             }
+                            case Action::GetGazeLayout:
+                            {
+                                plhs_[0] = mxTypes::ToMatlab(TittaLSL::gazeLayoutToString(receiverInstance->getGazeLayout()));
+                                return;
+                            }
                             case Action::Start:
                             {
                                 receiverInstance->start();
@@ -612,6 +720,9 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 case Titta::Stream::Positioning:
                                     plhs_[0] = mxTypes::ToMatlab(receiverInstance->consumeN<TittaLSL::Receiver::positioning>(nSamp, side));
                                     return;
+                                case Titta::Stream::EyeImage:
+                                    plhs_[0] = mxTypes::ToMatlab(receiverInstance->consumeN<TittaLSL::Receiver::eyeImage>(nSamp, side));
+                                    return;
                                 }
                                 return;
                             }
@@ -652,6 +763,9 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 case Titta::Stream::TimeSync:
                                     plhs_[0] = mxTypes::ToMatlab(receiverInstance->consumeTimeRange<TittaLSL::Receiver::timeSync>(timeStart, timeEnd, timeIsLocalTime));
                                     return;
+                                case Titta::Stream::EyeImage:
+                                    plhs_[0] = mxTypes::ToMatlab(receiverInstance->consumeTimeRange<TittaLSL::Receiver::eyeImage>(timeStart, timeEnd, timeIsLocalTime));
+                                    return;
                                 case Titta::Stream::Positioning:
                                     throw "consumeTimeRange: not supported for positioning stream.";
                                 }
@@ -692,6 +806,9 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 case Titta::Stream::Positioning:
                                     plhs_[0] = mxTypes::ToMatlab(receiverInstance->peekN<TittaLSL::Receiver::positioning>(nSamp, side));
                                     return;
+                                case Titta::Stream::EyeImage:
+                                    plhs_[0] = mxTypes::ToMatlab(receiverInstance->peekN<TittaLSL::Receiver::eyeImage>(nSamp, side));
+                                    return;
                                 }
                                 return;
                             }
@@ -732,6 +849,9 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                                 case Titta::Stream::TimeSync:
                                     plhs_[0] = mxTypes::ToMatlab(receiverInstance->peekTimeRange<TittaLSL::Receiver::timeSync>(timeStart, timeEnd, timeIsLocalTime));
                                     return;
+                                case Titta::Stream::EyeImage:
+                                    plhs_[0] = mxTypes::ToMatlab(receiverInstance->peekTimeRange<TittaLSL::Receiver::eyeImage>(timeStart, timeEnd, timeIsLocalTime));
+                                    return;
                                 case Titta::Stream::Positioning:
                                     throw "peekTimeRange: not supported for positioning stream.";
                                 }
@@ -941,6 +1061,31 @@ namespace mxTypes
 
         return storage_;
     }
+    mxArray* ToMatlab(TittaLSL::Sender::SendQueueStats data_)
+    {
+        const char* fieldNames[] = {"depth","highWaterMark","numQueued","numDropped","numCallbacks","maxCallbackDuration"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.depth));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.highWaterMark));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.numQueued));
+        mxSetFieldByNumber(out, 0, 3, ToMatlab(data_.numDropped));
+        mxSetFieldByNumber(out, 0, 4, ToMatlab(data_.numCallbacks));
+        mxSetFieldByNumber(out, 0, 5, ToMatlab(data_.maxCallbackDuration));
+
+        return out;
+    }
+    mxArray* ToMatlab(TittaLSL::Sender::EyeImageOptions data_)
+    {
+        const char* fieldNames[] = {"asGif","downscaleFactor","maxFrameRate"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.asGif));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(static_cast<double>(data_.downscaleFactor)));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.maxFrameRate));
+
+        return out;
+    }
     mxArray* ToMatlab(lsl::channel_format_t data_)
     {
         switch (data_)
@@ -1096,6 +1241,70 @@ namespace mxTypes
         return out;
     }
 
+    mxArray* eyeImagesToMatlab(const std::vector<TittaLSL::Receiver::eyeImage>& data_)
+    {
+        if (data_.empty())
+            return mxCreateDoubleMatrix(0, 0, mxREAL);
+
+        // 1. see if all same size, then we can put them in one big matrix (one column per image)
+        const auto sz = data_[0].eyeImageData.data_size;
+        const bool same = std::all_of(data_.begin(), data_.end(), [sz](const auto& frame_) { return frame_.eyeImageData.data_size == sz; });
+        for (auto& frame : data_)
+            if (!frame.eyeImageData.is_gif && frame.eyeImageData.bits_per_pixel + frame.eyeImageData.padding_per_pixel != 8)
+                throw "TittaLSL: eyeImagesToMatlab: non-8bit images not implemented";
+        // 2. then copy over the images (raw pixels or GIF file bytes) to matlab
+        mxArray* out;
+        if (same)
+        {
+            auto storage = static_cast<uint8_t*>(mxGetData(out = mxCreateUninitNumericMatrix(sz, data_.size(), mxUINT8_CLASS, mxREAL)));
+            size_t i = 0;
+            for (auto& frame : data_)
+                std::memcpy(storage + (i++)*sz, frame.eyeImageData.data(), sz);
+        }
+        else
+        {
+            out = mxCreateCellMatrix(1, static_cast<mwSize>(data_.size()));
+            mwIndex i = 0;
+            for (auto& frame : data_)
+            {
+                mxArray* temp;
+                auto storage = static_cast<uint8_t*>(mxGetData(temp = mxCreateUninitNumericMatrix(1, frame.eyeImageData.data_size, mxUINT8_CLASS, mxREAL)));
+                std::memcpy(storage, frame.eyeImageData.data(), frame.eyeImageData.data_size);
+                mxSetCell(out, i++, temp);
+            }
+        }
+
+        return out;
+    }
+    mxArray* ToMatlab(std::vector<TittaLSL::Receiver::eyeImage> data_)
+    {
+        const char* fieldNames[] = {"remoteSystemTimeStamp","localSystemTimeStamp","deviceTimeStamp","systemTimeStamp","regionID","regionTop","regionLeft","bitsPerPixel","paddingPerPixel","width","height","type","cameraID","isGif","downscaleFactor","image"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        // 1. remote system timestamps
+        mxSetFieldByNumber(out, 0, 0, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::remoteSystemTimeStamp));
+        // 2. local system timestamps
+        mxSetFieldByNumber(out, 0, 1, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::localSystemTimeStamp));
+        // 3. image info
+        mxSetFieldByNumber(out, 0, 2, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::device_time_stamp));
+        mxSetFieldByNumber(out, 0, 3, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::system_time_stamp));
+        mxSetFieldByNumber(out, 0, 4, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::region_id, 0.));            // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0, 5, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::region_top, 0.));           // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0, 6, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::region_left, 0.));          // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0, 7, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::bits_per_pixel, 0.));       // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0, 8, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::padding_per_pixel, 0.));    // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0, 9, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::width, 0.));                // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0,10, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::height, 0.));               // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0,11, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::type, [](auto in_) {return TobiiResearchEyeImageToString(in_);}));
+        mxSetFieldByNumber(out, 0,12, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::camera_id, 0.));            // 0. causes values to be stored as double
+        mxSetFieldByNumber(out, 0,13, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::is_gif));
+        mxSetFieldByNumber(out, 0,14, FieldToMatlab(data_, true, &TittaLSL::Receiver::eyeImage::downscaleFactor, 0.));                                      // 0. causes values to be stored as double
+        // 4. the images themselves
+        mxSetFieldByNumber(out, 0,15, eyeImagesToMatlab(data_));
+
+        return out;
+    }
+
     mxArray* ToMatlab(std::vector<TittaLSL::Receiver::positioning> data_)
     {
         const char* fieldNames[] = {"remoteSystemTimeStamp","localSystemTimeStamp","left","right"};
@@ -161,6 +161,46 @@ py::dict StructVectorToDict(std::vector<TittaLSL::Receiver::gaze>&& data_)
     return out;
 }
 
+py::dict StructVectorToDict(std::vector<TittaLSL::Receiver::eyeImage>&& data_)
+{
+    py::dict out;
+
+    // check if all gif, then don't output unneeded fields
+    const bool allGif = allEquals(data_, &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::is_gif, true);
+
+    FieldToNpArray<true>(out, data_, "remote_system_time_stamp", &TittaLSL::Receiver::eyeImage::remoteSystemTimeStamp);
+    FieldToNpArray<true>(out, data_, "local_system_time_stamp" , &TittaLSL::Receiver::eyeImage::localSystemTimeStamp);
+    FieldToNpArray<true>(out, data_, "device_time_stamp", &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::device_time_stamp);
+    FieldToNpArray<true>(out, data_, "system_time_stamp", &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::system_time_stamp);
+    FieldToNpArray<true>(out, data_, "region_id"        , &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::region_id);
+    FieldToNpArray<true>(out, data_, "region_top"       , &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::region_top);
+    FieldToNpArray<true>(out, data_, "region_left"      , &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::region_left);
+    if (!allGif)
+    {
+        FieldToNpArray<true>(out, data_, "bits_per_pixel"   , &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::bits_per_pixel);
+        FieldToNpArray<true>(out, data_, "padding_per_pixel", &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::padding_per_pixel);
+        FieldToNpArray<true>(out, data_, "downscale_factor" , &TittaLSL::Receiver::eyeImage::downscaleFactor);
+    }
+    FieldToNpArray<false>(out, data_, "type"     , &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::type);
+    FieldToNpArray<true> (out, data_, "camera_id", &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::camera_id);
+    FieldToNpArray<true> (out, data_, "is_gif"   , &TittaLSL::Receiver::eyeImage::eyeImageData, &Titta::eyeImage::is_gif);
+
+    // the images: 8 bit raw images as height x width arrays, others (GIF files, raw images with larger pixels)
+    // as their bytes
+    py::list l;
+    for (const auto& frame : data_)
+    {
+        const auto& im = frame.eyeImageData;
+        if (!im.is_gif && im.bits_per_pixel + im.padding_per_pixel == 8)
+            l.append(imageToNumpy(im));
+        else
+            l.append(py::array_t<uint8_t>(static_cast<py::ssize_t>(im.data_size), static_cast<uint8_t*>(im.data())));
+    }
+    out["image"] = l;
+
+    return out;
+}
+
 py::dict StructVectorToDict(std::vector<TittaLSL::Receiver::extSignal>&& data_)
 {
     py::dict out;
@@ -274,6 +314,27 @@ py::dict StructToDict(const TobiiTypes::eyeTracker& data_)
     d["supported_modes"] = data_.supportedModes;
     return d;
 }
+
+py::dict StructToDict(const TittaLSL::Sender::SendQueueStats& data_)
+{
+    py::dict d;
+    d["depth"] = data_.depth;
+    d["high_water_mark"] = data_.highWaterMark;
+    d["num_queued"] = data_.numQueued;
+    d["num_dropped"] = data_.numDropped;
+    d["num_callbacks"] = data_.numCallbacks;
+    d["max_callback_duration"] = data_.maxCallbackDuration;
+    return d;
+}
+
+py::dict StructToDict(const TittaLSL::Sender::EyeImageOptions& data_)
+{
+    py::dict d;
+    d["as_gif"] = data_.asGif;
+    d["downscale_factor"] = data_.downscaleFactor;
+    d["max_frame_rate"] = data_.maxFrameRate;
+    return d;
+}
 }
 
 
@@ -299,6 +360,11 @@ PYBIND11_MODULE(MODULE_NAME, m)
         .value("int64", lsl::cf_int64)
         .value("undefined", lsl::cf_undefined)
         ;
+    py::enum_<TittaLSL::GazeLayout>(m, "gaze_layout")
+        .value("full", TittaLSL::GazeLayout::Full)
+        .value("float32", TittaLSL::GazeLayout::Float32)
+        .value("compact", TittaLSL::GazeLayout::Compact)
+        ;
     // NB: stream type is already exported by TittaPy, no need for us to also create it (actually not possible, would clash on import)
 
     //// global SDK functions
@@ -327,10 +393,22 @@ PYBIND11_MODULE(MODULE_NAME, m)
             "stream"_a)
 
         // outlets
-        .def("start", [](TittaLSL::Sender& instance_, std::string stream_) { return instance_.start(std::move(stream_), true); },
-            "stream"_a)
-        .def("start", py::overload_cast<Titta::Stream>(&TittaLSL::Sender::start),
-            "stream"_a)
+        .def("start",
+            [](TittaLSL::Sender& instance_, std::variant<std::string, Titta::Stream> stream_, std::optional<size_t> chunk_size_, std::optional<int64_t> chunk_max_latency_, std::optional<std::variant<std::string, TittaLSL::GazeLayout>> gaze_layout_)
+            {
+                std::optional<TittaLSL::GazeLayout> layout;
+                if (gaze_layout_.has_value())
+                {
+                    if (std::holds_alternative<std::string>(*gaze_layout_))
+                        layout = TittaLSL::stringToGazeLayout(std::get<std::string>(*gaze_layout_));
+                    else
+                        layout = std::get<TittaLSL::GazeLayout>(*gaze_layout_);
+                }
+                if (std::holds_alternative<std::string>(stream_))
+                    return instance_.start(std::get<std::string>(stream_), chunk_size_, chunk_max_latency_, layout, true);
+                return instance_.start(std::get<Titta::Stream>(stream_), chunk_size_, chunk_max_latency_, layout);
+            },
+            "stream"_a, py::arg_v("chunk_size", std::nullopt, "None"), py::arg_v("chunk_max_latency", std::nullopt, "None"), py::arg_v("gaze_layout", std::nullopt, "None"))
 
         .def("is_streaming", [](const TittaLSL::Sender& instance_, std::string stream_) -> bool { return instance_.isStreaming(std::move(stream_), true); },
             "stream"_a)
@@ -339,6 +417,16 @@ PYBIND11_MODULE(MODULE_NAME, m)
 
         .def("set_include_eye_openness_in_gaze", &TittaLSL::Sender::setIncludeEyeOpennessInGaze,
             "include"_a)
+        .def("set_eye_image_options", &TittaLSL::Sender::setEyeImageOptions,
+            py::arg_v("as_gif", std::nullopt, "None"), py::arg_v("downscale_factor", std::nullopt, "None"), py::arg_v("max_frame_rate", std::nullopt, "None"))
+        .def("get_eye_image_options", [](const TittaLSL::Sender& instance_) { return StructToDict(instance_.getEyeImageOptions()); })
+        .def("set_use_send_queue", &TittaLSL::Sender::setUseSendQueue,
+            "use_queue"_a)
+        .def("get_use_send_queue", &TittaLSL::Sender::getUseSendQueue)
+        .def("get_send_queue_stats", [](const TittaLSL::Sender& instance_, std::string stream_) { return StructToDict(instance_.getSendQueueStats(std::move(stream_), true)); },
+            "stream"_a)
+        .def("get_send_queue_stats", [](const TittaLSL::Sender& instance_, Titta::Stream stream_) { return StructToDict(instance_.getSendQueueStats(stream_)); },
+            "stream"_a)
 
         .def("stop", [](TittaLSL::Sender& instance_, std::string stream_) { instance_.stop(std::move(stream_), true); },
             "stream"_a)
@@ -362,6 +450,7 @@ PYBIND11_MODULE(MODULE_NAME, m)
 
         .def("get_info", [](const TittaLSL::Receiver& instance_) { return StructToDict(instance_.getInfo()); })
         .def("get_type", py::overload_cast<>(&TittaLSL::Receiver::getType, py::const_))
+        .def("get_gaze_layout", &TittaLSL::Receiver::getGazeLayout)
 
         .def("start", &TittaLSL::Receiver::start)
 
@@ -391,6 +480,8 @@ PYBIND11_MODULE(MODULE_NAME, m)
                     return StructVectorToDict(instance_.consumeN<TittaLSL::Receiver::timeSync>(NSamp_, bufSide));
                 case Titta::Stream::Positioning:
                     return StructVectorToDict(instance_.consumeN<TittaLSL::Receiver::positioning>(NSamp_, bufSide));
+                case Titta::Stream::EyeImage:
+                    return StructVectorToDict(instance_.consumeN<TittaLSL::Receiver::eyeImage>(NSamp_, bufSide));
                 }
                 return {};
             },
@@ -408,6 +499,8 @@ PYBIND11_MODULE(MODULE_NAME, m)
                     return StructVectorToDict(instance_.consumeTimeRange<TittaLSL::Receiver::extSignal>(timeStart_, timeEnd_, timeIsLocalTime_));
                 case Titta::Stream::TimeSync:
                     return StructVectorToDict(instance_.consumeTimeRange<TittaLSL::Receiver::timeSync>(timeStart_, timeEnd_, timeIsLocalTime_));
+                case Titta::Stream::EyeImage:
+                    return StructVectorToDict(instance_.consumeTimeRange<TittaLSL::Receiver::eyeImage>(timeStart_, timeEnd_, timeIsLocalTime_));
                 case Titta::Stream::Positioning:
                     DoExitWithMsg("TittaLSL::cpp::consume_time_range: not supported for positioning stream.");
                 }
@@ -439,6 +532,8 @@ PYBIND11_MODULE(MODULE_NAME, m)
                     return StructVectorToDict(instance_.peekN<TittaLSL::Receiver::timeSync>(NSamp_, bufSide));
                 case Titta::Stream::Positioning:
                     return StructVectorToDict(instance_.peekN<TittaLSL::Receiver::positioning>(NSamp_, bufSide));
+                case Titta::Stream::EyeImage:
+                    return StructVectorToDict(instance_.peekN<TittaLSL::Receiver::eyeImage>(NSamp_, bufSide));
                 }
                 return {};
             },
@@ -456,6 +551,8 @@ PYBIND11_MODULE(MODULE_NAME, m)
                     return StructVectorToDict(instance_.peekTimeRange<TittaLSL::Receiver::extSignal>(timeStart_, timeEnd_, timeIsLocalTime_));
                 case Titta::Stream::TimeSync:
                     return StructVectorToDict(instance_.peekTimeRange<TittaLSL::Receiver::timeSync>(timeStart_, timeEnd_, timeIsLocalTime_));
+                case Titta::Stream::EyeImage:
+                    return StructVectorToDict(instance_.peekTimeRange<TittaLSL::Receiver::eyeImage>(timeStart_, timeEnd_, timeIsLocalTime_));
                 case Titta::Stream::Positioning:
                     DoExitWithMsg("Titta::cpp::peek_time_range: not supported for positioning stream.");
                 }
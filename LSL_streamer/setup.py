@@ -33,7 +33,7 @@ class get_pybind_include(object):
 ext_modules = [
     Extension(
         'TittaLSLPy',
-        ['../SDK_wrapper/src/Titta.cpp','../SDK_wrapper/src/types.cpp','../SDK_wrapper/src/utils.cpp','src/TittaLSL.cpp','TittaLSLPy/TittaLSLPy.cpp'],
+        ['../SDK_wrapper/src/Titta.cpp','../SDK_wrapper/src/types.cpp','../SDK_wrapper/src/utils.cpp','../SDK_wrapper/src/journal.cpp','../SDK_wrapper/src/session.cpp','../SDK_wrapper/src/parquet.cpp','../SDK_wrapper/src/convert.cpp','../SDK_wrapper/src/simulator.cpp','../SDK_wrapper/src/latency.cpp','../SDK_wrapper/src/trace.cpp','src/TittaLSL.cpp','TittaLSLPy/TittaLSLPy.cpp'],
         include_dirs=[
             # Path to pybind11 headers
             get_pybind_include(),
@@ -5,8 +5,13 @@
 #include <numeric>
 #include <map>
 #include <ranges>
+#include <cinttypes>
+#include <cstring>
+#include <cmath>
 
 #include "Titta/utils.h"
+#include "Titta/convert.h"
+#include "Titta/trace.h"
 
 namespace
 {
@@ -14,6 +19,13 @@ namespace
     namespace defaults
     {
         constexpr bool                  createStartsRecording   = false;
+        constexpr size_t                recorderChunkSize       = 256;          // maximum number of samples a recorder thread pulls at once
+
+        constexpr size_t                outletChunkSize         = 1;
+        constexpr int64_t               outletChunkMaxLatency   = 10'000;       // microseconds
+        constexpr auto                  chunkFlushInterval      = std::chrono::milliseconds(1);
+        constexpr auto                  sendQueueDrainInterval  = std::chrono::milliseconds(1);
+        constexpr TittaLSL::GazeLayout  gazeLayout              = TittaLSL::GazeLayout::Full;
 
         constexpr size_t                gazeBufSize             = 2<<19;        // about half an hour at 600Hz
 
@@ -23,6 +35,8 @@ namespace
 
         constexpr size_t                positioningBufSize      = 2<<11;
 
+        constexpr size_t                eyeImageBufSize         = 2<<11;        // about seven minutes at 2*5Hz
+
         constexpr int64_t               clearTimeRangeStart     = 0;
         constexpr int64_t               clearTimeRangeEnd       = std::numeric_limits<int64_t>::max();
 
@@ -47,6 +61,7 @@ namespace
     template <>                struct TittaStreamToLSLInletType<Titta::Stream::ExtSignal> { using type = TittaLSL::Receiver::extSignal; };
     template <>                struct TittaStreamToLSLInletType<Titta::Stream::TimeSync> { using type = TittaLSL::Receiver::timeSync; };
     template <>                struct TittaStreamToLSLInletType<Titta::Stream::Positioning> { using type = TittaLSL::Receiver::positioning; };
+    template <>                struct TittaStreamToLSLInletType<Titta::Stream::EyeImage> { using type = TittaLSL::Receiver::eyeImage; };
     template <Titta::Stream T>
     using TittaStreamToLSLInletType_t = typename TittaStreamToLSLInletType<T>::type;
 
@@ -55,29 +70,80 @@ namespace
     template <>           struct LSLInletTypeToTittaStream<TittaLSL::Receiver::extSignal> { static constexpr Titta::Stream value = Titta::Stream::ExtSignal; };
     template <>           struct LSLInletTypeToTittaStream<TittaLSL::Receiver::timeSync> { static constexpr Titta::Stream value = Titta::Stream::TimeSync; };
     template <>           struct LSLInletTypeToTittaStream<TittaLSL::Receiver::positioning> { static constexpr Titta::Stream value = Titta::Stream::Positioning; };
+    template <>           struct LSLInletTypeToTittaStream<TittaLSL::Receiver::eyeImage> { static constexpr Titta::Stream value = Titta::Stream::EyeImage; };
     template <typename T>
     constexpr Titta::Stream LSLInletTypeToTittaStream_v = LSLInletTypeToTittaStream<T>::value;
 
-    template <typename T> struct LSLInletTypeNumSamples { static_assert(always_false_t<T>, "LSLInletTypeNumSamples not implemented for this type"); static constexpr size_t value = 0; };
+    // the layout only applies to gaze streams, other streams have one layout (the default)
+    template <typename T, TittaLSL::GazeLayout L = TittaLSL::GazeLayout::Full> struct LSLInletTypeNumSamples { static_assert(always_false_t<T>, "LSLInletTypeNumSamples not implemented for this type"); static constexpr size_t value = 0; };
     template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::gaze> { static constexpr size_t value = 43; };
+    template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::gaze, TittaLSL::GazeLayout::Float32> { static constexpr size_t value = 44; };
+    template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::gaze, TittaLSL::GazeLayout::Compact> { static constexpr size_t value = 12; };
     template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::extSignal> { static constexpr size_t value = 4; };
     template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::timeSync> { static constexpr size_t value = 3; };
     template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::positioning> { static constexpr size_t value = 8; };
-    template <typename T>
-    constexpr size_t LSLInletTypeNumSamples_v = LSLInletTypeNumSamples<T>::value;
+    template <>           struct LSLInletTypeNumSamples<TittaLSL::Receiver::eyeImage> { static constexpr size_t value = 2; };
+    template <typename T, TittaLSL::GazeLayout L = TittaLSL::GazeLayout::Full>
+    constexpr size_t LSLInletTypeNumSamples_v = LSLInletTypeNumSamples<T, L>::value;
 
-    template <typename T> struct LSLInletTypeToChannelFormat { static_assert(always_false_t<T>, "LSLInletTypeToChannelFormat not implemented for this type"); static constexpr enum lsl::channel_format_t value = lsl::cf_undefined; };
+    template <typename T, TittaLSL::GazeLayout L = TittaLSL::GazeLayout::Full> struct LSLInletTypeToChannelFormat { static_assert(always_false_t<T>, "LSLInletTypeToChannelFormat not implemented for this type"); static constexpr enum lsl::channel_format_t value = lsl::cf_undefined; };
     template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::gaze> { static constexpr enum lsl::channel_format_t value = lsl::cf_double64; };
+    template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::gaze, TittaLSL::GazeLayout::Float32> { static constexpr enum lsl::channel_format_t value = lsl::cf_float32; };
+    template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::gaze, TittaLSL::GazeLayout::Compact> { static constexpr enum lsl::channel_format_t value = lsl::cf_float32; };
     template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::extSignal> { static constexpr enum lsl::channel_format_t value = lsl::cf_int64; };
     template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::timeSync> { static constexpr enum lsl::channel_format_t value = lsl::cf_int64; };
     template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::positioning> { static constexpr enum lsl::channel_format_t value = lsl::cf_float32; };
+    template <>           struct LSLInletTypeToChannelFormat<TittaLSL::Receiver::eyeImage> { static constexpr enum lsl::channel_format_t value = lsl::cf_string; };
+    template <typename T, TittaLSL::GazeLayout L = TittaLSL::GazeLayout::Full>
+    constexpr enum lsl::channel_format_t LSLInletTypeToChannelFormat_v = LSLInletTypeToChannelFormat<T, L>::value;
+
+    // in the float gaze layouts, the device time stamp (us) is split over two channels, the value above and
+    // below this. Both parts are exactly representable as float for time stamps up to about 8.9 years
+    constexpr int64_t gazeTimeStampSplit = int64_t{1} << 24;
+
+    const std::map<std::string, TittaLSL::GazeLayout> gazeLayoutMap =
+    {
+        { "full",       TittaLSL::GazeLayout::Full },
+        { "float32",    TittaLSL::GazeLayout::Float32 },
+        { "compact",    TittaLSL::GazeLayout::Compact },
+    };
+
+    // eye images are sent as two string channels: a header with the image's metadata as comma-separated
+    // text, and the image's bytes (raw pixels, or a GIF file)
+    constexpr const char* eyeImageHeaderFields = "is_gif,device_time_stamp,system_time_stamp,bits_per_pixel,padding_per_pixel,width,height,region_id,region_top,region_left,type,camera_id,downscale_factor";
+    constexpr int eyeImageMaxDownscaleFactor = 255;
+
+    // shrink an image by averaging blocks of factor_ x factor_ pixels, each stored in sizeof(T) bytes
     template <typename T>
-    constexpr enum lsl::channel_format_t LSLInletTypeToChannelFormat_v = LSLInletTypeToChannelFormat<T>::value;
+    void downscaleImage(uint8_t* out_, const uint8_t* in_, const int inWidth_, const int outWidth_, const int outHeight_, const int factor_)
+    {
+        const auto nPix = static_cast<uint64_t>(factor_) * factor_;
+        for (int y = 0; y < outHeight_; y++)
+        {
+            for (int x = 0; x < outWidth_; x++)
+            {
+                uint64_t sum = 0;
+                for (int dy = 0; dy < factor_; dy++)
+                {
+                    const auto row = in_ + (static_cast<size_t>(y * factor_ + dy) * inWidth_ + static_cast<size_t>(x) * factor_) * sizeof(T);
+                    for (int dx = 0; dx < factor_; dx++)
+                    {
+                        T val;
+                        std::memcpy(&val, row + dx * sizeof(T), sizeof(T));
+                        sum += val;
+                    }
+                }
+                const auto val = static_cast<T>((sum + nPix / 2) / nPix);
+                std::memcpy(out_ + (static_cast<size_t>(y) * outWidth_ + x) * sizeof(T), &val, sizeof(T));
+            }
+        }
+    }
 
     template <enum lsl::channel_format_t T> struct LSLChannelFormatToCppType { static_assert(always_false_nt<T>, "LSLChannelFormatToCppType not implemented for this enum value: this channel format is not supported by TittaLSL"); };
     template <>                struct LSLChannelFormatToCppType<lsl::cf_float32> { using type = float; };
     template <>                struct LSLChannelFormatToCppType<lsl::cf_double64> { using type = double; };
     template <>                struct LSLChannelFormatToCppType<lsl::cf_int64> { using type = int64_t; };
+    template <>                struct LSLChannelFormatToCppType<lsl::cf_string> { using type = std::string; };
     template <enum lsl::channel_format_t T>
     using LSLChannelFormatToCppType_t = typename LSLChannelFormatToCppType<T>::type;
 }
@@ -97,49 +163,118 @@ int32_t getLSLVersion()
     return lsl::library_version();
 }
 
+GazeLayout stringToGazeLayout(std::string layout_)
+{
+    const auto it = gazeLayoutMap.find(layout_);
+    if (it == gazeLayoutMap.end())
+        DoExitWithMsg(
+            R"(TittaLSL::cpp: Requested gaze layout ")" + layout_ + R"(" is not recognized. Supported gaze layouts are: )" + getAllGazeLayoutsString("\"")
+        );
+    return it->second;
+}
+std::string gazeLayoutToString(const GazeLayout layout_)
+{
+    const auto it = std::find_if(gazeLayoutMap.begin(), gazeLayoutMap.end(), [&layout_](auto p_) {return p_.second == layout_;});
+    return it == gazeLayoutMap.end() ? "unknown" : it->first;
+}
+std::string getAllGazeLayoutsString(const char* quoteChar_ /*= "\""*/)
+{
+    using val_t = std::underlying_type_t<GazeLayout>;
+    std::string out;
+    for (auto val = static_cast<val_t>(GazeLayout::Full); val < static_cast<val_t>(GazeLayout::Last); val++)
+    {
+        if (val)
+            out += ", ";
+        out += quoteChar_ + gazeLayoutToString(static_cast<GazeLayout>(val)) + quoteChar_;
+    }
+    return out;
+}
+
 
 // callbacks
 void GazeCallback(TobiiResearchGazeData* gaze_data_, void* user_data)
 {
     if (user_data)
     {
+        const auto start = std::chrono::steady_clock::now();
         const auto instance = static_cast<TittaLSL::Sender*>(user_data);
-        instance->receiveSample(gaze_data_, nullptr);
+        if (instance->_useSendQueue)
+            instance->enqueueSample(Titta::Stream::Gaze, instance->_gazeSendQueue, *gaze_data_);
+        else
+            instance->receiveSample(gaze_data_, nullptr);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::Gaze)].addCallback(start);
     }
 }
 void EyeOpennessCallback(TobiiResearchEyeOpennessData* openness_data_, void* user_data)
 {
     if (user_data)
     {
+        const auto start = std::chrono::steady_clock::now();
         const auto instance = static_cast<TittaLSL::Sender*>(user_data);
-        instance->receiveSample(nullptr, openness_data_);
+        if (instance->_useSendQueue)
+            instance->enqueueSample(Titta::Stream::EyeOpenness, instance->_eyeOpennessSendQueue, *openness_data_);
+        else
+            instance->receiveSample(nullptr, openness_data_);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::EyeOpenness)].addCallback(start);
     }
 }
 void ExtSignalCallback(TobiiResearchExternalSignalData* ext_signal_, void* user_data)
 {
     if (user_data)
     {
+        const auto start = std::chrono::steady_clock::now();
         const auto instance = static_cast<TittaLSL::Sender*>(user_data);
-        if (instance->isStreaming(Titta::Stream::ExtSignal))
+        if (instance->_useSendQueue)
+            instance->enqueueSample(Titta::Stream::ExtSignal, instance->_extSignalSendQueue, *ext_signal_);
+        else if (instance->isStreaming(Titta::Stream::ExtSignal))
             instance->pushSample(*ext_signal_);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::ExtSignal)].addCallback(start);
     }
 }
 void TimeSyncCallback(TobiiResearchTimeSynchronizationData* time_sync_data_, void* user_data)
 {
     if (user_data)
     {
+        const auto start = std::chrono::steady_clock::now();
         const auto instance = static_cast<TittaLSL::Sender*>(user_data);
-        if (instance->isStreaming(Titta::Stream::TimeSync))
+        if (instance->_useSendQueue)
+            instance->enqueueSample(Titta::Stream::TimeSync, instance->_timeSyncSendQueue, *time_sync_data_);
+        else if (instance->isStreaming(Titta::Stream::TimeSync))
             instance->pushSample(*time_sync_data_);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::TimeSync)].addCallback(start);
     }
 }
 void PositioningCallback(TobiiResearchUserPositionGuide* position_data_, void* user_data)
 {
     if (user_data)
     {
+        const auto start = std::chrono::steady_clock::now();
         const auto instance = static_cast<TittaLSL::Sender*>(user_data);
-        if (instance->isStreaming(Titta::Stream::Positioning))
+        if (instance->_useSendQueue)
+            instance->enqueueSample(Titta::Stream::Positioning, instance->_positioningSendQueue, *position_data_);
+        else if (instance->isStreaming(Titta::Stream::Positioning))
             instance->pushSample(*position_data_);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::Positioning)].addCallback(start);
+    }
+}
+void EyeImageCallback(TobiiResearchEyeImage* eye_image_, void* user_data)
+{
+    if (user_data)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto instance = static_cast<TittaLSL::Sender*>(user_data);
+        instance->receiveSample(eye_image_);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::EyeImage)].addCallback(start);
+    }
+}
+void EyeImageGifCallback(TobiiResearchEyeImageGif* eye_image_, void* user_data)
+{
+    if (user_data)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        const auto instance = static_cast<TittaLSL::Sender*>(user_data);
+        instance->receiveSample(eye_image_);
+        instance->_sendQueueCounters[static_cast<size_t>(Titta::Stream::EyeImage)].addCallback(start);
     }
 }
 }
@@ -156,7 +291,10 @@ Sender::Sender(TobiiResearchEyeTracker* et_)
 }
 Sender::Sender(const TobiiTypes::eyeTracker& et_)
 {
-    connect(et_.et);
+    if (!et_.et && TittaSimulator::isSimulatorAddress(et_.address))
+        connect(et_.address);
+    else
+        connect(et_.et);
 }
 Sender::~Sender()
 {
@@ -165,6 +303,15 @@ Sender::~Sender()
     stop(Titta::Stream::ExtSignal);
     stop(Titta::Stream::TimeSync);
     stop(Titta::Stream::Positioning);
+    stop(Titta::Stream::EyeImage);
+
+    _sendThreadShouldStop = true;
+    if (_sendThread.joinable())
+        _sendThread.join();
+
+    _chunkFlushShouldStop = true;
+    if (_chunkFlushThread.joinable())
+        _chunkFlushThread.join();
 }
 
 void Sender::CheckClocks()
@@ -205,6 +352,14 @@ void Sender::CheckClocks()
 
 void Sender::connect(std::string address_)
 {
+    if (TittaSimulator::isSimulatorAddress(address_))
+    {
+        _simulator       = std::make_unique<TittaSimulator::tracker>(TittaSimulator::settings::fromAddress(address_), address_);
+        _localEyeTracker = _simulator->getInfo();
+        CheckClocks();
+        return;
+    }
+
     TobiiResearchEyeTracker* et;
     const TobiiResearchStatus status = tobii_research_get_eyetracker(address_.c_str(), &et);
     if (status != TOBII_RESEARCH_STATUS_OK)
@@ -221,9 +376,16 @@ void Sender::connect(TobiiResearchEyeTracker* et_)
 
 TobiiTypes::eyeTracker Sender::getEyeTracker()
 {
-    _localEyeTracker.refreshInfo();
+    refreshEyeTrackerInfo();
     return _localEyeTracker;
 }
+void Sender::refreshEyeTrackerInfo()
+{
+    if (_simulator)
+        _localEyeTracker = _simulator->getInfo();
+    else
+        _localEyeTracker.refreshInfo();
+}
 
 std::string Sender::getStreamSourceID(std::string stream_, bool snake_case_on_stream_not_found /*= false*/) const
 {
@@ -236,20 +398,36 @@ std::string Sender::getStreamSourceID(Titta::Stream stream_) const
     return string_format("TittaLSL:%s@%s", lslStreamName.c_str(), _localEyeTracker.serialNumber.c_str());
 }
 
-bool Sender::start(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/)
+bool Sender::start(std::string stream_, std::optional<size_t> chunkSize_, std::optional<int64_t> chunkMaxLatency_, std::optional<GazeLayout> gazeLayout_, const bool snake_case_on_stream_not_found /*= false*/)
 {
-    return start(Titta::stringToStream(std::move(stream_), snake_case_on_stream_not_found, true));
+    return start(Titta::stringToStream(std::move(stream_), snake_case_on_stream_not_found, true), chunkSize_, chunkMaxLatency_, gazeLayout_);
 }
-bool Sender::start(const Titta::Stream stream_)
+bool Sender::start(const Titta::Stream stream_, std::optional<size_t> chunkSize_, std::optional<int64_t> chunkMaxLatency_, std::optional<GazeLayout> gazeLayout_)
 {
     // if already streaming, don't start again
     if (isStreaming(stream_))
         return false;
 
+    // deal with default arguments
+    const auto chunkSize        = chunkSize_      .value_or(defaults::outletChunkSize);
+    const auto chunkMaxLatency  = chunkMaxLatency_.value_or(defaults::outletChunkMaxLatency);
+    if (chunkSize < 1)
+        DoExitWithMsg("TittaLSL::cpp::start: chunkSize must be at least 1");
+    if (chunkMaxLatency < 0)
+        DoExitWithMsg("TittaLSL::cpp::start: chunkMaxLatency cannot be negative");
+    if (chunkSize > 1 && stream_ == Titta::Stream::EyeImage)
+        DoExitWithMsg(string_format("TittaLSL::cpp::start: the %s stream cannot be sent in chunks, chunkSize must be 1.", Titta::streamToString(Titta::Stream::EyeImage).c_str()));
+    const auto isGaze = stream_ == Titta::Stream::Gaze || stream_ == Titta::Stream::EyeOpenness;
+    if (gazeLayout_ && !isGaze)
+        DoExitWithMsg(string_format("TittaLSL::cpp::start: a gaze layout can only be specified for the %s stream.", Titta::streamToString(Titta::Stream::Gaze).c_str()));
+    const auto gazeLayout       = gazeLayout_     .value_or(defaults::gazeLayout);
+    if (gazeLayout == GazeLayout::Last)
+        DoExitWithMsg("TittaLSL::cpp::start: invalid gaze layout");
+
     // for gaze signal, get info about the eye tracker's gaze stream
-    const auto hasFreq = stream_ == Titta::Stream::Gaze || stream_ == Titta::Stream::EyeOpenness;
+    const auto hasFreq = isGaze;
     if (hasFreq)
-        _localEyeTracker.refreshInfo();
+        refreshEyeTrackerInfo();
 
     std::string type;
     int nChannel = 0;
@@ -259,8 +437,21 @@ bool Sender::start(const Titta::Stream stream_)
     case Titta::Stream::Gaze:
     case Titta::Stream::EyeOpenness:
         type = "Gaze";
-        nChannel = LSLInletTypeNumSamples_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>>;
-        format = LSLInletTypeToChannelFormat_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>>;
+        switch (gazeLayout)
+        {
+        case GazeLayout::Full:
+            nChannel = LSLInletTypeNumSamples_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>, GazeLayout::Full>;
+            format = LSLInletTypeToChannelFormat_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>, GazeLayout::Full>;
+            break;
+        case GazeLayout::Float32:
+            nChannel = LSLInletTypeNumSamples_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>, GazeLayout::Float32>;
+            format = LSLInletTypeToChannelFormat_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>, GazeLayout::Float32>;
+            break;
+        case GazeLayout::Compact:
+            nChannel = LSLInletTypeNumSamples_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>, GazeLayout::Compact>;
+            format = LSLInletTypeToChannelFormat_v<TittaStreamToLSLInletType_t<Titta::Stream::Gaze>, GazeLayout::Compact>;
+            break;
+        }
         break;
     case Titta::Stream::ExtSignal:
         type = "TTL";
@@ -277,6 +468,11 @@ bool Sender::start(const Titta::Stream stream_)
         nChannel = LSLInletTypeNumSamples_v<TittaStreamToLSLInletType_t<Titta::Stream::Positioning>>;
         format = LSLInletTypeToChannelFormat_v<TittaStreamToLSLInletType_t<Titta::Stream::Positioning>>;
         break;
+    case Titta::Stream::EyeImage:
+        type = "EyeImage";
+        nChannel = LSLInletTypeNumSamples_v<TittaStreamToLSLInletType_t<Titta::Stream::EyeImage>>;
+        format = LSLInletTypeToChannelFormat_v<TittaStreamToLSLInletType_t<Titta::Stream::EyeImage>>;
+        break;
     default:
         DoExitWithMsg(string_format("TittaLSL::cpp::start: opening an outlet for %s stream is not supported.", Titta::streamToString(stream_).c_str()));
         break;
@@ -300,6 +496,10 @@ bool Sender::start(const Titta::Stream stream_)
         .append_child_value("serial_number", _localEyeTracker.serialNumber)
         .append_child_value("firmware_version", _localEyeTracker.firmwareVersion)
         .append_child_value("tracking_mode", _localEyeTracker.trackingMode);
+    if (isGaze)
+        info.desc().append_child_value("layout", gazeLayoutToString(gazeLayout));
+    else if (stream_ == Titta::Stream::EyeImage)
+        info.desc().append_child_value("image_format", _eyeImageAsGif ? "gif" : "raw");
     auto channels = info.desc().append_child("channels");
 
     // describe the streams
@@ -308,6 +508,48 @@ bool Sender::start(const Titta::Stream stream_)
     case Titta::Stream::Gaze:
         [[fallthrough]];
     case Titta::Stream::EyeOpenness:
+        if (gazeLayout == GazeLayout::Compact)
+        {
+            for (const auto eye : { "left", "right" })
+            {
+                const std::string suffix = std::string(".") + eye + "_eye";
+                channels.append_child("channel")
+                    .append_child_value("label", "x.position_on_display_area.gaze_point" + suffix)
+                    .append_child_value("eye", eye)
+                    .append_child_value("type", "ScreenX")
+                    .append_child_value("unit", "normalized");
+                channels.append_child("channel")
+                    .append_child_value("label", "y.position_on_display_area.gaze_point" + suffix)
+                    .append_child_value("eye", eye)
+                    .append_child_value("type", "ScreenY")
+                    .append_child_value("unit", "normalized");
+                channels.append_child("channel")
+                    .append_child_value("label", "valid.gaze_point" + suffix)
+                    .append_child_value("eye", eye)
+                    .append_child_value("type", "ValidFlag")
+                    .append_child_value("unit", "bool");
+                channels.append_child("channel")
+                    .append_child_value("label", "diameter.pupil" + suffix)
+                    .append_child_value("eye", eye)
+                    .append_child_value("type", "Diameter")
+                    .append_child_value("unit", "mm");
+                channels.append_child("channel")
+                    .append_child_value("label", "valid.pupil" + suffix)
+                    .append_child_value("eye", eye)
+                    .append_child_value("type", "ValidFlag")
+                    .append_child_value("unit", "bool");
+            }
+            channels.append_child("channel")
+                .append_child_value("label", "device_time_stamp.high")
+                .append_child_value("type", "TimeStamp")
+                .append_child_value("unit", "us")
+                .append_child_value("multiplier", std::to_string(gazeTimeStampSplit));
+            channels.append_child("channel")
+                .append_child_value("label", "device_time_stamp.low")
+                .append_child_value("type", "TimeStamp")
+                .append_child_value("unit", "us");
+            break;
+        }
         channels.append_child("channel")
             .append_child_value("label", "x.position_on_display_area.gaze_point.left_eye")
             .append_child_value("eye", "left")
@@ -526,6 +768,24 @@ bool Sender::start(const Titta::Stream stream_)
             .append_child_value("eye", "right")
             .append_child_value("type", "AvailableFlag")
             .append_child_value("unit", "bool");
+
+        if (gazeLayout == GazeLayout::Full)
+            channels.append_child("channel")
+                .append_child_value("label", "device_time_stamp")
+                .append_child_value("type", "TimeStamp")
+                .append_child_value("unit", "s");
+        else
+        {
+            channels.append_child("channel")
+                .append_child_value("label", "device_time_stamp.high")
+                .append_child_value("type", "TimeStamp")
+                .append_child_value("unit", "us")
+                .append_child_value("multiplier", std::to_string(gazeTimeStampSplit));
+            channels.append_child("channel")
+                .append_child_value("label", "device_time_stamp.low")
+                .append_child_value("type", "TimeStamp")
+                .append_child_value("unit", "us");
+        }
         break;
     case Titta::Stream::ExtSignal:
         channels.append_child("channel")
@@ -600,10 +860,44 @@ bool Sender::start(const Titta::Stream stream_)
             .append_child_value("type", "ValidFlag")
             .append_child_value("unit", "bool");
         break;
+    case Titta::Stream::EyeImage:
+        channels.append_child("channel")
+            .append_child_value("label", "header")
+            .append_child_value("type", "ImageHeader")
+            .append_child_value("fields", eyeImageHeaderFields);
+        channels.append_child("channel")
+            .append_child_value("label", "image")
+            .append_child_value("type", "ImageData");
+        break;
     }
 
-    // make the outlet
-    _outStreams.insert(std::make_pair(stream_,lsl::stream_outlet(info, 1)));
+    if (isGaze)
+        _gazeLayout = gazeLayout;
+
+    // make the outlet. When pushing chunks, let each chunk be transmitted as a whole instead of per sample
+    std::unique_lock ls(_sendDrainMutex);
+    auto& outlet = _outStreams.insert(std::make_pair(stream_,lsl::stream_outlet(info, chunkSize > 1 ? 0 : 1))).first->second;
+    ls.unlock();
+    if (chunkSize > 1)
+    {
+        auto& chunk = _outChunks[static_cast<size_t>(stream_)];
+        std::scoped_lock l(chunk.mutex);
+        chunk.outlet        = &outlet;
+        chunk.size          = chunkSize;
+        chunk.maxLatency    = chunkMaxLatency;
+        chunk.numChannels   = static_cast<size_t>(nChannel);
+        chunk.numSamples    = 0;
+        chunk.timeStamps.assign(chunkSize, 0.);
+        if (format == lsl::cf_double64)
+            chunk.values = std::vector<double>(chunkSize * chunk.numChannels);
+        else if (format == lsl::cf_int64)
+            chunk.values = std::vector<int64_t>(chunkSize * chunk.numChannels);
+        else
+            chunk.values = std::vector<float>(chunkSize * chunk.numChannels);
+
+        if (chunkMaxLatency && !_chunkFlushThread.joinable())
+            _chunkFlushThread = std::thread(&Sender::chunkFlushThread, this);
+    }
 
     // start the eye tracker stream
     return attachCallback(stream_);
@@ -626,6 +920,27 @@ void Sender::setIncludeEyeOpennessInGaze(const bool include_)
         attachCallback(Titta::Stream::EyeOpenness);
 }
 
+void Sender::setEyeImageOptions(const std::optional<bool> asGif_, const std::optional<int> downscaleFactor_, const std::optional<double> maxFrameRate_)
+{
+    if (asGif_ && *asGif_ != _eyeImageAsGif && _streamingEyeImage)
+        DoExitWithMsg("TittaLSL::cpp::setEyeImageOptions: Cannot change whether eye images are sent as GIF while sending them, stop the " + Titta::streamToString(Titta::Stream::EyeImage) + " stream first.");
+    if (downscaleFactor_ && (*downscaleFactor_ < 1 || *downscaleFactor_ > eyeImageMaxDownscaleFactor))
+        DoExitWithMsg(string_format("TittaLSL::cpp::setEyeImageOptions: downscaleFactor must be between 1 and %d", eyeImageMaxDownscaleFactor));
+    if (maxFrameRate_ && !(*maxFrameRate_ >= 0. && std::isfinite(*maxFrameRate_)))
+        DoExitWithMsg("TittaLSL::cpp::setEyeImageOptions: maxFrameRate must be a finite value that is 0 or larger");
+
+    if (asGif_)
+        _eyeImageAsGif = *asGif_;
+    if (downscaleFactor_)
+        _eyeImageDownscaleFactor = *downscaleFactor_;
+    if (maxFrameRate_)
+        _eyeImageMaxFrameRate = *maxFrameRate_;
+}
+Sender::EyeImageOptions Sender::getEyeImageOptions() const
+{
+    return { _eyeImageAsGif, _eyeImageDownscaleFactor, _eyeImageMaxFrameRate };
+}
+
 bool Sender::attachCallback(const Titta::Stream stream_)
 {
     TobiiResearchStatus result=TOBII_RESEARCH_STATUS_OK;
@@ -639,7 +954,7 @@ bool Sender::attachCallback(const Titta::Stream stream_)
             else
             {
                 // start sending
-                result = tobii_research_subscribe_to_gaze_data(_localEyeTracker.et, GazeCallback, this);
+                result = _simulator ? _simulator->subscribe(GazeCallback, this) : tobii_research_subscribe_to_gaze_data(_localEyeTracker.et, GazeCallback, this);
                 stateVar = &_streamingGaze;
             }
             break;
@@ -651,7 +966,7 @@ bool Sender::attachCallback(const Titta::Stream stream_)
             else
             {
                 // start sending
-                result = tobii_research_subscribe_to_eye_openness(_localEyeTracker.et, EyeOpennessCallback, this);
+                result = _simulator ? _simulator->subscribe(EyeOpennessCallback, this) : tobii_research_subscribe_to_eye_openness(_localEyeTracker.et, EyeOpennessCallback, this);
                 stateVar = &_streamingEyeOpenness;
             }
             break;
@@ -663,7 +978,7 @@ bool Sender::attachCallback(const Titta::Stream stream_)
             else
             {
                 // start sending
-                result = tobii_research_subscribe_to_external_signal_data(_localEyeTracker.et, ExtSignalCallback, this);
+                result = _simulator ? _simulator->subscribe(ExtSignalCallback, this) : tobii_research_subscribe_to_external_signal_data(_localEyeTracker.et, ExtSignalCallback, this);
                 stateVar = &_streamingExtSignal;
             }
             break;
@@ -675,7 +990,7 @@ bool Sender::attachCallback(const Titta::Stream stream_)
             else
             {
                 // start sending
-                result = tobii_research_subscribe_to_time_synchronization_data(_localEyeTracker.et, TimeSyncCallback, this);
+                result = _simulator ? _simulator->subscribe(TimeSyncCallback, this) : tobii_research_subscribe_to_time_synchronization_data(_localEyeTracker.et, TimeSyncCallback, this);
                 stateVar = &_streamingTimeSync;
             }
             break;
@@ -687,11 +1002,28 @@ bool Sender::attachCallback(const Titta::Stream stream_)
             else
             {
                 // start sending
-                result = tobii_research_subscribe_to_user_position_guide(_localEyeTracker.et, PositioningCallback, this);
+                result = _simulator ? _simulator->subscribe(PositioningCallback, this) : tobii_research_subscribe_to_user_position_guide(_localEyeTracker.et, PositioningCallback, this);
                 stateVar = &_streamingPositioning;
             }
             break;
         }
+        case Titta::Stream::EyeImage:
+        {
+            if (_streamingEyeImage)
+                result = TOBII_RESEARCH_STATUS_OK;
+            else
+            {
+                // start sending
+                _eyeImageNextDue.clear();
+                _eyeImageIsGif = _eyeImageAsGif;
+                if (_eyeImageIsGif)
+                    result = _simulator ? _simulator->subscribe(EyeImageGifCallback, this) : tobii_research_subscribe_to_eye_image_as_gif(_localEyeTracker.et, EyeImageGifCallback, this);
+                else
+                    result = _simulator ? _simulator->subscribe(EyeImageCallback, this) : tobii_research_subscribe_to_eye_image(_localEyeTracker.et, EyeImageCallback, this);
+                stateVar = &_streamingEyeImage;
+            }
+            break;
+        }
         default:
         {
             DoExitWithMsg("TittaLSL::cpp::start: Cannot start sending " + Titta::streamToString(stream_) + " stream, not supported to send via outlet");
@@ -721,26 +1053,6 @@ bool Sender::attachCallback(const Titta::Stream stream_)
 
 // tobii to own type helpers
 namespace {
-    void convert(TobiiTypes::gazePoint& out_, const TobiiResearchGazePoint& in_)
-    {
-        out_.position_in_user_coordinates   = in_.position_in_user_coordinates;
-        out_.position_on_display_area       = in_.position_on_display_area;
-        out_.validity                       = in_.validity;
-        out_.available                      = true;
-    }
-    void convert(TobiiTypes::pupilData& out_, const TobiiResearchPupilData& in_)
-    {
-        out_.diameter                       = in_.diameter;
-        out_.validity                       = in_.validity;
-        out_.available                      = true;
-    }
-    void convert(TobiiTypes::gazeOrigin& out_, const TobiiResearchGazeOrigin& in_)
-    {
-        out_.position_in_track_box_coordinates = in_.position_in_track_box_coordinates;
-        out_.position_in_user_coordinates   = in_.position_in_user_coordinates;
-        out_.validity                       = in_.validity;
-        out_.available                      = true;
-    }
     void convert(TobiiTypes::eyeOpenness& out_, const TobiiResearchEyeOpennessData* in_, const bool leftEye_)
     {
         if (leftEye_)
@@ -755,12 +1067,6 @@ namespace {
         }
         out_.available = true;
     }
-    void convert(TobiiTypes::eyeData& out_, const TobiiResearchEyeData& in_)
-    {
-        convert(out_.gaze_point, in_.gaze_point);
-        convert(out_.pupil, in_.pupil_data);
-        convert(out_.gaze_origin, in_.gaze_origin);
-    }
 }
 
 void Sender::receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiResearchEyeOpennessData* openness_data_)
@@ -840,8 +1146,8 @@ void Sender::receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiR
     if (gaze_data_)
     {
         // convert to own gaze data type
-        convert(sample->left_eye,  gaze_data_->left_eye);
-        convert(sample->right_eye, gaze_data_->right_eye);
+        TittaConvert::toEyeData(sample->left_eye,  gaze_data_->left_eye);
+        TittaConvert::toEyeData(sample->right_eye, gaze_data_->right_eye);
     }
     else if (openness_data_)
     {
@@ -861,60 +1167,107 @@ void Sender::receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiR
     }
 }
 
+template <typename T>
+void Sender::receiveSample(const T* eye_image_)
+{
+    // apply the frame rate cap, before the image is copied. Decided per camera and region, on the device
+    // clock, with some tolerance for jitter in the image timing
+    if (const auto maxFrameRate = _eyeImageMaxFrameRate.load(std::memory_order_relaxed); maxFrameRate > 0.)
+    {
+        const auto interval = static_cast<int64_t>(1'000'000. / maxFrameRate);
+        const auto ts       = eye_image_->device_time_stamp;
+        auto& nextDue = _eyeImageNextDue.try_emplace({ eye_image_->camera_id, eye_image_->region_id }, ts).first->second;
+        // NB: also send if the next due time is more than an interval away, which happens when the cap is raised
+        if (ts < nextDue - interval / 10 && nextDue - ts <= interval)
+            return;
+        // if we've fallen behind (e.g. gap in the images), schedule from this image
+        nextDue = (nextDue < ts - interval || nextDue - ts > interval ? ts : nextDue) + interval;
+    }
+
+    if (_useSendQueue)
+        enqueueSample(Titta::Stream::EyeImage, _eyeImageSendQueue, Titta::eyeImage(eye_image_));
+    else if (isStreaming(Titta::Stream::EyeImage))
+        pushSample(Titta::eyeImage(eye_image_));
+}
+
 void Sender::pushSample(const Titta::gaze& sample_)
 {
+    TittaTrace::scope trace("LSL push", "lsl", "gaze");
     using lsl_inlet_type = TittaStreamToLSLInletType_t<Titta::Stream::Gaze>;
-    using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type>>;
+    const auto timeStamp = static_cast<double>(sample_.system_time_stamp)/1'000'000.;
+    // float layouts: device time stamp in us, split over two channels so that it remains exact
+    const auto tsHigh = static_cast<float>(sample_.device_time_stamp / gazeTimeStampSplit);
+    const auto tsLow  = static_cast<float>(sample_.device_time_stamp % gazeTimeStampSplit);
 
-    const data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type>] = {
-        sample_.left_eye.gaze_point.position_on_display_area.x, sample_.left_eye.gaze_point.position_on_display_area.y,
-        sample_.left_eye.gaze_point.position_in_user_coordinates.x, sample_.left_eye.gaze_point.position_in_user_coordinates.y, sample_.left_eye.gaze_point.position_in_user_coordinates.z,
-        static_cast<data_t>(sample_.left_eye.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.left_eye.gaze_point.available),
-        sample_.left_eye.pupil.diameter,
-        static_cast<data_t>(sample_.left_eye.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.left_eye.pupil.available),
-        sample_.left_eye.gaze_origin.position_in_user_coordinates.x, sample_.left_eye.gaze_origin.position_in_user_coordinates.y, sample_.left_eye.gaze_origin.position_in_user_coordinates.z,
-        sample_.left_eye.gaze_origin.position_in_track_box_coordinates.x, sample_.left_eye.gaze_origin.position_in_track_box_coordinates.y, sample_.left_eye.gaze_origin.position_in_track_box_coordinates.z,
-        static_cast<data_t>(sample_.left_eye.gaze_origin.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.left_eye.gaze_origin.available),
-        sample_.left_eye.eye_openness.diameter,
-        static_cast<data_t>(sample_.left_eye.eye_openness.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.left_eye.eye_openness.available),
-
-        sample_.right_eye.gaze_point.position_on_display_area.x, sample_.right_eye.gaze_point.position_on_display_area.y,
-        sample_.right_eye.gaze_point.position_in_user_coordinates.x, sample_.right_eye.gaze_point.position_in_user_coordinates.y, sample_.right_eye.gaze_point.position_in_user_coordinates.z,
-        static_cast<data_t>(sample_.right_eye.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.right_eye.gaze_point.available),
-        sample_.right_eye.pupil.diameter,
-        static_cast<data_t>(sample_.right_eye.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.right_eye.pupil.available),
-        sample_.right_eye.gaze_origin.position_in_user_coordinates.x, sample_.right_eye.gaze_origin.position_in_user_coordinates.y, sample_.right_eye.gaze_origin.position_in_user_coordinates.z,
-        sample_.right_eye.gaze_origin.position_in_track_box_coordinates.x, sample_.right_eye.gaze_origin.position_in_track_box_coordinates.y, sample_.right_eye.gaze_origin.position_in_track_box_coordinates.z,
-        static_cast<data_t>(sample_.right_eye.gaze_origin.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.right_eye.gaze_origin.available),
-        sample_.right_eye.eye_openness.diameter,
-        static_cast<data_t>(sample_.right_eye.eye_openness.validity == TOBII_RESEARCH_VALIDITY_VALID),static_cast<data_t>(sample_.right_eye.eye_openness.available),
-
-        static_cast<data_t>(sample_.device_time_stamp) / 1'000'000.
-    };
-    _outStreams.at(Titta::Stream::Gaze).push_sample(sample, static_cast<double>(sample_.system_time_stamp)/1'000'000.);
+    switch (_gazeLayout)
+    {
+    case GazeLayout::Full:
+    {
+        using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type, GazeLayout::Full>>;
+        static_assert(LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Full> == TittaConvert::rowSize);
+
+        data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Full>];
+        TittaConvert::toRows(sample, &sample_, 1);
+        pushToOutlet(Titta::Stream::Gaze, sample, timeStamp);
+        break;
+    }
+    case GazeLayout::Float32:
+    {
+        using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type, GazeLayout::Float32>>;
+        static_assert(LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Float32> == TittaConvert::rowSize + 1);
+
+        data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Float32>];
+        TittaConvert::toRows(sample, &sample_, 1);
+        sample[TittaConvert::rowSize - 1] = tsHigh;
+        sample[TittaConvert::rowSize]     = tsLow;
+        pushToOutlet(Titta::Stream::Gaze, sample, timeStamp);
+        break;
+    }
+    case GazeLayout::Compact:
+    {
+        using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type, GazeLayout::Compact>>;
+
+        const data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Compact>] = {
+            sample_.left_eye.gaze_point.position_on_display_area.x, sample_.left_eye.gaze_point.position_on_display_area.y,
+            static_cast<float>(sample_.left_eye.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID),
+            sample_.left_eye.pupil.diameter,
+            static_cast<float>(sample_.left_eye.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID),
+            sample_.right_eye.gaze_point.position_on_display_area.x, sample_.right_eye.gaze_point.position_on_display_area.y,
+            static_cast<float>(sample_.right_eye.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID),
+            sample_.right_eye.pupil.diameter,
+            static_cast<float>(sample_.right_eye.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID),
+            tsHigh, tsLow
+        };
+        pushToOutlet(Titta::Stream::Gaze, sample, timeStamp);
+        break;
+    }
+    }
 }
 void Sender::pushSample(const Titta::extSignal& sample_)
 {
+    TittaTrace::scope trace("LSL push", "lsl", "externalSignal");
     using lsl_inlet_type = TittaStreamToLSLInletType_t<Titta::Stream::ExtSignal>;
     using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type>>;
 
     const data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type>] = {
         sample_.device_time_stamp, sample_.system_time_stamp, sample_.value, sample_.change_type
     };
-    _outStreams.at(Titta::Stream::ExtSignal).push_sample(sample, static_cast<double>(sample_.system_time_stamp) / 1'000'000.);
+    pushToOutlet(Titta::Stream::ExtSignal, sample, static_cast<double>(sample_.system_time_stamp) / 1'000'000.);
 }
 void Sender::pushSample(const Titta::timeSync& sample_)
 {
+    TittaTrace::scope trace("LSL push", "lsl", "timeSync");
     using lsl_inlet_type = TittaStreamToLSLInletType_t<Titta::Stream::TimeSync>;
     using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type>>;
 
     const data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type>] = {
         sample_.system_request_time_stamp, sample_.device_time_stamp, sample_.system_response_time_stamp
     };
-    _outStreams.at(Titta::Stream::TimeSync).push_sample(sample, static_cast<double>(sample_.system_request_time_stamp) / 1'000'000.);
+    pushToOutlet(Titta::Stream::TimeSync, sample, static_cast<double>(sample_.system_request_time_stamp) / 1'000'000.);
 }
 void Sender::pushSample(const Titta::positioning& sample_)
 {
+    TittaTrace::scope trace("LSL push", "lsl", "positioning");
     using lsl_inlet_type = TittaStreamToLSLInletType_t<Titta::Stream::Positioning>;
     using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type>>;
 
@@ -924,7 +1277,238 @@ void Sender::pushSample(const Titta::positioning& sample_)
         sample_.right_eye.user_position.x, sample_.right_eye.user_position.y, sample_.right_eye.user_position.z,
         static_cast<float>(sample_.right_eye.validity == TOBII_RESEARCH_VALIDITY_VALID)
     };
-    _outStreams.at(Titta::Stream::Positioning).push_sample(sample); // this stream doesn't have a timestamp
+    pushToOutlet(Titta::Stream::Positioning, sample, 0.);   // this stream doesn't have a timestamp, LSL uses the current time
+}
+void Sender::pushSample(const Titta::eyeImage& sample_)
+{
+    TittaTrace::scope trace("LSL push", "lsl", "eyeImage");
+    using lsl_inlet_type = TittaStreamToLSLInletType_t<Titta::Stream::EyeImage>;
+    using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<lsl_inlet_type>>;
+
+    // shrink raw images if wanted. Only for images with pixels of one or two bytes, others are sent as is
+    const auto data             = static_cast<const uint8_t*>(sample_.data());
+    const auto factor           = sample_.is_gif ? 1 : _eyeImageDownscaleFactor.load(std::memory_order_relaxed);
+    const auto bytesPerPixel    = (sample_.bits_per_pixel + sample_.padding_per_pixel) / 8;
+    const auto canDownscale     = factor > 1 && (bytesPerPixel == 1 || bytesPerPixel == 2) &&
+                                  sample_.width >= factor && sample_.height >= factor &&
+                                  sample_.data_size >= static_cast<size_t>(sample_.width) * sample_.height * bytesPerPixel;
+    const auto downscale        = canDownscale ? factor : 1;
+    const auto width            = sample_.width  / downscale;
+    const auto height           = sample_.height / downscale;
+
+    data_t sample[LSLInletTypeNumSamples_v<lsl_inlet_type>];
+    sample[0] = string_format("%d,%" PRId64 ",%" PRId64 ",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
+        static_cast<int>(sample_.is_gif), sample_.device_time_stamp, sample_.system_time_stamp,
+        sample_.bits_per_pixel, sample_.padding_per_pixel, width, height,
+        sample_.region_id, sample_.region_top, sample_.region_left,
+        static_cast<int>(sample_.type), sample_.camera_id, downscale);
+    if (canDownscale)
+    {
+        sample[1].resize(static_cast<size_t>(width) * height * bytesPerPixel);
+        const auto out = reinterpret_cast<uint8_t*>(sample[1].data());
+        if (bytesPerPixel == 1)
+            downscaleImage<uint8_t >(out, data, sample_.width, width, height, downscale);
+        else
+            downscaleImage<uint16_t>(out, data, sample_.width, width, height, downscale);
+    }
+    else
+        sample[1].assign(reinterpret_cast<const char*>(data), sample_.data_size);
+
+    // images are not sent in chunks
+    _outStreams.at(Titta::Stream::EyeImage).push_sample(sample, static_cast<double>(sample_.system_time_stamp) / 1'000'000.);
+}
+template <typename T>
+void Sender::pushToOutlet(const Titta::Stream stream_, const T* sample_, const double timeStamp_)
+{
+    auto& chunk = _outChunks[static_cast<size_t>(stream_)];
+    if (chunk.size <= 1)
+    {
+        _outStreams.at(stream_).push_sample(sample_, timeStamp_);
+        return;
+    }
+
+    // add to chunk, push it once full or once its oldest sample has waited long enough
+    std::scoped_lock l(chunk.mutex);
+    const auto now = std::chrono::steady_clock::now();
+    if (!chunk.numSamples)
+        chunk.firstArrival = now;
+    auto& values = std::get<std::vector<T>>(chunk.values);
+    std::copy_n(sample_, chunk.numChannels, values.data() + chunk.numSamples * chunk.numChannels);
+    chunk.timeStamps[chunk.numSamples++] = timeStamp_ != 0. ? timeStamp_ : lsl::local_clock();
+    if (chunk.numSamples == chunk.size || (chunk.maxLatency && now - chunk.firstArrival >= std::chrono::microseconds(chunk.maxLatency)))
+        flushChunk(chunk);
+}
+void Sender::flushChunk(OutletChunk& chunk_)
+{
+    if (!chunk_.numSamples || !chunk_.outlet)
+        return;
+    TittaTrace::scope trace("LSL push chunk", "lsl");
+    std::visit([&chunk_](const auto& values_)
+    {
+        chunk_.outlet->push_chunk_multiplexed(values_.data(), chunk_.timeStamps.data(), chunk_.numSamples * chunk_.numChannels);
+    }, chunk_.values);
+    chunk_.numSamples = 0;
+}
+void Sender::chunkFlushThread()
+{
+    TittaTrace::setThreadName("TittaLSL chunk flush");
+    while (!_chunkFlushShouldStop)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        for (auto& chunk : _outChunks)
+        {
+            std::scoped_lock l(chunk.mutex);
+            if (chunk.numSamples && chunk.maxLatency && now - chunk.firstArrival >= std::chrono::microseconds(chunk.maxLatency))
+                flushChunk(chunk);
+        }
+        std::this_thread::sleep_for(defaults::chunkFlushInterval);
+    }
+}
+
+bool Sender::setUseSendQueue(const bool useQueue_)
+{
+    const auto previous = _useSendQueue.load();
+    if (useQueue_ == previous)
+        return previous;
+
+    if (_streamingGaze || _streamingEyeOpenness || _streamingExtSignal || _streamingTimeSync || _streamingPositioning || _streamingEyeImage)
+        DoExitWithMsg("TittaLSL::cpp::setUseSendQueue: Cannot change send queue mode while sending, stop all streams first.");
+
+    if (useQueue_)
+    {
+        _useSendQueue = true;
+        _sendThreadShouldStop = false;
+        _sendThread = std::thread(&Sender::sendThread, this);
+    }
+    else
+    {
+        _useSendQueue = false;
+        _sendThreadShouldStop = true;
+        if (_sendThread.joinable())
+            _sendThread.join();
+    }
+
+    return previous;
+}
+bool Sender::getUseSendQueue() const
+{
+    return _useSendQueue;
+}
+
+void Sender::sendQueueCounters::addCallback(const std::chrono::steady_clock::time_point start_)
+{
+    const auto duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    numCallbacks.fetch_add(1, std::memory_order_relaxed);
+    if (duration > maxCallbackDurationNs.load(std::memory_order_relaxed))
+        maxCallbackDurationNs.store(duration, std::memory_order_relaxed);
+}
+template <typename T>
+void Sender::enqueueSample(const Titta::Stream stream_, moodycamel::ReaderWriterQueue<T>& queue_, T sample_)
+{
+    auto& counters = _sendQueueCounters[static_cast<size_t>(stream_)];
+    // never allocates: if the queue is full, the sample is discarded
+    if (!queue_.try_enqueue(std::move(sample_)))
+    {
+        counters.numDropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    counters.numQueued.fetch_add(1, std::memory_order_relaxed);
+    if (const auto depth = queue_.size_approx(); depth > counters.highWaterMark.load(std::memory_order_relaxed))
+        counters.highWaterMark.store(depth, std::memory_order_relaxed);
+}
+
+void Sender::sendThread()
+{
+    TittaTrace::setThreadName("TittaLSL send");
+    while (!_sendThreadShouldStop)
+    {
+        {
+            std::scoped_lock l(_sendDrainMutex);
+            TittaTrace::scope trace("drain send queues", "lsl");
+            drainSendQueues();
+        }
+        std::this_thread::sleep_for(defaults::sendQueueDrainInterval);
+    }
+    std::scoped_lock l(_sendDrainMutex);
+    drainSendQueues();
+}
+void Sender::drainSendQueues()
+{
+    // !NB: caller must hold _sendDrainMutex
+    // feed gaze and eye openness samples to the merger in order of their device timestamps, so it sees
+    // them in the same order as when they are received directly from the callbacks
+    while (true)
+    {
+        const auto gazeData     = _gazeSendQueue.peek();
+        const auto opennessData = _eyeOpennessSendQueue.peek();
+        if (!gazeData && !opennessData)
+            break;
+
+        if (gazeData && (!opennessData || gazeData->device_time_stamp <= opennessData->device_time_stamp))
+        {
+            receiveSample(gazeData, nullptr);
+            _gazeSendQueue.pop();
+        }
+        else
+        {
+            receiveSample(nullptr, opennessData);
+            _eyeOpennessSendQueue.pop();
+        }
+    }
+
+    const auto drain = [this](auto& queue_, const Titta::Stream stream_)
+    {
+        const auto streaming = isStreaming(stream_);
+        while (const auto sample = queue_.peek())
+        {
+            if (streaming)
+                pushSample(*sample);
+            queue_.pop();
+        }
+    };
+    drain(_extSignalSendQueue,   Titta::Stream::ExtSignal);
+    drain(_timeSyncSendQueue,    Titta::Stream::TimeSync);
+    drain(_positioningSendQueue, Titta::Stream::Positioning);
+    drain(_eyeImageSendQueue,    Titta::Stream::EyeImage);
+}
+
+Sender::SendQueueStats Sender::getSendQueueStats(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/) const
+{
+    return getSendQueueStats(Titta::stringToStream(std::move(stream_), snake_case_on_stream_not_found, true));
+}
+Sender::SendQueueStats Sender::getSendQueueStats(const Titta::Stream stream_) const
+{
+    SendQueueStats out;
+    switch (stream_)
+    {
+        case Titta::Stream::Gaze:
+            out.depth = _gazeSendQueue.size_approx();
+            break;
+        case Titta::Stream::EyeOpenness:
+            out.depth = _eyeOpennessSendQueue.size_approx();
+            break;
+        case Titta::Stream::ExtSignal:
+            out.depth = _extSignalSendQueue.size_approx();
+            break;
+        case Titta::Stream::TimeSync:
+            out.depth = _timeSyncSendQueue.size_approx();
+            break;
+        case Titta::Stream::Positioning:
+            out.depth = _positioningSendQueue.size_approx();
+            break;
+        case Titta::Stream::EyeImage:
+            out.depth = _eyeImageSendQueue.size_approx();
+            break;
+        default:
+            DoExitWithMsg("TittaLSL::cpp::getSendQueueStats: " + Titta::streamToString(stream_) + " stream is not supported to send via outlet");
+    }
+    const auto& counters        = _sendQueueCounters[static_cast<size_t>(stream_)];
+    out.highWaterMark           = counters.highWaterMark.load(std::memory_order_relaxed);
+    out.numQueued               = counters.numQueued.load(std::memory_order_relaxed);
+    out.numDropped              = counters.numDropped.load(std::memory_order_relaxed);
+    out.numCallbacks            = counters.numCallbacks.load(std::memory_order_relaxed);
+    out.maxCallbackDuration     = static_cast<double>(counters.maxCallbackDurationNs.load(std::memory_order_relaxed)) / 1000.;
+    return out;
 }
 
 bool Sender::removeCallback(const Titta::Stream stream_)
@@ -934,28 +1518,43 @@ bool Sender::removeCallback(const Titta::Stream stream_)
     switch (stream_)
     {
     case Titta::Stream::Gaze:
-        result = !_streamingGaze ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_gaze_data(_localEyeTracker.et, GazeCallback);
+        result = !_streamingGaze ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(GazeCallback) : tobii_research_unsubscribe_from_gaze_data(_localEyeTracker.et, GazeCallback);
         stateVar = &_streamingGaze;
         break;
     case Titta::Stream::EyeOpenness:
-        result = !_streamingEyeOpenness ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_eye_openness(_localEyeTracker.et, EyeOpennessCallback);
+        result = !_streamingEyeOpenness ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(EyeOpennessCallback) : tobii_research_unsubscribe_from_eye_openness(_localEyeTracker.et, EyeOpennessCallback);
         stateVar = &_streamingEyeOpenness;
         break;
     case Titta::Stream::ExtSignal:
-        result = !_streamingExtSignal ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_external_signal_data(_localEyeTracker.et, ExtSignalCallback);
+        result = !_streamingExtSignal ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(ExtSignalCallback) : tobii_research_unsubscribe_from_external_signal_data(_localEyeTracker.et, ExtSignalCallback);
         stateVar = &_streamingExtSignal;
         break;
     case Titta::Stream::TimeSync:
-        result = !_streamingTimeSync ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_time_synchronization_data(_localEyeTracker.et, TimeSyncCallback);
+        result = !_streamingTimeSync ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TimeSyncCallback) : tobii_research_unsubscribe_from_time_synchronization_data(_localEyeTracker.et, TimeSyncCallback);
         stateVar = &_streamingTimeSync;
         break;
     case Titta::Stream::Positioning:
-        result = !_streamingPositioning ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_user_position_guide(_localEyeTracker.et, PositioningCallback);
+        result = !_streamingPositioning ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(PositioningCallback) : tobii_research_unsubscribe_from_user_position_guide(_localEyeTracker.et, PositioningCallback);
         stateVar = &_streamingPositioning;
         break;
+    case Titta::Stream::EyeImage:
+        if (!_streamingEyeImage)
+            result = TOBII_RESEARCH_STATUS_OK;
+        else if (_eyeImageIsGif)
+            result = _simulator ? _simulator->unsubscribe(EyeImageGifCallback) : tobii_research_unsubscribe_from_eye_image_as_gif(_localEyeTracker.et, EyeImageGifCallback);
+        else
+            result = _simulator ? _simulator->unsubscribe(EyeImageCallback) : tobii_research_unsubscribe_from_eye_image(_localEyeTracker.et, EyeImageCallback);
+        stateVar = &_streamingEyeImage;
+        break;
     }
 
     const bool success = result==TOBII_RESEARCH_STATUS_OK;
+    // send samples still in the queue, while the stream is still marked as being sent
+    if (success && _useSendQueue)
+    {
+        std::scoped_lock l(_sendDrainMutex);
+        drainSendQueues();
+    }
     if (stateVar && success)
         *stateVar = false;
 
@@ -992,6 +1591,9 @@ bool Sender::isStreaming(const Titta::Stream stream_) const
         case Titta::Stream::Positioning:
             isStreaming = _streamingPositioning;
             break;
+        case Titta::Stream::EyeImage:
+            isStreaming = _streamingEyeImage;
+            break;
     }
 
     // EyeOpenness is always packed in a gaze stream, so check for that instead
@@ -1008,9 +1610,19 @@ void Sender::stop(const Titta::Stream stream_)
     // stop the callback
     removeCallback(stream_);
 
-    // stop the outlet, if any
+    // stop the outlet, if any, sending samples still waiting in a chunk first
+    std::scoped_lock ls(_sendDrainMutex);
     if (_outStreams.contains(stream_))
+    {
+        {
+            auto& chunk = _outChunks[static_cast<size_t>(stream_)];
+            std::scoped_lock l(chunk.mutex);
+            flushChunk(chunk);
+            chunk.outlet = nullptr;
+            chunk.size   = 1;
+        }
         _outStreams.erase(stream_);
+    }
 }
 }
 
@@ -1182,7 +1794,7 @@ void Receiver::create(lsl::stream_info streamInfo_, std::optional<size_t> initia
         DoExitWithMsg(string_format("TittaLSL::Receiver: stream %s (source_id: %s) is not an TittaLSL stream, cannot be used.", streamInfo_.name().c_str(), streamInfo_.source_id().c_str()));
 
 # define MAKE_INLET(type, defaultName) \
-    _inlet = std::make_unique<AllInlets>(std::in_place_type<Inlet<gaze>>, streamInfo_); \
+    _inlet = std::make_unique<AllInlets>(std::in_place_type<Inlet<type>>, streamInfo_); \
     auto& inlet = getInlet<type>(); \
     createdInlet = &inlet._lsl_inlet; \
     getBuffer<type>(inlet).reserve(initialBufferSize_.value_or(defaults::defaultName));
@@ -1192,6 +1804,18 @@ void Receiver::create(lsl::stream_info streamInfo_, std::optional<size_t> initia
     lsl::stream_inlet* createdInlet = nullptr;
     if (sType =="Gaze")
     {
+        // determine the channel layout of the stream
+        using lsl_inlet_type = TittaLSL::Receiver::gaze;
+        const auto format   = streamInfo_.channel_format();
+        const auto nChannel = static_cast<size_t>(streamInfo_.channel_count());
+        if (format == LSLInletTypeToChannelFormat_v<lsl_inlet_type, GazeLayout::Full> && nChannel == LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Full>)
+            _gazeLayout = GazeLayout::Full;
+        else if (format == LSLInletTypeToChannelFormat_v<lsl_inlet_type, GazeLayout::Float32> && nChannel == LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Float32>)
+            _gazeLayout = GazeLayout::Float32;
+        else if (format == LSLInletTypeToChannelFormat_v<lsl_inlet_type, GazeLayout::Compact> && nChannel == LSLInletTypeNumSamples_v<lsl_inlet_type, GazeLayout::Compact>)
+            _gazeLayout = GazeLayout::Compact;
+        else
+            DoExitWithMsg(string_format("TittaLSL::Receiver: gaze stream %s (source_id: %s) has %zu channels of format %d, which does not match any of the known layouts (%s).", streamInfo_.name().c_str(), streamInfo_.source_id().c_str(), nChannel, static_cast<int>(format), getAllGazeLayoutsString().c_str()));
         MAKE_INLET(TittaLSL::Receiver::gaze, gazeBufSize)
     }
     else if (sType == "TTL")
@@ -1206,6 +1830,10 @@ void Receiver::create(lsl::stream_info streamInfo_, std::optional<size_t> initia
     {
         MAKE_INLET(TittaLSL::Receiver::positioning, positioningBufSize)
     }
+    else if (sType == "EyeImage")
+    {
+        MAKE_INLET(TittaLSL::Receiver::eyeImage, eyeImageBufSize)
+    }
     else
         DoExitWithMsg(string_format("TittaLSL::Receiver: stream %s (source_id: %s}) has type %s, which is not understood.", streamInfo_.name().c_str(), streamInfo_.source_id().c_str(), sType.c_str()));
 
@@ -1281,7 +1909,7 @@ std::vector<lsl::stream_info> Receiver::GetStreams(const std::optional<Titta::St
     // filter if wanted
     if (stream_.has_value())
     {
-        if (*stream_!=Titta::Stream::Gaze && *stream_!=Titta::Stream::ExtSignal && *stream_!=Titta::Stream::TimeSync && *stream_!=Titta::Stream::Positioning)
+        if (*stream_!=Titta::Stream::Gaze && *stream_!=Titta::Stream::ExtSignal && *stream_!=Titta::Stream::TimeSync && *stream_!=Titta::Stream::Positioning && *stream_!=Titta::Stream::EyeImage)
             DoExitWithMsg(string_format("TittaLSL::cpp::GetStreams: %s streams are not supported.", Titta::streamToString(*stream_).c_str()));
         const auto streamName = string_format("Tobii_%s", Titta::streamToString(*stream_).c_str());
         return lsl::resolve_stream("name", streamName, 0, timeout);
@@ -1323,16 +1951,30 @@ void Receiver::start()
     {
     case Titta::Stream::Gaze:
     case Titta::Stream::EyeOpenness:
-        getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<gaze>, this);
+        switch (_gazeLayout)
+        {
+        case GazeLayout::Full:
+            getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<gaze, GazeLayout::Full>, this);
+            break;
+        case GazeLayout::Float32:
+            getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<gaze, GazeLayout::Float32>, this);
+            break;
+        case GazeLayout::Compact:
+            getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<gaze, GazeLayout::Compact>, this);
+            break;
+        }
         break;
     case Titta::Stream::ExtSignal:
-        getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<extSignal>, this);
+        getInlet<extSignal>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<extSignal>, this);
         break;
     case Titta::Stream::TimeSync:
-        getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<timeSync>, this);
+        getInlet<timeSync>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<timeSync>, this);
         break;
     case Titta::Stream::Positioning:
-        getInlet<gaze>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<positioning>, this);
+        getInlet<positioning>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<positioning>, this);
+        break;
+    case Titta::Stream::EyeImage:
+        getInlet<eyeImage>()._recorder = std::make_unique<std::thread>(&Receiver::recorderThreadFunc<eyeImage>, this);
         break;
     }
 }
@@ -1343,31 +1985,43 @@ bool Receiver::isRecording() const
     return getWorkerThread(inlet) && !getWorkerThreadStopFlag(inlet);
 }
 
-template <typename DataType>
+GazeLayout Receiver::getGazeLayout() const
+{
+    return _gazeLayout;
+}
+
+template <typename DataType, GazeLayout Layout>
 void Receiver::recorderThreadFunc()
 {
-    using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<DataType>>;
-    constexpr size_t numElem = LSLInletTypeNumSamples_v<DataType>;
-    using array_t = data_t[numElem];
+    using data_t = LSLChannelFormatToCppType_t<LSLInletTypeToChannelFormat_v<DataType, Layout>>;
+    constexpr size_t numElem = LSLInletTypeNumSamples_v<DataType, Layout>;
     auto& inlet = getInlet<DataType>();
+    // samples are pulled in chunks into these reusable buffers, converted, and then appended to the
+    // inlet's buffer in one go
+    std::vector<data_t>     values(defaults::recorderChunkSize * numElem);
+    std::vector<double>     timeStamps(defaults::recorderChunkSize);
+    std::vector<DataType>   received;
+    received.reserve(defaults::recorderChunkSize);
     double lastTCorr = -1.;
     while (!inlet._recorder_should_stop)
     {
-        array_t sample = { 0 };
-        double remoteT = 0.;
-        double tCorr = 0.;
+        // wait for a sample, then also take all further samples that are already available
+        size_t nSamples = 0;
         try
         {
-            remoteT = inlet._lsl_inlet.template pull_sample<data_t, numElem>(sample, 0.1);
+            timeStamps[0] = inlet._lsl_inlet.pull_sample(values.data(), static_cast<int32_t>(numElem), 0.1);
+            if (timeStamps[0] <= 0.)
+                // no new sample available
+                continue;
+            nSamples = 1 + inlet._lsl_inlet.pull_chunk_multiplexed(values.data() + numElem, timeStamps.data() + 1, values.size() - numElem, timeStamps.size() - 1, 0.) / numElem;
         }
         catch (const lsl::lost_error&)
         {
             break;
         }
-        if (remoteT <= 0.)
-            // no new sample available
-            continue;
 
+        // one time correction for the whole chunk
+        double tCorr = 0.;
         try
         {
             tCorr = inlet._lsl_inlet.time_correction(0);
@@ -1383,127 +2037,180 @@ void Receiver::recorderThreadFunc()
         lastTCorr = tCorr;
 
         // now parse into type
-        if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::gaze>)
+        received.clear();
+        for (size_t i = 0; i < nSamples; i++)
         {
-            data_t* ptr = sample;
-            inlet._buffer.emplace_back(TittaLSL::Receiver::gaze{
+            const double remoteT = timeStamps[i];
+            data_t* sample = values.data() + i * numElem;
+            if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::gaze> && Layout == GazeLayout::Compact)
+            {
+                // only gaze point on the display area and pupil diameter are transmitted, the rest is unavailable
+                data_t* ptr = sample;
+                TittaLSL::Receiver::gaze samp{};
+                for (auto eye : { &samp.gazeData.left_eye, &samp.gazeData.right_eye })
                 {
-                    {   // left eye
-                        {   // gazePoint
-                            {   // position_on_display_area
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                    eye->gaze_point.position_on_display_area.x  = *ptr++;
+                    eye->gaze_point.position_on_display_area.y  = *ptr++;
+                    eye->gaze_point.validity                    = *ptr++ == 1.f ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID;
+                    eye->gaze_point.available                   = true;
+                    eye->pupil.diameter                         = *ptr++;
+                    eye->pupil.validity                         = *ptr++ == 1.f ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID;
+                    eye->pupil.available                        = true;
+                }
+                samp.gazeData.device_time_stamp = static_cast<int64_t>(ptr[0]) * gazeTimeStampSplit + static_cast<int64_t>(ptr[1]);
+                // system timestamp, transmitted as remote time
+                samp.gazeData.system_time_stamp = timeStampSecondsToUs(remoteT);
+                samp.remoteSystemTimeStamp      = timeStampSecondsToUs(remoteT);
+                samp.localSystemTimeStamp       = timeStampSecondsToUs(remoteT + tCorr);
+                received.push_back(samp);
+            }
+            else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::gaze>)
+            {
+                data_t* ptr = sample;
+                received.emplace_back(TittaLSL::Receiver::gaze{
+                    {
+                        {   // left eye
+                            {   // gazePoint
+                                {   // position_on_display_area
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                {   // position_in_user_coordinates
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            {   // position_in_user_coordinates
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                            {   // pupilData
+                                static_cast<float>(*ptr++),
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
-                        },
-                        {   // pupilData
-                            static_cast<float>(*ptr++),
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
-                        },
-                        {   // gazeOrigin
-                            {   // position_in_user_coordinates
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                            {   // gazeOrigin
+                                {   // position_in_user_coordinates
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                {   // position_in_track_box_coordinates
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            {   // position_in_track_box_coordinates
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                            {   // eyeOpenness
+                                static_cast<float>(*ptr++),
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
-                        },
-                        {   // eyeOpenness
-                            static_cast<float>(*ptr++),
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
                         },
-                    },
-                    // right eye
-                    {
-                        {   // gazePoint
-                            {   // position_on_display_area
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                        // right eye
+                        {
+                            {   // gazePoint
+                                {   // position_on_display_area
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                {   // position_in_user_coordinates
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            {   // position_in_user_coordinates
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                            {   // pupilData
+                                static_cast<float>(*ptr++),
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
-                        },
-                        {   // pupilData
-                            static_cast<float>(*ptr++),
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
-                        },
-                        {   // gazeOrigin
-                            {   // position_in_user_coordinates
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                            {   // gazeOrigin
+                                {   // position_in_user_coordinates
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                {   // position_in_track_box_coordinates
+                                    static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                                },
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            {   // position_in_track_box_coordinates
-                                static_cast<float>(*ptr++), static_cast<float>(*ptr++), static_cast<float>(*ptr++)
+                            {   // eyeOpenness
+                                static_cast<float>(*ptr++),
+                                *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
+                                *ptr++ == 1.
                             },
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
-                        },
-                        {   // eyeOpenness
-                            static_cast<float>(*ptr++),
-                            *ptr++ == 1. ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID,
-                            *ptr++ == 1.
                         },
+                        // device time, for the float32 layout split over two channels
+                        Layout == GazeLayout::Full ? timeStampSecondsToUs(static_cast<double>(*ptr)) : static_cast<int64_t>(ptr[0]) * gazeTimeStampSplit + static_cast<int64_t>(ptr[1]),
+                        // system timestamp, transmitted as remote time
+                        timeStampSecondsToUs(remoteT),
                     },
-                    // device time
-                    timeStampSecondsToUs(*ptr),
-                    // system timestamp, transmitted as remote time
-                    timeStampSecondsToUs(remoteT),
-                },
-            timeStampSecondsToUs(remoteT),
-            timeStampSecondsToUs(remoteT + tCorr)
-            });
-        }
-        else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::extSignal>)
-        {
-            data_t* ptr = sample;
-            inlet._buffer.emplace_back(TittaLSL::Receiver::extSignal{
-                {
-                    *ptr++, *ptr++, static_cast<uint32_t>(*ptr++), *ptr==TOBII_RESEARCH_EXTERNAL_SIGNAL_VALUE_CHANGED? TOBII_RESEARCH_EXTERNAL_SIGNAL_VALUE_CHANGED: *ptr == TOBII_RESEARCH_EXTERNAL_SIGNAL_INITIAL_VALUE? TOBII_RESEARCH_EXTERNAL_SIGNAL_INITIAL_VALUE: TOBII_RESEARCH_EXTERNAL_SIGNAL_CONNECTION_RESTORED
-                },
-                timeStampSecondsToUs(remoteT),
-                timeStampSecondsToUs(remoteT + tCorr)
-            });
-        }
-        else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::timeSync>)
-        {
-            data_t* ptr = sample;
-            inlet._buffer.emplace_back(TittaLSL::Receiver::timeSync{
-                {
-                    *ptr++, *ptr++, *ptr
-                },
                 timeStampSecondsToUs(remoteT),
                 timeStampSecondsToUs(remoteT + tCorr)
-            });
-        }
-        else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::positioning>)
-        {
-            data_t* ptr = sample;
-            inlet._buffer.emplace_back(TittaLSL::Receiver::positioning{
-                {
-                    // left eye
+                });
+            }
+            else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::extSignal>)
+            {
+                data_t* ptr = sample;
+                received.emplace_back(TittaLSL::Receiver::extSignal{
                     {
-                        {*ptr++, *ptr++, *ptr++},
-                        *ptr++ == 1.f ? TOBII_RESEARCH_VALIDITY_VALID: TOBII_RESEARCH_VALIDITY_INVALID
+                        *ptr++, *ptr++, static_cast<uint32_t>(*ptr++), *ptr==TOBII_RESEARCH_EXTERNAL_SIGNAL_VALUE_CHANGED? TOBII_RESEARCH_EXTERNAL_SIGNAL_VALUE_CHANGED: *ptr == TOBII_RESEARCH_EXTERNAL_SIGNAL_INITIAL_VALUE? TOBII_RESEARCH_EXTERNAL_SIGNAL_INITIAL_VALUE: TOBII_RESEARCH_EXTERNAL_SIGNAL_CONNECTION_RESTORED
                     },
-                    // right eye
+                    timeStampSecondsToUs(remoteT),
+                    timeStampSecondsToUs(remoteT + tCorr)
+                });
+            }
+            else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::timeSync>)
+            {
+                data_t* ptr = sample;
+                received.emplace_back(TittaLSL::Receiver::timeSync{
                     {
-                        {*ptr++, *ptr++, *ptr++},
-                        *ptr   == 1.f ? TOBII_RESEARCH_VALIDITY_VALID: TOBII_RESEARCH_VALIDITY_INVALID
-                    }
-                },
-                timeStampSecondsToUs(remoteT),
-                timeStampSecondsToUs(remoteT + tCorr)
-            });
+                        *ptr++, *ptr++, *ptr
+                    },
+                    timeStampSecondsToUs(remoteT),
+                    timeStampSecondsToUs(remoteT + tCorr)
+                });
+            }
+            else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::positioning>)
+            {
+                data_t* ptr = sample;
+                received.emplace_back(TittaLSL::Receiver::positioning{
+                    {
+                        // left eye
+                        {
+                            {*ptr++, *ptr++, *ptr++},
+                            *ptr++ == 1.f ? TOBII_RESEARCH_VALIDITY_VALID: TOBII_RESEARCH_VALIDITY_INVALID
+                        },
+                        // right eye
+                        {
+                            {*ptr++, *ptr++, *ptr++},
+                            *ptr   == 1.f ? TOBII_RESEARCH_VALIDITY_VALID: TOBII_RESEARCH_VALIDITY_INVALID
+                        }
+                    },
+                    timeStampSecondsToUs(remoteT),
+                    timeStampSecondsToUs(remoteT + tCorr)
+                });
+            }
+            else if constexpr (std::is_same_v<DataType, TittaLSL::Receiver::eyeImage>)
+            {
+                // first channel is the header, see eyeImageHeaderFields; second the image data
+                TittaLSL::Receiver::eyeImage samp{};
+                auto& im = samp.eyeImageData;
+                int isGif = 0, type = 0;
+                const auto nField = std::sscanf(sample[0].c_str(), "%d,%" SCNd64 ",%" SCNd64 ",%d,%d,%d,%d,%d,%d,%d,%d,%d,%d",
+                    &isGif, &im.device_time_stamp, &im.system_time_stamp,
+                    &im.bits_per_pixel, &im.padding_per_pixel, &im.width, &im.height,
+                    &im.region_id, &im.region_top, &im.region_left,
+                    &type, &im.camera_id, &samp.downscaleFactor);
+                if (nField != 13)
+                    // malformed header, skip
+                    continue;
+                im.is_gif = isGif != 0;
+                im.type   = static_cast<TobiiResearchEyeImageType>(type);
+                im.setData(reinterpret_cast<const uint8_t*>(sample[1].data()), sample[1].size());
+                samp.remoteSystemTimeStamp  = timeStampSecondsToUs(remoteT);
+                samp.localSystemTimeStamp   = timeStampSecondsToUs(remoteT + tCorr);
+                received.push_back(std::move(samp));
+            }
         }
+
+        // and store
+        auto l = lockForWriting(inlet);
+        inlet._buffer.insert(inlet._buffer.end(), std::make_move_iterator(received.begin()), std::make_move_iterator(received.end()));
     }
     // also marked as stopped
     inlet._recorder_should_stop = true;
@@ -1608,6 +2315,9 @@ void Receiver::clearTimeRange(const std::optional<int64_t> timeStart_, const std
         case Titta::Stream::TimeSync:
             clearVec(getInlet<TittaLSL::Receiver::timeSync>(), timeStart, timeEnd, timeIsLocalTime);
             break;
+        case Titta::Stream::EyeImage:
+            clearVec(getInlet<TittaLSL::Receiver::eyeImage>(), timeStart, timeEnd, timeIsLocalTime);
+            break;
         case Titta::Stream::Positioning:
             DoExitWithMsg("Titta::cpp::clearTimeRange: not supported for the positioning stream.");
             break;
@@ -1653,6 +2363,12 @@ template std::vector<TittaLSL::Receiver::extSignal> Receiver::consumeTimeRange(s
 template std::vector<TittaLSL::Receiver::extSignal> Receiver::peekN(std::optional<size_t> NSamp_, std::optional<Titta::BufferSide> side_);
 template std::vector<TittaLSL::Receiver::extSignal> Receiver::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_, std::optional<bool> timeIsLocalTime_);
 
+// eye images, instantiate templated functions
+template std::vector<TittaLSL::Receiver::eyeImage> Receiver::consumeN(std::optional<size_t> NSamp_, std::optional<Titta::BufferSide> side_);
+template std::vector<TittaLSL::Receiver::eyeImage> Receiver::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_, std::optional<bool> timeIsLocalTime_);
+template std::vector<TittaLSL::Receiver::eyeImage> Receiver::peekN(std::optional<size_t> NSamp_, std::optional<Titta::BufferSide> side_);
+template std::vector<TittaLSL::Receiver::eyeImage> Receiver::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_, std::optional<bool> timeIsLocalTime_);
+
 // time sync data, instantiate templated functions
 template std::vector<TittaLSL::Receiver::timeSync> Receiver::consumeN(std::optional<size_t> NSamp_, std::optional<Titta::BufferSide> side_);
 template std::vector<TittaLSL::Receiver::timeSync> Receiver::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_, std::optional<bool> timeIsLocalTime_);
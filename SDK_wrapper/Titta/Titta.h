@@ -2,12 +2,16 @@
 #include <vector>
 #include <deque>
 #include <array>
+#include <map>
 #include <string>
 #include <tuple>
 #include <optional>
 #include <thread>
 #include <atomic>
 #include <variant>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
 #include <tobii_research.h>
 #include <tobii_research_eyetracker.h>
 #include <tobii_research_streams.h>
@@ -22,6 +26,13 @@
 #include <readerwriterqueue/readerwriterqueue.h>
 
 #include "types.h"
+#include "buffer.h"
+#include "seqlock.h"
+#include "journal.h"
+#include "session.h"
+#include "parquet.h"
+#include "simulator.h"
+#include "latency.h"
 
 
 class Titta
@@ -35,7 +46,11 @@ public:
     using logMessage    = TobiiTypes::logMessage;
     using streamError   = TobiiTypes::streamErrorMessage;
     using notification  = TobiiTypes::notification;
+    using gazeColumns   = TobiiTypes::gazeColumns;
     using allLogTypes   = std::variant<logMessage, streamError>;
+    // gaze samples are stored in packed form and converted to gaze when read, see TobiiTypes::gazeDataPacked
+    template <typename T>
+    using buffer_t      = SegmentedBuffer<T, std::conditional_t<std::is_same_v<T, gaze>, TobiiTypes::gazeDataPacked, T>>;
 
     // data stream type (NB: not log, as that isn't a class member)
     enum class Stream
@@ -70,6 +85,97 @@ public:
     static std::vector<std::string> getAllBufferSides();
     static std::string getAllBufferSidesString(const char* quoteChar_ = "\"");
 
+    // what to do when a bounded buffer is full
+    enum class OverflowPolicy
+    {
+        Unknown,
+        DropOldest,     // discard the oldest samples in the buffer to make room for the new sample
+        DropNewest,     // discard the incoming sample
+        Last            // fake value for iteration
+    };
+    // "dropOldest", or "dropNewest"
+    static Titta::OverflowPolicy stringToOverflowPolicy(std::string overflowPolicy_);
+    static std::string overflowPolicyToString(Titta::OverflowPolicy overflowPolicy_, bool snakeCase_ = false);
+    static std::vector<std::string> getAllOverflowPolicies(bool snakeCase_ = false);
+    static std::string getAllOverflowPoliciesString(const char* quoteChar_ = "\"", bool snakeCase_ = false);
+
+    // read-only view of a range of samples in a buffer, for access without copying. Holds a shared lock on the
+    // buffer for as long as it exists (or until release() is called). NB: while a lease is held, new samples
+    // cannot be stored in the buffer and the SDK callbacks delivering them wait (unless in ingest queue mode,
+    // where they are queued), so keep leases short-lived
+    template <typename T>
+    class BufferLease
+    {
+    public:
+        using value_type        = T;
+        using size_type         = size_t;
+        using difference_type   = std::ptrdiff_t;
+        using reference         = typename buffer_t<T>::const_reference;  // NB: a value for buffers storing samples in a different form (gaze)
+        using const_reference   = typename buffer_t<T>::const_reference;
+        using const_iterator    = typename buffer_t<T>::const_iterator;
+        using iterator          = const_iterator;
+
+        BufferLease(read_lock&& lock_, const_iterator first_, const_iterator last_) : _lock(std::move(lock_)), _first(first_), _last(last_) {}
+
+        size_type       size()  const { return static_cast<size_type>(_last - _first); }
+        bool            empty() const { return _first == _last; }
+        const_reference operator[](size_type i_) const { return _first[static_cast<difference_type>(i_)]; }
+        const_reference front() const { return *_first; }
+        const_reference back()  const { return *(_last-1); }
+        const_iterator  begin() const { return _first; }
+        const_iterator  end()   const { return _last; }
+        const_iterator  cbegin() const { return _first; }
+        const_iterator  cend()  const { return _last; }
+
+        // release the lock on the buffer, the lease is empty afterwards
+        void release()
+        {
+            _first = _last;
+            if (_lock.owns_lock())
+                _lock.unlock();
+        }
+
+    private:
+        read_lock       _lock;
+        const_iterator  _first;
+        const_iterator  _last;
+    };
+
+    // time spent in Tobii SDK callbacks
+    struct CallbackTimingStats
+    {
+        uint64_t    numCallbacks = 0;
+        double      meanDuration = 0.;  // microseconds
+        double      maxDuration  = 0.;  // microseconds
+    };
+
+    // latency of a stream on the way of its samples to user code. callback and commit are the durations of
+    // consecutive stages, each measured per sample. read is the end-to-end age of samples when they are read;
+    // it is sampled: only the newest sample returned by each call is measured
+    struct LatencyStats
+    {
+        TittaLatency::stats callback;   // from recording by the eye tracker (system_time_stamp) to entering the Tobii SDK callback
+        TittaLatency::stats commit;     // from entering the Tobii SDK callback to storage in the buffer (queueing, merging, lock waits)
+        TittaLatency::stats read;       // from recording by the eye tracker to being read by a consume, peek or readSince call
+    };
+
+    // runtime counters of a stream
+    struct StreamCounters
+    {
+        uint64_t    numCallbacks        = 0;    // Tobii SDK callbacks received
+        uint64_t    numCommitted        = 0;    // samples stored in the buffer
+        uint64_t    numDropped          = 0;    // samples discarded because the buffer was full
+        uint64_t    numBuffered         = 0;    // samples currently in the buffer
+        uint64_t    bufferBytes         = 0;    // memory currently allocated by the buffer (for eye images excluding the image data)
+        uint64_t    numQueued           = 0;    // samples waiting in the ingest queue
+        uint64_t    numQueueDropped     = 0;    // samples discarded because the ingest queue was full
+        uint64_t    numLockWaits        = 0;    // times that storing samples had to wait for the buffer lock (held by a reader)
+        double      lockWaitTime        = 0.;   // microseconds, total time spent waiting for the buffer lock
+        // merging of gaze and eye openness samples, only for the gaze stream
+        uint64_t    numMerged           = 0;    // samples combined with their partner
+        uint64_t    numMergeTimeouts    = 0;    // samples output without partner because it did not arrive in time
+    };
+
 public:
     Titta(std::string address_);
     Titta(TobiiResearchEyeTracker* et_);
@@ -84,6 +190,13 @@ public:
     static bool startLogging(std::optional<size_t> initialBufferSize_ = std::nullopt);
     static std::vector<Titta::allLogTypes> getLog(std::optional<bool> clearLog_ = std::nullopt);
     static bool stopLogging();	// always clears buffer
+    // memory pool for eye image payloads, shared by all instances
+    static TobiiTypes::imagePool::stats getEyeImagePoolStats();
+    // tracing of internal activity (callbacks, buffer locks, reads, calibration work), for inspection in a
+    // trace viewer. Starting discards a previous trace, stopping keeps it so it can be written
+    static void startTracing(std::optional<size_t> eventsPerThread_ = std::nullopt);
+    static void stopTracing();
+    static void writeTrace(std::string filePath_);  // Chrome trace event JSON format. Can also be called while tracing
 
     //// eye-tracker specific getters and setters
     // getters
@@ -117,10 +230,47 @@ public:
 
     // deal with eyeOpenness stream
     bool setIncludeEyeOpennessInGaze(bool include_);    // returns previous state
+    // when merging gaze and eye openness, the maximum time (in microseconds) a sample waits for its partner
+    // from the other stream before it is written to the buffer incomplete. Returns previous value
+    int64_t setGazeMergeMaxWait(int64_t maxWait_);
+    int64_t getGazeMergeMaxWait() const;
+
+    // ingest queue mode: if enabled, the Tobii SDK callbacks only put incoming samples in a wait-free
+    // single-producer queue per stream, so that they never have to wait for a buffer lock held by a
+    // consume or peek call. The queues are drained into the buffers by a separate thread, and by any
+    // call that reads from a buffer. Can only be changed when no streams are being recorded
+    // The queues have a fixed capacity that is allocated up front, so that the callbacks never allocate. If a
+    // queue is full because draining is held up, further samples are discarded (see
+    // StreamCounters::numQueueDropped)
+    static constexpr size_t ingestQueueCapacityGaze = 1<<13;    // gaze and eye openness queues, samples
+    static constexpr size_t ingestQueueCapacity     = 1<<10;    // queues of the other streams, samples
+    bool setUseIngestQueue(bool useQueue_);     // returns previous state
+    bool getUseIngestQueue() const;
 
-    // start stream
-    bool start(std::string stream_, std::optional<size_t> initialBufferSize_ = std::nullopt, std::optional<bool> asGif_ = std::nullopt, bool snake_case_on_stream_not_found = false);
-    bool start(Stream      stream_, std::optional<size_t> initialBufferSize_ = std::nullopt, std::optional<bool> asGif_ = std::nullopt);
+    // get how many times the Tobii SDK callback for a stream has been called and how long it took
+    CallbackTimingStats getCallbackTimingStats(std::string stream_, bool snake_case_on_stream_not_found = false) const;
+    CallbackTimingStats getCallbackTimingStats(Stream      stream_) const;
+
+    // get the latency of a stream. Eye openness samples are stored in the gaze buffer, so for the eyeOpenness
+    // stream only the callback latency is available, the others are included in that of the gaze stream.
+    // Not available for the positioning stream, as its samples have no timestamp
+    LatencyStats getLatencyStats(std::string stream_, bool snake_case_on_stream_not_found = false) const;
+    LatencyStats getLatencyStats(Stream      stream_) const;
+
+    // get a snapshot of the runtime counters of all streams. Cheap, only briefly takes the lock of each buffer
+    // to read its size, so can be polled during a recording. Eye openness samples are stored in the gaze
+    // buffer, so for the eyeOpenness stream only numCallbacks, numQueued and numQueueDropped are available
+    std::map<Stream, StreamCounters> getCounters();
+
+    // when connected to a replay of a recording (see TittaSimulator), get how well the processing of the
+    // samples keeps up with the replay
+    TittaSimulator::replayStats getReplayStats() const;
+
+    // start stream. If capacity_ is provided, the buffer is bounded to hold at most that many samples, and
+    // overflowPolicy_ determines which samples are discarded when it is full. If not provided, the bounds
+    // set by a previous call to start() remain in effect (default: unbounded)
+    bool start(std::string stream_, std::optional<size_t> initialBufferSize_ = std::nullopt, std::optional<bool> asGif_ = std::nullopt, std::optional<size_t> capacity_ = std::nullopt, std::optional<OverflowPolicy> overflowPolicy_ = std::nullopt, bool snake_case_on_stream_not_found = false);
+    bool start(Stream      stream_, std::optional<size_t> initialBufferSize_ = std::nullopt, std::optional<bool> asGif_ = std::nullopt, std::optional<size_t> capacity_ = std::nullopt, std::optional<OverflowPolicy> overflowPolicy_ = std::nullopt);
 
     // request stream state
     bool isRecording(std::string stream_, bool snake_case_on_stream_not_found = false) const;
@@ -140,6 +290,75 @@ public:
     template <typename T>
     std::vector<T> peekTimeRange(std::optional<int64_t> timeStart_ = std::nullopt, std::optional<int64_t> timeEnd_ = std::nullopt);
 
+    // get the most recent sample of a stream without touching its buffer or taking its lock, so this
+    // is cheap enough to call every frame (e.g. for gaze-contingent displays). Available for gaze,
+    // external signal, time sync and positioning data. Returns std::nullopt if no sample was received yet.
+    // The latest sample is also updated when the buffer is full and the sample is discarded
+    template <typename T>
+    std::optional<T> getLatest() const;
+
+    // zero-copy versions of the above: instead of copying the samples, get a lease providing direct access to
+    // them in the buffer (see BufferLease)
+    template <typename T>
+    BufferLease<T> peekNLease(std::optional<size_t> NSamp_ = std::nullopt, std::optional<BufferSide> side_ = std::nullopt);
+    template <typename T>
+    BufferLease<T> peekTimeRangeLease(std::optional<int64_t> timeStart_ = std::nullopt, std::optional<int64_t> timeEnd_ = std::nullopt);
+
+    // columnar versions of the above for gaze data: the samples are returned as one contiguous array per field
+    // (see TobiiTypes::gazeColumns), filled in a single pass over the buffer. Each column can then be handed to
+    // MATLAB or numpy in one go, instead of visiting all samples again for each output field
+    gazeColumns consumeNColumns(std::optional<size_t> NSamp_ = std::nullopt, std::optional<BufferSide> side_ = std::nullopt);
+    gazeColumns consumeTimeRangeColumns(std::optional<int64_t> timeStart_ = std::nullopt, std::optional<int64_t> timeEnd_ = std::nullopt);
+    gazeColumns peekNColumns(std::optional<size_t> NSamp_ = std::nullopt, std::optional<BufferSide> side_ = std::nullopt);
+    gazeColumns peekTimeRangeColumns(std::optional<int64_t> timeStart_ = std::nullopt, std::optional<int64_t> timeEnd_ = std::nullopt);
+
+    // cursors, for reading a stream incrementally. Any number of independent consumers can each open a cursor
+    // on the same stream. readSince() returns the samples the cursor has not yet passed (at most NSamp_, by
+    // default all) and advances the cursor past them, without removing them from the buffer. The cursor
+    // starts at the given side of the buffer (default: start, i.e., the first read returns all samples
+    // currently in the buffer). Samples consumed or cleared from the buffer by other calls are skipped.
+    // If reclaim_ is set for all cursors open on a stream, samples that all cursors have passed are removed
+    // from the buffer and their memory released (i.e., they are no longer available to peek or consume)
+    uint64_t openCursor(std::string stream_, std::optional<BufferSide> side_ = std::nullopt, std::optional<bool> reclaim_ = std::nullopt, bool snake_case_on_stream_not_found = false);
+    uint64_t openCursor(Stream      stream_, std::optional<BufferSide> side_ = std::nullopt, std::optional<bool> reclaim_ = std::nullopt);
+    template <typename T>
+    std::vector<T> readSince(uint64_t cursor_, std::optional<size_t> NSamp_ = std::nullopt);
+    Stream getCursorStream(uint64_t cursor_) const;
+    bool closeCursor(uint64_t cursor_);         // returns false if the cursor was not open
+
+    // journal: a background thread continuously appends the samples of all streams to a file (see journal.h
+    // for the format), so that a recording survives a crash and does not need to be collected and saved at
+    // the end of a session. If inMemoryWindow_ is provided, for each stream at most that many samples that
+    // have been written to the journal are kept in memory, older ones are removed from the buffer. Samples that
+    // an open cursor (see openCursor()) or the incremental parquet export has not yet passed are never removed,
+    // so the buffer can grow beyond the window while a cursor lags behind.
+    // NB: samples that are consumed or cleared from the buffer before they have been written to the journal
+    // (which happens about every 100 ms) are not included in the journal
+    // If writing to the file fails (e.g. the disk is full), journaling stops and the error is raised by the next
+    // call to isJournaling() or stopJournal()
+    void startJournal(std::string filePath_, std::optional<size_t> inMemoryWindow_ = std::nullopt);
+    bool stopJournal();                         // writes remaining samples and closes the file. Returns false if no journal was being written
+    bool isJournaling();
+    static TittaJournal::contents readJournal(std::string filePath_);   // recovers all complete chunks, also from a journal that was not properly closed
+
+    // session file: recording stored for fast access to time ranges without loading the whole file (see
+    // session.h, and TittaSession::reader for reading). Positioning data is not stored
+    void saveSession(std::string filePath_);    // write the current contents of all buffers (non-destructive)
+    static void convertJournalToSession(std::string journalFilePath_, std::string sessionFilePath_);
+
+    // parquet export: write the buffers directly to Apache Parquet files, one per stream, named
+    // <filePathBase_>_<stream>.parq and with the same columns as Titta.saveDataToParquet produces (see
+    // parquet.h). Samples are written in row groups of at most rowGroupSize_ samples. Positioning data is not
+    // exported
+    void saveParquet(std::string filePathBase_, std::optional<size_t> rowGroupSize_ = std::nullopt);   // write the current contents of all buffers (non-destructive)
+    // incremental parquet export, for long sessions: each call to flushParquet() appends the samples recorded
+    // since the previous call (for the first call: all samples in the buffer) to the files as new row groups.
+    // NB: samples that are consumed or cleared from the buffer before they have been flushed are not exported
+    void startParquet(std::string filePathBase_, std::optional<size_t> rowGroupSize_ = std::nullopt);
+    void flushParquet();
+    bool stopParquet();                         // flushes and completes the files. Returns false if no parquet export was ongoing
+    bool isWritingParquet() const;
+
     // clear all buffer contents
     void clear(std::string stream_, bool snake_case_on_stream_not_found = false);
     void clear(Stream      stream_);
@@ -151,8 +370,13 @@ public:
     bool stop(std::string stream_, std::optional<bool> clearBuffer_ = std::nullopt, bool snake_case_on_stream_not_found = false);
     bool stop(Stream      stream_, std::optional<bool> clearBuffer_ = std::nullopt);
 
+    // number of samples discarded because the buffer was full (see capacity_ argument of start())
+    uint64_t getNumDroppedSamples(std::string stream_, bool snake_case_on_stream_not_found = false);
+    uint64_t getNumDroppedSamples(Stream      stream_);
+
 private:
     void Init();
+    void refreshEyeTrackerInfo(std::optional<std::string> paramToRefresh_ = std::nullopt);
     // Tobii callbacks need to be friends
     friend void TittaGazeCallback       (TobiiResearchGazeData*                     gaze_data_, void* user_data_);
     friend void TittaEyeOpennessCallback(TobiiResearchEyeOpennessData*          openness_data_, void* user_data_);
@@ -167,60 +391,220 @@ private:
     // calibration
     void calibrationThread();
     // gaze + eye openness receiver
-    void receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiResearchEyeOpennessData* openness_data_);
+    void receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiResearchEyeOpennessData* openness_data_, int64_t callbackTime_);
+    void flushGazeStaging(bool onlyStale_);     // if onlyStale_, only flush samples that waited longer than _gazeMergeMaxWait since they arrived
+    void emitUnmerged(write_lock& lOut_);       // output front of staging area without waiting for its partner any longer. !NB: caller must hold _gazeStageMutex
+    // ingest queues
+    void ingestDrainThread();
+    void stopIngestDrainThread();
+    void drainAllIngestQueues();
+    void drainGazeIngestQueues();               // !NB: caller must hold _ingestDrainMutex
+    // journal
+    void journalThread();
+    std::string stopJournalImpl();              // returns the error that stopped the journal thread, if any
+    bool writeJournal();                        // write samples not yet in journal for all streams. Returns false on a write error
+    template <typename T>  bool             writeJournalStream();
+    // session file and parquet saving
+    // export the samples currently in a buffer in parts, so that the buffer is not locked during file I/O:
+    // encode_(buf, first, last) is called with the buffer locked and encodes some of the samples with indices
+    // [first, last), returning the index past the last one it encoded. write_() is then called without lock
+    template <typename T, typename Encode, typename Write>
+    void                                    exportBuffer(Encode&& encode_, Write&& write_);
+    template <typename T>  void             saveSessionStream(TittaSession::writer& w_);
+    template <typename T>  void             saveParquetStream(const std::string& filePathBase_, size_t rowGroupSize_);
+    // parquet export
+    void writeParquet();                        // write samples not yet exported for all streams
+    template <typename T>  void             writeParquetStream();
     //// generic functions for internal use
+    // buffer bounds
+    struct bufferBounds
+    {
+        size_t                  capacity = 0;   // 0: unbounded
+        OverflowPolicy          policy   = OverflowPolicy::DropOldest;
+        std::atomic<uint64_t>   nDropped = 0;
+    };
+    // callback timing
+    struct callbackTimer
+    {
+        std::atomic<uint64_t>   numCallbacks    = 0;
+        std::atomic<uint64_t>   totalDurationNs = 0;
+        std::atomic<uint64_t>   maxDurationNs   = 0;
+
+        void add(std::chrono::steady_clock::time_point start_);     // only to be called from the callback thread
+    };
+    callbackTimer&                          getCallbackTimer(Stream stream_);
+    // end-to-end latency
+    struct latencyHistograms
+    {
+        TittaLatency::histogram callback;
+        TittaLatency::histogram commit;
+        TittaLatency::histogram read;
+    };
+    latencyHistograms&                      getLatencyHistograms(Stream stream_);
+    // runtime counters, those not kept elsewhere (callback timers, buffer bounds)
+    struct bufferCounters
+    {
+        std::atomic<uint64_t>   numCommitted        = 0;
+        std::atomic<uint64_t>   numLockWaits        = 0;
+        std::atomic<uint64_t>   lockWaitNs          = 0;
+        std::atomic<uint64_t>   numMerged           = 0;
+        std::atomic<uint64_t>   numMergeTimeouts    = 0;
+        std::atomic<uint64_t>   numQueueDropped     = 0;
+    };
+    template <typename T>  bufferCounters&  getBufferCounters();
+    template <typename T>  StreamCounters   getBufferCountersImpl();
+    template <typename T>  void             recordCommitLatency(int64_t callbackTime_);
+    template <typename T, typename It>
+                           void             recordReadLatency(It startIt_, It endIt_);
     // helpers
     template <typename T>  mutex_type&      getMutex();
     template <typename T>  read_lock        lockForReading();
     template <typename T>  write_lock       lockForWriting();
-    template <typename T>  std::vector<T>&  getBuffer();
+    // lock buffer for storing samples, counting how often and how long this has to wait
+    template <typename T>  write_lock       lockForIngest();
+    template <typename T>  void             lockForIngest(write_lock& lock_);
+    template <typename T>  buffer_t<T>&     getBuffer();
+    template <typename T>  bufferBounds&    getBufferBounds();
+    template <typename T>  static constexpr bool hasLatestSlot = std::is_same_v<T, gaze> || std::is_same_v<T, extSignal> || std::is_same_v<T, timeSync> || std::is_same_v<T, positioning>;
+    template <typename T>  SeqLockSlot<T>&  getLatestSlot();
+    template <typename T>  void             prepareBuffer(size_t initialBufferSize_, std::optional<size_t> capacity_, std::optional<OverflowPolicy> overflowPolicy_);
+    // sample in an ingest queue, along with the time its callback was entered (for the commit latency)
+    template <typename T>
+    struct ingestItem
+    {
+        template <typename... Args>
+        ingestItem(const int64_t callbackTime_, Args&&... args_) : sample(std::forward<Args>(args_)...), callbackTime(callbackTime_) {}
+
+        T       sample;
+        int64_t callbackTime;
+    };
+    template <typename T>  moodycamel::ReaderWriterQueue<ingestItem<T>>&
+                                            getIngestQueue();
+    // add sample to ingest queue or buffer, depending on mode. Takes care of locking
+    template <typename T, typename... Args>
+                           void             ingestSample(int64_t callbackTime_, Args&&... args_);
+    template <typename T>  void             drainIngestQueue();
+    // add sample(s) to buffer, respecting its bounds. !NB: appropriate locking is responsibility of caller!
+    // callbackTime_ is the time the sample's callback was entered
+    template <typename T, typename... Args>
+                           void             pushToBuffer(int64_t callbackTime_, Args&&... args_);
+    template <typename T, typename InputIt>
+                           void             appendToBuffer(InputIt first_, InputIt last_);
     template <typename T>
-                           std::tuple<typename std::vector<T>::iterator, typename std::vector<T>::iterator>
+                           std::tuple<typename buffer_t<T>::iterator, typename buffer_t<T>::iterator>
                                             getIteratorsFromSampleAndSide(size_t NSamp_, BufferSide side_);
     template <typename T>
-                           std::tuple<typename std::vector<T>::iterator, typename std::vector<T>::iterator, bool>
+                           std::tuple<typename buffer_t<T>::iterator, typename buffer_t<T>::iterator, bool>
                                             getIteratorsFromTimeRange(int64_t timeStart_, int64_t timeEnd_);
     // generic implementations
     template <typename T>  void             clearImpl(int64_t timeStart_, int64_t timeEnd_);
+    template <typename T>  void             openCursorImpl(uint64_t cursor_, BufferSide side_, bool reclaim_);
+    template <typename T>  bool             closeCursorImpl(uint64_t cursor_);
 
 private:
     TobiiTypes::eyeTracker      _eyeTracker;
+    // set when connected to a simulated eye tracker (see simulator.h), _eyeTracker.et is then nullptr
+    std::unique_ptr<TittaSimulator::tracker> _simulator;
 
     bool                        _recordingGaze          = false;
     bool                        _recordingEyeOpenness   = false;
     bool                        _includeEyeOpennessInGaze = false;
-    std::vector<gaze>           _gaze;
-    mutex_type                  _gazeMutex;
-    // staging area to merge gaze and eye openness
-    std::deque<gaze>            _gazeStaging;
+    buffer_t<gaze>              _gaze;
+    bufferBounds                _gazeBounds;
+    mutex_type                  _gazeMutex{"gaze"};
+    SeqLockSlot<gaze>           _gazeLatest;
+    // staging area to merge gaze and eye openness. Ordered by timestamp, and only ever contains samples
+    // that wait for the same stream, so matching is done at the front
+    struct stagedGaze
+    {
+        gaze    sample;
+        int64_t callbackTime = 0;   // callback entry time of the half of the sample that arrived first
+    };
+    FixedRingBuffer<stagedGaze, 64> _gazeStaging;
+    // samples that were output without waiting for their partner any longer. If the partner still arrives, it is
+    // discarded instead of output as a second sample with the same timestamp
+    struct unmergedGaze
+    {
+        int64_t deviceTimeStamp = 0;
+        bool    waitsForGaze    = false;    // if false, waits for eye openness
+    };
+    FixedRingBuffer<unmergedGaze, 64> _gazeUnmerged;
     std::atomic<bool>           _gazeStagingEmpty       = true;
-    mutex_type                  _gazeStageMutex;
+    std::atomic<int64_t>        _gazeMergeMaxWait       = 0;
+    mutex_type                  _gazeStageMutex{"gaze staging"};
 
     bool                        _recordingEyeImages     = false;
-    std::vector<eyeImage>       _eyeImages;
+    buffer_t<eyeImage>          _eyeImages;
+    bufferBounds                _eyeImagesBounds;
     bool                        _eyeImIsGif             = false;
-    mutex_type                  _eyeImagesMutex;
+    mutex_type                  _eyeImagesMutex{"eyeImage"};
 
     bool                        _recordingExtSignal     = false;
-    std::vector<extSignal>      _extSignal;
-    mutex_type                  _extSignalMutex;
+    buffer_t<extSignal>         _extSignal;
+    bufferBounds                _extSignalBounds;
+    SeqLockSlot<extSignal>      _extSignalLatest;
+    mutex_type                  _extSignalMutex{"externalSignal"};
 
     bool                        _recordingTimeSync      = false;
-    std::vector<timeSync>       _timeSync;
-    mutex_type                  _timeSyncMutex;
+    buffer_t<timeSync>          _timeSync;
+    bufferBounds                _timeSyncBounds;
+    SeqLockSlot<timeSync>       _timeSyncLatest;
+    mutex_type                  _timeSyncMutex{"timeSync"};
 
     bool                        _recordingPositioning   = false;
-    std::vector<positioning>    _positioning;
-    mutex_type                  _positioningMutex;
+    buffer_t<positioning>       _positioning;
+    bufferBounds                _positioningBounds;
+    SeqLockSlot<positioning>    _positioningLatest;
+    mutex_type                  _positioningMutex{"positioning"};
 
     bool                        _recordingNotification  = false;
-    std::vector<notification>   _notification;
-    mutex_type                  _notificationMutex;
+    buffer_t<notification>      _notification;
+    bufferBounds                _notificationBounds;
+    mutex_type                  _notificationMutex{"notification"};
+
+    // ingest queues, filled by the Tobii SDK callbacks if in ingest queue mode
+    std::atomic<bool>           _useIngestQueue         = false;
+    moodycamel::ReaderWriterQueue<ingestItem<TobiiResearchGazeData>>         _gazeIngestQueue        {ingestQueueCapacityGaze};
+    moodycamel::ReaderWriterQueue<ingestItem<TobiiResearchEyeOpennessData>>  _eyeOpennessIngestQueue {ingestQueueCapacityGaze};
+    moodycamel::ReaderWriterQueue<ingestItem<eyeImage>>                      _eyeImagesIngestQueue   {ingestQueueCapacity};
+    moodycamel::ReaderWriterQueue<ingestItem<extSignal>>                     _extSignalIngestQueue   {ingestQueueCapacity};
+    moodycamel::ReaderWriterQueue<ingestItem<timeSync>>                      _timeSyncIngestQueue    {ingestQueueCapacity};
+    moodycamel::ReaderWriterQueue<ingestItem<positioning>>                   _positioningIngestQueue {ingestQueueCapacity};
+    moodycamel::ReaderWriterQueue<ingestItem<notification>>                  _notificationIngestQueue{ingestQueueCapacity};
+    std::mutex                  _ingestDrainMutex;      // queues are single consumer, serialize draining
+    std::thread                 _ingestDrainThread;
+    std::atomic<bool>           _ingestDrainShouldStop  = false;
+
+    std::array<callbackTimer, static_cast<size_t>(Stream::Last)> _callbackTimers;
+    std::array<latencyHistograms, static_cast<size_t>(Stream::Last)> _latencyHistograms;
+    std::array<bufferCounters, static_cast<size_t>(Stream::Last)> _bufferCounters;
+
+    // cursors, position of each is stored in the buffer of the stream it is opened on
+    std::map<uint64_t, Stream>  _cursors;
+    uint64_t                    _nextCursorId           = 1;
+    mutable std::mutex          _cursorsMutex;
+
+    // journal
+    std::unique_ptr<TittaJournal::writer> _journal;
+    std::array<uint64_t, 6>     _journalCursors         = {};   // cursor for each buffer
+    size_t                      _journalWindow          = 0;    // 0: unbounded
+    std::thread                 _journalThread;
+    bool                        _journalShouldStop      = false;
+    std::mutex                  _journalMutex;                  // serializes writing to the journal, and guards _journalShouldStop
+    std::condition_variable     _journalStopCV;
+    std::string                 _journalError;                  // set by the journal thread before it sets _journalFailed
+    std::atomic<bool>           _journalFailed          = false;
+
+    // parquet export, indexed as the journal cursors (no writer for positioning, which is not exported)
+    std::array<std::unique_ptr<TittaParquet::writer>, 6> _parquetWriters;
+    std::array<uint64_t, 6>     _parquetCursors         = {};   // cursor for each buffer
+    size_t                      _parquetRowGroupSize    = 0;
+    mutable std::mutex          _parquetMutex;                  // serializes writing to the files
 
     static inline bool          _isLogging              = false;
     static inline std::unique_ptr<
         std::vector<allLogTypes>> _logMessages          = nullptr;
-    static inline mutex_type    _logsMutex;
+    static inline mutex_type    _logsMutex{"log"};
 
     // calibration
     bool                                        _calibrationIsMonocular = false;
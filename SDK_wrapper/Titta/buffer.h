@@ -0,0 +1,415 @@
+#pragma once
+#include <deque>
+#include <array>
+#include <vector>
+#include <memory>
+#include <iterator>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+// Segmented, block-linked sample buffer.
+// Elements are stored in fixed-size blocks so that:
+// 1. growth never reallocates or moves existing elements (a new block is simply linked in), and
+// 2. erasing from the front (the common consume case) only destroys the erased elements and
+//    releases whole blocks, instead of shifting the remainder of the buffer.
+// Released blocks are kept in a spare pool up to the reserved capacity, so that a buffer that
+// is repeatedly filled and consumed does not keep hitting the allocator.
+// Cursors can be registered with the buffer. A cursor is a position in the buffer that keeps pointing to
+// the same element when elements before it are removed, so that a reader can keep track of which elements
+// it has already seen regardless of what other users of the buffer do.
+// Elements can be stored in a different (e.g. more compact) form than the one they are added and read in: if
+// S is not T, elements are converted to S when added and converted back to T each time they are accessed.
+// S must then be constructible from T and explicitly convertible to T. Element access then returns values
+// instead of references, so elements cannot be modified in place. The stored form can be accessed through
+// stored() and iter::stored().
+// Not thread safe, appropriate locking is the responsibility of the user.
+template <typename T, typename S = T, size_t BlockBytes = (1<<16)>
+class SegmentedBuffer
+{
+public:
+    using value_type        = T;
+    using stored_type       = S;
+    using size_type         = size_t;
+    using difference_type   = std::ptrdiff_t;
+    static constexpr bool isConverting = !std::is_same_v<T, S>;
+    using reference         = std::conditional_t<isConverting, T, T&>;
+    using const_reference   = std::conditional_t<isConverting, T, const T&>;
+
+    static constexpr size_type blockSize = sizeof(S) >= BlockBytes ? 1 : BlockBytes/sizeof(S);
+
+private:
+    template <bool IsConst>
+    class iter
+    {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = std::conditional_t<IsConst, const T*, T*>;
+        using reference         = std::conditional_t<IsConst, typename SegmentedBuffer::const_reference, typename SegmentedBuffer::reference>;
+        using container         = std::conditional_t<IsConst, const SegmentedBuffer, SegmentedBuffer>;
+
+        iter() = default;
+        iter(container* buf_, size_type idx_) : _buf(buf_), _idx(idx_) {}
+        // allow iterator -> const_iterator conversion
+        template <bool C = IsConst, typename = std::enable_if_t<C>>
+        iter(const iter<false>& other_) : _buf(other_._buf), _idx(other_._idx) {}
+
+        reference   operator* () const { return (*_buf)[_idx]; }
+        pointer     operator->() const requires (!isConverting) { return &(*_buf)[_idx]; }
+        reference   operator[](difference_type n_) const { return (*_buf)[_idx+n_]; }
+        // element in the form it is stored in
+        const S&    stored() const { return _buf->stored(_idx); }
+
+        iter&       operator++()    { ++_idx; return *this; }
+        iter        operator++(int) { auto t = *this; ++_idx; return t; }
+        iter&       operator--()    { --_idx; return *this; }
+        iter        operator--(int) { auto t = *this; --_idx; return t; }
+        iter&       operator+=(difference_type n_) { _idx += n_; return *this; }
+        iter&       operator-=(difference_type n_) { _idx -= n_; return *this; }
+        friend iter operator+ (iter a_, difference_type n_) { a_ += n_; return a_; }
+        friend iter operator+ (difference_type n_, iter a_) { a_ += n_; return a_; }
+        friend iter operator- (iter a_, difference_type n_) { a_ -= n_; return a_; }
+        friend difference_type operator-(const iter& a_, const iter& b_) { return static_cast<difference_type>(a_._idx) - static_cast<difference_type>(b_._idx); }
+
+        friend bool operator==(const iter& a_, const iter& b_) { return a_._idx == b_._idx; }
+        friend bool operator!=(const iter& a_, const iter& b_) { return a_._idx != b_._idx; }
+        friend bool operator< (const iter& a_, const iter& b_) { return a_._idx <  b_._idx; }
+        friend bool operator> (const iter& a_, const iter& b_) { return a_._idx >  b_._idx; }
+        friend bool operator<=(const iter& a_, const iter& b_) { return a_._idx <= b_._idx; }
+        friend bool operator>=(const iter& a_, const iter& b_) { return a_._idx >= b_._idx; }
+
+        size_type   index() const { return _idx; }
+
+    private:
+        friend class iter<!IsConst>;
+        container*  _buf = nullptr;
+        size_type   _idx = 0;
+    };
+
+public:
+    using iterator          = iter<false>;
+    using const_iterator    = iter<true>;
+
+    SegmentedBuffer() = default;
+    SegmentedBuffer(const SegmentedBuffer&) = delete;
+    SegmentedBuffer& operator=(const SegmentedBuffer&) = delete;
+    ~SegmentedBuffer()
+    {
+        clear();
+        releaseSpares(0);
+    }
+
+    // element access
+    reference       operator[](size_type i_)       { if constexpr (isConverting) return static_cast<T>(stored(i_)); else return stored(i_); }
+    const_reference operator[](size_type i_) const { if constexpr (isConverting) return static_cast<T>(stored(i_)); else return stored(i_); }
+    S&              stored(size_type i_)           { const auto p = _first+i_; return _blocks[p/blockSize][p%blockSize]; }
+    const S&        stored(size_type i_)     const { const auto p = _first+i_; return _blocks[p/blockSize][p%blockSize]; }
+    reference       front()       { return (*this)[0]; }
+    const_reference front() const { return (*this)[0]; }
+    reference       back()        { return (*this)[_size-1]; }
+    const_reference back()  const { return (*this)[_size-1]; }
+
+    iterator        begin()        { return {this, 0}; }
+    iterator        end()          { return {this, _size}; }
+    const_iterator  begin()  const { return {this, 0}; }
+    const_iterator  end()    const { return {this, _size}; }
+    const_iterator  cbegin() const { return {this, 0}; }
+    const_iterator  cend()   const { return {this, _size}; }
+
+    // capacity
+    size_type       size()  const { return _size; }
+    bool            empty() const { return _size==0; }
+    // number of elements that can be stored without allocating
+    size_type       capacity() const { return (_blocks.size()+_spare.size())*blockSize - _first; }
+    // number of bytes of storage currently held, including spare blocks
+    size_type       allocatedBytes() const { return (_blocks.size()+_spare.size())*blockSize*sizeof(S); }
+
+    // preallocate storage for at least n_ elements. Blocks are allocated up front and put in the
+    // spare pool, existing elements are never moved. Also sets the number of blocks that are kept
+    // around when released, so reserved memory is reused instead of returned to the allocator
+    void reserve(size_type n_)
+    {
+        const auto nBlocks = (n_+blockSize-1)/blockSize;
+        _maxSpare = std::max(_maxSpare, nBlocks);
+        while (capacity() < n_)
+            _spare.push_back(allocBlock());
+    }
+
+    // modifiers
+    template <class... Args>
+    void emplace_back(Args&&... args_)
+    {
+        const auto p = _first+_size;
+        if (p == _blocks.size()*blockSize)
+            _blocks.push_back(acquireBlock());
+        S* slot = _blocks[p/blockSize]+p%blockSize;
+        if constexpr (isConverting)
+            ::new (static_cast<void*>(slot)) S(T(std::forward<Args>(args_)...));
+        else
+            ::new (static_cast<void*>(slot)) T(std::forward<Args>(args_)...);
+        ++_size;
+    }
+    void push_back(const T& v_) { emplace_back(v_); }
+    void push_back(T&& v_)      { emplace_back(std::move(v_)); }
+
+    // append range to end of buffer
+    template <typename InputIt>
+    void append(InputIt first_, InputIt last_)
+    {
+        for (; first_ != last_; ++first_)
+            emplace_back(*first_);
+    }
+
+    void pop_front(size_type n_ = 1)
+    {
+        n_ = std::min(n_, _size);
+        for (auto& c: _cursors)
+            c.pos = c.pos > n_ ? c.pos-n_ : 0;
+        popFrontImpl(n_);
+    }
+    void pop_back(size_type n_ = 1)
+    {
+        n_ = std::min(n_, _size);
+        for (auto& c: _cursors)
+            c.pos = std::min(c.pos, _size-n_);
+        popBackImpl(n_);
+    }
+
+    // erase range [first_, last_). Erasing from either end is cheap, for erasure in the middle
+    // the shorter side of the buffer is moved to fill the gap
+    iterator erase(const_iterator first_, const_iterator last_)
+    {
+        const auto s = first_.index();
+        const auto e = last_.index();
+        if (s >= e)
+            return {this, s};
+        const auto n = e-s;
+
+        for (auto& c: _cursors)
+        {
+            if (c.pos >= e)
+                c.pos -= n;
+            else if (c.pos > s)
+                c.pos = s;
+        }
+
+        if (s == 0)
+            popFrontImpl(n);
+        else if (e == _size)
+        {
+            popBackImpl(n);
+            return end();
+        }
+        else if (s < _size-e)
+        {
+            // fewer elements before than after the range: shift head towards the back
+            for (size_type i = s; i-- > 0;)
+                stored(i+n) = std::move(stored(i));
+            popFrontImpl(n);
+            return {this, s};
+        }
+        else
+        {
+            // shift tail towards the front
+            for (size_type i = e; i < _size; i++)
+                stored(i-n) = std::move(stored(i));
+            popBackImpl(n);
+        }
+        return {this, s};
+    }
+    iterator erase(const_iterator pos_) { return erase(pos_, pos_+1); }
+
+    void clear()
+    {
+        pop_back(_size);
+        _first = 0;
+    }
+
+    // cursors
+    using cursor_id = uint64_t;
+    // register a cursor at position pos_. If reclaim_ is set, the cursor allows elements it has passed to be
+    // removed, see reclaimableCount()
+    void addCursor(cursor_id id_, size_type pos_, bool reclaim_ = false)
+    {
+        _cursors.push_back({id_, std::min(pos_, _size), reclaim_});
+    }
+    bool removeCursor(cursor_id id_)
+    {
+        const auto it = findCursor(id_);
+        if (it == _cursors.end())
+            return false;
+        _cursors.erase(it);
+        return true;
+    }
+    bool hasCursor(cursor_id id_) const
+    {
+        return findCursor(id_) != _cursors.end();
+    }
+    // !NB: caller must ensure cursor exists
+    size_type cursorPosition(cursor_id id_) const
+    {
+        return findCursor(id_)->pos;
+    }
+    void setCursorPosition(cursor_id id_, size_type pos_)
+    {
+        findCursor(id_)->pos = std::min(pos_, _size);
+    }
+    // number of elements at the front of the buffer that all cursors have passed (size() if there are no cursors)
+    size_type passedCount() const
+    {
+        size_type n = _size;
+        for (const auto& c: _cursors)
+            n = std::min(n, c.pos);
+        return n;
+    }
+    // number of elements at the front of the buffer that all cursors have passed, if all cursors allow
+    // reclaiming elements. 0 otherwise
+    size_type reclaimableCount() const
+    {
+        if (_cursors.empty())
+            return 0;
+        size_type n = _size;
+        for (const auto& c: _cursors)
+        {
+            if (!c.reclaim)
+                return 0;
+            n = std::min(n, c.pos);
+        }
+        return n;
+    }
+
+private:
+    struct cursor
+    {
+        cursor_id   id;
+        size_type   pos;        // index of first element not yet passed by the cursor
+        bool        reclaim;
+    };
+    auto findCursor(cursor_id id_)       { return std::find_if(_cursors.begin(), _cursors.end(), [id_](const cursor& c_) { return c_.id == id_; }); }
+    auto findCursor(cursor_id id_) const { return std::find_if(_cursors.begin(), _cursors.end(), [id_](const cursor& c_) { return c_.id == id_; }); }
+
+    // removal of elements without updating cursors
+    void popFrontImpl(size_type n_)
+    {
+        for (size_type i = 0; i < n_; i++)
+            stored(i).~S();
+        _first += n_;
+        _size  -= n_;
+        // release whole blocks that are no longer used
+        while (_first >= blockSize)
+        {
+            releaseBlock(_blocks.front());
+            _blocks.pop_front();
+            _first -= blockSize;
+        }
+        if (_size==0)
+            trimBack();
+    }
+    void popBackImpl(size_type n_)
+    {
+        for (size_type i = _size-n_; i < _size; i++)
+            stored(i).~S();
+        _size -= n_;
+        trimBack();
+    }
+
+private:
+    S* allocBlock()
+    {
+        return std::allocator<S>().allocate(blockSize);
+    }
+    void freeBlock(S* b_)
+    {
+        std::allocator<S>().deallocate(b_, blockSize);
+    }
+    S* acquireBlock()
+    {
+        if (!_spare.empty())
+        {
+            auto b = _spare.back();
+            _spare.pop_back();
+            return b;
+        }
+        return allocBlock();
+    }
+    void releaseBlock(S* b_)
+    {
+        if (_blocks.size()-1+_spare.size() < _maxSpare)
+            _spare.push_back(b_);
+        else
+            freeBlock(b_);
+    }
+    void releaseSpares(size_type keep_)
+    {
+        while (_spare.size() > keep_)
+        {
+            freeBlock(_spare.back());
+            _spare.pop_back();
+        }
+    }
+    // release blocks past the end of the used range
+    void trimBack()
+    {
+        if (_size==0)
+            _first = 0;
+        const auto nNeeded = (_first+_size+blockSize-1)/blockSize;
+        while (_blocks.size() > nNeeded)
+        {
+            releaseBlock(_blocks.back());
+            _blocks.pop_back();
+        }
+    }
+
+private:
+    std::deque<S*>  _blocks;        // blocks in use, in order
+    std::vector<S*> _spare;         // allocated but currently unused blocks
+    std::vector<cursor> _cursors;
+    size_type       _first    = 0;  // offset of first element in first block
+    size_type       _size     = 0;
+    size_type       _maxSpare = 0;  // number of blocks to retain (set through reserve())
+};
+
+
+// Fixed-capacity FIFO ring of N elements. All storage is part of the object, so pushing and
+// popping never allocate. Elements are not destroyed on pop, slots are reused by assignment,
+// so T must be default constructible and assignable.
+// Not thread safe, appropriate locking is the responsibility of the user.
+template <typename T, size_t N>
+class FixedRingBuffer
+{
+public:
+    using value_type    = T;
+    using size_type     = size_t;
+
+    static constexpr size_type capacity() { return N; }
+
+    size_type       size()  const { return _size; }
+    bool            empty() const { return _size==0; }
+    bool            full()  const { return _size==N; }
+
+    T&              front()       { return _data[_head]; }
+    const T&        front() const { return _data[_head]; }
+    T&              back()        { return _data[(_head+_size-1)%N]; }
+    const T&        back()  const { return _data[(_head+_size-1)%N]; }
+
+    // !NB: caller must ensure the ring is not full
+    T& push_back(T&& v_)      { auto& slot = _data[(_head+_size)%N]; slot = std::move(v_); ++_size; return slot; }
+    T& push_back(const T& v_) { auto& slot = _data[(_head+_size)%N]; slot = v_;            ++_size; return slot; }
+    // !NB: caller must ensure the ring is not empty
+    void pop_front()
+    {
+        _head = (_head+1)%N;
+        if (--_size==0)
+            _head = 0;
+    }
+    void clear() { _head = 0; _size = 0; }
+
+private:
+    std::array<T, N>    _data{};
+    size_type           _head = 0;
+    size_type           _size = 0;
+};
@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <tobii_research_streams.h>
+
+#include "types.h"
+
+// Batch conversion of gaze samples between the Tobii SDK's structs, Titta's sample types and flat arrays
+// (columns, as output to MATLAB and Python, and rows, as pushed to LSL).
+// Vectorized for the instruction set the compiler targets: AVX2 (e.g. /arch:AVX2 or -mavx2), SSE2 (always
+// available on x64), or scalar code otherwise (e.g. ARM). Define TITTA_NO_SIMD to force the scalar code.
+#if !defined(TITTA_NO_SIMD) && defined(__AVX2__)
+#   define TITTA_CONVERT_AVX2
+#endif
+#if !defined(TITTA_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#   define TITTA_CONVERT_SSE2
+#endif
+
+namespace TittaConvert
+{
+    // instruction set used by the conversions: "AVX2", "SSE2" or "scalar"
+    const char* getInstructionSet();
+
+    // Tobii SDK eye data -> Titta eye data, eye openness is left untouched. Inline, as it is called per sample
+    // from the SDK callbacks
+    inline void toEyeData(TobiiTypes::eyeData& out_, const TobiiResearchEyeData& in_)
+    {
+        // positions and validity are laid out the same, copy them as a block (the compiler emits vector moves)
+        static_assert(offsetof(TobiiTypes::gazePoint,  validity) == offsetof(TobiiResearchGazePoint,  validity));
+        static_assert(offsetof(TobiiTypes::pupilData,  validity) == offsetof(TobiiResearchPupilData,  validity));
+        static_assert(offsetof(TobiiTypes::gazeOrigin, validity) == offsetof(TobiiResearchGazeOrigin, validity));
+        static_assert(offsetof(TobiiTypes::gazeOrigin, position_in_track_box_coordinates) == offsetof(TobiiResearchGazeOrigin, position_in_track_box_coordinates));
+        std::memcpy(static_cast<void*>(&out_.gaze_point),  &in_.gaze_point , sizeof(in_.gaze_point));
+        std::memcpy(static_cast<void*>(&out_.pupil),       &in_.pupil_data , sizeof(in_.pupil_data));
+        std::memcpy(static_cast<void*>(&out_.gaze_origin), &in_.gaze_origin, sizeof(in_.gaze_origin));
+        out_.gaze_point.available   = true;
+        out_.pupil.available        = true;
+        out_.gaze_origin.available  = true;
+    }
+    // and back, e.g. for replaying recorded samples. Availability and eye openness are dropped
+    inline void toTobiiEyeData(TobiiResearchEyeData& out_, const TobiiTypes::eyeData& in_)
+    {
+        std::memcpy(&out_.gaze_point,  &in_.gaze_point , sizeof(out_.gaze_point));
+        std::memcpy(&out_.pupil_data,  &in_.pupil      , sizeof(out_.pupil_data));
+        std::memcpy(&out_.gaze_origin, &in_.gaze_origin, sizeof(out_.gaze_origin));
+    }
+
+    // packed samples -> columns. out_ must hold at least offset_+n_ samples, samples_ are written starting at
+    // offset_
+    void toColumns(TobiiTypes::gazeColumns& out_, size_t offset_, const TobiiTypes::gazeDataPacked* const* samples_, size_t n_);
+    // all samples in a range of a Titta buffer (e.g. a Titta::BufferLease)
+    template <typename It>
+    TobiiTypes::gazeColumns toColumns(It first_, It last_)
+    {
+        constexpr size_t batchSize = 256;
+        const TobiiTypes::gazeDataPacked* batch[batchSize];
+
+        TobiiTypes::gazeColumns out;
+        out.resize(static_cast<size_t>(std::distance(first_, last_)));
+        size_t i = 0, n = 0;
+        for (; first_ != last_; ++first_)
+        {
+            batch[n++] = &first_.stored();
+            if (n == batchSize)
+            {
+                toColumns(out, i, batch, n);
+                i += n;
+                n  = 0;
+            }
+        }
+        toColumns(out, i, batch, n);
+        return out;
+    }
+
+    // gaze samples -> rows of values, in the order of the channels of the TittaLSL gaze stream: for the left
+    // and then the right eye: gaze point on display area (x,y), in user coordinates (x,y,z), valid, available,
+    // pupil diameter, valid, available, gaze origin in user coordinates (x,y,z), in track box coordinates
+    // (x,y,z), valid, available, eye openness diameter, valid, available. Finally the device time stamp in s.
+    // out_ must hold n_*rowSize values
+    inline constexpr size_t rowSize = 43;
+    template <typename T>   // float or double
+    void toRows(T* out_, const TobiiTypes::gazeData* samples_, size_t n_);
+
+    // float columns of equal length -> [nColumns_ x n_] column-major double matrix (as used by MATLAB), i.e.,
+    // values of a sample are adjacent in the output
+    void interleave(double* out_, const float* const* columns_, size_t nColumns_, size_t n_);
+}
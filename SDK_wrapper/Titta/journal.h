@@ -0,0 +1,81 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <tobii_research.h>
+#include <tobii_research_streams.h>
+
+#include "types.h"
+
+// On-disk journal of recorded samples. A journal file consists of a header followed by a sequence of
+// self-contained chunks, each holding one or more samples of a single stream followed by a checksum.
+// Chunks are only ever appended, and each chunk is handed to the operating system as soon as it is
+// written. So when the process crashes, all chunks written before the crash can be recovered; a
+// partially written last chunk is detected and skipped when reading.
+// Samples of the gaze, external signal, time sync and positioning streams are stored as their in-memory
+// representation, eye images and notifications are stored field by field.
+namespace TittaJournal
+{
+    enum class StreamId : uint8_t
+    {
+        Gaze = 1,
+        EyeImage,
+        ExtSignal,
+        TimeSync,
+        Positioning,
+        Notification
+    };
+
+    // append samples to a byte buffer for writing as the payload of a chunk
+    void serialize(std::vector<uint8_t>& out_, const TobiiTypes::gazeData& sample_);
+    void serialize(std::vector<uint8_t>& out_, const TobiiTypes::eyeImage& sample_);
+    void serialize(std::vector<uint8_t>& out_, const TobiiResearchExternalSignalData& sample_);
+    void serialize(std::vector<uint8_t>& out_, const TobiiResearchTimeSynchronizationData& sample_);
+    void serialize(std::vector<uint8_t>& out_, const TobiiResearchUserPositionGuide& sample_);
+    void serialize(std::vector<uint8_t>& out_, const TobiiTypes::notification& sample_);
+    // read a sample written by serialize() and advance p_ past it. Returns false if the data is incomplete
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiTypes::gazeData& sample_);
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiTypes::eyeImage& sample_);
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiResearchExternalSignalData& sample_);
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiResearchTimeSynchronizationData& sample_);
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiResearchUserPositionGuide& sample_);
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiTypes::notification& sample_);
+
+    class writer
+    {
+    public:
+        explicit writer(const std::string& filePath_);   // creates file (overwriting existing), writes header
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+        ~writer();
+
+        // NB: does not raise errors, as it is called from the journal thread. Returns false if writing failed,
+        // the file should then no longer be written to
+        bool writeChunk(StreamId stream_, uint32_t nSamples_, const std::vector<uint8_t>& payload_);
+
+        const std::string& getFilePath()   const { return _filePath; }
+        uint64_t           getBytesWritten() const { return _nBytes; }
+
+    private:
+        bool write(const void* data_, size_t nBytes_);
+
+    private:
+        std::string _filePath;
+        std::FILE*  _file   = nullptr;
+        uint64_t    _nBytes = 0;
+    };
+
+    struct contents
+    {
+        std::vector<TobiiTypes::gazeData>                   gaze;
+        std::vector<TobiiTypes::eyeImage>                   eyeImage;
+        std::vector<TobiiResearchExternalSignalData>        extSignal;
+        std::vector<TobiiResearchTimeSynchronizationData>   timeSync;
+        std::vector<TobiiResearchUserPositionGuide>         positioning;
+        std::vector<TobiiTypes::notification>               notification;
+        uint64_t    nChunks     = 0;
+        bool        complete    = true;     // false if the file ended with a partially written or damaged chunk, which was skipped
+    };
+    contents read(const std::string& filePath_);
+}
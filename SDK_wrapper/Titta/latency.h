@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <cstddef>
+
+// Histograms of latencies, in microseconds. HDR-style (high dynamic range): values below 64 us are counted
+// exactly, larger values in bins whose width is 1/32 of their lower edge, so percentiles are accurate to
+// within about 3% over the whole range, at a fixed, small memory cost. Values up to about 71 minutes are
+// binned, larger ones are counted in the last bin (but do count toward the mean and maximum).
+// Recording is wait-free and can be done from multiple threads concurrently.
+namespace TittaLatency
+{
+    struct stats
+    {
+        uint64_t    count   = 0;
+        // all in microseconds, 0 if count is 0
+        double      min     = 0.;
+        double      mean    = 0.;
+        double      p50     = 0.;
+        double      p90     = 0.;
+        double      p99     = 0.;
+        double      p999    = 0.;
+        double      max     = 0.;
+    };
+
+    class histogram
+    {
+    public:
+        void record(int64_t value_)     // negative values (e.g. due to clock jitter) are counted as 0
+        {
+            const auto value = static_cast<uint64_t>(value_ < 0 ? 0 : value_);
+            _counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+            _count.fetch_add(1, std::memory_order_relaxed);
+            _sum  .fetch_add(value, std::memory_order_relaxed);
+            auto prev = _min.load(std::memory_order_relaxed);
+            while (value < prev && !_min.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+            prev = _max.load(std::memory_order_relaxed);
+            while (value > prev && !_max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) {}
+        }
+        stats getStats() const;
+
+    private:
+        static constexpr unsigned   subBucketBits   = 5;                                // 32 bins per power of two
+        static constexpr size_t     numSubBuckets   = size_t{1} << subBucketBits;
+        static constexpr uint64_t   exactLimit      = 2*numSubBuckets;                  // values below are counted exactly
+        static constexpr unsigned   maxBits         = 32;                               // values up to 2^32 us are binned
+        static constexpr size_t     numBuckets      = exactLimit + (maxBits - subBucketBits - 1)*numSubBuckets;
+
+        static size_t bucketIndex(const uint64_t value_)
+        {
+            if (value_ < exactLimit)
+                return static_cast<size_t>(value_);
+            const auto magnitude = static_cast<unsigned>(std::bit_width(value_)) - 1;   // >= subBucketBits+1
+            if (magnitude >= maxBits)
+                return numBuckets - 1;
+            const auto shift = magnitude - subBucketBits;
+            return static_cast<size_t>(exactLimit + (magnitude - subBucketBits - 1)*numSubBuckets + ((value_ >> shift) - numSubBuckets));
+        }
+        // middle of the range of values counted in a bin
+        static double bucketValue(size_t index_);
+
+        std::array<std::atomic<uint64_t>, numBuckets>   _counts{};
+        std::atomic<uint64_t>   _count  = 0;
+        std::atomic<uint64_t>   _sum    = 0;
+        std::atomic<uint64_t>   _min    = UINT64_MAX;
+        std::atomic<uint64_t>   _max    = 0;
+    };
+}
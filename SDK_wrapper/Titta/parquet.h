@@ -0,0 +1,141 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdio>
+#include <cstdint>
+#include <iterator>
+#include <tobii_research.h>
+#include <tobii_research_streams.h>
+
+#include "types.h"
+#include "session.h"
+
+// Apache Parquet export of the recorded streams. Each stream is written to its own file as a table with one
+// row per sample and flat columns, named as Titta.saveDataToParquet names them (nested fields joined with
+// underscores, 2D and 3D points split into _x, _y and _z columns). Rows are written in row groups, so a file
+// can be extended while recording is ongoing, and only one row group at a time needs to be held in memory.
+// All columns are required (non-nullable), PLAIN encoded and uncompressed. Missing values are stored as NaN
+// (floating point columns) or an empty string. The positioning stream has no time stamps and is not exported.
+namespace TittaParquet
+{
+    using StreamId = TittaJournal::StreamId;
+
+    enum class ColumnType
+    {
+        Boolean,
+        UInt8,
+        UInt32,
+        Int64,
+        Double,
+        String,
+        Binary
+    };
+    struct column
+    {
+        std::string name;
+        ColumnType  type;
+    };
+    // columns of the table for a stream
+    const std::vector<column>& getColumns(StreamId stream_);
+    // name of the file a stream is written to: <filePathBase_>_<stream>.parq, e.g., "rec_gaze.parq"
+    std::string getFilePath(const std::string& filePathBase_, StreamId stream_);
+
+    // rows to be written as one row group, stored as an encoded column chunk per column
+    class rowGroup
+    {
+    public:
+        explicit rowGroup(StreamId stream_);
+
+        void add(const TobiiTypes::gazeData& sample_);
+        void add(const TobiiTypes::eyeImage& sample_);
+        void add(const TobiiResearchExternalSignalData& sample_);
+        void add(const TobiiResearchTimeSynchronizationData& sample_);
+        void add(const TobiiTypes::notification& sample_);
+        void clear();
+
+        StreamId getStream()   const { return _stream; }
+        uint64_t getNumRows()  const { return _nRows; }
+        uint64_t getNumBytes() const { return _nBytes; }
+        const std::vector<uint8_t>& getColumnData(size_t column_) const { return _columns[column_]; }
+
+    private:
+        void beginRow(StreamId stream_);
+        void endRow();
+        void put(bool value_);
+        void put(uint8_t value_);
+        void put(uint32_t value_);
+        void put(int64_t value_);
+        void put(double value_);
+        void put(std::string_view value_);
+        void put(const void* data_, size_t nBytes_);    // binary
+        void put(const TobiiResearchNormalizedPoint2D& value_);
+        void put(const TobiiResearchPoint3D& value_);
+        void put(const TobiiTypes::eyeData& value_);
+
+    private:
+        StreamId                            _stream;
+        std::vector<std::vector<uint8_t>>   _columns;
+        size_t                              _column = 0;    // column the next value is written to
+        uint64_t                            _nRows  = 0;
+        uint64_t                            _nBytes = 0;
+    };
+
+    class writer
+    {
+    public:
+        writer(const std::string& filePath_, StreamId stream_);    // creates file (overwriting existing)
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+        ~writer();                                      // closes the file. NB: does not call finish(), the caller must
+
+        void writeRowGroup(const rowGroup& rows_);      // empty row groups are skipped
+        // write all samples of a stream, in row groups of at most rowGroupSize_ samples and
+        // maxRowGroupBytes_ bytes. Cont is any container of samples that can be iterated over
+        // (e.g. std::vector, Titta::BufferLease)
+        template <typename Cont>
+        void writeStream(const Cont& samples_, size_t rowGroupSize_, uint64_t maxRowGroupBytes_)
+        {
+            rowGroup rows(_stream);
+            for (const auto& s: samples_)
+            {
+                rows.add(s);
+                if (rows.getNumRows() >= rowGroupSize_ || rows.getNumBytes() >= maxRowGroupBytes_)
+                {
+                    writeRowGroup(rows);
+                    rows.clear();
+                }
+            }
+            writeRowGroup(rows);
+        }
+        // write the file metadata and close the file. File cannot be read before this has been called
+        void finish();
+
+        StreamId           getStream()   const { return _stream; }
+        const std::string& getFilePath() const { return _filePath; }
+        uint64_t           getNumRows()  const { return _nRows; }
+
+    private:
+        void write(const void* data_, size_t nBytes_);
+
+    private:
+        struct columnChunkInfo
+        {
+            uint64_t    offset;     // position of page in file
+            uint64_t    nBytes;     // including page header
+        };
+        struct rowGroupInfo
+        {
+            std::vector<columnChunkInfo> columns;
+            uint64_t    nRows;
+            uint64_t    nBytes;
+        };
+
+        std::string                 _filePath;
+        StreamId                    _stream;
+        std::FILE*                  _file   = nullptr;
+        uint64_t                    _nBytes = 0;
+        uint64_t                    _nRows  = 0;
+        std::vector<rowGroupInfo>   _rowGroups;
+    };
+}
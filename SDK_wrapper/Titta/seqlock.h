@@ -0,0 +1,76 @@
+#pragma once
+#include <atomic>
+#include <array>
+#include <optional>
+#include <thread>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+// Single-slot sequence lock holding the most recent value of a trivially copyable type.
+// Storing never blocks and never waits for readers. Loading never blocks the writer either,
+// a reader that overlaps with a store simply retries until it obtains a consistent copy.
+// The value is kept in an array of atomic words so that the overlapping reads and writes are
+// well-defined.
+// Stores must be serialized by the user (i.e., one writer at a time), any number of threads
+// can load concurrently.
+template <typename T>
+class SeqLockSlot
+{
+    static_assert(std::is_trivially_copyable_v<T>, "SeqLockSlot: T must be trivially copyable");
+    static_assert(std::is_default_constructible_v<T>, "SeqLockSlot: T must be default constructible");
+
+    using word_type = uint64_t;
+    static constexpr size_t nWords = (sizeof(T)+sizeof(word_type)-1)/sizeof(word_type);
+    using storage_type = std::array<word_type, nWords>;
+
+public:
+    SeqLockSlot() = default;
+    SeqLockSlot(const SeqLockSlot&) = delete;
+    SeqLockSlot& operator=(const SeqLockSlot&) = delete;
+
+    void store(const T& value_)
+    {
+        storage_type tmp{};
+        std::memcpy(tmp.data(), &value_, sizeof(T));
+
+        // odd sequence number: write in progress
+        const auto seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq+1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < nWords; i++)
+            _data[i].store(tmp[i], std::memory_order_relaxed);
+        _seq.store(seq+2, std::memory_order_release);
+    }
+
+    // returns std::nullopt if nothing was stored yet
+    std::optional<T> load() const
+    {
+        storage_type tmp;
+        while (true)
+        {
+            const auto seq0 = _seq.load(std::memory_order_acquire);
+            if (seq0==0)
+                return std::nullopt;
+            if (seq0 & 1)
+            {
+                // writer busy
+                std::this_thread::yield();
+                continue;
+            }
+            for (size_t i = 0; i < nWords; i++)
+                tmp[i] = _data[i].load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_seq.load(std::memory_order_relaxed) == seq0)
+                break;
+        }
+
+        T out;
+        std::memcpy(static_cast<void*>(&out), tmp.data(), sizeof(T));
+        return out;
+    }
+
+private:
+    std::atomic<uint64_t>                       _seq = 0;   // even: stable, odd: write in progress
+    std::array<std::atomic<word_type>, nWords>  _data{};
+};
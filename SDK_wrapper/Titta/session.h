@@ -0,0 +1,160 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <array>
+#include <optional>
+#include <cstdio>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <tobii_research.h>
+#include <tobii_research_streams.h>
+
+#include "types.h"
+#include "journal.h"
+
+// Session file: a recording stored for random access by time. Each stream is stored as a sequence of chunks
+// of at most chunkSize samples. A chunk is columnar: it holds the time stamps of its samples, then the offset
+// of each sample in the payload, then the payload (samples serialized as in the journal, see journal.h).
+// An index at the end of the file records for each chunk its position and first and last time stamp.
+// A reader memory-maps the file and uses this index to locate the chunks covering a requested time range,
+// so only those chunks are touched, regardless of the size of the file.
+// Samples of a stream must be ordered by time stamp. The positioning stream has no time stamps and is not
+// stored.
+namespace TittaSession
+{
+    using StreamId = TittaJournal::StreamId;
+    inline constexpr uint32_t chunkSize = 4096;
+
+    // time stamp used for ordering and for time range queries, same as Titta::getIteratorsFromTimeRange()
+    inline int64_t getTimeStamp(const TobiiTypes::gazeData& sample_)                      { return sample_.system_time_stamp; }
+    inline int64_t getTimeStamp(const TobiiTypes::eyeImage& sample_)                      { return sample_.system_time_stamp; }
+    inline int64_t getTimeStamp(const TobiiResearchExternalSignalData& sample_)           { return sample_.system_time_stamp; }
+    inline int64_t getTimeStamp(const TobiiResearchTimeSynchronizationData& sample_)      { return sample_.system_request_time_stamp; }
+    inline int64_t getTimeStamp(const TobiiTypes::notification& sample_)                  { return sample_.system_time_stamp; }
+
+    template <typename T>
+    constexpr StreamId getStreamId()
+    {
+        if constexpr (std::is_same_v<T, TobiiTypes::gazeData>)
+            return StreamId::Gaze;
+        else if constexpr (std::is_same_v<T, TobiiTypes::eyeImage>)
+            return StreamId::EyeImage;
+        else if constexpr (std::is_same_v<T, TobiiResearchExternalSignalData>)
+            return StreamId::ExtSignal;
+        else if constexpr (std::is_same_v<T, TobiiResearchTimeSynchronizationData>)
+            return StreamId::TimeSync;
+        else if constexpr (std::is_same_v<T, TobiiTypes::notification>)
+            return StreamId::Notification;
+        else
+            static_assert(!sizeof(T), "TittaSession: stream not supported");
+    }
+
+    // index entry
+    struct chunkInfo
+    {
+        int64_t     firstTimeStamp;
+        int64_t     lastTimeStamp;
+        uint64_t    offset;         // position in file
+        uint32_t    nSamples;
+    };
+
+    class writer
+    {
+    public:
+        explicit writer(const std::string& filePath_);   // creates file (overwriting existing)
+        writer(const writer&) = delete;
+        writer& operator=(const writer&) = delete;
+        ~writer();                                      // closes the file. NB: does not call finish(), the caller must
+
+        // write all samples of a stream. Cont is any container of samples that can be iterated over (e.g.
+        // std::vector, Titta::BufferLease). Each stream can only be written once
+        template <typename Cont>
+        void writeStream(const Cont& samples_)
+        {
+            using T = typename Cont::value_type;
+            beginStream(getStreamId<T>());
+            auto it = std::begin(samples_);
+            const auto end = std::end(samples_);
+            while (it != end)
+            {
+                it = encodeChunk(it, end);
+                writeChunk();
+            }
+        }
+        // alternatively, a stream can be written in parts (e.g. so that the source of the samples does not need
+        // to be locked during file I/O): call beginStream(), and then for each part encodeChunk() followed by
+        // writeChunk()
+        void beginStream(StreamId stream_);
+        // encode up to chunkSize samples of [first_, last_) as the next chunk. Returns iterator past the last
+        // encoded sample
+        template <typename It>
+        It encodeChunk(It first_, const It last_)
+        {
+            _timeStamps.clear();
+            _offsets.clear();
+            _payload.clear();
+            for (uint32_t n = 0; n < chunkSize && first_ != last_; ++n, ++first_)
+            {
+                _timeStamps.push_back(getTimeStamp(*first_));
+                _offsets.push_back(_payload.size());
+                TittaJournal::serialize(_payload, *first_);
+            }
+            _offsets.push_back(_payload.size());
+            return first_;
+        }
+        void writeChunk();                              // write the encoded chunk. Empty chunks are skipped
+        // write the index and close the file. File cannot be read before this has been called
+        void finish();
+
+    private:
+        void write(const void* data_, size_t nBytes_);
+
+    private:
+        struct streamInfo
+        {
+            StreamId                stream;
+            std::vector<chunkInfo>  chunks;
+        };
+
+        std::string                 _filePath;
+        std::FILE*                  _file   = nullptr;
+        uint64_t                    _nBytes = 0;
+        std::vector<streamInfo>     _streams;
+        // reused for each chunk
+        std::vector<int64_t>        _timeStamps;
+        std::vector<uint64_t>       _offsets;
+        std::vector<uint8_t>        _payload;
+    };
+
+    class reader
+    {
+    public:
+        explicit reader(const std::string& filePath_);   // memory-maps file and reads index
+        reader(const reader&) = delete;
+        reader& operator=(const reader&) = delete;
+        ~reader();
+
+        bool     hasStream(StreamId stream_) const;
+        uint64_t getNumSamples(StreamId stream_) const;
+
+        // get samples within given time stamps (inclusive, by default whole file). Same semantics as
+        // Titta::peekTimeRange()
+        template <typename T>
+        std::vector<T> peekTimeRange(std::optional<int64_t> timeStart_ = std::nullopt, std::optional<int64_t> timeEnd_ = std::nullopt) const;
+
+    private:
+        const std::vector<chunkInfo>* getChunks(StreamId stream_) const;
+        void unmap();
+
+    private:
+        std::string                 _filePath;
+        const uint8_t*              _data   = nullptr;
+        uint64_t                    _size   = 0;
+#ifdef _WIN32
+        void*                       _fileHandle    = nullptr;
+        void*                       _mappingHandle = nullptr;
+#endif
+        std::array<std::optional<std::vector<chunkInfo>>, 7> _chunks;     // indexed by StreamId
+    };
+}
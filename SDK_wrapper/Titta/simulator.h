@@ -0,0 +1,238 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <array>
+#include <optional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <random>
+#include <cstdint>
+#include <tobii_research.h>
+#include <tobii_research_eyetracker.h>
+#include <tobii_research_streams.h>
+#include <tobii_research_calibration.h>
+
+#include "types.h"
+#include "journal.h"
+
+// Simulated eye tracker, to run Titta (and everything built on it: TittaMex, TittaPy, TittaLSL, the websocket
+// server) without eye tracker hardware, e.g. for load testing and benchmarking. Connect to it using an address
+// starting with "sim://", optionally followed by settings as query parameters, e.g.
+// "sim://?frequency=1200&noise=0.01&blinkRate=0.5" (see settings for all parameters and their defaults).
+// A thread generates samples in real time and delivers them to the subscribed callbacks like the Tobii SDK
+// does, time stamped with the Tobii SDK's system clock. When the thread cannot wake up often enough for the
+// sampling frequency, samples are delivered in bursts, but the average rate is exact.
+// Gaze model: fixations at random positions on the display, connected by saccades. Gaze positions have Gaussian
+// noise and pupil diameter drifts slowly. Blinks occur at random, during which eye openness goes to zero and
+// gaze data is invalid. Data loss: episodes during which an eye is not tracked (its data is invalid), and
+// samples that are not delivered at all.
+// Replay: instead of simulated data, the samples of a recording (a session or journal file) are delivered, by
+// connecting to an address starting with "replay://" followed by the path of the file, optionally followed by
+// settings, e.g. "replay://C:/data/sub01.session?speed=4". Gaze, eye openness, eye image, external signal and
+// time synchronization samples are replayed (positioning data has no time stamps and notifications are not
+// replayed). Replay starts shortly after the first subscription to one of these streams (see replayDelay),
+// at the speed of the recording, N times faster or as fast as possible. Samples are delivered with their
+// recorded data, with system time stamps set to when they are replayed (the time a sample is due, or when
+// replaying as fast as possible, the time it is delivered). Device time stamps keep the recorded spacing.
+// Samples are delivered on schedule as long as the subscribed callbacks keep up, getReplayStats() reports how
+// well they do.
+namespace TittaSimulator
+{
+    inline constexpr std::string_view addressPrefix       = "sim://";
+    inline constexpr std::string_view replayAddressPrefix = "replay://";
+    bool isSimulatorAddress(std::string_view address_);     // simulated eye tracker or replay
+
+    struct settings
+    {
+        float       frequency           = 600.f;    // Hz, gaze, eye openness and positioning streams
+        // gaze
+        double      fixationDuration    = 0.3;      // s, mean (exponentially distributed, at least 50 ms)
+        double      saccadeDuration     = 0.04;     // s
+        double      noise               = 0.003;    // SD of gaze position noise, in normalized display area coordinates
+        double      pupilDiameter       = 3.5;      // mm
+        double      eyeOpenness         = 11.;      // mm
+        // blinks
+        double      blinkRate           = 0.3;      // per s
+        double      blinkDuration       = 0.15;     // s
+        // data loss
+        double      lossRate            = 0.1;      // episodes per s, per eye
+        double      lossDuration        = 0.05;     // s, mean (exponentially distributed)
+        double      dropProbability     = 0.;       // probability that a sample is not delivered
+        // other streams
+        float       eyeImageFrequency   = 30.f;     // Hz
+        double      extSignalInterval   = 1.;       // s, time between changes of the external signal (toggles between 0 and 1), 0 for no changes
+        double      timeSyncInterval    = 0.5;      // s
+        uint32_t    seed                = 0;        // random seed, 0 for a random seed
+        // replay
+        std::string replayFile;                     // session or journal file, empty for simulated data
+        double      replaySpeed         = 1.;       // 1: real time, N: N times as fast, 0: as fast as possible
+        double      replayDelay         = 0.1;      // s, between first subscription to a data stream and start of replay
+        bool        replayLoop          = false;    // start over when the end of the recording is reached
+
+        // parse the settings in an address, e.g. "sim://?frequency=1200&blinkRate=0" or
+        // "replay://recording.session?speed=0&loop=1". Unknown parameters are an error
+        static settings fromAddress(std::string_view address_);
+    };
+
+    struct replayStats
+    {
+        bool        finished            = false;    // all samples of the recording have been delivered
+        // number of samples delivered to at least one callback
+        uint64_t    numGaze             = 0;
+        uint64_t    numEyeOpenness      = 0;
+        uint64_t    numEyeImages        = 0;
+        uint64_t    numExtSignals       = 0;
+        uint64_t    numTimeSyncs        = 0;
+        double      recordingDuration   = 0.;       // s, part of the recording that has been replayed
+        double      elapsedTime         = 0.;       // s, since start of replay (until it finished)
+        double      speed               = 0.;       // recordingDuration/elapsedTime
+        double      maxLag              = 0.;       // s, longest that a sample was delivered after it was due
+        double      callbackTime        = 0.;       // s, spent in the callbacks, i.e., by the code processing the samples
+    };
+
+    class tracker
+    {
+    public:
+        explicit tracker(settings settings_, std::string address_ = std::string(addressPrefix));
+        tracker(const tracker&) = delete;
+        tracker& operator=(const tracker&) = delete;
+        ~tracker();
+
+        // info, as the Tobii SDK provides it for a real eye tracker
+        TobiiTypes::eyeTracker      getInfo() const;
+        TobiiResearchTrackBox       getTrackBox() const;
+        TobiiResearchDisplayArea    getDisplayArea() const;
+        std::optional<replayStats>  getReplayStats() const;     // std::nullopt if not replaying a recording
+
+        // the below functions each replace the Tobii SDK function with the same name, and return status as it does
+        TobiiResearchStatus setDeviceName(std::string deviceName_);
+        TobiiResearchStatus setGazeOutputFrequency(float frequency_);                      // must be one of the supported frequencies
+        TobiiResearchStatus setEyeTrackingMode(std::string trackingMode_);                 // must be one of the supported modes
+        TobiiResearchStatus applyLicenses(size_t nLicenses_, TobiiResearchLicenseValidationResult* validationResults_);     // all licenses are accepted
+
+        // streams. Any number of callbacks can be subscribed to a stream, unsubscribing removes all subscriptions
+        // of the callback and waits for a call in progress to finish
+        TobiiResearchStatus subscribe(tobii_research_gaze_data_callback                 callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_eye_openness_data_callback         callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_eye_image_callback                 callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_eye_image_as_gif_callback          callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_external_signal_data_callback      callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_time_synchronization_data_callback callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_user_position_guide_callback       callback_, void* userData_);
+        TobiiResearchStatus subscribe(tobii_research_notification_callback              callback_, void* userData_);
+        TobiiResearchStatus unsubscribe(tobii_research_gaze_data_callback                 callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_eye_openness_data_callback         callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_eye_image_callback                 callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_eye_image_as_gif_callback          callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_external_signal_data_callback      callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_time_synchronization_data_callback callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_user_position_guide_callback       callback_);
+        TobiiResearchStatus unsubscribe(tobii_research_notification_callback              callback_);
+
+        // calibration. Collected data is simulated as a few samples close to the calibration point. For
+        // monocular calibration, provide the eye. Calibration data does not affect the simulated gaze data
+        TobiiResearchStatus enterCalibrationMode();
+        TobiiResearchStatus leaveCalibrationMode();
+        TobiiResearchStatus calibrationCollectData(float x_, float y_, std::optional<TobiiResearchSelectedEye> eye_ = std::nullopt);
+        TobiiResearchStatus calibrationDiscardData(float x_, float y_, std::optional<TobiiResearchSelectedEye> eye_ = std::nullopt);
+        TobiiResearchStatus calibrationComputeAndApply(TobiiTypes::CalibrationResult& result_);
+        TobiiResearchStatus retrieveCalibrationData(std::vector<uint8_t>& data_);
+        TobiiResearchStatus applyCalibrationData(const std::vector<uint8_t>& data_);
+
+    private:
+        template <typename Callback>
+        struct subscription
+        {
+            Callback    callback;
+            void*       userData;
+        };
+        template <typename Callback>
+        using subscriptions = std::vector<subscription<Callback>>;
+
+        struct calibrationPoint
+        {
+            float       x, y;
+            bool        left, right;    // whether data was collected for each eye
+        };
+        struct replayEvent
+        {
+            int64_t                 timeStamp;
+            uint32_t                index;      // into the stream's samples in _recording
+            TittaJournal::StreamId  stream;
+        };
+
+        void loadRecording();
+        // sample generation, !NB: caller must hold _mutex
+        void run();
+        double generate(double now_);   // these return when next sample is due
+        double replay(double now_);
+        void replaySample(const replayEvent& event_, int64_t timeOffset_, int64_t loopOffset_);
+        void subscribed();              // call when a data stream is subscribed to
+        void makeGazeSample(int64_t timeStamp_);
+        void makeEyeImage(int64_t timeStamp_);
+        void queueNotification(TobiiResearchNotificationType type_, float frequency_ = 0.f);
+        int64_t toDeviceTime(int64_t systemTimeStamp_) const { return systemTimeStamp_ + _deviceClockOffset; }
+
+    private:
+        settings                    _settings;
+        std::string                 _address;
+        std::string                 _deviceName         = "Titta simulator";
+        float                       _frequency;
+        std::string                 _trackingMode       = "human";
+        std::vector<float>          _supportedFrequencies;
+        int64_t                     _deviceClockOffset  = 0;
+
+        subscriptions<tobii_research_gaze_data_callback>                    _gazeSubs;
+        subscriptions<tobii_research_eye_openness_data_callback>            _eyeOpennessSubs;
+        subscriptions<tobii_research_eye_image_callback>                    _eyeImageSubs;
+        subscriptions<tobii_research_eye_image_as_gif_callback>             _eyeImageGifSubs;
+        subscriptions<tobii_research_external_signal_data_callback>         _extSignalSubs;
+        subscriptions<tobii_research_time_synchronization_data_callback>    _timeSyncSubs;
+        subscriptions<tobii_research_user_position_guide_callback>          _positioningSubs;
+        subscriptions<tobii_research_notification_callback>                 _notificationSubs;
+        std::vector<TobiiResearchNotification>                              _pendingNotifications;
+
+        // generator state. Schedule in system time (us), gaze model times in s since _startTime
+        std::mt19937                _rng;
+        int64_t                     _startTime          = 0;
+        double                      _nextGazeTime       = 0.;
+        double                      _nextEyeImageTime   = 0.;
+        double                      _nextExtSignalTime  = 0.;
+        double                      _nextTimeSyncTime   = 0.;
+        std::array<double, 2>       _gazePos            = {.5, .5};     // fixation position
+        std::array<double, 2>       _saccadeFrom        = {.5, .5};
+        double                      _saccadeStart       = -1.;
+        double                      _fixationEnd        = 0.;
+        double                      _blinkStart         = -1.;
+        double                      _nextBlink          = 0.;
+        std::array<double, 2>       _lossEnd            = {};   // left and right eye
+        std::array<double, 2>       _nextLoss           = {};
+        uint32_t                    _extSignalValue     = 0;
+        bool                        _extSignalInitial   = false;    // initial value is to be sent to new subscribers
+        int                         _eyeImageCamera     = 0;
+        std::vector<uint8_t>        _eyeImage;
+        std::vector<uint8_t>        _eyeImageGif;
+
+        // replay
+        TittaJournal::contents      _recording;
+        std::vector<replayEvent>    _replayEvents;      // all samples, in order of time stamp
+        size_t                      _replayPos          = 0;
+        int64_t                     _replayStart        = -1;   // system time stamp, -1 if not started
+        int64_t                     _replayEnd          = 0;
+        int64_t                     _replayLoopOffset   = 0;    // added to time stamps when looping
+        int64_t                     _replayLoopDuration = 0;
+        replayStats                 _replayStats;
+
+        // calibration
+        bool                        _inCalibrationMode  = false;
+        std::vector<calibrationPoint> _calibrationPoints;
+        std::vector<uint8_t>        _calibrationData;   // of the applied calibration
+
+        std::thread                 _thread;
+        bool                        _shouldStop         = false;
+        mutable std::mutex          _mutex;             // guards all state, held by the generator while it delivers samples
+        std::condition_variable     _cv;
+    };
+}
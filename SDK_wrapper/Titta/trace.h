@@ -0,0 +1,145 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <optional>
+#include <string>
+
+// Optional tracing of Titta's internal activity (SDK callbacks, waiting for and holding buffer locks, reads,
+// calibration work, LSL pushes), for finding out which thread was busy when, e.g., frames were dropped.
+// The trace is output in the Chrome trace event format, which can be opened in chrome://tracing or
+// https://ui.perfetto.dev.
+// Each thread records into its own fixed-size buffer, so recording takes no locks. When a thread's buffer is
+// full, its further events are dropped (and counted). When tracing is off, an instrumented code path costs a
+// relaxed atomic load.
+namespace TittaTrace
+{
+    constexpr size_t defaultEventsPerThread = 1<<16;
+
+    // starting discards the events of a previous trace. Stopping keeps the events, so they can be written out
+    void start(std::optional<size_t> eventsPerThread_ = std::nullopt);
+    void stop();
+    inline std::atomic<bool> _isTracing = false;
+    inline bool isTracing() { return _isTracing.load(std::memory_order_relaxed); }
+
+    // trace recorded so far, in the Chrome trace event JSON format. Can be called while tracing
+    std::string toChromeTrace();
+    void writeChromeTrace(const std::string& filePath_);
+
+    // label the calling thread in the trace. Can be called before tracing is started
+    void setThreadName(const char* name_);
+
+    // ns on the steady clock
+    inline int64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+    // record an event of the calling thread. name_, category_ and stream_ (optional) are not copied and must
+    // remain valid until the trace is written, use string literals
+    void record(const char* name_, const char* category_, const char* stream_, int64_t begin_, int64_t end_);
+
+    // records an event spanning its lifetime
+    class scope
+    {
+    public:
+        scope(const char* name_, const char* category_, const char* stream_ = nullptr) :
+            _name(name_), _category(category_), _stream(stream_), _begin(isTracing() ? now() : -1) {}
+        ~scope()
+        {
+            if (_begin >= 0 && isTracing())
+                record(_name, _category, _stream, _begin, now());
+        }
+        scope(const scope&) = delete;
+        scope& operator=(const scope&) = delete;
+
+    private:
+        const char*     _name;
+        const char*     _category;
+        const char*     _stream;
+        int64_t         _begin;
+    };
+
+    // holding locks in shared mode, these are kept per thread (there can be multiple holders)
+    void pushSharedHold(const void* mutex_, int64_t begin_);
+    int64_t popSharedHold(const void* mutex_);
+
+    // mutex that, while tracing, records how long taking the lock had to wait and for how long the lock was held
+    template <typename Mutex>
+    class tracedMutex : public Mutex
+    {
+    public:
+        explicit tracedMutex(const char* name_ = nullptr) : _name(name_) {}
+
+        void lock()
+        {
+            if (!isTracing())
+            {
+                Mutex::lock();
+                _holdBegin = -1;
+                return;
+            }
+            const auto t0 = now();
+            if (Mutex::try_lock())
+                _holdBegin = t0;
+            else
+            {
+                Mutex::lock();
+                _holdBegin = now();
+                record("lock wait", "lock", _name, t0, _holdBegin);
+            }
+        }
+        bool try_lock()
+        {
+            if (!Mutex::try_lock())
+                return false;
+            _holdBegin = isTracing() ? now() : -1;
+            return true;
+        }
+        void unlock()
+        {
+            const auto begin = _holdBegin;     // read while still holding the lock
+            Mutex::unlock();
+            if (begin >= 0 && isTracing())
+                record("lock hold", "lock", _name, begin, now());
+        }
+
+        void lock_shared()
+        {
+            if (!isTracing())
+            {
+                Mutex::lock_shared();
+                return;
+            }
+            const auto t0 = now();
+            if (Mutex::try_lock_shared())
+                pushSharedHold(this, t0);
+            else
+            {
+                Mutex::lock_shared();
+                const auto t1 = now();
+                record("lock wait (shared)", "lock", _name, t0, t1);
+                pushSharedHold(this, t1);
+            }
+        }
+        bool try_lock_shared()
+        {
+            if (!Mutex::try_lock_shared())
+                return false;
+            if (isTracing())
+                pushSharedHold(this, now());
+            return true;
+        }
+        void unlock_shared()
+        {
+            Mutex::unlock_shared();
+            if (isTracing())
+                if (const auto begin = popSharedHold(this); begin >= 0)
+                    record("lock hold (shared)", "lock", _name, begin, now());
+        }
+
+    private:
+        const char*     _name;
+        int64_t         _holdBegin = -1;    // only accessed by the thread holding the lock
+    };
+}
@@ -8,11 +8,16 @@
 #include <mutex>
 #include <shared_mutex>
 #include <limits>
+#include <utility>
+#include <iterator>
+#include <cstdint>
 
 #include <tobii_research_streams.h>
 #include <tobii_research_calibration.h>
 
-using mutex_type = std::shared_mutex;
+#include "trace.h"
+
+using mutex_type = TittaTrace::tracedMutex<std::shared_mutex>;   // records lock waits and holds when tracing
 using read_lock  = std::shared_lock<mutex_type>;
 using write_lock = std::unique_lock<mutex_type>;
 
@@ -119,6 +124,145 @@ namespace TobiiTypes
         int64_t system_time_stamp;
     };
 
+    // Compact version of gazeData, used for storing gaze samples in Titta's buffers: the floats of each eye are
+    // stored densely and its validity and availability flags are bit-packed into a single byte (the validity
+    // of Tobii data is only ever valid or invalid). This takes 128 bytes per sample instead of 184.
+    // Internal storage type, convert to gazeData for use
+    struct eyeDataPacked
+    {
+        enum flag : uint8_t
+        {
+            GazePointValid          = 1<<0,
+            GazePointAvailable      = 1<<1,
+            PupilValid              = 1<<2,
+            PupilAvailable          = 1<<3,
+            GazeOriginValid         = 1<<4,
+            GazeOriginAvailable     = 1<<5,
+            EyeOpennessValid        = 1<<6,
+            EyeOpennessAvailable    = 1<<7
+        };
+
+        eyeDataPacked() = default;
+        explicit eyeDataPacked(const eyeData& data_);
+        explicit operator eyeData() const;
+        bool has(flag f_) const { return flags & f_; }
+
+        float   gaze_point_on_display_area[2];
+        float   gaze_point_in_user_coordinates[3];
+        float   pupil_diameter;
+        float   gaze_origin_in_user_coordinates[3];
+        float   gaze_origin_in_track_box_coordinates[3];
+        float   eye_openness_diameter;
+        uint8_t flags;
+    };
+    struct gazeDataPacked
+    {
+        gazeDataPacked() = default;
+        explicit gazeDataPacked(const gazeData& sample_);
+        explicit operator gazeData() const;
+
+        int64_t         device_time_stamp;
+        int64_t         system_time_stamp;
+        eyeDataPacked   left_eye;
+        eyeDataPacked   right_eye;
+    };
+
+    // Columnar (struct-of-arrays) version of a series of gazeData samples: one contiguous array per field,
+    // points are split into an array per dimension. Validity and availability are stored as one byte per
+    // sample with value 0 or 1, so these columns can be copied directly into bool/logical arrays
+    struct eyeDataColumns
+    {
+        std::vector<float>      gaze_point_on_display_area_x, gaze_point_on_display_area_y;
+        std::vector<float>      gaze_point_in_user_coordinates_x, gaze_point_in_user_coordinates_y, gaze_point_in_user_coordinates_z;
+        std::vector<uint8_t>    gaze_point_valid, gaze_point_available;
+        std::vector<float>      pupil_diameter;
+        std::vector<uint8_t>    pupil_valid, pupil_available;
+        std::vector<float>      gaze_origin_in_user_coordinates_x, gaze_origin_in_user_coordinates_y, gaze_origin_in_user_coordinates_z;
+        std::vector<float>      gaze_origin_in_track_box_coordinates_x, gaze_origin_in_track_box_coordinates_y, gaze_origin_in_track_box_coordinates_z;
+        std::vector<uint8_t>    gaze_origin_valid, gaze_origin_available;
+        std::vector<float>      eye_openness_diameter;
+        std::vector<uint8_t>    eye_openness_valid, eye_openness_available;
+
+        void reserve(size_t n_);
+        void resize(size_t n_);
+        void push_back(const eyeData& sample_);
+    };
+    struct gazeColumns
+    {
+        std::vector<int64_t>    device_time_stamp;
+        std::vector<int64_t>    system_time_stamp;
+        eyeDataColumns          left_eye;
+        eyeDataColumns          right_eye;
+
+        gazeColumns() = default;
+        // fill in a single pass over any container of gazeData (e.g. std::vector). For packed samples in a Titta
+        // buffer, see TittaConvert::toColumns()
+        template <typename InputIt>
+        gazeColumns(InputIt first_, InputIt last_)
+        {
+            reserve(static_cast<size_t>(std::distance(first_, last_)));
+            for (; first_ != last_; ++first_)
+                push_back(*first_);
+        }
+
+        size_t size()  const { return system_time_stamp.size(); }
+        bool   empty() const { return system_time_stamp.empty(); }
+        void reserve(size_t n_);
+        void resize(size_t n_);
+        void push_back(const gazeData& sample_);
+    };
+
+    // Pool for eye image payloads. Memory blocks are grouped into size classes (four per power of two), and
+    // blocks that are released are kept for reuse by the next image of the same size class instead of
+    // being returned to the system allocator (up to a limit). This avoids allocator churn on the SDK
+    // callback thread and heap fragmentation when images are continuously recorded and consumed.
+    // Thread safe.
+    class imagePool
+    {
+    public:
+        struct stats
+        {
+            uint64_t    numRequests   = 0;  // number of blocks requested
+            uint64_t    numHits       = 0;  // number of requests served from the pool
+            double      hitRate       = 0.; // numHits/numRequests
+            size_t      residentBytes = 0;  // bytes allocated by the pool (blocks in use and idle)
+            size_t      idleBytes     = 0;  // bytes in idle blocks, available for reuse
+        };
+
+        // owning handle to a block of pooled memory, returns the block to the pool on destruction
+        class block
+        {
+        public:
+            block() = default;
+            explicit block(size_t nBytes_);
+            block(block&& other_) noexcept : _ptr(std::exchange(other_._ptr, nullptr)), _sizeClass(other_._sizeClass) {}
+            block& operator=(block&& other_) noexcept
+            {
+                if (this != &other_)
+                {
+                    reset();
+                    _ptr       = std::exchange(other_._ptr, nullptr);
+                    _sizeClass = other_._sizeClass;
+                }
+                return *this;
+            }
+            block(const block&) = delete;
+            block& operator=(const block&) = delete;
+            ~block() { reset(); }
+
+            void* get() const { return _ptr; }
+            void reset();
+
+        private:
+            void*   _ptr       = nullptr;
+            size_t  _sizeClass = 0;
+        };
+
+        static stats getStats();
+        // maximum number of bytes kept in idle blocks, anything beyond is returned to the system allocator
+        static constexpr size_t maxIdleBytes = size_t{128} << 20;
+    };
+
     // My own almost POD class for Tobii eye images, for safe resource management
     // of the data heap array member
     class eyeImage
@@ -137,8 +281,7 @@ namespace TobiiTypes
             region_left(0),
             type(TOBII_RESEARCH_EYE_IMAGE_TYPE_UNKNOWN),
             camera_id(0),
-            data_size(0),
-            _eyeIm({nullptr,std::free})
+            data_size(0)
         {}
         eyeImage(const TobiiResearchEyeImage* e_) :
             is_gif(false),
@@ -154,7 +297,7 @@ namespace TobiiTypes
             type(e_->type),
             camera_id(e_->camera_id),
             data_size(e_->data_size),
-            _eyeIm({malloc(e_->data_size),std::free})
+            _eyeIm(e_->data_size)
         {
             std::memcpy(_eyeIm.get(), e_->data, e_->data_size);
         }
@@ -172,7 +315,7 @@ namespace TobiiTypes
             type(e_->type),
             camera_id(e_->camera_id),
             data_size(e_->image_size),
-            _eyeIm({malloc(e_->image_size),std::free})
+            _eyeIm(e_->image_size)
         {
             std::memcpy(_eyeIm.get(), e_->image_data, e_->image_size);
         }
@@ -191,7 +334,7 @@ namespace TobiiTypes
             type(other_.type),
             camera_id(other_.camera_id),
             data_size(other_.data_size),
-            _eyeIm({malloc(other_.data_size),std::free})
+            _eyeIm(other_.data_size)
         {
             std::memcpy(_eyeIm.get(), other_.data(), other_.data_size);
         }
@@ -209,7 +352,7 @@ namespace TobiiTypes
         {
             if (nBytes_)
             {
-                _eyeIm.reset(malloc(nBytes_));
+                _eyeIm = imagePool::block(nBytes_);
                 std::memcpy(_eyeIm.get(), data_, nBytes_);
                 data_size = nBytes_;
             }
@@ -250,7 +393,7 @@ namespace TobiiTypes
         int                         camera_id;
         size_t                      data_size;
     private:
-        std::unique_ptr<void, decltype(std::free)*> _eyeIm;
+        imagePool::block            _eyeIm;
     };
 
     // My own almost POD class for Tobii log messages, for safe resource management
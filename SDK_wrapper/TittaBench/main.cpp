@@ -0,0 +1,233 @@
+// Micro-benchmarks of Titta's sample processing paths, no eye tracker needed.
+// For each path, the throughput of the straightforward field-by-field implementation (reference) is shown
+// next to that of the batch conversions in Titta/convert.h.
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <functional>
+
+#include "Titta/Titta.h"
+#include "Titta/convert.h"
+
+
+void DoExitWithMsg(std::string errMsg_);
+
+namespace
+{
+    constexpr size_t                    nSamples    = 10000;
+    constexpr std::chrono::milliseconds minDuration{500};
+
+    // keeps the optimizer from removing the work being measured
+    volatile double sink = 0.;
+
+    // samples/s of calling fun_ (which processes nSamples samples) repeatedly for at least minDuration
+    double measure(const std::function<void()>& fun_)
+    {
+        fun_();     // warm up
+        size_t nRep = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration{};
+        do
+        {
+            fun_();
+            ++nRep;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while (elapsed < minDuration);
+        return static_cast<double>(nRep*nSamples) / std::chrono::duration<double>(elapsed).count();
+    }
+
+    void report(const std::string& path_, const double reference_, const double converter_)
+    {
+        std::cout << std::left << std::setw(32) << path_ << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << reference_/1e6 << " M samples/s"
+                  << std::setw(10) << converter_/1e6 << " M samples/s"
+                  << std::setw(8)  << converter_/reference_ << "x" << std::endl;
+    }
+
+    TobiiResearchEyeData makeEye(std::mt19937& rng_)
+    {
+        std::uniform_real_distribution<float> pos(0.f, 1.f);
+        const auto validity = [&]() { return rng_()%10 ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID; };
+        TobiiResearchEyeData e;
+        e.gaze_point.position_on_display_area           = {pos(rng_), pos(rng_)};
+        e.gaze_point.position_in_user_coordinates       = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_point.validity                           = validity();
+        e.pupil_data.diameter                           = pos(rng_)*4.f;
+        e.pupil_data.validity                           = validity();
+        e.gaze_origin.position_in_user_coordinates      = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_origin.position_in_track_box_coordinates = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_origin.validity                          = validity();
+        return e;
+    }
+
+    // reference implementations: field-by-field, as Titta did before the batch conversions
+    void referenceToEyeData(TobiiTypes::eyeData& out_, const TobiiResearchEyeData& in_)
+    {
+        out_.gaze_point.position_on_display_area            = in_.gaze_point.position_on_display_area;
+        out_.gaze_point.position_in_user_coordinates        = in_.gaze_point.position_in_user_coordinates;
+        out_.gaze_point.validity                            = in_.gaze_point.validity;
+        out_.gaze_point.available                           = true;
+        out_.pupil.diameter                                 = in_.pupil_data.diameter;
+        out_.pupil.validity                                 = in_.pupil_data.validity;
+        out_.pupil.available                                = true;
+        out_.gaze_origin.position_in_user_coordinates       = in_.gaze_origin.position_in_user_coordinates;
+        out_.gaze_origin.position_in_track_box_coordinates  = in_.gaze_origin.position_in_track_box_coordinates;
+        out_.gaze_origin.validity                           = in_.gaze_origin.validity;
+        out_.gaze_origin.available                          = true;
+    }
+    void referenceEyeToRow(double* out_, const TobiiTypes::eyeData& e_)
+    {
+        const double row[21] = {
+            e_.gaze_point.position_on_display_area.x, e_.gaze_point.position_on_display_area.y,
+            e_.gaze_point.position_in_user_coordinates.x, e_.gaze_point.position_in_user_coordinates.y, e_.gaze_point.position_in_user_coordinates.z,
+            static_cast<double>(e_.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID), static_cast<double>(e_.gaze_point.available),
+            e_.pupil.diameter,
+            static_cast<double>(e_.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID), static_cast<double>(e_.pupil.available),
+            e_.gaze_origin.position_in_user_coordinates.x, e_.gaze_origin.position_in_user_coordinates.y, e_.gaze_origin.position_in_user_coordinates.z,
+            e_.gaze_origin.position_in_track_box_coordinates.x, e_.gaze_origin.position_in_track_box_coordinates.y, e_.gaze_origin.position_in_track_box_coordinates.z,
+            static_cast<double>(e_.gaze_origin.validity == TOBII_RESEARCH_VALIDITY_VALID), static_cast<double>(e_.gaze_origin.available),
+            e_.eye_openness.diameter,
+            static_cast<double>(e_.eye_openness.validity == TOBII_RESEARCH_VALIDITY_VALID), static_cast<double>(e_.eye_openness.available)
+        };
+        std::copy(std::begin(row), std::end(row), out_);
+    }
+    void referenceInterleave(double* out_, const float* const* columns_, const size_t nColumns_, const size_t n_)
+    {
+        for (size_t c = 0; c < nColumns_; c++)
+            for (size_t i = 0; i < n_; i++)
+                out_[i*nColumns_ + c] = static_cast<double>(columns_[c][i]);
+    }
+}
+
+int main()
+{
+    try
+    {
+        std::mt19937 rng(1);
+        std::vector<TobiiResearchGazeData> tobiiSamples(nSamples);
+        for (size_t i = 0; i < nSamples; i++)
+        {
+            tobiiSamples[i].left_eye            = makeEye(rng);
+            tobiiSamples[i].right_eye           = makeEye(rng);
+            tobiiSamples[i].device_time_stamp   = static_cast<int64_t>(i)*833;
+            tobiiSamples[i].system_time_stamp   = static_cast<int64_t>(i)*833+1000;
+        }
+        std::vector<Titta::gaze> samples(nSamples);
+        Titta::buffer_t<Titta::gaze> buffer;
+        for (size_t i = 0; i < nSamples; i++)
+        {
+            TittaConvert::toEyeData(samples[i].left_eye , tobiiSamples[i].left_eye);
+            TittaConvert::toEyeData(samples[i].right_eye, tobiiSamples[i].right_eye);
+            samples[i].device_time_stamp = tobiiSamples[i].device_time_stamp;
+            samples[i].system_time_stamp = tobiiSamples[i].system_time_stamp;
+            buffer.push_back(samples[i]);
+        }
+
+        std::cout << "TittaConvert instruction set: " << TittaConvert::getInstructionSet() << ", " << nSamples << " samples per batch" << std::endl;
+        std::cout << std::left << std::setw(32) << "path" << std::right << std::setw(22) << "reference" << std::setw(22) << "TittaConvert" << std::setw(9) << "speedup" << std::endl;
+
+        // 1. Tobii SDK sample -> Titta::gaze (receiveSample)
+        {
+            std::vector<Titta::gaze> out(nSamples);
+            const auto ref = measure([&]()
+            {
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    referenceToEyeData(out[i].left_eye , tobiiSamples[i].left_eye);
+                    referenceToEyeData(out[i].right_eye, tobiiSamples[i].right_eye);
+                }
+                sink = sink + out[nSamples-1].right_eye.pupil.diameter;
+            });
+            const auto cvt = measure([&]()
+            {
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    TittaConvert::toEyeData(out[i].left_eye , tobiiSamples[i].left_eye);
+                    TittaConvert::toEyeData(out[i].right_eye, tobiiSamples[i].right_eye);
+                }
+                sink = sink + out[nSamples-1].right_eye.pupil.diameter;
+            });
+            report("tobii -> gaze", ref, cvt);
+        }
+
+        // 2. buffer -> columns (consumeN/peekN to MATLAB and Python)
+        {
+            const auto ref = measure([&]()
+            {
+                const TobiiTypes::gazeColumns c(buffer.cbegin(), buffer.cend());
+                sink = sink + c.right_eye.pupil_diameter.back();
+            });
+            const auto cvt = measure([&]()
+            {
+                const auto c = TittaConvert::toColumns(buffer.cbegin(), buffer.cend());
+                sink = sink + c.right_eye.pupil_diameter.back();
+            });
+            report("buffer -> columns", ref, cvt);
+        }
+
+        // 3. columns -> MATLAB matrix
+        {
+            const auto c = TittaConvert::toColumns(buffer.cbegin(), buffer.cend());
+            const float* cols[3] = {c.left_eye.gaze_point_in_user_coordinates_x.data(), c.left_eye.gaze_point_in_user_coordinates_y.data(), c.left_eye.gaze_point_in_user_coordinates_z.data()};
+            std::vector<double> out(3*nSamples);
+            for (size_t nCols = 1; nCols <= 3; nCols++)
+            {
+                const auto ref = measure([&]()
+                {
+                    referenceInterleave(out.data(), cols, nCols, nSamples);
+                    sink = sink + out.back();
+                });
+                const auto cvt = measure([&]()
+                {
+                    TittaConvert::interleave(out.data(), cols, nCols, nSamples);
+                    sink = sink + out.back();
+                });
+                report("columns -> matrix (" + std::to_string(nCols) + " rows)", ref, cvt);
+            }
+        }
+
+        // 4. Titta::gaze -> LSL row
+        {
+            std::vector<double> out(TittaConvert::rowSize*nSamples);
+            const auto ref = measure([&]()
+            {
+                for (size_t i = 0; i < nSamples; i++)
+                {
+                    auto row = out.data() + i*TittaConvert::rowSize;
+                    referenceEyeToRow(row     , samples[i].left_eye);
+                    referenceEyeToRow(row + 21, samples[i].right_eye);
+                    row[42] = static_cast<double>(samples[i].device_time_stamp) / 1'000'000.;
+                }
+                sink = sink + out.back();
+            });
+            const auto cvt = measure([&]()
+            {
+                TittaConvert::toRows(out.data(), samples.data(), nSamples);
+                sink = sink + out.back();
+            });
+            report("gaze -> LSL rows", ref, cvt);
+        }
+    }
+    catch (const std::string& e)
+    {
+        DoExitWithMsg(e);
+    }
+    catch (const char* e)
+    {
+        DoExitWithMsg(e);
+    }
+    catch (...)
+    {
+        DoExitWithMsg("Some exception occurred");
+    }
+
+    return 0;
+}
+
+void DoExitWithMsg(std::string errMsg_)
+{
+    std::cout << "Error: " << errMsg_ << std::endl;
+}
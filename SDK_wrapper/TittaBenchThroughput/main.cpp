@@ -0,0 +1,475 @@
+// Throughput benchmarks of the Titta core, no eye tracker needed: samples are driven through Titta's SDK
+// callbacks by replaying a synthetic recording as fast as possible (see TittaSimulator). Measured are:
+// 1. ingest: callback cost per sample and memory growth, for one or more Titta instances at the same time;
+// 2. read latency: consumeN, peekN and peekTimeRange for buffers of increasing size;
+// 3. contention: ingest rate and read latency with threads concurrently polling the buffer.
+// The results are written as JSON (to stdout, or to the file given with --out), so that they can be tracked
+// over time. Progress is shown on stderr.
+//
+// usage: TittaBenchThroughput [--instances 1,2,4] [--samples 250000] [--duration 1] [--readers 0,1,2,4]
+//                             [--buffer-sizes 1000,10000,100000,1000000] [--out file]
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <random>
+#include <algorithm>
+#include <functional>
+#include <filesystem>
+#include <memory>
+#include <limits>
+#include <cmath>
+#include <cstdlib>
+
+#ifdef _WIN32
+#   define NOMINMAX
+#   include <windows.h>
+#   include <psapi.h>
+#elif defined(__APPLE__)
+#   include <mach/mach.h>
+#elif defined(__linux__)
+#   include <unistd.h>
+#endif
+
+#include "Titta/Titta.h"
+#include "Titta/session.h"
+#include "Titta/convert.h"
+
+
+void DoExitWithMsg(std::string errMsg_);
+
+namespace
+{
+    using clock = std::chrono::steady_clock;
+
+    // keeps the optimizer from removing the work being measured
+    volatile size_t sink = 0;
+
+    struct config
+    {
+        std::vector<size_t> instances       = {1, 2, 4};
+        size_t              samples         = 250'000;  // per instance, for the ingest benchmark
+        double              duration        = 1.;       // s, of each contention run
+        std::vector<size_t> readers         = {0, 1, 2, 4};
+        std::vector<size_t> bufferSizes     = {1'000, 10'000, 100'000, 1'000'000};
+        std::string         outFile;
+    };
+
+    std::vector<size_t> parseList(const std::string& str_)
+    {
+        std::vector<size_t> out;
+        std::stringstream ss(str_);
+        std::string item;
+        while (std::getline(ss, item, ','))
+            out.push_back(std::stoull(item));
+        return out;
+    }
+
+    config parseArgs(const int argc_, char** argv_)
+    {
+        config cfg;
+        for (int i = 1; i < argc_; i++)
+        {
+            const std::string arg = argv_[i];
+            if (i + 1 == argc_)
+                throw "missing value for argument " + arg;
+            const std::string val = argv_[++i];
+            if (arg == "--instances")
+                cfg.instances = parseList(val);
+            else if (arg == "--samples")
+                cfg.samples = std::stoull(val);
+            else if (arg == "--duration")
+                cfg.duration = std::stod(val);
+            else if (arg == "--readers")
+                cfg.readers = parseList(val);
+            else if (arg == "--buffer-sizes")
+                cfg.bufferSizes = parseList(val);
+            else if (arg == "--out")
+                cfg.outFile = val;
+            else
+                throw "unknown argument " + arg + ", possible arguments are --instances, --samples, --duration, --readers, --buffer-sizes and --out";
+        }
+        return cfg;
+    }
+
+    // resident memory of this process, in bytes (0 if not available)
+    size_t residentMemory()
+    {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters;
+        if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return counters.WorkingSetSize;
+#elif defined(__APPLE__)
+        mach_task_basic_info info;
+        mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+        if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info), &count) == KERN_SUCCESS)
+            return info.resident_size;
+#elif defined(__linux__)
+        std::ifstream statm("/proc/self/statm");
+        size_t size = 0, resident = 0;
+        if (statm >> size >> resident)
+            return resident * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        return 0;
+    }
+
+    // minimal JSON writer: objects and arrays are opened and closed explicitly, commas are inserted as needed
+    class json
+    {
+    public:
+        json& beginObject(const std::string& key_ = {}) { prefix(key_); _out << '{'; _first = true; return *this; }
+        json& endObject()                               { _out << '}'; _first = false; return *this; }
+        json& beginArray(const std::string& key_)       { prefix(key_); _out << '['; _first = true; return *this; }
+        json& endArray()                                { _out << ']'; _first = false; return *this; }
+        json& value(const std::string& key_, const std::string& val_)   { prefix(key_); writeString(val_); return *this; }
+        json& value(const std::string& key_, const char* val_)          { return value(key_, std::string(val_)); }
+        json& value(const std::string& key_, const size_t val_)         { prefix(key_); _out << val_; return *this; }
+        json& value(const std::string& key_, const double val_)
+        {
+            prefix(key_);
+            if (std::isfinite(val_))
+                _out << std::setprecision(6) << val_;
+            else
+                _out << "null";
+            return *this;
+        }
+        std::string str() const { return _out.str(); }
+
+    private:
+        void prefix(const std::string& key_)
+        {
+            if (!_first)
+                _out << ',';
+            _first = false;
+            if (!key_.empty())
+            {
+                writeString(key_);
+                _out << ':';
+            }
+        }
+        void writeString(const std::string& str_)
+        {
+            _out << '"';
+            for (const auto c : str_)
+            {
+                if (c == '"' || c == '\\')
+                    _out << '\\';
+                _out << c;
+            }
+            _out << '"';
+        }
+
+        std::ostringstream  _out;
+        bool                _first = true;
+    };
+
+    // distribution of call durations, in microseconds
+    struct latencyStats
+    {
+        size_t  numCalls = 0;
+        double  mean = 0., median = 0., p99 = 0., max = 0.;
+    };
+    latencyStats summarize(std::vector<double> durations_)
+    {
+        latencyStats out;
+        out.numCalls = durations_.size();
+        if (durations_.empty())
+            return out;
+        std::ranges::sort(durations_);
+        for (const auto d : durations_)
+            out.mean += d;
+        out.mean   /= static_cast<double>(durations_.size());
+        out.median  = durations_[durations_.size()/2];
+        out.p99     = durations_[std::min(durations_.size()-1, durations_.size()*99/100)];
+        out.max     = durations_.back();
+        return out;
+    }
+    void write(json& j_, const std::string& key_, const latencyStats& stats_)
+    {
+        j_.beginObject(key_)
+            .value("num_calls", stats_.numCalls)
+            .value("mean_us", stats_.mean)
+            .value("median_us", stats_.median)
+            .value("p99_us", stats_.p99)
+            .value("max_us", stats_.max)
+          .endObject();
+    }
+
+    // call fun_ repeatedly, at least minCalls_ times and for at least minDuration_ (but at most maxCalls_ times)
+    latencyStats measureCalls(const std::function<void()>& fun_, const size_t minCalls_ = 100, const size_t maxCalls_ = 100'000, const std::chrono::milliseconds minDuration_ = std::chrono::milliseconds{200})
+    {
+        std::vector<double> durations;
+        const auto start = clock::now();
+        while (durations.size() < maxCalls_ && (durations.size() < minCalls_ || clock::now() - start < minDuration_))
+        {
+            const auto t0 = clock::now();
+            fun_();
+            durations.push_back(std::chrono::duration<double, std::micro>(clock::now() - t0).count());
+        }
+        return summarize(std::move(durations));
+    }
+
+    TobiiResearchEyeData makeEye(std::mt19937& rng_)
+    {
+        std::uniform_real_distribution<float> pos(0.f, 1.f);
+        const auto validity = [&]() { return rng_()%10 ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID; };
+        TobiiResearchEyeData e;
+        e.gaze_point.position_on_display_area           = {pos(rng_), pos(rng_)};
+        e.gaze_point.position_in_user_coordinates       = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_point.validity                           = validity();
+        e.pupil_data.diameter                           = pos(rng_)*4.f;
+        e.pupil_data.validity                           = validity();
+        e.gaze_origin.position_in_user_coordinates      = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_origin.position_in_track_box_coordinates = {pos(rng_), pos(rng_), pos(rng_)};
+        e.gaze_origin.validity                          = validity();
+        return e;
+    }
+
+    // 10 s of synthetic 600 Hz gaze data, replayed in a loop to drive the callbacks
+    void writeRecording(const std::string& filePath_)
+    {
+        constexpr size_t nSamples = 6000;
+        std::mt19937 rng(1);
+        std::vector<Titta::gaze> samples(nSamples);
+        for (size_t i = 0; i < nSamples; i++)
+        {
+            TittaConvert::toEyeData(samples[i].left_eye , makeEye(rng));
+            TittaConvert::toEyeData(samples[i].right_eye, makeEye(rng));
+            samples[i].device_time_stamp = static_cast<int64_t>(i)*1667;
+            samples[i].system_time_stamp = static_cast<int64_t>(i)*1667+1000;
+        }
+        TittaSession::writer writer(filePath_);
+        writer.writeStream(samples);
+        writer.finish();
+    }
+
+    uint64_t numGazeCallbacks(const Titta& instance_)
+    {
+        return instance_.getCallbackTimingStats(Titta::Stream::Gaze).numCallbacks;
+    }
+    void waitForGazeCallbacks(const Titta& instance_, const uint64_t n_)
+    {
+        while (numGazeCallbacks(instance_) < n_)
+            std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+
+    // 1. callback cost per sample and memory growth, for n_ instances ingesting at the same time
+    void benchIngest(json& j_, const std::string& address_, const size_t n_, const size_t samples_)
+    {
+        std::vector<std::unique_ptr<Titta>> instances;
+        for (size_t i = 0; i < n_; i++)
+            instances.push_back(std::make_unique<Titta>(address_));
+        const auto memBefore = residentMemory();
+
+        const auto start = clock::now();
+        for (const auto& t : instances)
+            t->start(Titta::Stream::Gaze);
+        for (const auto& t : instances)
+            waitForGazeCallbacks(*t, samples_);
+        const auto elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        for (const auto& t : instances)
+            t->stop(Titta::Stream::Gaze);
+        const auto memAfter = residentMemory();
+
+        uint64_t numSamples = 0;
+        double meanCallback = 0., maxCallback = 0.;
+        for (const auto& t : instances)
+        {
+            const auto stats = t->getCallbackTimingStats(Titta::Stream::Gaze);
+            numSamples   += stats.numCallbacks;
+            meanCallback += stats.meanDuration * static_cast<double>(stats.numCallbacks);
+            maxCallback   = std::max(maxCallback, stats.maxDuration);
+        }
+        meanCallback /= static_cast<double>(numSamples);
+        const auto memGrowth = memAfter > memBefore ? memAfter - memBefore : 0;
+
+        j_.beginObject()
+            .value("instances", n_)
+            .value("samples", static_cast<size_t>(numSamples))
+            .value("elapsed_s", elapsed)
+            .value("samples_per_s", static_cast<double>(numSamples) / elapsed)
+            .value("callback_mean_us", meanCallback)
+            .value("callback_max_us", maxCallback)
+            .value("memory_growth_bytes", memGrowth)
+            .value("memory_per_sample_bytes", memBefore ? static_cast<double>(memGrowth) / static_cast<double>(numSamples) : std::nan(""))
+          .endObject();
+        std::cerr << "ingest, " << n_ << " instance(s): " << std::fixed << std::setprecision(2) << static_cast<double>(numSamples) / elapsed / 1e6
+                  << " M samples/s, callback " << std::setprecision(3) << meanCallback << " us (max " << maxCallback << " us), "
+                  << std::setprecision(1) << static_cast<double>(memGrowth) / static_cast<double>(numSamples) << " bytes/sample" << std::endl;
+    }
+
+    // 2. latency of reading from a buffer of the given size
+    void benchReadLatency(json& j_, const std::string& address_, const size_t size_)
+    {
+        Titta t(address_);
+        t.start(Titta::Stream::Gaze);
+        waitForGazeCallbacks(t, size_);
+        t.stop(Titta::Stream::Gaze);
+        // more samples than requested may have arrived, remove the surplus. There may also be fewer, e.g. if
+        // the buffer dropped samples
+        const auto buffered = t.peekNLease<Titta::gaze>(std::numeric_limits<size_t>::max()).size();
+        if (buffered > size_)
+            t.consumeN<Titta::gaze>(buffered - size_, Titta::BufferSide::Start);
+        size_t size = 0;
+        int64_t midStart = 0, midEnd = 0;
+        {
+            const auto all = t.peekNLease<Titta::gaze>(std::numeric_limits<size_t>::max(), Titta::BufferSide::Start);
+            size     = all.size();
+            if (size)
+            {
+                midStart = all[size/2].system_time_stamp;
+                midEnd   = all[std::min(size/2 + 99, size-1)].system_time_stamp;
+            }
+        }
+
+        const auto peekLast     = measureCalls([&]() { sink = t.peekN<Titta::gaze>(100).size(); });
+        const auto peekAll      = measureCalls([&]() { sink = t.peekN<Titta::gaze>(size, Titta::BufferSide::Start).size(); }, 10, 1000);
+        const auto peekRange    = measureCalls([&]() { sink = t.peekTimeRange<Titta::gaze>(midStart, midEnd).size(); });
+        // consuming shrinks the buffer, stop once a tenth of it has been consumed
+        const auto consumeFirst = measureCalls([&]() { sink = t.consumeN<Titta::gaze>(100, Titta::BufferSide::Start).size(); }, 1, std::max(size_t{1}, size/1000));
+        const auto remaining    = t.peekNLease<Titta::gaze>(std::numeric_limits<size_t>::max()).size();     // lease is released right away
+        const auto consumeAll   = measureCalls([&]() { sink = t.consumeN<Titta::gaze>().size(); }, 1, 1);
+
+        j_.beginObject()
+            .value("buffer_size", size);
+        write(j_, "peekN_last_100", peekLast);
+        write(j_, "peekN_all", peekAll);
+        write(j_, "peekTimeRange_100", peekRange);
+        write(j_, "consumeN_first_100", consumeFirst);
+        j_.value("consumeN_all_size", remaining);
+        write(j_, "consumeN_all", consumeAll);
+        j_.endObject();
+        std::cerr << "read latency, " << size << " samples: peekN(100) " << std::fixed << std::setprecision(2) << peekLast.median
+                  << " us, peekN(all) " << peekAll.median << " us, peekTimeRange(100) " << peekRange.median
+                  << " us, consumeN(100) " << consumeFirst.median << " us, consumeN(all) " << consumeAll.median << " us" << std::endl;
+    }
+
+    // 3. ingest while nReaders_ threads poll the last samples in the buffer, as a MATLAB or Python loop would
+    void benchContention(json& j_, const std::string& address_, const size_t nReaders_, const double duration_)
+    {
+        Titta t(address_);
+        // bounded buffer, so that memory does not run out when ingesting for a long time
+        t.start(Titta::Stream::Gaze, std::nullopt, std::nullopt, 100'000, Titta::OverflowPolicy::DropOldest);
+        waitForGazeCallbacks(t, 100'000);
+
+        std::atomic<bool> stop = false;
+        std::vector<std::vector<double>> durations(nReaders_);
+        std::vector<std::thread> readers;
+        const auto startCallbacks = numGazeCallbacks(t);
+        const auto start = clock::now();
+        for (size_t r = 0; r < nReaders_; r++)
+            readers.emplace_back([&, r]()
+            {
+                while (!stop)
+                {
+                    const auto t0 = clock::now();
+                    sink = t.peekN<Titta::gaze>(100).size();
+                    durations[r].push_back(std::chrono::duration<double, std::micro>(clock::now() - t0).count());
+                }
+            });
+        std::this_thread::sleep_for(std::chrono::duration<double>(duration_));
+        stop = true;
+        for (auto& r : readers)
+            r.join();
+        const auto elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        const auto numSamples = numGazeCallbacks(t) - startCallbacks;
+        const auto callbackStats = t.getCallbackTimingStats(Titta::Stream::Gaze);
+        t.stop(Titta::Stream::Gaze);
+
+        std::vector<double> allDurations;
+        for (const auto& d : durations)
+            allDurations.insert(allDurations.end(), d.begin(), d.end());
+        const auto readStats = summarize(std::move(allDurations));
+
+        j_.beginObject()
+            .value("readers", nReaders_)
+            .value("elapsed_s", elapsed)
+            .value("samples_per_s", static_cast<double>(numSamples) / elapsed)
+            .value("callback_mean_us", callbackStats.meanDuration)
+            .value("callback_max_us", callbackStats.maxDuration)
+            .value("reads_per_s", static_cast<double>(readStats.numCalls) / elapsed);
+        write(j_, "peekN_last_100", readStats);
+        j_.endObject();
+        std::cerr << "contention, " << nReaders_ << " reader(s): " << std::fixed << std::setprecision(2) << static_cast<double>(numSamples) / elapsed / 1e6
+                  << " M samples/s, callback max " << callbackStats.maxDuration << " us";
+        if (nReaders_)
+            std::cerr << ", peekN(100) " << readStats.median << " us (p99 " << readStats.p99 << " us, max " << readStats.max << " us)";
+        std::cerr << std::endl;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try
+    {
+        const auto cfg = parseArgs(argc, argv);
+
+        const auto recording = (std::filesystem::temp_directory_path() / "TittaBenchThroughput.session").string();
+        writeRecording(recording);
+        const auto address = std::string(TittaSimulator::replayAddressPrefix) + recording + "?speed=0&delay=0&loop=1";
+
+        json j;
+        j.beginObject()
+            .beginObject("system")
+                .value("instruction_set", TittaConvert::getInstructionSet())
+                .value("hardware_threads", static_cast<size_t>(std::thread::hardware_concurrency()))
+            .endObject()
+            .beginObject("config")
+                .value("samples", cfg.samples)
+                .value("duration_s", cfg.duration)
+            .endObject();
+
+        j.beginArray("ingest");
+        for (const auto n : cfg.instances)
+            benchIngest(j, address, n, cfg.samples);
+        j.endArray();
+
+        j.beginArray("read_latency");
+        for (const auto s : cfg.bufferSizes)
+            benchReadLatency(j, address, s);
+        j.endArray();
+
+        j.beginArray("contention");
+        for (const auto r : cfg.readers)
+            benchContention(j, address, r, cfg.duration);
+        j.endArray();
+        j.endObject();
+
+        std::filesystem::remove(recording);
+
+        if (cfg.outFile.empty())
+            std::cout << j.str() << std::endl;
+        else
+            std::ofstream(cfg.outFile) << j.str() << std::endl;
+    }
+    catch (const std::string& e)
+    {
+        DoExitWithMsg(e);
+    }
+    catch (const char* e)
+    {
+        DoExitWithMsg(e);
+    }
+    catch (const std::exception& e)
+    {
+        DoExitWithMsg(e.what());
+    }
+    catch (...)
+    {
+        DoExitWithMsg("Some exception occurred");
+    }
+
+    return 0;
+}
+
+void DoExitWithMsg(std::string errMsg_)
+{
+    // incomplete results are of no use, stop
+    std::cerr << "Error: " << errMsg_ << std::endl;
+    std::exit(EXIT_FAILURE);
+}
@@ -155,6 +155,54 @@ classdef TittaMex < handle
         function stopLogging(this)
             this.cppmethodGlobal('stopLogging');
         end
+        % eye image memory pool
+        function stats = getEyeImagePoolStats(this)
+            stats = this.cppmethodGlobal('getEyeImagePoolStats');
+        end
+        % tracing
+        function startTracing(this,eventsPerThread)
+            % optional number of events to allocate memory for per thread
+            if nargin>1 && ~isempty(eventsPerThread)
+                this.cppmethodGlobal('startTracing',uint64(eventsPerThread));
+            else
+                this.cppmethodGlobal('startTracing');
+            end
+        end
+        function stopTracing(this)
+            this.cppmethodGlobal('stopTracing');
+        end
+        function writeTrace(this,filePath)
+            this.cppmethodGlobal('writeTrace',ensureStringIsChar(filePath));
+        end
+        % journal
+        function data = readJournal(this,filePath)
+            % read a journal file written by startJournal. Also works for
+            % journals that were not properly closed (e.g. because of a
+            % crash). Field complete is false if a damaged last chunk of
+            % the file was skipped
+            data = this.cppmethodGlobal('readJournal',ensureStringIsChar(filePath));
+        end
+        % session files
+        function convertJournalToSession(this,journalFilePath,sessionFilePath)
+            this.cppmethodGlobal('convertJournalToSession',ensureStringIsChar(journalFilePath),ensureStringIsChar(sessionFilePath));
+        end
+        function data = readSessionTimeRange(this,filePath,stream,startT,endT)
+            % read data of the indicated stream within a time range from a
+            % session file, without loading the whole file.
+            % optional inputs startT and endT. Default: whole file
+            if nargin<3
+                error('TittaMex::readSessionTimeRange: provide file path and stream arguments. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            filePath = ensureStringIsChar(filePath);
+            stream   = ensureStringIsChar(stream);
+            if nargin>4 && ~isempty(endT)
+                data = this.cppmethodGlobal('readSessionTimeRange',filePath,stream,int64(startT),int64(endT));
+            elseif nargin>3 && ~isempty(startT)
+                data = this.cppmethodGlobal('readSessionTimeRange',filePath,stream,int64(startT));
+            else
+                data = this.cppmethodGlobal('readSessionTimeRange',filePath,stream);
+            end
+        end
         % stream info
         function streams = getAllStreamsString(this,quoteChar,snakeCase)
             if nargin>2
@@ -172,6 +220,13 @@ classdef TittaMex < handle
                 bufferSides = this.cppmethodGlobal('getAllBufferSidesString');
             end
         end
+        function overflowPolicies = getAllOverflowPoliciesString(this,quoteChar)
+            if nargin>1
+                overflowPolicies = this.cppmethodGlobal('getAllOverflowPoliciesString',ensureStringIsChar(quoteChar));
+            else
+                overflowPolicies = this.cppmethodGlobal('getAllOverflowPoliciesString');
+            end
+        end
         
         %% eye-tracker specific getters and setters
         % getters
@@ -349,21 +404,64 @@ classdef TittaMex < handle
         function prevEyeOpennessState = setIncludeEyeOpennessInGaze(this,include)
             prevEyeOpennessState = this.cppmethod('setIncludeEyeOpennessInGaze',include);
         end
-        function success = start(this,stream,initialBufferSize,asGif,blockUntilStarted)
-            % optional buffer size input, and optional input to request
-            % gif-encoded instead of raw images
+        function prevMaxWait = setGazeMergeMaxWait(this,maxWait)
+            % maxWait in microseconds
+            prevMaxWait = this.cppmethod('setGazeMergeMaxWait',int64(maxWait));
+        end
+        function maxWait = getGazeMergeMaxWait(this)
+            maxWait = this.cppmethod('getGazeMergeMaxWait');
+        end
+        function prevUseIngestQueueState = setUseIngestQueue(this,useQueue)
+            prevUseIngestQueueState = this.cppmethod('setUseIngestQueue',logical(useQueue));
+        end
+        function useIngestQueue = getUseIngestQueue(this)
+            useIngestQueue = this.cppmethod('getUseIngestQueue');
+        end
+        function stats = getCallbackTimingStats(this,stream)
+            if nargin<2
+                error('TittaMex::getCallbackTimingStats: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            stats = this.cppmethod('getCallbackTimingStats',ensureStringIsChar(stream));
+        end
+        function stats = getLatencyStats(this,stream)
+            if nargin<2
+                error('TittaMex::getLatencyStats: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            stats = this.cppmethod('getLatencyStats',ensureStringIsChar(stream));
+        end
+        function counters = getCounters(this)
+            counters = this.cppmethod('getCounters');
+        end
+        function stats = getReplayStats(this)
+            % only available when connected to a replay of a recording
+            % (address starting with replay://)
+            stats = this.cppmethod('getReplayStats');
+        end
+        function success = start(this,stream,initialBufferSize,asGif,blockUntilStarted,capacity,overflowPolicy)
+            % optional buffer size input, optional input to request
+            % gif-encoded instead of raw images, and optional inputs to
+            % bound the buffer to a maximum number of samples (capacity)
+            % and indicate what to do when it is full (overflowPolicy:
+            % 'dropOldest' or 'dropNewest')
             if nargin<2
                 error('TittaMex::start: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
             end
             stream = ensureStringIsChar(stream);
             t0 = this.systemTimestamp;
+            args = {[],[],[],[]};
+            if nargin>2 && ~isempty(initialBufferSize)
+                args{1} = uint64(initialBufferSize);
+            end
             if nargin>3 && ~isempty(asGif)
-                success = this.cppmethod('start',stream,uint64(initialBufferSize),logical(asGif));
-            elseif nargin>2 && ~isempty(initialBufferSize)
-                success = this.cppmethod('start',stream,uint64(initialBufferSize));
-            else
-                success = this.cppmethod('start',stream);
+                args{2} = logical(asGif);
+            end
+            if nargin>5 && ~isempty(capacity)
+                args{3} = uint64(capacity);
             end
+            if nargin>6 && ~isempty(overflowPolicy)
+                args{4} = ensureStringIsChar(overflowPolicy);
+            end
+            success = this.cppmethod('start',stream,args{:});
             if success && nargin>4 && ~isempty(blockUntilStarted) && blockUntilStarted
                 if ismember('gaze',{'gaze','eyeOpenness','eye_openness'})   % Only supported for gaze data streams
                     while true
@@ -447,6 +545,56 @@ classdef TittaMex < handle
                 data = this.cppmethod('peekTimeRange',stream);
             end
         end
+        function data = getLatest(this,stream)
+            % get most recent sample without touching the buffer. Cheap
+            % enough to call every frame
+            if nargin<2
+                error('TittaMex::getLatest: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            data = this.cppmethod('getLatest',ensureStringIsChar(stream));
+        end
+        function cursor = openCursor(this,stream,side,reclaim)
+            % open a cursor for reading the stream incrementally using
+            % readSince. Any number of cursors can be open on a stream.
+            % optional input arguments:
+            % -    side: Which side of buffer the cursor starts at.
+            %            Values: 'start' or 'end'
+            %            Default: 'start'
+            % - reclaim: If true for all cursors open on a stream, samples
+            %            that all cursors have passed are removed from the
+            %            buffer. Default: false
+            if nargin<2
+                error('TittaMex::openCursor: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            stream = ensureStringIsChar(stream);
+            if nargin>3 && ~isempty(reclaim)
+                cursor = this.cppmethod('openCursor',stream,ensureStringIsChar(side),logical(reclaim));
+            elseif nargin>2 && ~isempty(side)
+                cursor = this.cppmethod('openCursor',stream,ensureStringIsChar(side));
+            else
+                cursor = this.cppmethod('openCursor',stream);
+            end
+        end
+        function data = readSince(this,cursor,NSamp)
+            % get samples that the cursor has not yet passed, and advance
+            % the cursor past them. Samples are not removed from the buffer.
+            % optional input arguments:
+            % - NSamp: maximum number of samples to read. Default: all
+            if nargin<2
+                error('TittaMex::readSince: provide cursor argument.');
+            end
+            if nargin>2 && ~isempty(NSamp)
+                data = this.cppmethod('readSince',uint64(cursor),uint64(NSamp));
+            else
+                data = this.cppmethod('readSince',uint64(cursor));
+            end
+        end
+        function success = closeCursor(this,cursor)
+            if nargin<2
+                error('TittaMex::closeCursor: provide cursor argument.');
+            end
+            success = this.cppmethod('closeCursor',uint64(cursor));
+        end
         function clear(this,stream)
             if nargin<2
                 error('TittaMex::clear: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
@@ -480,6 +628,86 @@ classdef TittaMex < handle
                 success = this.cppmethod('stop',stream);
             end
         end
+        function nDropped = getNumDroppedSamples(this,stream)
+            if nargin<2
+                error('TittaMex::getNumDroppedSamples: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            nDropped = this.cppmethod('getNumDroppedSamples',ensureStringIsChar(stream));
+        end
+        function startJournal(this,filePath,inMemoryWindow)
+            % continuously write all recorded samples to the indicated file
+            % from a background thread.
+            % optional input argument:
+            % - inMemoryWindow: number of samples per stream to keep in
+            %                   memory once they have been written to the
+            %                   file. Default: all. Samples that an open
+            %                   cursor has not yet read are kept
+            % if writing the file fails, journaling stops and the error is
+            % raised by the next call to isJournaling or stopJournal.
+            if nargin<2
+                error('TittaMex::startJournal: provide file path argument.');
+            end
+            if nargin>2 && ~isempty(inMemoryWindow)
+                this.cppmethod('startJournal',ensureStringIsChar(filePath),uint64(inMemoryWindow));
+            else
+                this.cppmethod('startJournal',ensureStringIsChar(filePath));
+            end
+        end
+        function success = stopJournal(this)
+            success = this.cppmethod('stopJournal');
+        end
+        function journaling = isJournaling(this)
+            journaling = this.cppmethod('isJournaling');
+        end
+        function saveSession(this,filePath)
+            % write the current contents of all buffers to a session file
+            if nargin<2
+                error('TittaMex::saveSession: provide file path argument.');
+            end
+            this.cppmethod('saveSession',ensureStringIsChar(filePath));
+        end
+        function saveParquet(this,filePathBase,rowGroupSize)
+            % write the current contents of all buffers to Apache Parquet
+            % files, one per stream, named <filePathBase>_<stream>.parq.
+            % Columns are the same as those written by
+            % Titta.saveDataToParquet.
+            % optional input argument:
+            % - rowGroupSize: maximum number of samples per row group.
+            %                 Default: 65536
+            if nargin<2
+                error('TittaMex::saveParquet: provide file path base argument.');
+            end
+            if nargin>2 && ~isempty(rowGroupSize)
+                this.cppmethod('saveParquet',ensureStringIsChar(filePathBase),uint64(rowGroupSize));
+            else
+                this.cppmethod('saveParquet',ensureStringIsChar(filePathBase));
+            end
+        end
+        function startParquet(this,filePathBase,rowGroupSize)
+            % start incremental export to Apache Parquet files (see
+            % saveParquet). Each call to flushParquet appends the samples
+            % recorded since the previous call to the files.
+            % optional input argument:
+            % - rowGroupSize: maximum number of samples per row group.
+            %                 Default: 65536
+            if nargin<2
+                error('TittaMex::startParquet: provide file path base argument.');
+            end
+            if nargin>2 && ~isempty(rowGroupSize)
+                this.cppmethod('startParquet',ensureStringIsChar(filePathBase),uint64(rowGroupSize));
+            else
+                this.cppmethod('startParquet',ensureStringIsChar(filePathBase));
+            end
+        end
+        function flushParquet(this)
+            this.cppmethod('flushParquet');
+        end
+        function success = stopParquet(this)
+            success = this.cppmethod('stopParquet');
+        end
+        function writing = isWritingParquet(this)
+            writing = this.cppmethod('isWritingParquet');
+        end
     end
 end
 
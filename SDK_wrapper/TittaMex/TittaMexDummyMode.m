@@ -14,6 +14,7 @@ classdef TittaMexDummyMode < TittaMex
     properties (Access = protected, Hidden = true)
         isRecordingGaze = false;
         isInCalMode     = false;
+        cursorStreams   = {};
     end
 
     methods
@@ -54,7 +55,7 @@ classdef TittaMexDummyMode < TittaMex
                 % filter out those methods that we on purpose do not define
                 % in this subclass, as the superclass methods work fine
                 % (call static functions in the mex)
-                qNotOverridden = ~ismember({superMethods.Name},{thisMethods.Name}) & ~ismember({superMethods.Name},{'findAllEyeTrackers','startLogging','getLog','stopLogging','getAllBufferSidesString','getAllStreamsString'});
+                qNotOverridden = ~ismember({superMethods.Name},{thisMethods.Name}) & ~ismember({superMethods.Name},{'findAllEyeTrackers','startLogging','getLog','stopLogging','getAllBufferSidesString','getAllStreamsString','getAllOverflowPoliciesString','getEyeImagePoolStats','startTracing','stopTracing','writeTrace','readJournal','convertJournalToSession','readSessionTimeRange'});
                 if any(qNotOverridden)
                     fprintf('methods from %s not overridden in %s:\n',superInfo.Name,thisInfo.Name);
                     fprintf('  %s\n',superMethods(qNotOverridden).Name);
@@ -160,11 +161,48 @@ classdef TittaMexDummyMode < TittaMex
         function prevEyeOpennessState = setIncludeEyeOpennessInGaze(~,~)
             prevEyeOpennessState = false;
         end
-        function success = start(this,stream,~,~)
+        function prevMaxWait = setGazeMergeMaxWait(~,~)
+            prevMaxWait = int64(10000);
+        end
+        function maxWait = getGazeMergeMaxWait(~)
+            maxWait = int64(10000);
+        end
+        function prevUseIngestQueueState = setUseIngestQueue(~,~)
+            prevUseIngestQueueState = false;
+        end
+        function useIngestQueue = getUseIngestQueue(~)
+            useIngestQueue = false;
+        end
+        function stats = getCallbackTimingStats(this,stream)
+            if nargin<2
+                error('TittaMex::getCallbackTimingStats: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            checkValidStream(this,stream);
+            stats = struct('numCallbacks',uint64(0),'meanDuration',0,'maxDuration',0);
+        end
+        function stats = getLatencyStats(this,stream)
+            if nargin<2
+                error('TittaMex::getLatencyStats: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            checkValidStream(this,stream);
+            lat = struct('count',uint64(0),'min',0,'mean',0,'p50',0,'p90',0,'p99',0,'p999',0,'max',0);
+            stats = struct('callback',lat,'commit',lat,'read',lat);
+        end
+        function counters = getCounters(~)
+            c = struct('numCallbacks',uint64(0),'numCommitted',uint64(0),'numDropped',uint64(0),'numBuffered',uint64(0),'bufferBytes',uint64(0),'numQueued',uint64(0),'numQueueDropped',uint64(0),'numLockWaits',uint64(0),'lockWaitTime',0,'numMerged',uint64(0),'numMergeTimeouts',uint64(0));
+            counters = struct('gaze',c,'eyeOpenness',c,'eyeImage',c,'externalSignal',c,'timeSync',c,'positioning',c,'notification',c);
+        end
+        function stats = getReplayStats(~)
+            stats = struct('finished',false,'numGaze',uint64(0),'numEyeOpenness',uint64(0),'numEyeImages',uint64(0),'numExtSignals',uint64(0),'numTimeSyncs',uint64(0),'recordingDuration',0,'elapsedTime',0,'speed',0,'maxLag',0,'callbackTime',0);
+        end
+        function success = start(this,stream,~,~,~,~,overflowPolicy)
             if nargin<2
                 error('TittaMex::start: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
             end
             success = checkValidStream(this,stream);
+            if nargin>6 && ~isempty(overflowPolicy)
+                checkValidOverflowPolicy(this,overflowPolicy);
+            end
             if strcmpi(stream,'gaze')
                 this.isRecordingGaze = true;
             end
@@ -225,6 +263,48 @@ classdef TittaMexDummyMode < TittaMex
                 data = getMouseSample(this.isRecordingGaze);
             end
         end
+        function data = getLatest(this,stream)
+            if nargin<2
+                error('TittaMex::getLatest: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            checkValidStream(this,stream);
+            data = [];
+            if strcmpi(stream,'gaze')
+                data = getMouseSample(this.isRecordingGaze);
+            end
+        end
+        function cursor = openCursor(this,stream,side,~)
+            if nargin<2
+                error('TittaMex::openCursor: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            checkValidStream(this,stream);
+            if nargin>2 && ~isempty(side)
+                checkValidBufferSide(this,side);
+            end
+            this.cursorStreams{end+1} = ensureStringIsChar(stream);
+            cursor = uint64(length(this.cursorStreams));
+        end
+        function data = readSince(this,cursor,~)
+            if nargin<2
+                error('TittaMex::readSince: provide cursor argument.');
+            end
+            if cursor<1 || cursor>length(this.cursorStreams) || isempty(this.cursorStreams{cursor})
+                error('Titta::cpp::readSince: cursor %d is not open.',cursor);
+            end
+            data = [];
+            if strcmpi(this.cursorStreams{cursor},'gaze')
+                data = getMouseSample(this.isRecordingGaze);
+            end
+        end
+        function success = closeCursor(this,cursor)
+            if nargin<2
+                error('TittaMex::closeCursor: provide cursor argument.');
+            end
+            success = cursor>=1 && cursor<=length(this.cursorStreams) && ~isempty(this.cursorStreams{cursor});
+            if success
+                this.cursorStreams{cursor} = [];
+            end
+        end
         function clear(this,stream)
             if nargin<2
                 error('TittaMex::clear: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
@@ -246,6 +326,35 @@ classdef TittaMexDummyMode < TittaMex
                 this.isRecordingGaze = false;
             end
         end
+        function nDropped = getNumDroppedSamples(this,stream)
+            if nargin<2
+                error('TittaMex::getNumDroppedSamples: provide stream argument. \nSupported streams are: %s.',this.getAllStreamsString());
+            end
+            checkValidStream(this,stream);
+            nDropped = uint64(0);
+        end
+        function startJournal(~,~,~)
+        end
+        function success = stopJournal(~)
+            success = false;
+        end
+        function journaling = isJournaling(~)
+            journaling = false;
+        end
+        function saveSession(~,~)
+        end
+        function saveParquet(~,~,~)
+        end
+        function startParquet(~,~,~)
+        end
+        function flushParquet(~)
+        end
+        function success = stopParquet(~)
+            success = false;
+        end
+        function writing = isWritingParquet(~)
+            writing = false;
+        end
     end
 end
 
@@ -263,6 +372,9 @@ end
 function isValid = checkValidBufferSide(this,side)
 isValid = this.cppmethodGlobal('checkBufferSide',ensureStringIsChar(side));
 end
+function isValid = checkValidOverflowPolicy(this,overflowPolicy)
+isValid = this.cppmethodGlobal('checkOverflowPolicy',ensureStringIsChar(overflowPolicy));
+end
 
 function sample = getMouseSample(isRecording)
 % figure out mouse to screen mapping
@@ -65,6 +65,7 @@
 
 #include "Titta/Titta.h"
 #include "Titta/utils.h"
+#include "Titta/convert.h"
 
 // converting data to matlab. First here user extensions, then include with generic code driving this
 // extend set of function to convert C++ data to matlab
@@ -103,8 +104,10 @@ namespace mxTypes
     mxArray* ToMatlab(TobiiResearchLicenseValidationResult              data_);
 
     mxArray* ToMatlab(std::vector<Titta::gaze           >               data_);
-    mxArray* FieldToMatlab(const std::vector<Titta::gaze>&              data_, bool rowVector_, TobiiTypes::eyeData Titta::gaze::* field_);
+    mxArray* ToMatlab(const Titta::gazeColumns&                         data_);
+    mxArray* FieldToMatlab(const TobiiTypes::eyeDataColumns&            data_);
     mxArray* ToMatlab(std::vector<Titta::eyeImage       >               data_);
+    mxArray* ToMatlab(const Titta::BufferLease<Titta::eyeImage>&        data_);
     mxArray* ToMatlab(std::vector<Titta::extSignal      >               data_);
     mxArray* ToMatlab(std::vector<Titta::timeSync       >               data_);
     mxArray* ToMatlab(std::vector<Titta::positioning    >               data_);
@@ -120,6 +123,14 @@ namespace mxTypes
     mxArray* ToMatlab(TobiiResearchCalibrationStatus                    data_);
     mxArray* ToMatlab(TobiiTypes::CalibrationPoint data_, mwIndex idx_ = 0, mwSize size_ = 1, mxArray* storage_ = nullptr);
     mxArray* ToMatlab(TobiiResearchNormalizedPoint2D                    data_);
+    mxArray* ToMatlab(Titta::CallbackTimingStats                        data_);
+    mxArray* ToMatlab(TittaSimulator::replayStats                       data_);
+    mxArray* ToMatlab(Titta::LatencyStats                               data_);
+    mxArray* ToMatlab(TittaLatency::stats                               data_);
+    mxArray* ToMatlab(std::map<Titta::Stream, Titta::StreamCounters>    data_);
+    mxArray* ToMatlab(Titta::StreamCounters                             data_);
+    mxArray* ToMatlab(TobiiTypes::imagePool::stats                      data_);
+    mxArray* ToMatlab(TittaJournal::contents                            data_);
     mxArray* ToMatlab(std::vector<TobiiResearchCalibrationSample>       data_);
     mxArray* FieldToMatlab(std::vector<TobiiResearchCalibrationSample>  data_, bool rowVector_, TobiiResearchCalibrationEyeData TobiiResearchCalibrationSample::* field_);
 }
@@ -148,12 +159,24 @@ namespace {
         StartLogging,
         GetLog,
         StopLogging,
+        // eye image memory pool
+        GetEyeImagePoolStats,
+        // tracing
+        StartTracing,
+        StopTracing,
+        WriteTrace,
+        // journal and session files
+        ReadJournal,
+        ConvertJournalToSession,
+        ReadSessionTimeRange,
         // check functions for dummy mode
         CheckStream,
         CheckBufferSide,
+        CheckOverflowPolicy,
         // data stream info
         GetAllStreamsString,
         GetAllBufferSidesString,
+        GetAllOverflowPoliciesString,
 
         //// eye-tracker specific getters and setters
         // getters
@@ -194,15 +217,37 @@ namespace {
         //// data streams
         HasStream,
         SetIncludeEyeOpennessInGaze,
+        SetGazeMergeMaxWait,
+        GetGazeMergeMaxWait,
+        SetUseIngestQueue,
+        GetUseIngestQueue,
+        GetCallbackTimingStats,
+        GetLatencyStats,
+        GetCounters,
+        GetReplayStats,
         Start,
         IsRecording,
         ConsumeN,
         ConsumeTimeRange,
         PeekN,
         PeekTimeRange,
+        GetLatest,
+        OpenCursor,
+        ReadSince,
+        CloseCursor,
         Clear,
         ClearTimeRange,
-        Stop
+        Stop,
+        GetNumDroppedSamples,
+        StartJournal,
+        StopJournal,
+        IsJournaling,
+        SaveSession,
+        SaveParquet,
+        StartParquet,
+        FlushParquet,
+        StopParquet,
+        IsWritingParquet
     };
 
     // Map string (first input argument to mexFunction) to an Action
@@ -222,12 +267,24 @@ namespace {
         { "startLogging",                   Action::StartLogging },
         { "getLog",                         Action::GetLog },
         { "stopLogging",                    Action::StopLogging },
+        // eye image memory pool
+        { "getEyeImagePoolStats",           Action::GetEyeImagePoolStats },
+        // tracing
+        { "startTracing",                   Action::StartTracing },
+        { "stopTracing",                    Action::StopTracing },
+        { "writeTrace",                     Action::WriteTrace },
+        // journal and session files
+        { "readJournal",                    Action::ReadJournal },
+        { "convertJournalToSession",        Action::ConvertJournalToSession },
+        { "readSessionTimeRange",           Action::ReadSessionTimeRange },
         // check functions for dummy mode
         { "checkStream",                    Action::CheckStream },
         { "checkBufferSide",                Action::CheckBufferSide },
+        { "checkOverflowPolicy",            Action::CheckOverflowPolicy },
         // data stream info
         { "getAllStreamsString",            Action::GetAllStreamsString },
         { "getAllBufferSidesString",        Action::GetAllBufferSidesString },
+        { "getAllOverflowPoliciesString",   Action::GetAllOverflowPoliciesString },
 
         //// eye-tracker specific getters and setters
         // getters
@@ -268,15 +325,37 @@ namespace {
         //// data streams
         { "hasStream",                      Action::HasStream },
         { "setIncludeEyeOpennessInGaze",    Action::SetIncludeEyeOpennessInGaze },
+        { "setGazeMergeMaxWait",            Action::SetGazeMergeMaxWait },
+        { "getGazeMergeMaxWait",            Action::GetGazeMergeMaxWait },
+        { "setUseIngestQueue",              Action::SetUseIngestQueue },
+        { "getUseIngestQueue",              Action::GetUseIngestQueue },
+        { "getCallbackTimingStats",         Action::GetCallbackTimingStats },
+        { "getLatencyStats",                Action::GetLatencyStats },
+        { "getCounters",                    Action::GetCounters },
+        { "getReplayStats",                 Action::GetReplayStats },
         { "start",                          Action::Start },
         { "isRecording",                    Action::IsRecording },
         { "consumeN",                       Action::ConsumeN },
         { "consumeTimeRange",               Action::ConsumeTimeRange },
         { "peekN",                          Action::PeekN },
         { "peekTimeRange",                  Action::PeekTimeRange },
+        { "getLatest",                      Action::GetLatest },
+        { "openCursor",                     Action::OpenCursor },
+        { "readSince",                      Action::ReadSince },
+        { "closeCursor",                    Action::CloseCursor },
         { "clear",                          Action::Clear },
         { "clearTimeRange",                 Action::ClearTimeRange },
         { "stop",                           Action::Stop },
+        { "getNumDroppedSamples",           Action::GetNumDroppedSamples },
+        { "startJournal",                   Action::StartJournal },
+        { "stopJournal",                    Action::StopJournal },
+        { "isJournaling",                   Action::IsJournaling },
+        { "saveSession",                    Action::SaveSession },
+        { "saveParquet",                    Action::SaveParquet },
+        { "startParquet",                   Action::StartParquet },
+        { "flushParquet",                   Action::FlushParquet },
+        { "stopParquet",                    Action::StopParquet },
+        { "isWritingParquet",               Action::IsWritingParquet },
     };
 
 
@@ -341,8 +420,11 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             action != Action::GetSDKVersion && action != Action::GetSystemTimestamp &&
             action != Action::FindAllEyeTrackers && action != Action::GetEyeTrackerFromAddress &&
             action != Action::StartLogging && action != Action::GetLog && action != Action::StopLogging &&
-            action != Action::CheckStream && action != Action::CheckBufferSide &&
-            action != Action::GetAllStreamsString && action != Action::GetAllBufferSidesString)
+            action != Action::GetEyeImagePoolStats &&
+            action != Action::StartTracing && action != Action::StopTracing && action != Action::WriteTrace &&
+            action != Action::ReadJournal && action != Action::ConvertJournalToSession && action != Action::ReadSessionTimeRange &&
+            action != Action::CheckStream && action != Action::CheckBufferSide && action != Action::CheckOverflowPolicy &&
+            action != Action::GetAllStreamsString && action != Action::GetAllBufferSidesString && action != Action::GetAllOverflowPoliciesString)
         {
             instIt = checkHandle(instanceTab, getHandle(nrhs_, prhs_));
             instance = instIt->second;
@@ -443,6 +525,124 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
         case Action::StopLogging:
             plhs_[0] = mxCreateLogicalScalar(Titta::stopLogging());
             return;
+        case Action::GetEyeImagePoolStats:
+            plhs_[0] = mxTypes::ToMatlab(Titta::getEyeImagePoolStats());
+            return;
+        case Action::StartTracing:
+        {
+            // get optional input argument
+            std::optional<size_t> eventsPerThread;
+            if (nrhs_ > 1 && !mxIsEmpty(prhs_[1]))
+            {
+                if (!mxIsUint64(prhs_[1]) || mxIsComplex(prhs_[1]) || !mxIsScalar(prhs_[1]))
+                    throw "startTracing: Expected first argument to be a uint64 scalar.";
+                auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[1]));
+                if (temp > SIZE_MAX)
+                    throw "startTracing: Requesting preallocated buffer of a larger size than is possible on a 32bit platform.";
+                eventsPerThread = static_cast<size_t>(temp);
+            }
+
+            Titta::startTracing(eventsPerThread);
+            return;
+        }
+        case Action::StopTracing:
+            Titta::stopTracing();
+            return;
+        case Action::WriteTrace:
+        {
+            if (nrhs_ < 2 || !mxIsChar(prhs_[1]))
+                throw "writeTrace: First input must be a string (path of trace file).";
+
+            char* bufferCstr = mxArrayToString(prhs_[1]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            Titta::writeTrace(path);
+            return;
+        }
+        case Action::ReadJournal:
+        {
+            if (nrhs_ < 2 || !mxIsChar(prhs_[1]))
+                throw "readJournal: First input must be a string (path of journal file).";
+
+            char* bufferCstr = mxArrayToString(prhs_[1]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            plhs_[0] = mxTypes::ToMatlab(Titta::readJournal(path));
+            return;
+        }
+        case Action::ConvertJournalToSession:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[1]) || !mxIsChar(prhs_[2]))
+                throw "convertJournalToSession: First and second input must be strings (paths of journal file and of session file to write).";
+
+            char* bufferCstr = mxArrayToString(prhs_[1]);
+            std::string journalPath = bufferCstr;
+            mxFree(bufferCstr);
+            bufferCstr = mxArrayToString(prhs_[2]);
+            std::string sessionPath = bufferCstr;
+            mxFree(bufferCstr);
+            Titta::convertJournalToSession(journalPath, sessionPath);
+            return;
+        }
+        case Action::ReadSessionTimeRange:
+        {
+            if (nrhs_ < 2 || !mxIsChar(prhs_[1]))
+                throw "readSessionTimeRange: First input must be a string (path of session file).";
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+            {
+                std::string err = "readSessionTimeRange: Second input must be a data stream identifier string (" + Titta::getAllStreamsString("'") + ").";
+                throw err;
+            }
+
+            char* bufferCstr = mxArrayToString(prhs_[1]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            // get data stream identifier string
+            bufferCstr = mxArrayToString(prhs_[2]);
+            Titta::Stream stream = Titta::stringToStream(bufferCstr);
+            mxFree(bufferCstr);
+
+            // get optional input arguments
+            std::optional<int64_t> timeStart;
+            if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+            {
+                if (!mxIsInt64(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                    throw "readSessionTimeRange: Expected third argument to be a int64 scalar.";
+                timeStart = *static_cast<int64_t*>(mxGetData(prhs_[3]));
+            }
+            std::optional<int64_t> timeEnd;
+            if (nrhs_ > 4 && !mxIsEmpty(prhs_[4]))
+            {
+                if (!mxIsInt64(prhs_[4]) || mxIsComplex(prhs_[4]) || !mxIsScalar(prhs_[4]))
+                    throw "readSessionTimeRange: Expected fourth argument to be a int64 scalar.";
+                timeEnd = *static_cast<int64_t*>(mxGetData(prhs_[4]));
+            }
+
+            const TittaSession::reader reader(path);
+            switch (stream)
+            {
+            case Titta::Stream::Gaze:
+            case Titta::Stream::EyeOpenness:
+                plhs_[0] = mxTypes::ToMatlab(reader.peekTimeRange<Titta::gaze>(timeStart, timeEnd));
+                return;
+            case Titta::Stream::EyeImage:
+                plhs_[0] = mxTypes::ToMatlab(reader.peekTimeRange<Titta::eyeImage>(timeStart, timeEnd));
+                return;
+            case Titta::Stream::ExtSignal:
+                plhs_[0] = mxTypes::ToMatlab(reader.peekTimeRange<Titta::extSignal>(timeStart, timeEnd));
+                return;
+            case Titta::Stream::TimeSync:
+                plhs_[0] = mxTypes::ToMatlab(reader.peekTimeRange<Titta::timeSync>(timeStart, timeEnd));
+                return;
+            case Titta::Stream::Positioning:
+                throw "readSessionTimeRange: not supported for positioning stream.";
+                return;
+            case Titta::Stream::Notification:
+                plhs_[0] = mxTypes::ToMatlab(reader.peekTimeRange<Titta::notification>(timeStart, timeEnd));
+                return;
+            }
+            return;
+        }
         case Action::CheckStream:
         {
             if (nrhs_ < 2 || !mxIsChar(prhs_[1]))
@@ -473,6 +673,21 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             plhs_[0] = mxCreateLogicalScalar(true);
             return;
         }
+        case Action::CheckOverflowPolicy:
+        {
+            if (nrhs_ < 2 || !mxIsChar(prhs_[1]))
+            {
+                std::string err = "checkOverflowPolicy: First input must be an overflow policy identifier string (" + Titta::getAllOverflowPoliciesString("'") + ").";
+                throw err;
+            }
+
+            // get overflow policy identifier string, check if valid
+            char* bufferCstr = mxArrayToString(prhs_[1]);
+            Titta::stringToOverflowPolicy(bufferCstr);
+            mxFree(bufferCstr);
+            plhs_[0] = mxCreateLogicalScalar(true);
+            return;
+        }
         case Action::GetAllStreamsString:
         {
             if (nrhs_ > 1)
@@ -514,6 +729,21 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                 plhs_[0] = mxTypes::ToMatlab(Titta::getAllBufferSidesString());
             return;
         }
+        case Action::GetAllOverflowPoliciesString:
+        {
+            if (nrhs_ > 1)
+            {
+                if (!mxIsChar(prhs_[1]) || mxIsComplex(prhs_[1]) || (!mxIsScalar(prhs_[1]) && !mxIsEmpty(prhs_[1])))
+                    throw "getAllOverflowPoliciesString: Expected first argument to be a char scalar or empty char array.";
+                char quoteChar[2] = { "\0" };
+                if (!mxIsEmpty(prhs_[1]))
+                    quoteChar[0] = *static_cast<char*>(mxGetData(prhs_[1]));
+                plhs_[0] = mxTypes::ToMatlab(Titta::getAllOverflowPoliciesString(quoteChar));
+            }
+            else
+                plhs_[0] = mxTypes::ToMatlab(Titta::getAllOverflowPoliciesString());
+            return;
+        }
 
         case Action::GetEyeTrackerInfo:
         {
@@ -784,6 +1014,72 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             plhs_[0] = mxCreateLogicalScalar(instance->setIncludeEyeOpennessInGaze(include));
             break;
         }
+        case Action::SetGazeMergeMaxWait:
+        {
+            if (nrhs_ < 3 || !mxIsInt64(prhs_[2]) || mxIsComplex(prhs_[2]) || !mxIsScalar(prhs_[2]))
+                throw "setGazeMergeMaxWait: First argument must be an int64 scalar.";
+
+            auto maxWait = *static_cast<int64_t*>(mxGetData(prhs_[2]));
+            plhs_[0] = mxTypes::ToMatlab(instance->setGazeMergeMaxWait(maxWait));
+            break;
+        }
+        case Action::GetGazeMergeMaxWait:
+        {
+            plhs_[0] = mxTypes::ToMatlab(instance->getGazeMergeMaxWait());
+            break;
+        }
+        case Action::SetUseIngestQueue:
+        {
+            if (nrhs_ < 3 || mxIsEmpty(prhs_[2]) || !mxIsScalar(prhs_[2]) || !mxIsLogicalScalar(prhs_[2]))
+                throw "setUseIngestQueue: First argument must be a logical scalar.";
+
+            bool useQueue = mxIsLogicalScalarTrue(prhs_[2]);
+            plhs_[0] = mxCreateLogicalScalar(instance->setUseIngestQueue(useQueue));
+            break;
+        }
+        case Action::GetUseIngestQueue:
+        {
+            plhs_[0] = mxCreateLogicalScalar(instance->getUseIngestQueue());
+            break;
+        }
+        case Action::GetCallbackTimingStats:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+            {
+                std::string err = "getCallbackTimingStats: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'") + ").";
+                throw err;
+            }
+
+            // get data stream identifier string, get timing info
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            plhs_[0] = mxTypes::ToMatlab(instance->getCallbackTimingStats(bufferCstr));
+            mxFree(bufferCstr);
+            break;
+        }
+        case Action::GetLatencyStats:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+            {
+                std::string err = "getLatencyStats: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'") + ").";
+                throw err;
+            }
+
+            // get data stream identifier string, get latency info
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            plhs_[0] = mxTypes::ToMatlab(instance->getLatencyStats(bufferCstr));
+            mxFree(bufferCstr);
+            break;
+        }
+        case Action::GetCounters:
+        {
+            plhs_[0] = mxTypes::ToMatlab(instance->getCounters());
+            break;
+        }
+        case Action::GetReplayStats:
+        {
+            plhs_[0] = mxTypes::ToMatlab(instance->getReplayStats());
+            break;
+        }
         case Action::Start:
         {
             if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
@@ -808,10 +1104,30 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                     throw "start: Expected third argument to be a logical scalar.";
                 asGif = mxIsLogicalScalarTrue(prhs_[4]);
             }
+            std::optional<size_t> capacity;
+            if (nrhs_ > 5 && !mxIsEmpty(prhs_[5]))
+            {
+                if (!mxIsUint64(prhs_[5]) || mxIsComplex(prhs_[5]) || !mxIsScalar(prhs_[5]))
+                    throw "start: Expected fourth argument to be a uint64 scalar.";
+                auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[5]));
+                capacity = static_cast<size_t>(temp);
+            }
+            std::optional<Titta::OverflowPolicy> overflowPolicy;
+            if (nrhs_ > 6 && !mxIsEmpty(prhs_[6]))
+            {
+                if (!mxIsChar(prhs_[6]))
+                {
+                    std::string err = "start: Fifth input must be an overflow policy identifier string (" + Titta::getAllOverflowPoliciesString("'") + ").";
+                    throw err;
+                }
+                char* policyCstr = mxArrayToString(prhs_[6]);
+                overflowPolicy = Titta::stringToOverflowPolicy(policyCstr);
+                mxFree(policyCstr);
+            }
 
             // get data stream identifier string, call start() on instance
             char* bufferCstr = mxArrayToString(prhs_[2]);
-            plhs_[0] = mxCreateLogicalScalar(instance->start(bufferCstr, bufSize, asGif));
+            plhs_[0] = mxCreateLogicalScalar(instance->start(bufferCstr, bufSize, asGif, capacity, overflowPolicy));
             mxFree(bufferCstr);
             return;
         }
@@ -870,7 +1186,7 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             {
             case Titta::Stream::Gaze:
             case Titta::Stream::EyeOpenness:
-                plhs_[0] = mxTypes::ToMatlab(instance->consumeN<Titta::gaze>(nSamp, side));
+                plhs_[0] = mxTypes::ToMatlab(instance->consumeNColumns(nSamp, side));
                 return;
             case Titta::Stream::EyeImage:
                 plhs_[0] = mxTypes::ToMatlab(instance->consumeN<Titta::eyeImage>(nSamp, side));
@@ -922,7 +1238,7 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             {
             case Titta::Stream::Gaze:
             case Titta::Stream::EyeOpenness:
-                plhs_[0] = mxTypes::ToMatlab(instance->consumeTimeRange<Titta::gaze>(timeStart, timeEnd));
+                plhs_[0] = mxTypes::ToMatlab(instance->consumeTimeRangeColumns(timeStart, timeEnd));
                 return;
             case Titta::Stream::EyeImage:
                 plhs_[0] = mxTypes::ToMatlab(instance->consumeTimeRange<Titta::eyeImage>(timeStart, timeEnd));
@@ -982,10 +1298,11 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             {
             case Titta::Stream::Gaze:
             case Titta::Stream::EyeOpenness:
-                plhs_[0] = mxTypes::ToMatlab(instance->peekN<Titta::gaze>(nSamp, side));
+                plhs_[0] = mxTypes::ToMatlab(instance->peekNColumns(nSamp, side));
                 return;
             case Titta::Stream::EyeImage:
-                plhs_[0] = mxTypes::ToMatlab(instance->peekN<Titta::eyeImage>(nSamp, side));
+                // eye images are converted directly from the buffer, avoiding a copy
+                plhs_[0] = mxTypes::ToMatlab(instance->peekNLease<Titta::eyeImage>(nSamp, side));
                 return;
             case Titta::Stream::ExtSignal:
                 plhs_[0] = mxTypes::ToMatlab(instance->peekN<Titta::extSignal>(nSamp, side));
@@ -1034,10 +1351,11 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             {
             case Titta::Stream::Gaze:
             case Titta::Stream::EyeOpenness:
-                plhs_[0] = mxTypes::ToMatlab(instance->peekTimeRange<Titta::gaze>(timeStart, timeEnd));
+                plhs_[0] = mxTypes::ToMatlab(instance->peekTimeRangeColumns(timeStart, timeEnd));
                 return;
             case Titta::Stream::EyeImage:
-                plhs_[0] = mxTypes::ToMatlab(instance->peekTimeRange<Titta::eyeImage>(timeStart, timeEnd));
+                // eye images are converted directly from the buffer, avoiding a copy
+                plhs_[0] = mxTypes::ToMatlab(instance->peekTimeRangeLease<Titta::eyeImage>(timeStart, timeEnd));
                 return;
             case Titta::Stream::ExtSignal:
                 plhs_[0] = mxTypes::ToMatlab(instance->peekTimeRange<Titta::extSignal>(timeStart, timeEnd));
@@ -1053,6 +1371,137 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
                 return;
             }
         }
+        case Action::GetLatest:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+            {
+                std::string err = "getLatest: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'") + ").";
+                throw err;
+            }
+
+            // get data stream identifier string
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            Titta::Stream stream = instance->stringToStream(bufferCstr);
+            mxFree(bufferCstr);
+
+            // output in same format as peekN, with one sample or empty if no sample received yet
+            auto toVector = [](auto&& sample_)
+            {
+                std::vector<typename std::decay_t<decltype(sample_)>::value_type> out;
+                if (sample_)
+                    out.push_back(*sample_);
+                return out;
+            };
+
+            switch (stream)
+            {
+            case Titta::Stream::Gaze:
+            case Titta::Stream::EyeOpenness:
+                plhs_[0] = mxTypes::ToMatlab(toVector(instance->getLatest<Titta::gaze>()));
+                return;
+            case Titta::Stream::EyeImage:
+                throw "getLatest: not supported for eyeImage stream.";
+                return;
+            case Titta::Stream::ExtSignal:
+                plhs_[0] = mxTypes::ToMatlab(toVector(instance->getLatest<Titta::extSignal>()));
+                return;
+            case Titta::Stream::TimeSync:
+                plhs_[0] = mxTypes::ToMatlab(toVector(instance->getLatest<Titta::timeSync>()));
+                return;
+            case Titta::Stream::Positioning:
+                plhs_[0] = mxTypes::ToMatlab(toVector(instance->getLatest<Titta::positioning>()));
+                return;
+            case Titta::Stream::Notification:
+                throw "getLatest: not supported for notification stream.";
+                return;
+            }
+        }
+        case Action::OpenCursor:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+            {
+                std::string err = "openCursor: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'") + ").";
+                throw err;
+            }
+
+            // get data stream identifier string
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            Titta::Stream stream = instance->stringToStream(bufferCstr);
+            mxFree(bufferCstr);
+
+            // get optional input arguments
+            std::optional<Titta::BufferSide> side;
+            if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+            {
+                if (!mxIsChar(prhs_[3]))
+                {
+                    std::string err = "openCursor: Second input must be a buffer side identifier string (" + Titta::getAllBufferSidesString("'") + ").";
+                    throw err;
+                }
+                char* bufferCstr = mxArrayToString(prhs_[3]);
+                side = instance->stringToBufferSide(bufferCstr);
+                mxFree(bufferCstr);
+            }
+            std::optional<bool> reclaim;
+            if (nrhs_ > 4 && !mxIsEmpty(prhs_[4]))
+            {
+                if (!(mxIsDouble(prhs_[4]) && !mxIsComplex(prhs_[4]) && mxIsScalar(prhs_[4])) && !mxIsLogicalScalar(prhs_[4]))
+                    throw "openCursor: Expected third argument to be a logical scalar.";
+                reclaim = mxIsLogicalScalarTrue(prhs_[4]);
+            }
+
+            plhs_[0] = mxTypes::ToMatlab(instance->openCursor(stream, side, reclaim));
+            break;
+        }
+        case Action::ReadSince:
+        {
+            if (nrhs_ < 3 || mxIsEmpty(prhs_[2]) || !mxIsUint64(prhs_[2]) || mxIsComplex(prhs_[2]) || !mxIsScalar(prhs_[2]))
+                throw "readSince: First input must be a cursor (uint64 scalar, as returned by openCursor).";
+            const auto cursor = *static_cast<uint64_t*>(mxGetData(prhs_[2]));
+
+            // get optional input arguments
+            std::optional<size_t> nSamp;
+            if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+            {
+                if (!mxIsUint64(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                    throw "readSince: Expected second argument to be a uint64 scalar.";
+                auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[3]));
+                if (temp > SIZE_MAX)
+                    throw "readSince: Requesting preallocated buffer of a larger size than is possible on a 32bit platform.";
+                nSamp = static_cast<size_t>(temp);
+            }
+
+            switch (instance->getCursorStream(cursor))
+            {
+            case Titta::Stream::Gaze:
+            case Titta::Stream::EyeOpenness:
+                plhs_[0] = mxTypes::ToMatlab(instance->readSince<Titta::gaze>(cursor, nSamp));
+                return;
+            case Titta::Stream::EyeImage:
+                plhs_[0] = mxTypes::ToMatlab(instance->readSince<Titta::eyeImage>(cursor, nSamp));
+                return;
+            case Titta::Stream::ExtSignal:
+                plhs_[0] = mxTypes::ToMatlab(instance->readSince<Titta::extSignal>(cursor, nSamp));
+                return;
+            case Titta::Stream::TimeSync:
+                plhs_[0] = mxTypes::ToMatlab(instance->readSince<Titta::timeSync>(cursor, nSamp));
+                return;
+            case Titta::Stream::Positioning:
+                plhs_[0] = mxTypes::ToMatlab(instance->readSince<Titta::positioning>(cursor, nSamp));
+                return;
+            case Titta::Stream::Notification:
+                plhs_[0] = mxTypes::ToMatlab(instance->readSince<Titta::notification>(cursor, nSamp));
+                return;
+            }
+        }
+        case Action::CloseCursor:
+        {
+            if (nrhs_ < 3 || mxIsEmpty(prhs_[2]) || !mxIsUint64(prhs_[2]) || mxIsComplex(prhs_[2]) || !mxIsScalar(prhs_[2]))
+                throw "closeCursor: First input must be a cursor (uint64 scalar, as returned by openCursor).";
+
+            plhs_[0] = mxCreateLogicalScalar(instance->closeCursor(*static_cast<uint64_t*>(mxGetData(prhs_[2]))));
+            break;
+        }
         case Action::Clear:
         {
             if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
@@ -1120,6 +1569,125 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
             mxFree(bufferCstr);
             break;
         }
+        case Action::GetNumDroppedSamples:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+            {
+                std::string err = "getNumDroppedSamples: First input must be a data stream identifier string (" + Titta::getAllStreamsString("'") + ").";
+                throw err;
+            }
+
+            // get data stream identifier string, get number of dropped samples
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            plhs_[0] = mxTypes::ToMatlab(instance->getNumDroppedSamples(bufferCstr));
+            mxFree(bufferCstr);
+            break;
+        }
+        case Action::StartJournal:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+                throw "startJournal: First input must be a string (path of journal file).";
+
+            // get optional input arguments
+            std::optional<size_t> window;
+            if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+            {
+                if (!mxIsUint64(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                    throw "startJournal: Expected second argument to be a uint64 scalar.";
+                auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[3]));
+                if (temp > SIZE_MAX)
+                    throw "startJournal: Requesting in-memory window of a larger size than is possible on a 32bit platform.";
+                window = static_cast<size_t>(temp);
+            }
+
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            instance->startJournal(path, window);
+            break;
+        }
+        case Action::StopJournal:
+        {
+            plhs_[0] = mxCreateLogicalScalar(instance->stopJournal());
+            break;
+        }
+        case Action::IsJournaling:
+        {
+            plhs_[0] = mxCreateLogicalScalar(instance->isJournaling());
+            break;
+        }
+        case Action::SaveSession:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+                throw "saveSession: First input must be a string (path of session file).";
+
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            instance->saveSession(path);
+            break;
+        }
+        case Action::SaveParquet:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+                throw "saveParquet: First input must be a string (base of file paths).";
+
+            // get optional input arguments
+            std::optional<size_t> rowGroupSize;
+            if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+            {
+                if (!mxIsUint64(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                    throw "saveParquet: Expected second argument to be a uint64 scalar.";
+                auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[3]));
+                if (temp > SIZE_MAX)
+                    throw "saveParquet: Requesting row group size larger than is possible on a 32bit platform.";
+                rowGroupSize = static_cast<size_t>(temp);
+            }
+
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            instance->saveParquet(path, rowGroupSize);
+            break;
+        }
+        case Action::StartParquet:
+        {
+            if (nrhs_ < 3 || !mxIsChar(prhs_[2]))
+                throw "startParquet: First input must be a string (base of file paths).";
+
+            // get optional input arguments
+            std::optional<size_t> rowGroupSize;
+            if (nrhs_ > 3 && !mxIsEmpty(prhs_[3]))
+            {
+                if (!mxIsUint64(prhs_[3]) || mxIsComplex(prhs_[3]) || !mxIsScalar(prhs_[3]))
+                    throw "startParquet: Expected second argument to be a uint64 scalar.";
+                auto temp = *static_cast<uint64_t*>(mxGetData(prhs_[3]));
+                if (temp > SIZE_MAX)
+                    throw "startParquet: Requesting row group size larger than is possible on a 32bit platform.";
+                rowGroupSize = static_cast<size_t>(temp);
+            }
+
+            char* bufferCstr = mxArrayToString(prhs_[2]);
+            std::string path = bufferCstr;
+            mxFree(bufferCstr);
+            instance->startParquet(path, rowGroupSize);
+            break;
+        }
+        case Action::FlushParquet:
+        {
+            instance->flushParquet();
+            break;
+        }
+        case Action::StopParquet:
+        {
+            plhs_[0] = mxCreateLogicalScalar(instance->stopParquet());
+            break;
+        }
+        case Action::IsWritingParquet:
+        {
+            plhs_[0] = mxCreateLogicalScalar(instance->isWritingParquet());
+            break;
+        }
 
         default:
             throw "Unhandled action: " + actionStr;
@@ -1148,8 +1716,8 @@ void mexFunction(int nlhs_, mxArray *plhs_[], int nrhs_, const mxArray *prhs_[])
 // helpers
 namespace
 {
-    template <typename S, typename T, typename R>
-    bool allEquals(const std::vector<S>& data_, T S::* field_, const R& ref_)
+    template <typename Cont, typename M, typename R>
+    bool allEquals(const Cont& data_, M field_, const R& ref_)
     {
         for (auto &frame : data_)
             if (frame.*field_ != ref_)
@@ -1157,7 +1725,8 @@ namespace
         return true;
     }
 
-    mxArray* eyeImagesToMatlab(const std::vector<Titta::eyeImage>& data_)
+    template <typename Cont>
+    mxArray* eyeImagesToMatlab(const Cont& data_)
     {
         if (data_.empty())
             return mxCreateDoubleMatrix(0, 0, mxREAL);
@@ -1192,6 +1761,37 @@ namespace
         return out;
     }
 
+    // columnar gaze data (Titta::gazeColumns): each column is output with a single copy
+    mxArray* ColumnToMatlab(const std::vector<int64_t>& data_)
+    {
+        mxArray* out = mxCreateUninitNumericMatrix(1, data_.size(), mxINT64_CLASS, mxREAL);
+        if (!data_.empty())
+            std::memcpy(mxGetData(out), data_.data(), data_.size() * sizeof(int64_t));
+        return out;
+    }
+    mxArray* ColumnToMatlab(const std::vector<uint8_t>& data_)
+    {
+        // flags are stored as 0 or 1, same as mxLogical
+        static_assert(sizeof(mxLogical) == sizeof(uint8_t));
+        mxArray* out = mxCreateLogicalMatrix(1, data_.size());
+        if (!data_.empty())
+            std::memcpy(mxGetLogicals(out), data_.data(), data_.size());
+        return out;
+    }
+    // one to three float columns (e.g. x, y and z of a point) to a [nColumns x nSamples] double matrix
+    mxArray* ColumnsToMatlab(std::initializer_list<const std::vector<float>*> data_)
+    {
+        const auto nRow = data_.size();
+        const auto nCol = (*data_.begin())->size();
+        mxArray* out = mxCreateUninitNumericMatrix(nRow, nCol, mxDOUBLE_CLASS, mxREAL);
+        const float* cols[3];
+        size_t r = 0;
+        for (const auto col: data_)
+            cols[r++] = col->data();
+        TittaConvert::interleave(static_cast<double*>(mxGetData(out)), cols, nRow, nCol);
+        return out;
+    }
+
     std::string TobiiResearchCalibrationEyeValidityToString(TobiiResearchCalibrationEyeValidity data_)
     {
         switch (data_)
@@ -1347,22 +1947,27 @@ namespace mxTypes
     }
 
     mxArray* ToMatlab(std::vector<Titta::gaze> data_)
+    {
+        // transpose to columns in a single pass over the samples, then output column by column
+        return ToMatlab(Titta::gazeColumns(data_.begin(), data_.end()));
+    }
+    mxArray* ToMatlab(const Titta::gazeColumns& data_)
     {
         const char* fieldNames[] = {"deviceTimeStamp","systemTimeStamp","left","right"};
         mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
 
         // 1. all device timestamps
-        mxSetFieldByNumber(out, 0, 0, FieldToMatlab(data_, true, &Titta::gaze::device_time_stamp));
+        mxSetFieldByNumber(out, 0, 0, ColumnToMatlab(data_.device_time_stamp));
         // 2. all system timestamps
-        mxSetFieldByNumber(out, 0, 1, FieldToMatlab(data_, true, &Titta::gaze::system_time_stamp));
+        mxSetFieldByNumber(out, 0, 1, ColumnToMatlab(data_.system_time_stamp));
         // 3. left  eye data
-        mxSetFieldByNumber(out, 0, 2, FieldToMatlab(data_, true, &Titta::gaze::left_eye));
+        mxSetFieldByNumber(out, 0, 2, FieldToMatlab(data_.left_eye));
         // 4. right eye data
-        mxSetFieldByNumber(out, 0, 3, FieldToMatlab(data_, true, &Titta::gaze::right_eye));
+        mxSetFieldByNumber(out, 0, 3, FieldToMatlab(data_.right_eye));
 
         return out;
     }
-    mxArray* FieldToMatlab(const std::vector<Titta::gaze>& data_, bool rowVector_, TobiiTypes::eyeData Titta::gaze::* field_)
+    mxArray* FieldToMatlab(const TobiiTypes::eyeDataColumns& data_)
     {
         const char* fieldNamesEye[] = {"gazePoint","pupil","gazeOrigin","eyeOpenness"};
         const char* fieldNamesGP[] = {"onDisplayArea","inUserCoords","valid","available" };
@@ -1375,47 +1980,49 @@ namespace mxTypes
         // 1. gazePoint
         mxSetFieldByNumber(out, 0, 0, temp = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNamesGP)), fieldNamesGP));
         // 1.1 gazePoint.onDisplayArea
-        mxSetFieldByNumber(temp, 0, 0, TobiiFieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::position_on_display_area, 0.));              // 0. causes values to be stored as double
+        mxSetFieldByNumber(temp, 0, 0, ColumnsToMatlab({&data_.gaze_point_on_display_area_x, &data_.gaze_point_on_display_area_y}));
         // 1.2 gazePoint.inUserCoords
-        mxSetFieldByNumber(temp, 0, 1, TobiiFieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::position_in_user_coordinates, 0.));          // 0. causes values to be stored as double
+        mxSetFieldByNumber(temp, 0, 1, ColumnsToMatlab({&data_.gaze_point_in_user_coordinates_x, &data_.gaze_point_in_user_coordinates_y, &data_.gaze_point_in_user_coordinates_z}));
         // 1.3 gazePoint.validity
-        mxSetFieldByNumber(temp, 0, 2, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::validity, TOBII_RESEARCH_VALIDITY_VALID));
+        mxSetFieldByNumber(temp, 0, 2, ColumnToMatlab(data_.gaze_point_valid));
         // 1.4 gazePoint.available
-        mxSetFieldByNumber(temp, 0, 3, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::available));
+        mxSetFieldByNumber(temp, 0, 3, ColumnToMatlab(data_.gaze_point_available));
 
         // 2. pupil
         mxSetFieldByNumber(out, 0, 1, temp = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNamesPup)), fieldNamesPup));
         // 2.1 pupil.diameter
-        mxSetFieldByNumber(temp, 0, 0, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::pupil, &TobiiTypes::pupilData::diameter, 0.));                                   // 0. causes values to be stored as double
+        mxSetFieldByNumber(temp, 0, 0, ColumnsToMatlab({&data_.pupil_diameter}));
         // 2.2 pupil.validity
-        mxSetFieldByNumber(temp, 0, 1, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::pupil, &TobiiTypes::pupilData::validity, TOBII_RESEARCH_VALIDITY_VALID));
+        mxSetFieldByNumber(temp, 0, 1, ColumnToMatlab(data_.pupil_valid));
         // 2.3 pupil.available
-        mxSetFieldByNumber(temp, 0, 2, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::pupil, &TobiiTypes::pupilData::available));
+        mxSetFieldByNumber(temp, 0, 2, ColumnToMatlab(data_.pupil_available));
 
         // 3. gazeOrigin
         mxSetFieldByNumber(out, 0, 2, temp = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNamesGO)), fieldNamesGO));
         // 3.1 gazeOrigin.inUserCoords
-        mxSetFieldByNumber(temp, 0, 0, TobiiFieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::position_in_user_coordinates, 0.));        // 0. causes values to be stored as double
+        mxSetFieldByNumber(temp, 0, 0, ColumnsToMatlab({&data_.gaze_origin_in_user_coordinates_x, &data_.gaze_origin_in_user_coordinates_y, &data_.gaze_origin_in_user_coordinates_z}));
         // 3.2 gazeOrigin.inTrackBoxCoords
-        mxSetFieldByNumber(temp, 0, 1, TobiiFieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::position_in_track_box_coordinates, 0.));   // 0. causes values to be stored as double
+        mxSetFieldByNumber(temp, 0, 1, ColumnsToMatlab({&data_.gaze_origin_in_track_box_coordinates_x, &data_.gaze_origin_in_track_box_coordinates_y, &data_.gaze_origin_in_track_box_coordinates_z}));
         // 3.3 gazeOrigin.validity
-        mxSetFieldByNumber(temp, 0, 2, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::validity, TOBII_RESEARCH_VALIDITY_VALID));
+        mxSetFieldByNumber(temp, 0, 2, ColumnToMatlab(data_.gaze_origin_valid));
         // 3.4 gazeOrigin.available
-        mxSetFieldByNumber(temp, 0, 3, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::available));
+        mxSetFieldByNumber(temp, 0, 3, ColumnToMatlab(data_.gaze_origin_available));
 
         // 4. eyeOpenness
         mxSetFieldByNumber(out, 0, 3, temp = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNamesEO)), fieldNamesEO));
         // 4.1 eye_openness.diameter
-        mxSetFieldByNumber(temp, 0, 0, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::eye_openness, &TobiiTypes::eyeOpenness::diameter, 0.));                             // 0. causes values to be stored as double
+        mxSetFieldByNumber(temp, 0, 0, ColumnsToMatlab({&data_.eye_openness_diameter}));
         // 4.2 eye_openness.validity
-        mxSetFieldByNumber(temp, 0, 1, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::eye_openness, &TobiiTypes::eyeOpenness::validity, TOBII_RESEARCH_VALIDITY_VALID));
+        mxSetFieldByNumber(temp, 0, 1, ColumnToMatlab(data_.eye_openness_valid));
         // 4.3 eye_openness.available
-        mxSetFieldByNumber(temp, 0, 2, FieldToMatlab(data_, rowVector_, field_, &TobiiTypes::eyeData::eye_openness, &TobiiTypes::eyeOpenness::available));
+        mxSetFieldByNumber(temp, 0, 2, ColumnToMatlab(data_.eye_openness_available));
 
         return out;
     }
 
-    mxArray* ToMatlab(std::vector<Titta::eyeImage> data_)
+    // works on any container of eye images (std::vector, or Titta::BufferLease for direct access to buffer)
+    template <typename Cont>
+    mxArray* EyeImageContainerToMatlab(const Cont& data_)
     {
         // check if all gif, then don't output unneeded fields
         bool allGif = allEquals(data_, &Titta::eyeImage::is_gif, true);
@@ -1454,6 +2061,14 @@ namespace mxTypes
 
         return out;
     }
+    mxArray* ToMatlab(std::vector<Titta::eyeImage> data_)
+    {
+        return EyeImageContainerToMatlab(data_);
+    }
+    mxArray* ToMatlab(const Titta::BufferLease<Titta::eyeImage>& data_)
+    {
+        return EyeImageContainerToMatlab(data_);
+    }
 
     mxArray* ToMatlab(std::vector<Titta::extSignal> data_)
     {
@@ -1815,6 +2430,135 @@ namespace mxTypes
 
         return out;
     }
+
+    mxArray* ToMatlab(Titta::CallbackTimingStats data_)
+    {
+        const char* fieldNames[] = {"numCallbacks","meanDuration","maxDuration"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.numCallbacks));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.meanDuration));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.maxDuration));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(Titta::LatencyStats data_)
+    {
+        const char* fieldNames[] = {"callback","commit","read"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.callback));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.commit));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.read));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(TittaLatency::stats data_)
+    {
+        const char* fieldNames[] = {"count","min","mean","p50","p90","p99","p999","max"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.count));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.min));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.mean));
+        mxSetFieldByNumber(out, 0, 3, ToMatlab(data_.p50));
+        mxSetFieldByNumber(out, 0, 4, ToMatlab(data_.p90));
+        mxSetFieldByNumber(out, 0, 5, ToMatlab(data_.p99));
+        mxSetFieldByNumber(out, 0, 6, ToMatlab(data_.p999));
+        mxSetFieldByNumber(out, 0, 7, ToMatlab(data_.max));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(std::map<Titta::Stream, Titta::StreamCounters> data_)
+    {
+        // struct with a field per stream
+        std::vector<std::string> streamNames;
+        for (const auto& [stream, counters] : data_)
+            streamNames.push_back(Titta::streamToString(stream));
+        std::vector<const char*> fieldNames;
+        for (const auto& name : streamNames)
+            fieldNames.push_back(name.c_str());
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(fieldNames.size()), fieldNames.data());
+
+        int i = 0;
+        for (const auto& [stream, counters] : data_)
+            mxSetFieldByNumber(out, 0, i++, ToMatlab(counters));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(Titta::StreamCounters data_)
+    {
+        const char* fieldNames[] = {"numCallbacks","numCommitted","numDropped","numBuffered","bufferBytes","numQueued","numQueueDropped","numLockWaits","lockWaitTime","numMerged","numMergeTimeouts"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.numCallbacks));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.numCommitted));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.numDropped));
+        mxSetFieldByNumber(out, 0, 3, ToMatlab(data_.numBuffered));
+        mxSetFieldByNumber(out, 0, 4, ToMatlab(data_.bufferBytes));
+        mxSetFieldByNumber(out, 0, 5, ToMatlab(data_.numQueued));
+        mxSetFieldByNumber(out, 0, 6, ToMatlab(data_.numQueueDropped));
+        mxSetFieldByNumber(out, 0, 7, ToMatlab(data_.numLockWaits));
+        mxSetFieldByNumber(out, 0, 8, ToMatlab(data_.lockWaitTime));
+        mxSetFieldByNumber(out, 0, 9, ToMatlab(data_.numMerged));
+        mxSetFieldByNumber(out, 0, 10, ToMatlab(data_.numMergeTimeouts));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(TittaSimulator::replayStats data_)
+    {
+        const char* fieldNames[] = {"finished","numGaze","numEyeOpenness","numEyeImages","numExtSignals","numTimeSyncs","recordingDuration","elapsedTime","speed","maxLag","callbackTime"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.finished));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.numGaze));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.numEyeOpenness));
+        mxSetFieldByNumber(out, 0, 3, ToMatlab(data_.numEyeImages));
+        mxSetFieldByNumber(out, 0, 4, ToMatlab(data_.numExtSignals));
+        mxSetFieldByNumber(out, 0, 5, ToMatlab(data_.numTimeSyncs));
+        mxSetFieldByNumber(out, 0, 6, ToMatlab(data_.recordingDuration));
+        mxSetFieldByNumber(out, 0, 7, ToMatlab(data_.elapsedTime));
+        mxSetFieldByNumber(out, 0, 8, ToMatlab(data_.speed));
+        mxSetFieldByNumber(out, 0, 9, ToMatlab(data_.maxLag));
+        mxSetFieldByNumber(out, 0,10, ToMatlab(data_.callbackTime));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(TobiiTypes::imagePool::stats data_)
+    {
+        const char* fieldNames[] = {"numRequests","numHits","hitRate","residentBytes","idleBytes"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(data_.numRequests));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(data_.numHits));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(data_.hitRate));
+        mxSetFieldByNumber(out, 0, 3, ToMatlab(static_cast<uint64_t>(data_.residentBytes)));
+        mxSetFieldByNumber(out, 0, 4, ToMatlab(static_cast<uint64_t>(data_.idleBytes)));
+
+        return out;
+    }
+
+    mxArray* ToMatlab(TittaJournal::contents data_)
+    {
+        const char* fieldNames[] = {"gaze","eyeImage","externalSignal","timeSync","positioning","notification","complete"};
+        mxArray* out = mxCreateStructMatrix(1, 1, static_cast<int>(std::size(fieldNames)), fieldNames);
+
+        mxSetFieldByNumber(out, 0, 0, ToMatlab(std::move(data_.gaze)));
+        mxSetFieldByNumber(out, 0, 1, ToMatlab(std::move(data_.eyeImage)));
+        mxSetFieldByNumber(out, 0, 2, ToMatlab(std::move(data_.extSignal)));
+        mxSetFieldByNumber(out, 0, 3, ToMatlab(std::move(data_.timeSync)));
+        mxSetFieldByNumber(out, 0, 4, ToMatlab(std::move(data_.positioning)));
+        mxSetFieldByNumber(out, 0, 5, ToMatlab(std::move(data_.notification)));
+        mxSetFieldByNumber(out, 0, 6, mxCreateLogicalScalar(data_.complete));
+
+        return out;
+    }
 }
 
 
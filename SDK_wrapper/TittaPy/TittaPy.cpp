@@ -24,9 +24,10 @@ using namespace pybind11::literals;
 namespace
 {
 // default output is storage type corresponding to the type of the member variable accessed through this function, but it can be overridden through type tag dispatch (see nested_field::getWrapper implementation)
-template<bool UseArray, typename V, typename... Fs>
-void FieldToNpArray(py::dict& out_, const std::vector<V>& data_, const std::string& name_, Fs... fields_)
+template<bool UseArray, typename Cont, typename... Fs>
+void FieldToNpArray(py::dict& out_, const Cont& data_, const std::string& name_, Fs... fields_)
 {
+    using V = typename Cont::value_type;
     using U = decltype(nested_field::getWrapper(std::declval<V>(), fields_...));
     auto nElem = static_cast<py::ssize_t>(data_.size());
 
@@ -56,9 +57,10 @@ void FieldToNpArray(py::dict& out_, const std::vector<V>& data_, const std::stri
     }
 }
 
-template<typename V, typename... Fs>
-void TobiiFieldToNpArray(py::dict& out_, const std::vector<V>& data_, const std::string& name_, Fs... fields)
+template<typename Cont, typename... Fs>
+void TobiiFieldToNpArray(py::dict& out_, const Cont& data_, const std::string& name_, Fs... fields)
 {
+    using V = typename Cont::value_type;
     // get type member variable accessed through the last pointer-to-member-variable in the parameter pack (this is not necessarily the last type in the parameter pack as that can also be the type tag if the user explicitly requested a return type)
     using memVar = std::conditional_t<std::is_member_object_pointer_v<last<0, V, Fs...>>, last<0, V, Fs...>, last<1, V, Fs...>>;
     using retT = memVarType_t<memVar>;
@@ -76,53 +78,72 @@ void TobiiFieldToNpArray(py::dict& out_, const std::vector<V>& data_, const std:
         FieldToNpArray<true>(out_, data_, name_ + "_z", std::forward<Fs>(fields)..., &retT::z);
 }
 
-void FieldToNpArray(py::dict& out_, const std::vector<Titta::gaze>& data_, const std::string& name_, TobiiTypes::eyeData Titta::gaze::* field_)
+// columnar gaze data (Titta::gazeColumns): each column is output with a single copy
+template <typename V>
+void ColumnToNpArray(py::dict& out_, const std::vector<V>& data_, const std::string& name_)
+{
+    out_[name_.c_str()] = py::array_t<V>(static_cast<py::ssize_t>(data_.size()), data_.data());
+}
+void ColumnToNpArray(py::dict& out_, const std::vector<uint8_t>& data_, const std::string& name_)
+{
+    // flags are stored as 0 or 1, same as numpy bool
+    static_assert(sizeof(bool) == sizeof(uint8_t));
+    out_[name_.c_str()] = py::array_t<bool>(static_cast<py::ssize_t>(data_.size()), reinterpret_cast<const bool*>(data_.data()));
+}
+void FieldToNpArray(py::dict& out_, const TobiiTypes::eyeDataColumns& data_, const std::string& name_)
 {
     // 1. gaze_point
     auto localName = name_ + "_gaze_point_";
     // 1.1 gaze_point_on_display_area
-    TobiiFieldToNpArray (out_, data_, localName+"on_display_area"    , field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::position_on_display_area);
+    ColumnToNpArray(out_, data_.gaze_point_on_display_area_x    , localName + "on_display_area_x");
+    ColumnToNpArray(out_, data_.gaze_point_on_display_area_y    , localName + "on_display_area_y");
     // 1.2 gaze_point_in_user_coordinates
-    TobiiFieldToNpArray (out_, data_, localName+"in_user_coordinates", field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::position_in_user_coordinates);
+    ColumnToNpArray(out_, data_.gaze_point_in_user_coordinates_x, localName + "in_user_coordinates_x");
+    ColumnToNpArray(out_, data_.gaze_point_in_user_coordinates_y, localName + "in_user_coordinates_y");
+    ColumnToNpArray(out_, data_.gaze_point_in_user_coordinates_z, localName + "in_user_coordinates_z");
     // 1.3 gaze_point_valid
-    FieldToNpArray<true>(out_, data_, localName+"valid"              , field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::validity, TOBII_RESEARCH_VALIDITY_VALID);
+    ColumnToNpArray(out_, data_.gaze_point_valid                , localName + "valid");
     // 1.4 gaze_point_available
-    FieldToNpArray<true>(out_, data_, localName+"available"          , field_, &TobiiTypes::eyeData::gaze_point, &TobiiTypes::gazePoint::available);
+    ColumnToNpArray(out_, data_.gaze_point_available            , localName + "available");
 
     // 2. pupil
     localName = name_ + "_pupil_";
     // 2.1 pupil_diameter
-    FieldToNpArray<true>(out_, data_, localName + "diameter" , field_, &TobiiTypes::eyeData::pupil, &TobiiTypes::pupilData::diameter);
+    ColumnToNpArray(out_, data_.pupil_diameter                  , localName + "diameter");
     // 2.2 pupil_valid
-    FieldToNpArray<true>(out_, data_, localName + "valid"    , field_, &TobiiTypes::eyeData::pupil, &TobiiTypes::pupilData::validity, TOBII_RESEARCH_VALIDITY_VALID);
+    ColumnToNpArray(out_, data_.pupil_valid                     , localName + "valid");
     // 2.3 pupil_available
-    FieldToNpArray<true>(out_, data_, localName + "available", field_, &TobiiTypes::eyeData::pupil, &TobiiTypes::pupilData::available);
+    ColumnToNpArray(out_, data_.pupil_available                 , localName + "available");
 
     // 3. gazeOrigin
     localName = name_ + "_gaze_origin_";
     // 3.1 gaze_origin_in_user_coordinates
-    TobiiFieldToNpArray (out_, data_, localName + "in_user_coordinates"     , field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::position_in_user_coordinates);
+    ColumnToNpArray(out_, data_.gaze_origin_in_user_coordinates_x       , localName + "in_user_coordinates_x");
+    ColumnToNpArray(out_, data_.gaze_origin_in_user_coordinates_y       , localName + "in_user_coordinates_y");
+    ColumnToNpArray(out_, data_.gaze_origin_in_user_coordinates_z       , localName + "in_user_coordinates_z");
     // 3.2 gaze_origin_in_track_box_coordinates
-    TobiiFieldToNpArray (out_, data_, localName + "in_track_box_coordinates", field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::position_in_track_box_coordinates);
+    ColumnToNpArray(out_, data_.gaze_origin_in_track_box_coordinates_x  , localName + "in_track_box_coordinates_x");
+    ColumnToNpArray(out_, data_.gaze_origin_in_track_box_coordinates_y  , localName + "in_track_box_coordinates_y");
+    ColumnToNpArray(out_, data_.gaze_origin_in_track_box_coordinates_z  , localName + "in_track_box_coordinates_z");
     // 3.3 gaze_origin_valid
-    FieldToNpArray<true>(out_, data_, localName + "valid"                   , field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::validity, TOBII_RESEARCH_VALIDITY_VALID);
+    ColumnToNpArray(out_, data_.gaze_origin_valid                       , localName + "valid");
     // 3.4 gaze_origin_available
-    FieldToNpArray<true>(out_, data_, localName + "available"               , field_, &TobiiTypes::eyeData::gaze_origin, &TobiiTypes::gazeOrigin::available);
+    ColumnToNpArray(out_, data_.gaze_origin_available                   , localName + "available");
 
     // 4. eyeOpenness
     localName = name_ + "_eye_openness_";
     // 4.1 eye_openness_diameter
-    FieldToNpArray<true>(out_, data_, localName + "diameter"  , field_, &TobiiTypes::eyeData::eye_openness, &TobiiTypes::eyeOpenness::diameter);
+    ColumnToNpArray(out_, data_.eye_openness_diameter           , localName + "diameter");
     // 4.2 eye_openness_valid
-    FieldToNpArray<true>(out_, data_, localName + "valid"     , field_, &TobiiTypes::eyeData::eye_openness, &TobiiTypes::eyeOpenness::validity, TOBII_RESEARCH_VALIDITY_VALID);
+    ColumnToNpArray(out_, data_.eye_openness_valid              , localName + "valid");
     // 4.3 eye_openness_available
-    FieldToNpArray<true>(out_, data_, localName + "available" , field_, &TobiiTypes::eyeData::eye_openness, &TobiiTypes::eyeOpenness::available);
+    ColumnToNpArray(out_, data_.eye_openness_available          , localName + "available");
 }
 
 
 // eye images
-template <typename S, typename T, typename R>
-bool allEquals(const std::vector<S>& data_, T S::* field_, const R& ref_)
+template <typename Cont, typename M, typename R>
+bool allEquals(const Cont& data_, M field_, const R& ref_)
 {
     for (auto& frame : data_)
         if (frame.*field_ != ref_)
@@ -137,7 +158,8 @@ py::array_t<uint8_t> imageToNumpy(const TobiiTypes::eyeImage& e_)
     std::memcpy(a.mutable_data(), e_.data(), e_.data_size);
     return a;
 }
-void outputEyeImages(py::dict& out_, const std::vector<Titta::eyeImage>& data_, const std::string& name_)
+template <typename Cont>
+void outputEyeImages(py::dict& out_, const Cont& data_, const std::string& name_)
 {
     if (data_.empty())
     {
@@ -158,23 +180,30 @@ void outputEyeImages(py::dict& out_, const std::vector<Titta::eyeImage>& data_,
 
 
 
-py::dict StructVectorToDict(std::vector<Titta::gaze>&& data_)
+py::dict StructToDict(const Titta::gazeColumns& data_)
 {
     py::dict out;
 
     // 1. device timestamps
-    FieldToNpArray<true>(out, data_, "device_time_stamp", &Titta::gaze::device_time_stamp);
+    ColumnToNpArray(out, data_.device_time_stamp, "device_time_stamp");
     // 2. system timestamps
-    FieldToNpArray<true>(out, data_, "system_time_stamp", &Titta::gaze::system_time_stamp);
+    ColumnToNpArray(out, data_.system_time_stamp, "system_time_stamp");
     // 3. left  eye data
-    FieldToNpArray(out, data_, "left" , &Titta::gaze::left_eye);
+    FieldToNpArray(out, data_.left_eye , "left");
     // 4. right eye data
-    FieldToNpArray(out, data_, "right", &Titta::gaze::right_eye);
+    FieldToNpArray(out, data_.right_eye, "right");
 
     return out;
 }
+py::dict StructVectorToDict(std::vector<Titta::gaze>&& data_)
+{
+    // transpose to columns in a single pass over the samples, then output column by column
+    return StructToDict(Titta::gazeColumns(data_.begin(), data_.end()));
+}
 
-py::dict StructVectorToDict(std::vector<Titta::eyeImage>&& data_)
+// works on any container of eye images (std::vector, or Titta::BufferLease for direct access to buffer)
+template <typename Cont>
+py::dict EyeImagesToDict(const Cont& data_)
 {
     py::dict out;
 
@@ -198,6 +227,14 @@ py::dict StructVectorToDict(std::vector<Titta::eyeImage>&& data_)
 
     return out;
 }
+py::dict StructVectorToDict(std::vector<Titta::eyeImage>&& data_)
+{
+    return EyeImagesToDict(data_);
+}
+py::dict StructVectorToDict(const Titta::BufferLease<Titta::eyeImage>& data_)
+{
+    return EyeImagesToDict(data_);
+}
 
 py::dict StructVectorToDict(std::vector<Titta::extSignal>&& data_)
 {
@@ -433,6 +470,112 @@ py::dict StructToDict(const TobiiResearchDisplayArea& data_)
 
     return d;
 }
+
+py::dict StructToDict(const TobiiTypes::imagePool::stats& data_)
+{
+    py::dict d;
+    d["num_requests"] = data_.numRequests;
+    d["num_hits"] = data_.numHits;
+    d["hit_rate"] = data_.hitRate;
+    d["resident_bytes"] = data_.residentBytes;
+    d["idle_bytes"] = data_.idleBytes;
+
+    return d;
+}
+
+py::dict StructToDict(TittaJournal::contents&& data_)
+{
+    py::dict d;
+    d["gaze"] = StructVectorToDict(std::move(data_.gaze));
+    d["eye_image"] = StructVectorToDict(std::move(data_.eyeImage));
+    d["external_signal"] = StructVectorToDict(std::move(data_.extSignal));
+    d["time_sync"] = StructVectorToDict(std::move(data_.timeSync));
+    d["positioning"] = StructVectorToDict(std::move(data_.positioning));
+    d["notification"] = StructVectorToDict(std::move(data_.notification));
+    d["complete"] = data_.complete;
+
+    return d;
+}
+
+py::dict StructToDict(const Titta::CallbackTimingStats& data_)
+{
+    py::dict d;
+    d["num_callbacks"] = data_.numCallbacks;
+    d["mean_duration"] = data_.meanDuration;
+    d["max_duration"] = data_.maxDuration;
+
+    return d;
+}
+
+py::dict StructToDict(const TittaLatency::stats& data_)
+{
+    py::dict d;
+    d["count"] = data_.count;
+    d["min"] = data_.min;
+    d["mean"] = data_.mean;
+    d["p50"] = data_.p50;
+    d["p90"] = data_.p90;
+    d["p99"] = data_.p99;
+    d["p999"] = data_.p999;
+    d["max"] = data_.max;
+
+    return d;
+}
+
+py::dict StructToDict(const Titta::LatencyStats& data_)
+{
+    py::dict d;
+    d["callback"] = StructToDict(data_.callback);
+    d["commit"] = StructToDict(data_.commit);
+    d["read"] = StructToDict(data_.read);
+
+    return d;
+}
+
+py::dict StructToDict(const Titta::StreamCounters& data_)
+{
+    py::dict d;
+    d["num_callbacks"] = data_.numCallbacks;
+    d["num_committed"] = data_.numCommitted;
+    d["num_dropped"] = data_.numDropped;
+    d["num_buffered"] = data_.numBuffered;
+    d["buffer_bytes"] = data_.bufferBytes;
+    d["num_queued"] = data_.numQueued;
+    d["num_queue_dropped"] = data_.numQueueDropped;
+    d["num_lock_waits"] = data_.numLockWaits;
+    d["lock_wait_time"] = data_.lockWaitTime;
+    d["num_merged"] = data_.numMerged;
+    d["num_merge_timeouts"] = data_.numMergeTimeouts;
+
+    return d;
+}
+
+py::dict StructToDict(const std::map<Titta::Stream, Titta::StreamCounters>& data_)
+{
+    py::dict d;
+    for (const auto& [stream, counters] : data_)
+        d[Titta::streamToString(stream, true).c_str()] = StructToDict(counters);
+
+    return d;
+}
+
+py::dict StructToDict(const TittaSimulator::replayStats& data_)
+{
+    py::dict d;
+    d["finished"] = data_.finished;
+    d["num_gaze"] = data_.numGaze;
+    d["num_eye_openness"] = data_.numEyeOpenness;
+    d["num_eye_images"] = data_.numEyeImages;
+    d["num_ext_signals"] = data_.numExtSignals;
+    d["num_time_syncs"] = data_.numTimeSyncs;
+    d["recording_duration"] = data_.recordingDuration;
+    d["elapsed_time"] = data_.elapsedTime;
+    d["speed"] = data_.speed;
+    d["max_lag"] = data_.maxLag;
+    d["callback_time"] = data_.callbackTime;
+
+    return d;
+}
 }
 
 
@@ -578,6 +721,20 @@ PYBIND11_MODULE(MODULE_NAME, m)
     m.def("get_log", [](bool clearLog_) -> py::list { return StructVectorToList(Titta::getLog(clearLog_)); },
         py::arg_v("clear_log", std::nullopt, "None"));
     m.def("stop_logging", &Titta::stopLogging);
+    // eye image memory pool
+    m.def("get_eye_image_pool_stats", []() { return StructToDict(Titta::getEyeImagePoolStats()); });
+    // tracing
+    m.def("start_tracing", &Titta::startTracing,
+        py::arg_v("events_per_thread", std::nullopt, "None"));
+    m.def("stop_tracing", &Titta::stopTracing);
+    m.def("write_trace", &Titta::writeTrace,
+        "file_path"_a);
+    // journal
+    m.def("read_journal", [](std::string filePath_) { return StructToDict(Titta::readJournal(std::move(filePath_))); },
+        "file_path"_a);
+    // session files
+    m.def("convert_journal_to_session", &Titta::convertJournalToSession,
+        "journal_file_path"_a, "session_file_path"_a);
 
     // main class
     auto cET = py::class_<Titta>(m, "EyeTracker")
@@ -655,12 +812,47 @@ PYBIND11_MODULE(MODULE_NAME, m)
         // deal with eyeOpenness stream
         .def("set_include_eye_openness_in_gaze", &Titta::setIncludeEyeOpennessInGaze,
             "include"_a)
+        .def("set_gaze_merge_max_wait", &Titta::setGazeMergeMaxWait,
+            "max_wait"_a)
+        .def("get_gaze_merge_max_wait", &Titta::getGazeMergeMaxWait)
+
+        // ingest queue mode and callback timing
+        .def("set_use_ingest_queue", &Titta::setUseIngestQueue,
+            "use_queue"_a)
+        .def("get_use_ingest_queue", &Titta::getUseIngestQueue)
+        .def("get_callback_timing_stats", [](const Titta& instance_, std::string stream_) { return StructToDict(instance_.getCallbackTimingStats(std::move(stream_), true)); },
+            "stream"_a)
+        .def("get_callback_timing_stats", [](const Titta& instance_, Titta::Stream stream_) { return StructToDict(instance_.getCallbackTimingStats(stream_)); },
+            "stream"_a)
+        .def("get_latency_stats", [](const Titta& instance_, std::string stream_) { return StructToDict(instance_.getLatencyStats(std::move(stream_), true)); },
+            "stream"_a)
+        .def("get_latency_stats", [](const Titta& instance_, Titta::Stream stream_) { return StructToDict(instance_.getLatencyStats(stream_)); },
+            "stream"_a)
+        .def("get_counters", [](Titta& instance_) { return StructToDict(instance_.getCounters()); })
+        .def("get_replay_stats", [](const Titta& instance_) { return StructToDict(instance_.getReplayStats()); })
 
         // start stream
-        .def("start", [](Titta& instance_, std::string stream_, const std::optional<size_t> init_buf_, const std::optional<bool> as_gif_) { return instance_.start(std::move(stream_), init_buf_, as_gif_, true); },
-            "stream"_a, py::arg_v("initial_buffer_size", std::nullopt, "None"), py::arg_v("as_gif", std::nullopt, "None"))
-        .def("start", py::overload_cast<Titta::Stream, std::optional<size_t>, std::optional<bool>>(&Titta::start),
-            "stream"_a, py::arg_v("initial_buffer_size", std::nullopt, "None"), py::arg_v("as_gif", std::nullopt, "None"))
+        .def("start",
+            [](Titta& instance_, std::variant<std::string, Titta::Stream> stream_, const std::optional<size_t> init_buf_, const std::optional<bool> as_gif_, const std::optional<size_t> capacity_, std::optional<std::variant<std::string, Titta::OverflowPolicy>> overflow_policy_)
+            {
+                Titta::Stream stream;
+                if (std::holds_alternative<std::string>(stream_))
+                    stream = Titta::stringToStream(std::get<std::string>(stream_), true);
+                else
+                    stream = std::get<Titta::Stream>(stream_);
+
+                std::optional<Titta::OverflowPolicy> overflowPolicy;
+                if (overflow_policy_.has_value())
+                {
+                    if (std::holds_alternative<std::string>(*overflow_policy_))
+                        overflowPolicy = Titta::stringToOverflowPolicy(std::get<std::string>(*overflow_policy_));
+                    else
+                        overflowPolicy = std::get<Titta::OverflowPolicy>(*overflow_policy_);
+                }
+
+                return instance_.start(stream, init_buf_, as_gif_, capacity_, overflowPolicy);
+            },
+            "stream"_a, py::arg_v("initial_buffer_size", std::nullopt, "None"), py::arg_v("as_gif", std::nullopt, "None"), py::arg_v("capacity", std::nullopt, "None"), py::arg_v("overflow_policy", std::nullopt, "None"))
 
         // request stream state
         .def("is_recording", [](const Titta& instance_, std::string stream_) -> bool { return instance_.isRecording(std::move(stream_), true); },
@@ -692,7 +884,7 @@ PYBIND11_MODULE(MODULE_NAME, m)
                 {
                 case Titta::Stream::Gaze:
                 case Titta::Stream::EyeOpenness:
-                    return StructVectorToDict(instance_.consumeN<Titta::gaze>(NSamp_, bufSide));
+                    return StructToDict(instance_.consumeNColumns(NSamp_, bufSide));
                 case Titta::Stream::EyeImage:
                     return StructVectorToDict(instance_.consumeN<Titta::eyeImage>(NSamp_, bufSide));
                 case Titta::Stream::ExtSignal:
@@ -722,7 +914,7 @@ PYBIND11_MODULE(MODULE_NAME, m)
                 {
                 case Titta::Stream::Gaze:
                 case Titta::Stream::EyeOpenness:
-                    return StructVectorToDict(instance_.consumeTimeRange<Titta::gaze>(timeStart_, timeEnd_));
+                    return StructToDict(instance_.consumeTimeRangeColumns(timeStart_, timeEnd_));
                 case Titta::Stream::EyeImage:
                     return StructVectorToDict(instance_.consumeTimeRange<Titta::eyeImage>(timeStart_, timeEnd_));
                 case Titta::Stream::ExtSignal:
@@ -762,9 +954,10 @@ PYBIND11_MODULE(MODULE_NAME, m)
                 {
                 case Titta::Stream::Gaze:
                 case Titta::Stream::EyeOpenness:
-                    return StructVectorToDict(instance_.peekN<Titta::gaze>(NSamp_, bufSide));
+                    return StructToDict(instance_.peekNColumns(NSamp_, bufSide));
                 case Titta::Stream::EyeImage:
-                    return StructVectorToDict(instance_.peekN<Titta::eyeImage>(NSamp_, bufSide));
+                    // eye images are converted directly from the buffer, avoiding a copy
+                    return StructVectorToDict(instance_.peekNLease<Titta::eyeImage>(NSamp_, bufSide));
                 case Titta::Stream::ExtSignal:
                     return StructVectorToDict(instance_.peekN<Titta::extSignal>(NSamp_, bufSide));
                 case Titta::Stream::TimeSync:
@@ -792,9 +985,10 @@ PYBIND11_MODULE(MODULE_NAME, m)
                 {
                 case Titta::Stream::Gaze:
                 case Titta::Stream::EyeOpenness:
-                    return StructVectorToDict(instance_.peekTimeRange<Titta::gaze>(timeStart_, timeEnd_));
+                    return StructToDict(instance_.peekTimeRangeColumns(timeStart_, timeEnd_));
                 case Titta::Stream::EyeImage:
-                    return StructVectorToDict(instance_.peekTimeRange<Titta::eyeImage>(timeStart_, timeEnd_));
+                    // eye images are converted directly from the buffer, avoiding a copy
+                    return StructVectorToDict(instance_.peekTimeRangeLease<Titta::eyeImage>(timeStart_, timeEnd_));
                 case Titta::Stream::ExtSignal:
                     return StructVectorToDict(instance_.peekTimeRange<Titta::extSignal>(timeStart_, timeEnd_));
                 case Titta::Stream::TimeSync:
@@ -807,6 +1001,92 @@ PYBIND11_MODULE(MODULE_NAME, m)
                 return {};
             },
             "stream"_a, py::arg_v("time_start", std::nullopt, "None"), py::arg_v("time_end", std::nullopt, "None"))
+        // get most recent sample without touching the buffer (output has the same format as peek_N, one or no sample)
+        .def("get_latest",
+            [](const Titta& instance_, std::variant<std::string, Titta::Stream> stream_)
+            -> py::dict
+            {
+                Titta::Stream stream;
+                if (std::holds_alternative<std::string>(stream_))
+                    stream = Titta::stringToStream(std::get<std::string>(stream_), true);
+                else
+                    stream = std::get<Titta::Stream>(stream_);
+
+                auto toVector = [](auto&& sample_)
+                {
+                    std::vector<typename std::decay_t<decltype(sample_)>::value_type> out;
+                    if (sample_)
+                        out.push_back(*sample_);
+                    return out;
+                };
+
+                switch (stream)
+                {
+                case Titta::Stream::Gaze:
+                case Titta::Stream::EyeOpenness:
+                    return StructVectorToDict(toVector(instance_.getLatest<Titta::gaze>()));
+                case Titta::Stream::EyeImage:
+                    DoExitWithMsg("Titta::cpp::get_latest: not supported for eye_image stream.");
+                case Titta::Stream::ExtSignal:
+                    return StructVectorToDict(toVector(instance_.getLatest<Titta::extSignal>()));
+                case Titta::Stream::TimeSync:
+                    return StructVectorToDict(toVector(instance_.getLatest<Titta::timeSync>()));
+                case Titta::Stream::Positioning:
+                    return StructVectorToDict(toVector(instance_.getLatest<Titta::positioning>()));
+                case Titta::Stream::Notification:
+                    DoExitWithMsg("Titta::cpp::get_latest: not supported for notification stream.");
+                }
+                return {};
+            },
+            "stream"_a)
+
+        // cursors, for reading a stream incrementally (returns samples the cursor has not yet passed, by default all)
+        .def("open_cursor",
+            [](Titta& instance_, std::variant<std::string, Titta::Stream> stream_, std::optional<std::variant<std::string, Titta::BufferSide>> side_, const std::optional<bool> reclaim_)
+            {
+                Titta::Stream stream;
+                if (std::holds_alternative<std::string>(stream_))
+                    stream = Titta::stringToStream(std::get<std::string>(stream_), true);
+                else
+                    stream = std::get<Titta::Stream>(stream_);
+
+                std::optional<Titta::BufferSide> bufSide;
+                if (side_.has_value())
+                {
+                    if (std::holds_alternative<std::string>(*side_))
+                        bufSide = Titta::stringToBufferSide(std::get<std::string>(*side_));
+                    else
+                        bufSide = std::get<Titta::BufferSide>(*side_);
+                }
+
+                return instance_.openCursor(stream, bufSide, reclaim_);
+            },
+            "stream"_a, py::arg_v("side", std::nullopt, "None"), py::arg_v("reclaim", std::nullopt, "None"))
+        .def("read_since",
+            [](Titta& instance_, const uint64_t cursor_, const std::optional<size_t> NSamp_)
+            -> py::dict
+            {
+                switch (instance_.getCursorStream(cursor_))
+                {
+                case Titta::Stream::Gaze:
+                case Titta::Stream::EyeOpenness:
+                    return StructVectorToDict(instance_.readSince<Titta::gaze>(cursor_, NSamp_));
+                case Titta::Stream::EyeImage:
+                    return StructVectorToDict(instance_.readSince<Titta::eyeImage>(cursor_, NSamp_));
+                case Titta::Stream::ExtSignal:
+                    return StructVectorToDict(instance_.readSince<Titta::extSignal>(cursor_, NSamp_));
+                case Titta::Stream::TimeSync:
+                    return StructVectorToDict(instance_.readSince<Titta::timeSync>(cursor_, NSamp_));
+                case Titta::Stream::Positioning:
+                    return StructVectorToDict(instance_.readSince<Titta::positioning>(cursor_, NSamp_));
+                case Titta::Stream::Notification:
+                    return StructVectorToDict(instance_.readSince<Titta::notification>(cursor_, NSamp_));
+                }
+                return {};
+            },
+            "cursor"_a, py::arg_v("N_samples", std::nullopt, "None"))
+        .def("close_cursor", &Titta::closeCursor,
+            "cursor"_a)
 
         // clear all buffer contents
         .def("clear", [](Titta& instance_, std::string stream_) { return instance_.clear(std::move(stream_), true); },
@@ -825,6 +1105,29 @@ PYBIND11_MODULE(MODULE_NAME, m)
             "stream"_a, py::arg_v("clear_buffer", std::nullopt, "None"))
         .def("stop", py::overload_cast<Titta::Stream, std::optional<bool>>(&Titta::stop),
             "stream"_a, py::arg_v("clear_buffer", std::nullopt, "None"))
+
+        // number of samples discarded because the buffer was full
+        .def("get_num_dropped_samples", [](Titta& instance_, std::string stream_) { return instance_.getNumDroppedSamples(std::move(stream_), true); },
+            "stream"_a)
+        .def("get_num_dropped_samples", py::overload_cast<Titta::Stream>(&Titta::getNumDroppedSamples),
+            "stream"_a)
+
+        // journal: continuously write all recorded samples to file
+        .def("start_journal", &Titta::startJournal,
+            "file_path"_a, py::arg_v("in_memory_window", std::nullopt, "None"))
+        .def("stop_journal", &Titta::stopJournal)
+        .def("is_journaling", &Titta::isJournaling)
+        .def("save_session", &Titta::saveSession,
+            "file_path"_a)
+
+        // parquet export
+        .def("save_parquet", &Titta::saveParquet,
+            "file_path_base"_a, py::arg_v("row_group_size", std::nullopt, "None"))
+        .def("start_parquet", &Titta::startParquet,
+            "file_path_base"_a, py::arg_v("row_group_size", std::nullopt, "None"))
+        .def("flush_parquet", &Titta::flushParquet)
+        .def("stop_parquet", &Titta::stopParquet)
+        .def("is_writing_parquet", &Titta::isWritingParquet)
         ;
 
     // nested enums
@@ -843,6 +1146,46 @@ PYBIND11_MODULE(MODULE_NAME, m)
         .value(Titta::bufferSideToString(Titta::BufferSide::End).c_str(), Titta::BufferSide::End)
         ;
 
+    py::enum_<Titta::OverflowPolicy>(cET, "overflow_policy")
+        .value(Titta::overflowPolicyToString(Titta::OverflowPolicy::DropOldest, true).c_str(), Titta::OverflowPolicy::DropOldest)
+        .value(Titta::overflowPolicyToString(Titta::OverflowPolicy::DropNewest, true).c_str(), Titta::OverflowPolicy::DropNewest)
+        ;
+
+    // reader for session files
+    py::class_<TittaSession::reader>(m, "SessionReader")
+        .def(py::init<std::string>(), "file_path"_a)
+        // get samples within given timestamps (inclusive, by default whole file)
+        .def("peek_time_range",
+            [](const TittaSession::reader& instance_, std::variant<std::string, Titta::Stream> stream_, const std::optional<int64_t> timeStart_, const std::optional<int64_t> timeEnd_)
+            -> py::dict
+            {
+                Titta::Stream stream;
+                if (std::holds_alternative<std::string>(stream_))
+                    stream = Titta::stringToStream(std::get<std::string>(stream_), true);
+                else
+                    stream = std::get<Titta::Stream>(stream_);
+
+                switch (stream)
+                {
+                case Titta::Stream::Gaze:
+                case Titta::Stream::EyeOpenness:
+                    return StructVectorToDict(instance_.peekTimeRange<Titta::gaze>(timeStart_, timeEnd_));
+                case Titta::Stream::EyeImage:
+                    return StructVectorToDict(instance_.peekTimeRange<Titta::eyeImage>(timeStart_, timeEnd_));
+                case Titta::Stream::ExtSignal:
+                    return StructVectorToDict(instance_.peekTimeRange<Titta::extSignal>(timeStart_, timeEnd_));
+                case Titta::Stream::TimeSync:
+                    return StructVectorToDict(instance_.peekTimeRange<Titta::timeSync>(timeStart_, timeEnd_));
+                case Titta::Stream::Positioning:
+                    DoExitWithMsg("Titta::cpp::SessionReader::peek_time_range: not supported for positioning stream.");
+                case Titta::Stream::Notification:
+                    return StructVectorToDict(instance_.peekTimeRange<Titta::notification>(timeStart_, timeEnd_));
+                }
+                return {};
+            },
+            "stream"_a, py::arg_v("time_start", std::nullopt, "None"), py::arg_v("time_end", std::nullopt, "None"))
+        ;
+
 // set module version info
 #define Q(x) #x
 #define QUOTE(x) Q(x)
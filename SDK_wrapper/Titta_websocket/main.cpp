@@ -168,6 +168,7 @@ int main()
     // global Tobii Buffer instance
     std::unique_ptr<Titta> TittaInstance;
     TobiiResearchEyeTracker* eyeTracker = nullptr;
+    std::unique_ptr<TittaSimulator::tracker> simulator;    // when connected to a simulated eye tracker (see Titta/simulator.h)
 
     uWS::Hub h;
     std::atomic<int> nClients = 0;
@@ -196,7 +197,7 @@ int main()
         nClients++;
     });
 
-    h.onMessage([&h, &TittaInstance, &eyeTracker, &tobiiBroadcastCallback, &downSampFac, &baseSampleFreq, &needSetSampleStreamFreq](uWS::WebSocket<uWS::SERVER> *ws, char *message, size_t length, uWS::OpCode opCode)
+    h.onMessage([&h, &TittaInstance, &eyeTracker, &simulator, &tobiiBroadcastCallback, &downSampFac, &baseSampleFreq, &needSetSampleStreamFreq](uWS::WebSocket<uWS::SERVER> *ws, char *message, size_t length, uWS::OpCode opCode)
     {
         auto jsonInput = json::parse(std::string(message, length),nullptr,false);
         if (jsonInput.is_discarded() || jsonInput.is_null())
@@ -227,6 +228,20 @@ int main()
         {
             case Action::Connect:
             {
+                // optionally, the address of the eye tracker to connect to can be provided. Only used for simulated
+                // eye trackers, e.g. {"action": "connect", "address": "sim://?frequency=1200"}
+                if (!eyeTracker && !simulator && jsonInput.count("address") && TittaSimulator::isSimulatorAddress(jsonInput.at("address").get<std::string>()))
+                {
+                    const auto simAddress = jsonInput.at("address").get<std::string>();
+                    simulator = std::make_unique<TittaSimulator::tracker>(TittaSimulator::settings::fromAddress(simAddress), simAddress);
+                }
+                if (simulator)
+                {
+                    const auto info = simulator->getInfo();
+                    sendJson(ws, {{"action", "connect"}, {"deviceModel", info.model}, {"serialNumber", info.serialNumber}, {"address", info.address}});
+                    break;
+                }
+
                 if (!eyeTracker)
                 {
                     TobiiResearchEyeTrackers* eyetrackers = nullptr;
@@ -300,14 +315,19 @@ int main()
                 else
                 {
                     TobiiResearchGazeOutputFrequencies* tobiiFreqs = nullptr;
-                    TobiiResearchStatus result = tobii_research_get_all_gaze_output_frequencies(eyeTracker, &tobiiFreqs);
-                    if (result != TOBII_RESEARCH_STATUS_OK)
+                    if (simulator)
+                        frequencies = simulator->getInfo().supportedFrequencies;
+                    else
                     {
-                        sendTobiiErrorAsJson(ws, result, "Problem getting sampling frequencies");
-                        return;
+                        TobiiResearchStatus result = tobii_research_get_all_gaze_output_frequencies(eyeTracker, &tobiiFreqs);
+                        if (result != TOBII_RESEARCH_STATUS_OK)
+                        {
+                            sendTobiiErrorAsJson(ws, result, "Problem getting sampling frequencies");
+                            return;
+                        }
+                        frequencies.insert(frequencies.end(),&tobiiFreqs->frequencies[0], &tobiiFreqs->frequencies[tobiiFreqs->frequency_count]);   // yes, pointer to one past last element
+                        tobii_research_free_gaze_output_frequencies(tobiiFreqs);
                     }
-                    frequencies.insert(frequencies.end(),&tobiiFreqs->frequencies[0], &tobiiFreqs->frequencies[tobiiFreqs->frequency_count]);   // yes, pointer to one past last element
-                    tobii_research_free_gaze_output_frequencies(tobiiFreqs);
                 }
 
                 // see if the requested frequency is a divisor of any of the supported frequencies, choose the best one (lowest possible frequency)
@@ -343,7 +363,7 @@ int main()
                 freq = *best;
 
                 // now set the tracker to the base frequency
-                TobiiResearchStatus result = tobii_research_set_gaze_output_frequency(eyeTracker, freq);
+                TobiiResearchStatus result = simulator ? simulator->setGazeOutputFrequency(freq) : tobii_research_set_gaze_output_frequency(eyeTracker, freq);
                 if (result != TOBII_RESEARCH_STATUS_OK)
                 {
                     sendTobiiErrorAsJson(ws, result, "Problem setting sampling frequency");
@@ -361,7 +381,8 @@ int main()
                     sendJson(ws, {{"error", "startSampleStream"},{"reason","You have to set the stream sample rate first using action setSampleStreamFreq. NB: you also have to do this after calling setBaseSampleFreq."}});
                     return;
                 }
-                TobiiResearchStatus result = tobii_research_subscribe_to_gaze_data(eyeTracker, &invoke_function, new std::function<void(TobiiResearchGazeData*)>(tobiiBroadcastCallback));
+                auto callback = new std::function<void(TobiiResearchGazeData*)>(tobiiBroadcastCallback);
+                TobiiResearchStatus result = simulator ? simulator->subscribe(&invoke_function, callback) : tobii_research_subscribe_to_gaze_data(eyeTracker, &invoke_function, callback);
                 if (result != TOBII_RESEARCH_STATUS_OK)
                 {
                     sendTobiiErrorAsJson(ws, result, "Problem subscribing to gaze data");
@@ -373,7 +394,7 @@ int main()
             }
             case Action::StopSampleStream:
             {
-                TobiiResearchStatus result = tobii_research_unsubscribe_from_gaze_data(eyeTracker, &invoke_function);
+                TobiiResearchStatus result = simulator ? simulator->unsubscribe(&invoke_function) : tobii_research_unsubscribe_from_gaze_data(eyeTracker, &invoke_function);
                 if (result != TOBII_RESEARCH_STATUS_OK)
                 {
                     sendTobiiErrorAsJson(ws, result, "Problem unsubscribing from gaze data");
@@ -394,7 +415,7 @@ int main()
                 auto freq = jsonInput.at("freq").get<float>();
 
                 // now set the tracker to the base frequency
-                TobiiResearchStatus result = tobii_research_set_gaze_output_frequency(eyeTracker, freq);
+                TobiiResearchStatus result = simulator ? simulator->setGazeOutputFrequency(freq) : tobii_research_set_gaze_output_frequency(eyeTracker, freq);
                 if (result != TOBII_RESEARCH_STATUS_OK)
                 {
                     sendTobiiErrorAsJson(ws, result, "Problem setting sampling frequency");
@@ -405,7 +426,10 @@ int main()
                 // user needs to reset sampleStream frequency after calling this, as downsample factor may have changed or requested may even have become unavailable
                 needSetSampleStreamFreq = true;
                 // also ensure no stream is currently active
-                tobii_research_unsubscribe_from_gaze_data(eyeTracker, &invoke_function);
+                if (simulator)
+                    simulator->unsubscribe(&invoke_function);
+                else
+                    tobii_research_unsubscribe_from_gaze_data(eyeTracker, &invoke_function);
 
                 sendJson(ws, {{"action", "setSampleFreq"}, {"freq", freq}, {"status", true}});
                 break;
@@ -413,7 +437,10 @@ int main()
             case Action::StartSampleBuffer:
             {
                 if (!TittaInstance.get())
-                    if (eyeTracker)
+                    if (simulator)
+                        // buffer is fed by its own simulated eye tracker with the same settings
+                        TittaInstance = std::make_unique<Titta>(simulator->getInfo().address);
+                    else if (eyeTracker)
                         TittaInstance = std::make_unique<Titta>(eyeTracker);
                     else
                     {
@@ -613,13 +640,16 @@ int main()
         }
     });
 
-    h.onDisconnection([&h,&nClients,&eyeTracker,&TittaInstance](uWS::WebSocket<uWS::SERVER> *ws, int code, char *message, size_t length)
+    h.onDisconnection([&h,&nClients,&eyeTracker,&simulator,&TittaInstance](uWS::WebSocket<uWS::SERVER> *ws, int code, char *message, size_t length)
     {
         std::cout << "Client disconnected, code " << code << std::endl;
         if (--nClients == 0)
         {
             std::cout << "No clients left, stopping buffering and streaming, if active..." << std::endl;
-            tobii_research_unsubscribe_from_gaze_data(eyeTracker, &invoke_function);
+            if (simulator)
+                simulator->unsubscribe(&invoke_function);
+            else
+                tobii_research_unsubscribe_from_gaze_data(eyeTracker, &invoke_function);
             if (TittaInstance.get())
                 TittaInstance.get()->stop("gaze");
         }
@@ -34,6 +34,13 @@ if isOctave
         fullfile(myDir,'src','Titta.cpp')
         fullfile(myDir,'src','types.cpp')
         fullfile(myDir,'src','utils.cpp')
+        fullfile(myDir,'src','journal.cpp')
+        fullfile(myDir,'src','session.cpp')
+        fullfile(myDir,'src','parquet.cpp')
+        fullfile(myDir,'src','convert.cpp')
+        fullfile(myDir,'src','simulator.cpp')
+        fullfile(myDir,'src','latency.cpp')
+        fullfile(myDir,'src','trace.cpp')
         '-ltobii_research'}.';
 
     if isLinux
@@ -33,7 +33,7 @@ class get_pybind_include(object):
 ext_modules = [
     Extension(
         'TittaPy',
-        ['src/Titta.cpp','src/types.cpp','src/utils.cpp','TittaPy/TittaPy.cpp'],
+        ['src/Titta.cpp','src/types.cpp','src/utils.cpp','src/journal.cpp','src/session.cpp','src/parquet.cpp','src/convert.cpp','src/simulator.cpp','src/latency.cpp','src/trace.cpp','TittaPy/TittaPy.cpp'],
         include_dirs=[
             # Path to pybind11 headers
             get_pybind_include(),
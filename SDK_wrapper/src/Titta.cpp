@@ -6,6 +6,8 @@
 #include <cstring>
 
 #include "Titta/utils.h"
+#include "Titta/convert.h"
+#include "Titta/trace.h"
 
 namespace
 {
@@ -28,6 +30,10 @@ namespace
 
         constexpr size_t                notificationBufSize       = 2<<6;
 
+        constexpr auto                  ingestDrainInterval       = std::chrono::milliseconds(1);
+
+        constexpr int64_t               gazeMergeMaxWait          = 10'000;       // microseconds
+
         constexpr int64_t               clearTimeRangeStart       = 0;
         constexpr int64_t               clearTimeRangeEnd         = std::numeric_limits<int64_t>::max();
 
@@ -40,6 +46,15 @@ namespace
         constexpr size_t                peekNSamp                 = 1;
         constexpr int64_t               peekTimeRangeStart        = 0;
         constexpr int64_t               peekTimeRangeEnd          = std::numeric_limits<int64_t>::max();
+        constexpr Titta::BufferSide     cursorSide                = Titta::BufferSide::Start;
+        constexpr bool                  cursorReclaim             = false;
+        constexpr size_t                readSinceNSamp            = -1;           // this overflows on purpose, read all new samples is default
+
+        constexpr auto                  journalInterval           = std::chrono::milliseconds(100);
+        constexpr size_t                journalInMemoryWindow     = 0;            // 0: keep all samples in memory
+
+        constexpr size_t                parquetRowGroupSize       = 2<<15;
+        constexpr uint64_t              parquetMaxRowGroupBytes   = 256<<20;      // a row group is also ended when it reaches this size (eye images)
 
         constexpr size_t                logBufSize                = 2<<8;
         constexpr bool                  logBufClear               = true;
@@ -74,6 +89,18 @@ namespace
         { "end",            Titta::BufferSide::End }
     };
 
+    // Map string to an Overflow Policy
+    const std::map<std::string, Titta::OverflowPolicy> overflowPolicyMapCamelCase =
+    {
+        { "dropOldest",     Titta::OverflowPolicy::DropOldest },
+        { "dropNewest",     Titta::OverflowPolicy::DropNewest }
+    };
+    const std::map<std::string, Titta::OverflowPolicy> overflowPolicyMapSnakeCase =
+    {
+        { "drop_oldest",    Titta::OverflowPolicy::DropOldest },
+        { "drop_newest",    Titta::OverflowPolicy::DropNewest }
+    };
+
     std::unique_ptr<std::vector<Titta*>> g_allInstances = std::make_unique<std::vector<Titta*>>();
 }
 
@@ -109,7 +136,7 @@ std::vector<std::string> Titta::getAllStreams(const bool snakeCase_ /*= false*/,
     std::vector<std::string> out;
 
     for (auto val = static_cast<val_t>(Titta::Stream::Gaze); val < static_cast<val_t>(Titta::Stream::Last); val++)
-        if (!forLSL_ || !(val == static_cast<val_t>(Titta::Stream::EyeImage) || val == static_cast<val_t>(Titta::Stream::EyeOpenness) || val==static_cast<val_t>(Titta::Stream::Notification)))
+        if (!forLSL_ || !(val == static_cast<val_t>(Titta::Stream::EyeOpenness) || val==static_cast<val_t>(Titta::Stream::Notification)))
             out.push_back(Titta::streamToString(static_cast<Titta::Stream>(val), snakeCase_));
 
     return out;
@@ -173,66 +200,159 @@ std::string Titta::getAllBufferSidesString(const char* quoteChar_ /*= "\""*/)
     return out;
 }
 
+Titta::OverflowPolicy Titta::stringToOverflowPolicy(std::string overflowPolicy_)
+{
+    auto it = overflowPolicyMapCamelCase.find(overflowPolicy_);
+    if (it == overflowPolicyMapCamelCase.end())
+    {
+        it = overflowPolicyMapSnakeCase.find(overflowPolicy_);
+        if (it == overflowPolicyMapSnakeCase.end())
+        {
+            DoExitWithMsg(
+                R"(Titta::cpp: Requested overflow policy ")" + overflowPolicy_ + R"(" is not recognized. Supported overflow policies are: )" + Titta::getAllOverflowPoliciesString("\"")
+            );
+        }
+    }
+    return it->second;
+}
+
+std::string Titta::overflowPolicyToString(Titta::OverflowPolicy overflowPolicy_, const bool snakeCase_ /*= false*/)
+{
+    std::pair<std::string, Titta::OverflowPolicy> v;
+    if (snakeCase_)
+        v = *std::find_if(overflowPolicyMapSnakeCase.begin(), overflowPolicyMapSnakeCase.end(), [&overflowPolicy_](auto p_) {return p_.second == overflowPolicy_;});
+    else
+        v = *std::find_if(overflowPolicyMapCamelCase.begin(), overflowPolicyMapCamelCase.end(), [&overflowPolicy_](auto p_) {return p_.second == overflowPolicy_;});
+    return v.first;
+}
+
+std::vector<std::string> Titta::getAllOverflowPolicies(const bool snakeCase_ /*= false*/)
+{
+    using val_t = std::underlying_type_t<Titta::OverflowPolicy>;
+    std::vector<std::string> out;
+
+    for (auto val = static_cast<val_t>(Titta::OverflowPolicy::DropOldest); val < static_cast<val_t>(Titta::OverflowPolicy::Last); val++)
+        out.push_back(Titta::overflowPolicyToString(static_cast<Titta::OverflowPolicy>(val), snakeCase_));
+
+    return out;
+}
+
+std::string Titta::getAllOverflowPoliciesString(const char* quoteChar_ /*= "\""*/, const bool snakeCase_ /*= false*/)
+{
+    std::string out;
+    bool first = true;
+    for (auto const& s : Titta::getAllOverflowPolicies(snakeCase_))
+    {
+        if (first)
+            first = false;
+        else
+            out += ", ";
+        out += quoteChar_ + s + quoteChar_;
+    }
+    return out;
+}
+
 // callbacks
 void TittaGazeCallback(TobiiResearchGazeData* gaze_data_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("gaze callback", "callback", "gaze");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        instance->receiveSample(gaze_data_, nullptr);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::Gaze).callback.record(now - gaze_data_->system_time_stamp);
+        if (instance->_useIngestQueue)
+        {
+            if (!instance->_gazeIngestQueue.try_emplace(now, *gaze_data_))
+                instance->getBufferCounters<Titta::gaze>().numQueueDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+            instance->receiveSample(gaze_data_, nullptr, now);
+        instance->getCallbackTimer(Titta::Stream::Gaze).add(t0);
     }
 }
 void TittaEyeOpennessCallback(TobiiResearchEyeOpennessData* openness_data_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("eyeOpenness callback", "callback", "eyeOpenness");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        instance->receiveSample(nullptr, openness_data_);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::EyeOpenness).callback.record(now - openness_data_->system_time_stamp);
+        if (instance->_useIngestQueue)
+        {
+            // eye openness has no buffer of its own, so its counter is kept in the slot of the stream
+            if (!instance->_eyeOpennessIngestQueue.try_emplace(now, *openness_data_))
+                instance->_bufferCounters[static_cast<size_t>(Titta::Stream::EyeOpenness)].numQueueDropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+            instance->receiveSample(nullptr, openness_data_, now);
+        instance->getCallbackTimer(Titta::Stream::EyeOpenness).add(t0);
     }
 }
 void TittaEyeImageCallback(TobiiResearchEyeImage* eye_image_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("eyeImage callback", "callback", "eyeImage");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        auto l = instance->lockForWriting<Titta::eyeImage>();
-        instance->_eyeImages.emplace_back(eye_image_);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::EyeImage).callback.record(now - eye_image_->system_time_stamp);
+        instance->ingestSample<Titta::eyeImage>(now, eye_image_);
+        instance->getCallbackTimer(Titta::Stream::EyeImage).add(t0);
     }
 }
 void TittaEyeImageGifCallback(TobiiResearchEyeImageGif* eye_image_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("eyeImage callback", "callback", "eyeImage");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        auto l = instance->lockForWriting<Titta::eyeImage>();
-        instance->_eyeImages.emplace_back(eye_image_);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::EyeImage).callback.record(now - eye_image_->system_time_stamp);
+        instance->ingestSample<Titta::eyeImage>(now, eye_image_);
+        instance->getCallbackTimer(Titta::Stream::EyeImage).add(t0);
     }
 }
 void TittaExtSignalCallback(TobiiResearchExternalSignalData* ext_signal_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("externalSignal callback", "callback", "externalSignal");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        auto l = instance->lockForWriting<Titta::extSignal>();
-        instance->_extSignal.push_back(*ext_signal_);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::ExtSignal).callback.record(now - ext_signal_->system_time_stamp);
+        instance->ingestSample<Titta::extSignal>(now, *ext_signal_);
+        instance->getCallbackTimer(Titta::Stream::ExtSignal).add(t0);
     }
 }
 void TittaTimeSyncCallback(TobiiResearchTimeSynchronizationData* time_sync_data_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("timeSync callback", "callback", "timeSync");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        auto l = instance->lockForWriting<Titta::timeSync>();
-        instance->_timeSync.push_back(*time_sync_data_);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::TimeSync).callback.record(now - time_sync_data_->system_response_time_stamp);
+        instance->ingestSample<Titta::timeSync>(now, *time_sync_data_);
+        instance->getCallbackTimer(Titta::Stream::TimeSync).add(t0);
     }
 }
 void TittaPositioningCallback(TobiiResearchUserPositionGuide* position_data_, void* user_data_)
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("positioning callback", "callback", "positioning");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        auto l = instance->lockForWriting<Titta::positioning>();
-        instance->_positioning.push_back(*position_data_);
+        instance->ingestSample<Titta::positioning>(Titta::getSystemTimestamp(), *position_data_);
+        instance->getCallbackTimer(Titta::Stream::Positioning).add(t0);
     }
 }
 void TittaLogCallback(int64_t system_time_stamp_, TobiiResearchLogSource source_, TobiiResearchLogLevel level_, const char* message_)
@@ -263,9 +383,13 @@ void TittaNotificationCallback(TobiiResearchNotification* notification_, void* u
 {
     if (user_data_)
     {
+        TittaTrace::scope trace("notification callback", "callback", "notification");
+        const auto t0 = std::chrono::steady_clock::now();
         const auto instance = static_cast<Titta*>(user_data_);
-        auto l = instance->lockForWriting<Titta::notification>();
-        instance->_notification.emplace_back(*notification_);
+        const auto now = Titta::getSystemTimestamp();
+        instance->getLatencyHistograms(Titta::Stream::Notification).callback.record(now - notification_->system_time_stamp);
+        instance->ingestSample<Titta::notification>(now, *notification_);
+        instance->getCallbackTimer(Titta::Stream::Notification).add(t0);
     }
 }
 
@@ -301,6 +425,9 @@ std::vector<TobiiTypes::eyeTracker> Titta::findAllEyeTrackers()
 }
 TobiiTypes::eyeTracker Titta::getEyeTrackerFromAddress(std::string address_)
 {
+    if (TittaSimulator::isSimulatorAddress(address_))
+        return TittaSimulator::tracker(TittaSimulator::settings::fromAddress(address_), address_).getInfo();
+
     TobiiResearchEyeTracker* et;
     const TobiiResearchStatus status = tobii_research_get_eyetracker(address_.c_str(), &et);
     if (status != TOBII_RESEARCH_STATUS_OK)
@@ -364,18 +491,42 @@ bool Titta::stopLogging()
     return success;
 }
 
+TobiiTypes::imagePool::stats Titta::getEyeImagePoolStats()
+{
+    return TobiiTypes::imagePool::getStats();
+}
+
+void Titta::startTracing(std::optional<size_t> eventsPerThread_)
+{
+    if (eventsPerThread_ && !*eventsPerThread_)
+        DoExitWithMsg("Titta::cpp::startTracing: eventsPerThread must be larger than zero");
+    TittaTrace::start(eventsPerThread_);
+}
+void Titta::stopTracing()
+{
+    TittaTrace::stop();
+}
+void Titta::writeTrace(std::string filePath_)
+{
+    TittaTrace::writeChromeTrace(filePath_);
+}
+
 namespace
 {
     // eye image helpers
-    TobiiResearchStatus doSubscribeEyeImage(TobiiResearchEyeTracker* eyetracker_, Titta* instance_, const bool asGif_)
+    TobiiResearchStatus doSubscribeEyeImage(TobiiResearchEyeTracker* eyetracker_, TittaSimulator::tracker* simulator_, Titta* instance_, const bool asGif_)
     {
+        if (simulator_)
+            return asGif_ ? simulator_->subscribe(TittaEyeImageGifCallback, instance_) : simulator_->subscribe(TittaEyeImageCallback, instance_);
         if (asGif_)
             return tobii_research_subscribe_to_eye_image_as_gif(eyetracker_, TittaEyeImageGifCallback, instance_);
         else
             return tobii_research_subscribe_to_eye_image       (eyetracker_,    TittaEyeImageCallback, instance_);
     }
-    TobiiResearchStatus doUnsubscribeEyeImage(TobiiResearchEyeTracker* eyetracker_, const bool isGif_)
+    TobiiResearchStatus doUnsubscribeEyeImage(TobiiResearchEyeTracker* eyetracker_, TittaSimulator::tracker* simulator_, const bool isGif_)
     {
+        if (simulator_)
+            return isGif_ ? simulator_->unsubscribe(TittaEyeImageGifCallback) : simulator_->unsubscribe(TittaEyeImageCallback);
         if (isGif_)
             return tobii_research_unsubscribe_from_eye_image_as_gif(eyetracker_, TittaEyeImageGifCallback);
         else
@@ -388,6 +539,14 @@ namespace
 
 Titta::Titta(std::string address_)
 {
+    if (TittaSimulator::isSimulatorAddress(address_))
+    {
+        _simulator  = std::make_unique<TittaSimulator::tracker>(TittaSimulator::settings::fromAddress(address_), address_);
+        _eyeTracker = _simulator->getInfo();
+        Init();
+        return;
+    }
+
     TobiiResearchEyeTracker* et;
     const TobiiResearchStatus status = tobii_research_get_eyetracker(address_.c_str(), &et);
     if (status != TOBII_RESEARCH_STATUS_OK)
@@ -402,6 +561,13 @@ Titta::Titta(TobiiResearchEyeTracker* et_)
 }
 Titta::~Titta()
 {
+    // before stopping streams, which deletes the buffers. NB: errors are not raised from the destructor
+    stopJournalImpl();
+    try
+    {
+        stopParquet();
+    }
+    catch (...) {}
     stop(Stream::Gaze,        true);
     stop(Stream::EyeOpenness, true);
     stop(Stream::EyeImage,    true);
@@ -409,6 +575,7 @@ Titta::~Titta()
     stop(Stream::TimeSync,    true);
     stop(Stream::Positioning, true);
     stop(Stream::Notification,true);
+    stopIngestDrainThread();
 
     if (_eyeTracker.et)
         tobii_research_unsubscribe_from_stream_errors(_eyeTracker.et, TittaStreamErrorCallback);
@@ -437,8 +604,10 @@ void Titta::Init()
         }
 
         // start stream error logging
-        tobii_research_subscribe_to_stream_errors(_eyeTracker.et, TittaStreamErrorCallback, _eyeTracker.et);
+        if (_eyeTracker.et)
+            tobii_research_subscribe_to_stream_errors(_eyeTracker.et, TittaStreamErrorCallback, _eyeTracker.et);
     }
+    _gazeMergeMaxWait = defaults::gazeMergeMaxWait;
     start(Stream::Notification);    // always start notification stream as soon as we're connected
     if (g_allInstances)
         g_allInstances->push_back(this);
@@ -448,12 +617,21 @@ void Titta::Init()
 TobiiTypes::eyeTracker Titta::getEyeTrackerInfo(std::optional<std::string> paramToRefresh_ /*= std::nullopt*/)
 {
     // refresh ET info to make sure its up to date
-    _eyeTracker.refreshInfo(std::move(paramToRefresh_));
+    refreshEyeTrackerInfo(std::move(paramToRefresh_));
 
     return _eyeTracker;
 }
+void Titta::refreshEyeTrackerInfo(std::optional<std::string> paramToRefresh_ /*= std::nullopt*/)
+{
+    if (_simulator)
+        _eyeTracker = _simulator->getInfo();
+    else
+        _eyeTracker.refreshInfo(std::move(paramToRefresh_));
+}
 TobiiResearchTrackBox Titta::getTrackBox() const
 {
+    if (_simulator)
+        return _simulator->getTrackBox();
     TobiiResearchTrackBox track_box;
     const TobiiResearchStatus status = tobii_research_get_track_box(_eyeTracker.et, &track_box);
     if (status != TOBII_RESEARCH_STATUS_OK)
@@ -462,6 +640,8 @@ TobiiResearchTrackBox Titta::getTrackBox() const
 }
 TobiiResearchDisplayArea Titta::getDisplayArea() const
 {
+    if (_simulator)
+        return _simulator->getDisplayArea();
     TobiiResearchDisplayArea display_area;
     const TobiiResearchStatus status = tobii_research_get_display_area(_eyeTracker.et, &display_area);
     if (status != TOBII_RESEARCH_STATUS_OK)
@@ -471,30 +651,30 @@ TobiiResearchDisplayArea Titta::getDisplayArea() const
 // setters
 void Titta::setDeviceName(std::string deviceName_)
 {
-    const TobiiResearchStatus status = tobii_research_set_device_name(_eyeTracker.et, deviceName_.c_str());
+    const TobiiResearchStatus status = _simulator ? _simulator->setDeviceName(deviceName_) : tobii_research_set_device_name(_eyeTracker.et, deviceName_.c_str());
     if (status != TOBII_RESEARCH_STATUS_OK)
         ErrorExit("Titta::cpp: Cannot set eye tracker device name", status);
 
     // refresh eye tracker info to get updated name
-    _eyeTracker.refreshInfo("deviceName");
+    refreshEyeTrackerInfo("deviceName");
 }
 void Titta::setFrequency(const float frequency_)
 {
-    const TobiiResearchStatus status = tobii_research_set_gaze_output_frequency(_eyeTracker.et, frequency_);
+    const TobiiResearchStatus status = _simulator ? _simulator->setGazeOutputFrequency(frequency_) : tobii_research_set_gaze_output_frequency(_eyeTracker.et, frequency_);
     if (status != TOBII_RESEARCH_STATUS_OK)
         ErrorExit("Titta::cpp: Cannot set eye tracker frequency", status);
 
     // refresh eye tracker info to get updated frequency
-    _eyeTracker.refreshInfo("frequency");
+    refreshEyeTrackerInfo("frequency");
 }
 void Titta::setTrackingMode(std::string trackingMode_)
 {
-    const TobiiResearchStatus status = tobii_research_set_eye_tracking_mode(_eyeTracker.et, trackingMode_.c_str());
+    const TobiiResearchStatus status = _simulator ? _simulator->setEyeTrackingMode(trackingMode_) : tobii_research_set_eye_tracking_mode(_eyeTracker.et, trackingMode_.c_str());
     if (status != TOBII_RESEARCH_STATUS_OK)
         ErrorExit("Titta::cpp: Cannot set eye tracker tracking mode", status);
 
     // refresh eye tracker info to get updated tracking mode
-    _eyeTracker.refreshInfo("trackingMode");
+    refreshEyeTrackerInfo("trackingMode");
 }
 // modifiers
 std::vector<TobiiResearchLicenseValidationResult> Titta::applyLicenses(std::vector<std::vector<uint8_t>> licenses_)
@@ -507,34 +687,62 @@ std::vector<TobiiResearchLicenseValidationResult> Titta::applyLicenses(std::vect
         licenseLengths.push_back(license.size());
     }
     std::vector<TobiiResearchLicenseValidationResult> validationResults(licenses_.size(), TOBII_RESEARCH_LICENSE_VALIDATION_RESULT_UNKNOWN);
-    const TobiiResearchStatus status = tobii_research_apply_licenses(_eyeTracker.et, const_cast<const void**>(reinterpret_cast<void**>(licenseKeyRing.data())), licenseLengths.data(), validationResults.data(), licenses_.size());
+    const TobiiResearchStatus status = _simulator ? _simulator->applyLicenses(licenses_.size(), validationResults.data()) : tobii_research_apply_licenses(_eyeTracker.et, const_cast<const void**>(reinterpret_cast<void**>(licenseKeyRing.data())), licenseLengths.data(), validationResults.data(), licenses_.size());
     if (status != TOBII_RESEARCH_STATUS_OK)
         ErrorExit("Titta::cpp: Cannot apply eye tracker license(s)", status);
 
     // refresh eye tracker info, e.g. capabilities may have changed after license applied
-    _eyeTracker.refreshInfo();
+    refreshEyeTrackerInfo();
 
     return validationResults;
 }
 void Titta::clearLicenses()
 {
-    const TobiiResearchStatus status = tobii_research_clear_applied_licenses(_eyeTracker.et);
+    const TobiiResearchStatus status = _simulator ? TOBII_RESEARCH_STATUS_OK : tobii_research_clear_applied_licenses(_eyeTracker.et);
     if (status != TOBII_RESEARCH_STATUS_OK)
         ErrorExit("Titta::cpp: Cannot clear eye tracker license(s)", status);
 
     // refresh eye tracker info, e.g. capabilities may have changed after licenses removed
-    _eyeTracker.refreshInfo();
+    refreshEyeTrackerInfo();
 }
 
 //// calibration
+namespace
+{
+    const char* calibrationActionTraceName(const TobiiTypes::CalibrationAction action_)
+    {
+        switch (action_)
+        {
+        case TobiiTypes::CalibrationAction::Nothing:
+            return "calibration: nothing";
+        case TobiiTypes::CalibrationAction::Enter:
+            return "calibration: enter";
+        case TobiiTypes::CalibrationAction::CollectData:
+            return "calibration: collect data";
+        case TobiiTypes::CalibrationAction::DiscardData:
+            return "calibration: discard data";
+        case TobiiTypes::CalibrationAction::Compute:
+            return "calibration: compute";
+        case TobiiTypes::CalibrationAction::GetCalibrationData:
+            return "calibration: get calibration data";
+        case TobiiTypes::CalibrationAction::ApplyCalibrationData:
+            return "calibration: apply calibration data";
+        case TobiiTypes::CalibrationAction::Exit:
+            return "calibration: exit";
+        }
+        return "calibration";
+    }
+}
 void Titta::calibrationThread()
 {
+    TittaTrace::setThreadName("Titta calibration");
     bool keepRunning = true;
     TobiiResearchStatus result;
     while (keepRunning)
     {
         TobiiTypes::CalibrationWorkItem workItem;
         _calibrationWorkQueue.wait_dequeue(workItem);
+        TittaTrace::scope trace(calibrationActionTraceName(workItem.action), "calibration");
         switch (workItem.action)
         {
         case TobiiTypes::CalibrationAction::Nothing:
@@ -542,7 +750,7 @@ void Titta::calibrationThread()
             break;
         case TobiiTypes::CalibrationAction::Enter:
             // enter calibration mode
-            result = tobii_research_screen_based_calibration_enter_calibration_mode(_eyeTracker.et);
+            result = _simulator ? _simulator->enterCalibrationMode() : tobii_research_screen_based_calibration_enter_calibration_mode(_eyeTracker.et);
             _calibrationWorkResultQueue.enqueue({workItem, result});
 
             _calibrationState = TobiiTypes::CalibrationState::AwaitingCalPoint;
@@ -558,10 +766,10 @@ void Titta::calibrationThread()
                 if (workItem.eye == "right")
                     collectEye = TOBII_RESEARCH_SELECTED_EYE_RIGHT;
 
-                result = tobii_research_screen_based_monocular_calibration_collect_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]), collectEye, &ignore);
+                result = _simulator ? _simulator->calibrationCollectData(static_cast<float>(coords[0]), static_cast<float>(coords[1]), collectEye) : tobii_research_screen_based_monocular_calibration_collect_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]), collectEye, &ignore);
             }
             else
-                result = tobii_research_screen_based_calibration_collect_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]));
+                result = _simulator ? _simulator->calibrationCollectData(static_cast<float>(coords[0]), static_cast<float>(coords[1])) : tobii_research_screen_based_calibration_collect_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]));
 
             _calibrationWorkResultQueue.enqueue({workItem, result});
 
@@ -578,10 +786,10 @@ void Titta::calibrationThread()
                 TobiiResearchSelectedEye discardEye = TOBII_RESEARCH_SELECTED_EYE_LEFT;
                 if (workItem.eye == "right")
                     discardEye = TOBII_RESEARCH_SELECTED_EYE_RIGHT;
-                result = tobii_research_screen_based_monocular_calibration_discard_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]), discardEye);
+                result = _simulator ? _simulator->calibrationDiscardData(static_cast<float>(coords[0]), static_cast<float>(coords[1]), discardEye) : tobii_research_screen_based_monocular_calibration_discard_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]), discardEye);
             }
             else
-                result = tobii_research_screen_based_calibration_discard_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]));
+                result = _simulator ? _simulator->calibrationDiscardData(static_cast<float>(coords[0]), static_cast<float>(coords[1])) : tobii_research_screen_based_calibration_discard_data(_eyeTracker.et, static_cast<float>(coords[0]), static_cast<float>(coords[1]));
 
             _calibrationWorkResultQueue.enqueue({workItem, result});
 
@@ -591,6 +799,14 @@ void Titta::calibrationThread()
         case TobiiTypes::CalibrationAction::Compute:
         {
             _calibrationState = TobiiTypes::CalibrationState::Computing;
+            if (_simulator)
+            {
+                TobiiTypes::CalibrationResult computeResult;
+                result = _simulator->calibrationComputeAndApply(computeResult);
+                _calibrationWorkResultQueue.enqueue({ workItem, result, {}, std::move(computeResult) });
+                _calibrationState = TobiiTypes::CalibrationState::AwaitingCalPoint;
+                break;
+            }
             TobiiResearchCalibrationResult* computeResult;
             if (_calibrationIsMonocular)
                 result = tobii_research_screen_based_monocular_calibration_compute_and_apply(_eyeTracker.et, &computeResult);
@@ -606,6 +822,17 @@ void Titta::calibrationThread()
         case TobiiTypes::CalibrationAction::GetCalibrationData:
         {
             _calibrationState = TobiiTypes::CalibrationState::GettingCalibrationData;
+            if (_simulator)
+            {
+                TobiiTypes::CalibrationWorkResult workResult{ workItem };
+                std::vector<uint8_t> calData;
+                workResult.status = _simulator->retrieveCalibrationData(calData);
+                if (!calData.empty())
+                    workResult.calibrationData = std::move(calData);
+                _calibrationWorkResultQueue.enqueue(std::move(workResult));
+                _calibrationState = TobiiTypes::CalibrationState::AwaitingCalPoint;
+                break;
+            }
             TobiiResearchCalibrationData* calData;
 
             result = tobii_research_retrieve_calibration_data(_eyeTracker.et, &calData);
@@ -622,7 +849,12 @@ void Titta::calibrationThread()
         case TobiiTypes::CalibrationAction::ApplyCalibrationData:
         {
             _calibrationState = TobiiTypes::CalibrationState::ApplyingCalibrationData;
-            if (!workItem.calibrationData.value().empty())
+            if (_simulator && !workItem.calibrationData.value().empty())
+            {
+                result = _simulator->applyCalibrationData(workItem.calibrationData.value());
+                _calibrationWorkResultQueue.enqueue({workItem, result});
+            }
+            else if (!workItem.calibrationData.value().empty())
             {
                 TobiiResearchCalibrationData calData;
                 // copy calibration data into array
@@ -642,7 +874,7 @@ void Titta::calibrationThread()
         }
         case TobiiTypes::CalibrationAction::Exit:
             // leave calibration mode and exit
-            result = tobii_research_screen_based_calibration_leave_calibration_mode(_eyeTracker.et);
+            result = _simulator ? _simulator->leaveCalibrationMode() : tobii_research_screen_based_calibration_leave_calibration_mode(_eyeTracker.et);
             _calibrationWorkResultQueue.enqueue({workItem, result});
             keepRunning = false;
             break;
@@ -684,7 +916,10 @@ bool Titta::leaveCalibrationMode(std::optional<bool> force_)
         // call leave calibration mode on Tobii SDK, ignore error if any
         // this is provided as user code may need to ensure we're not in
         // calibration mode, e.g. after a previous crash
-        tobii_research_screen_based_calibration_leave_calibration_mode(_eyeTracker.et);
+        if (_simulator)
+            _simulator->leaveCalibrationMode();
+        else
+            tobii_research_screen_based_calibration_leave_calibration_mode(_eyeTracker.et);
     }
 
     if (_calibrationThread.joinable())
@@ -761,13 +996,50 @@ std::optional<TobiiTypes::CalibrationWorkResult> Titta::calibrationRetrieveResul
 
 
 // helpers to make the below generic
+namespace
+{
+    template <typename T>
+    constexpr Titta::Stream getStreamOfBuffer()
+    {
+        if constexpr (std::is_same_v<T, Titta::gaze>)
+            return Titta::Stream::Gaze;
+        if constexpr (std::is_same_v<T, Titta::eyeImage>)
+            return Titta::Stream::EyeImage;
+        if constexpr (std::is_same_v<T, Titta::extSignal>)
+            return Titta::Stream::ExtSignal;
+        if constexpr (std::is_same_v<T, Titta::timeSync>)
+            return Titta::Stream::TimeSync;
+        if constexpr (std::is_same_v<T, Titta::positioning>)
+            return Titta::Stream::Positioning;
+        if constexpr (std::is_same_v<T, Titta::notification>)
+            return Titta::Stream::Notification;
+        return Titta::Stream::Unknown;
+    }    // name of the stream of a buffer, for tracing
+    template <typename T>
+    constexpr const char* getTraceName()
+    {
+        if constexpr (std::is_same_v<T, Titta::gaze>)
+            return "gaze";
+        if constexpr (std::is_same_v<T, Titta::eyeImage>)
+            return "eyeImage";
+        if constexpr (std::is_same_v<T, Titta::extSignal>)
+            return "externalSignal";
+        if constexpr (std::is_same_v<T, Titta::timeSync>)
+            return "timeSync";
+        if constexpr (std::is_same_v<T, Titta::positioning>)
+            return "positioning";
+        if constexpr (std::is_same_v<T, Titta::notification>)
+            return "notification";
+        return "unknown";
+    }
+}
 template <typename T>
 mutex_type& Titta::getMutex()
 {
     if constexpr (std::is_same_v<T, Titta::gaze>)
         return _gazeMutex;
     if constexpr (std::is_same_v<T, Titta::eyeImage>)
-        return _extSignalMutex;
+        return _eyeImagesMutex;
     if constexpr (std::is_same_v<T, Titta::extSignal>)
         return _extSignalMutex;
     if constexpr (std::is_same_v<T, Titta::timeSync>)
@@ -786,9 +1058,33 @@ template <typename T>
 read_lock  Titta::lockForReading() { return  read_lock(getMutex<T>()); }
 template <typename T>
 write_lock Titta::lockForWriting() { return write_lock(getMutex<T>()); }
+template <typename T>
+write_lock Titta::lockForIngest()
+{
+    write_lock l(getMutex<T>(), std::defer_lock);
+    lockForIngest<T>(l);
+    return l;
+}
+template <typename T>
+void Titta::lockForIngest(write_lock& lock_)
+{
+    // only time the wait if the lock is not free right away
+    if (lock_.try_lock())
+        return;
+    const auto t0 = std::chrono::steady_clock::now();
+    lock_.lock();
+    auto& counters = getBufferCounters<T>();
+    counters.numLockWaits.fetch_add(1, std::memory_order_relaxed);
+    counters.lockWaitNs  .fetch_add(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - t0).count()), std::memory_order_relaxed);
+}
+template <typename T>
+Titta::bufferCounters& Titta::getBufferCounters()
+{
+    return _bufferCounters[static_cast<size_t>(getStreamOfBuffer<T>())];
+}
 
 template <typename T>
-std::vector<T>& Titta::getBuffer()
+Titta::buffer_t<T>& Titta::getBuffer()
 {
     if constexpr (std::is_same_v<T, gaze>)
         return _gaze;
@@ -804,7 +1100,175 @@ std::vector<T>& Titta::getBuffer()
         return _notification;
 }
 template <typename T>
-std::tuple<typename std::vector<T>::iterator, typename std::vector<T>::iterator>
+Titta::bufferBounds& Titta::getBufferBounds()
+{
+    if constexpr (std::is_same_v<T, gaze>)
+        return _gazeBounds;
+    if constexpr (std::is_same_v<T, eyeImage>)
+        return _eyeImagesBounds;
+    if constexpr (std::is_same_v<T, extSignal>)
+        return _extSignalBounds;
+    if constexpr (std::is_same_v<T, timeSync>)
+        return _timeSyncBounds;
+    if constexpr (std::is_same_v<T, positioning>)
+        return _positioningBounds;
+    if constexpr (std::is_same_v<T, notification>)
+        return _notificationBounds;
+}
+template <typename T>
+void Titta::prepareBuffer(const size_t initialBufferSize_, std::optional<size_t> capacity_, std::optional<OverflowPolicy> overflowPolicy_)
+{
+    auto l          = lockForWriting<T>();
+    auto& bounds    = getBufferBounds<T>();
+    if (capacity_)
+        bounds.capacity = *capacity_;
+    if (overflowPolicy_)
+        bounds.policy   = *overflowPolicy_;
+    // no point reserving more than the buffer can hold
+    getBuffer<T>().reserve(bounds.capacity ? std::min(initialBufferSize_, bounds.capacity) : initialBufferSize_);
+}
+template <typename T>
+SeqLockSlot<T>& Titta::getLatestSlot()
+{
+    if constexpr (std::is_same_v<T, gaze>)
+        return _gazeLatest;
+    if constexpr (std::is_same_v<T, extSignal>)
+        return _extSignalLatest;
+    if constexpr (std::is_same_v<T, timeSync>)
+        return _timeSyncLatest;
+    if constexpr (std::is_same_v<T, positioning>)
+        return _positioningLatest;
+}
+template <typename T, typename... Args>
+void Titta::pushToBuffer(const int64_t callbackTime_, Args&&... args_)
+{
+    // !NB: appropriate locking is responsibility of caller!
+    auto& buf       = getBuffer<T>();
+    auto& bounds    = getBufferBounds<T>();
+    if (bounds.capacity && std::size(buf) >= bounds.capacity)
+    {
+        if (bounds.policy == OverflowPolicy::DropNewest)
+        {
+            if constexpr (hasLatestSlot<T>)
+                getLatestSlot<T>().store(T(std::forward<Args>(args_)...));
+            ++bounds.nDropped;
+            return;
+        }
+        // drop oldest
+        const auto nDrop = std::size(buf) - bounds.capacity + 1;
+        buf.pop_front(nDrop);
+        bounds.nDropped += nDrop;
+    }
+    if constexpr (hasLatestSlot<T>)
+    {
+        // construct sample here instead of in the buffer, the buffer may store it in a different form (e.g. gaze)
+        T sample(std::forward<Args>(args_)...);
+        getLatestSlot<T>().store(sample);
+        buf.push_back(std::move(sample));
+    }
+    else
+        buf.emplace_back(std::forward<Args>(args_)...);
+    recordCommitLatency<T>(callbackTime_);
+    // only written with the buffer locked, so no need for an atomic increment
+    auto& nCommitted = getBufferCounters<T>().numCommitted;
+    nCommitted.store(nCommitted.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+template <typename T, typename InputIt>
+void Titta::appendToBuffer(InputIt first_, InputIt last_)
+{
+    // !NB: appropriate locking is responsibility of caller!
+    auto& buf       = getBuffer<T>();
+    auto& bounds    = getBufferBounds<T>();
+    const auto nNew = static_cast<size_t>(std::distance(first_, last_));
+    if constexpr (hasLatestSlot<T>)
+        if (nNew)
+            getLatestSlot<T>().store(*std::prev(last_));
+    if (bounds.capacity && std::size(buf) + nNew > bounds.capacity)
+    {
+        const auto nOver = std::size(buf) + nNew - bounds.capacity;
+        if (bounds.policy == OverflowPolicy::DropNewest)
+        {
+            // NB: nOver can be larger than nNew if capacity was lowered while samples were in the buffer
+            const auto nDrop = std::min(nOver, nNew);
+            last_ = std::prev(last_, nDrop);
+            bounds.nDropped += nDrop;
+        }
+        else
+        {
+            // drop oldest, first from buffer, then from new samples if there are more than fit
+            const auto nDropBuf = std::min(nOver, std::size(buf));
+            buf.pop_front(nDropBuf);
+            first_ = std::next(first_, nOver - nDropBuf);
+            bounds.nDropped += nOver;
+        }
+    }
+    buf.append(first_, last_);
+}
+template <typename T>
+moodycamel::ReaderWriterQueue<Titta::ingestItem<T>>& Titta::getIngestQueue()
+{
+    if constexpr (std::is_same_v<T, TobiiResearchGazeData>)
+        return _gazeIngestQueue;
+    if constexpr (std::is_same_v<T, TobiiResearchEyeOpennessData>)
+        return _eyeOpennessIngestQueue;
+    if constexpr (std::is_same_v<T, eyeImage>)
+        return _eyeImagesIngestQueue;
+    if constexpr (std::is_same_v<T, extSignal>)
+        return _extSignalIngestQueue;
+    if constexpr (std::is_same_v<T, timeSync>)
+        return _timeSyncIngestQueue;
+    if constexpr (std::is_same_v<T, positioning>)
+        return _positioningIngestQueue;
+    if constexpr (std::is_same_v<T, notification>)
+        return _notificationIngestQueue;
+}
+template <typename T, typename... Args>
+void Titta::ingestSample(const int64_t callbackTime_, Args&&... args_)
+{
+    if (_useIngestQueue)
+    {
+        // never allocates: if the queue is full, the sample is discarded
+        if (!getIngestQueue<T>().try_emplace(callbackTime_, std::forward<Args>(args_)...))
+            getBufferCounters<T>().numQueueDropped.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        auto l = lockForIngest<T>();
+        pushToBuffer<T>(callbackTime_, std::forward<Args>(args_)...);
+    }
+}
+template <typename T>
+void Titta::drainIngestQueue()
+{
+    if constexpr (std::is_same_v<T, gaze>)
+    {
+        if (_useIngestQueue || _gazeIngestQueue.size_approx() || _eyeOpennessIngestQueue.size_approx())
+        {
+            std::lock_guard<std::mutex> lq(_ingestDrainMutex);
+            drainGazeIngestQueues();
+        }
+        // also output samples that have waited too long for their partner in the merge staging area
+        flushGazeStaging(true);
+    }
+    else
+    {
+        auto& queue = getIngestQueue<T>();
+        if (!_useIngestQueue && !queue.size_approx())
+            return;
+        std::lock_guard<std::mutex> lq(_ingestDrainMutex);
+        if (!queue.peek())
+            return;
+
+        auto l = lockForIngest<T>();
+        while (auto item = queue.peek())
+        {
+            pushToBuffer<T>(item->callbackTime, std::move(item->sample));
+            queue.pop();
+        }
+    }
+}
+template <typename T>
+std::tuple<typename Titta::buffer_t<T>::iterator, typename Titta::buffer_t<T>::iterator>
 Titta::getIteratorsFromSampleAndSide(const size_t NSamp_, const Titta::BufferSide side_)
 {
     auto& buf       = getBuffer<T>();
@@ -828,7 +1292,7 @@ Titta::getIteratorsFromSampleAndSide(const size_t NSamp_, const Titta::BufferSid
 }
 
 template <typename T>
-std::tuple<typename std::vector<T>::iterator, typename std::vector<T>::iterator, bool>
+std::tuple<typename Titta::buffer_t<T>::iterator, typename Titta::buffer_t<T>::iterator, bool>
 Titta::getIteratorsFromTimeRange(const int64_t timeStart_, const int64_t timeEnd_)
 {
     // !NB: appropriate locking is responsibility of caller!
@@ -912,12 +1376,17 @@ bool Titta::setIncludeEyeOpennessInGaze(const bool include_)
     return previous;
 }
 
-bool Titta::start(std::string stream_, std::optional<size_t> initialBufferSize_, std::optional<bool> asGif_, const bool snake_case_on_stream_not_found /*= false*/)
+bool Titta::start(std::string stream_, std::optional<size_t> initialBufferSize_, std::optional<bool> asGif_, std::optional<size_t> capacity_, std::optional<OverflowPolicy> overflowPolicy_, const bool snake_case_on_stream_not_found /*= false*/)
 {
-    return start(stringToStream(std::move(stream_), snake_case_on_stream_not_found), initialBufferSize_, asGif_);
+    return start(stringToStream(std::move(stream_), snake_case_on_stream_not_found), initialBufferSize_, asGif_, capacity_, overflowPolicy_);
 }
-bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_, std::optional<bool> asGif_)
+bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_, std::optional<bool> asGif_, std::optional<size_t> capacity_, std::optional<OverflowPolicy> overflowPolicy_)
 {
+    if (capacity_ && *capacity_ == 0)
+        DoExitWithMsg("Titta::cpp::start: capacity should be larger than zero.");
+    if (overflowPolicy_ && (*overflowPolicy_ == OverflowPolicy::Unknown || *overflowPolicy_ == OverflowPolicy::Last))
+        DoExitWithMsg("Titta::cpp::start: unknown overflow policy provided.");
+
     TobiiResearchStatus result=TOBII_RESEARCH_STATUS_OK;
     bool* stateVar = nullptr;
     switch (stream_)
@@ -931,12 +1400,9 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
                 // deal with default arguments
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::sampleBufSize);
                 // prepare buffer
-                {
-                    auto l = lockForWriting<gaze>();
-                    _gaze.reserve(initialBufferSize);   // NB: if already reserved when starting eye openness, this will not shrink
-                }
+                prepareBuffer<gaze>(initialBufferSize, capacity_, overflowPolicy_);   // NB: if already reserved when starting eye openness, this will not shrink
                 // start buffer
-                result = tobii_research_subscribe_to_gaze_data(_eyeTracker.et, TittaGazeCallback, this);
+                result = _simulator ? _simulator->subscribe(TittaGazeCallback, this) : tobii_research_subscribe_to_gaze_data(_eyeTracker.et, TittaGazeCallback, this);
                 stateVar = &_recordingGaze;
             }
             break;
@@ -950,12 +1416,9 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
                 // deal with default arguments
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::sampleBufSize);
                 // prepare buffer
-                {
-                    auto l = lockForWriting<gaze>();
-                    _gaze.reserve(initialBufferSize);   // NB: if already reserved when starting gaze, this will not shrink
-                }
+                prepareBuffer<gaze>(initialBufferSize, capacity_, overflowPolicy_);   // NB: if already reserved when starting gaze, this will not shrink
                 // start buffer
-                result = tobii_research_subscribe_to_eye_openness(_eyeTracker.et, TittaEyeOpennessCallback, this);
+                result = _simulator ? _simulator->subscribe(TittaEyeOpennessCallback, this) : tobii_research_subscribe_to_eye_openness(_eyeTracker.et, TittaEyeOpennessCallback, this);
                 stateVar = &_recordingEyeOpenness;
             }
             break;
@@ -970,22 +1433,19 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::eyeImageBufSize);
                 const auto asGif             = asGif_            .value_or(defaults::eyeImageAsGIF);
 
-                // prepare and start buffer
-                {
-                    auto l = lockForWriting<eyeImage>();
-                    _eyeImages.reserve(initialBufferSize);
-                }
+                // prepare buffer
+                prepareBuffer<eyeImage>(initialBufferSize, capacity_, overflowPolicy_);
 
                 // if already recording and switching from gif to normal or other way, first stop old stream
                 if (_recordingEyeImages)
                     if (asGif != _eyeImIsGif)
-                        doUnsubscribeEyeImage(_eyeTracker.et, _eyeImIsGif);
+                        doUnsubscribeEyeImage(_eyeTracker.et, _simulator.get(), _eyeImIsGif);
                     else
                         // nothing to do
                         return true;
 
                 // subscribe to new stream
-                result = doSubscribeEyeImage(_eyeTracker.et, this, asGif);
+                result = doSubscribeEyeImage(_eyeTracker.et, _simulator.get(), this, asGif);
                 stateVar = &_recordingEyeImages;
                 if (result==TOBII_RESEARCH_STATUS_OK)
                     // update type being recorded if subscription to stream was successful
@@ -1001,12 +1461,9 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
             {
                 // deal with default arguments
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::extSignalBufSize);
-                // prepare and start buffer
-                {
-                    auto l = lockForWriting<extSignal>();
-                    _extSignal.reserve(initialBufferSize);
-                }
-                result = tobii_research_subscribe_to_external_signal_data(_eyeTracker.et, TittaExtSignalCallback, this);
+                // prepare buffer
+                prepareBuffer<extSignal>(initialBufferSize, capacity_, overflowPolicy_);
+                result = _simulator ? _simulator->subscribe(TittaExtSignalCallback, this) : tobii_research_subscribe_to_external_signal_data(_eyeTracker.et, TittaExtSignalCallback, this);
                 stateVar = &_recordingExtSignal;
             }
             break;
@@ -1019,12 +1476,9 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
             {
                 // deal with default arguments
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::timeSyncBufSize);
-                // prepare and start buffer
-                {
-                    auto l = lockForWriting<timeSync>();
-                    _timeSync.reserve(initialBufferSize);
-                }
-                result = tobii_research_subscribe_to_time_synchronization_data(_eyeTracker.et, TittaTimeSyncCallback, this);
+                // prepare buffer
+                prepareBuffer<timeSync>(initialBufferSize, capacity_, overflowPolicy_);
+                result = _simulator ? _simulator->subscribe(TittaTimeSyncCallback, this) : tobii_research_subscribe_to_time_synchronization_data(_eyeTracker.et, TittaTimeSyncCallback, this);
                 stateVar = &_recordingTimeSync;
             }
             break;
@@ -1037,12 +1491,9 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
             {
                 // deal with default arguments
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::positioningBufSize);
-                // prepare and start buffer
-                {
-                    auto l = lockForWriting<positioning>();
-                    _positioning.reserve(initialBufferSize);
-                }
-                result = tobii_research_subscribe_to_user_position_guide(_eyeTracker.et, TittaPositioningCallback, this);
+                // prepare buffer
+                prepareBuffer<positioning>(initialBufferSize, capacity_, overflowPolicy_);
+                result = _simulator ? _simulator->subscribe(TittaPositioningCallback, this) : tobii_research_subscribe_to_user_position_guide(_eyeTracker.et, TittaPositioningCallback, this);
                 stateVar = &_recordingPositioning;
             }
             break;
@@ -1055,12 +1506,9 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
             {
                 // deal with default arguments
                 const auto initialBufferSize = initialBufferSize_.value_or(defaults::notificationBufSize);
-                // prepare and start buffer
-                {
-                    auto l = lockForWriting<notification>();
-                    _notification.reserve(initialBufferSize);
-                }
-                result = tobii_research_subscribe_to_notifications(_eyeTracker.et, TittaNotificationCallback, this);
+                // prepare buffer
+                prepareBuffer<notification>(initialBufferSize, capacity_, overflowPolicy_);
+                result = _simulator ? _simulator->subscribe(TittaNotificationCallback, this) : tobii_research_subscribe_to_notifications(_eyeTracker.et, TittaNotificationCallback, this);
                 stateVar = &_recordingNotification;
             }
             break;
@@ -1076,10 +1524,10 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
     {
         // if requested to merge gaze and eye openness, a call to start eye openness also starts gaze
         if (     stream_==Stream::EyeOpenness && _includeEyeOpennessInGaze && !_recordingGaze)
-            return start(Stream::Gaze       , initialBufferSize_, asGif_);
+            return start(Stream::Gaze       , initialBufferSize_, asGif_, capacity_, overflowPolicy_);
         // if requested to merge gaze and eye openness, a call to start gaze also starts eye openness
         else if (stream_==Stream::Gaze        && _includeEyeOpennessInGaze && !_recordingEyeOpenness)
-            return start(Stream::EyeOpenness, initialBufferSize_, asGif_);
+            return start(Stream::EyeOpenness, initialBufferSize_, asGif_, capacity_, overflowPolicy_);
         return true;
     }
 
@@ -1089,26 +1537,6 @@ bool Titta::start(const Stream stream_, std::optional<size_t> initialBufferSize_
 
 // tobii to own type helpers
 namespace {
-    void convert(TobiiTypes::gazePoint& out_, const TobiiResearchGazePoint in_)
-    {
-        out_.position_in_user_coordinates   = in_.position_in_user_coordinates;
-        out_.position_on_display_area       = in_.position_on_display_area;
-        out_.validity                       = in_.validity;
-        out_.available                      = true;
-    }
-    void convert(TobiiTypes::pupilData& out_, const TobiiResearchPupilData in_)
-    {
-        out_.diameter                       = in_.diameter;
-        out_.validity                       = in_.validity;
-        out_.available                      = true;
-    }
-    void convert(TobiiTypes::gazeOrigin& out_, const TobiiResearchGazeOrigin in_)
-    {
-        out_.position_in_track_box_coordinates = in_.position_in_track_box_coordinates;
-        out_.position_in_user_coordinates   = in_.position_in_user_coordinates;
-        out_.validity                       = in_.validity;
-        out_.available                      = true;
-    }
     void convert(TobiiTypes::eyeOpenness& out_, const TobiiResearchEyeOpennessData* in_, const bool leftEye_)
     {
         if (leftEye_)
@@ -1123,118 +1551,376 @@ namespace {
         }
         out_.available = true;
     }
-    void convert(TobiiTypes::eyeData& out_, const TobiiResearchEyeData in_)
-    {
-        convert(out_.gaze_point, in_.gaze_point);
-        convert(out_.pupil, in_.pupil_data);
-        convert(out_.gaze_origin, in_.gaze_origin);
-    }
 }
 
-void Titta::receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiResearchEyeOpennessData* openness_data_)
+void Titta::receiveSample(const TobiiResearchGazeData* gaze_data_, const TobiiResearchEyeOpennessData* openness_data_, const int64_t callbackTime_)
 {
-    const auto needStage = _recordingGaze && _recordingEyeOpenness;
-    if (!needStage && !_gazeStagingEmpty)
+    const auto needStage    = _recordingGaze && _recordingEyeOpenness;
+    const auto isGaze       = !!gaze_data_;
+    const auto deviceTs     = isGaze ? gaze_data_->device_time_stamp : openness_data_->device_time_stamp;
+    const auto systemTs     = isGaze ? gaze_data_->system_time_stamp : openness_data_->system_time_stamp;
+    // whether a sample already has the data that is being delivered now
+    auto hasData = [isGaze](const Titta::gaze& s_) { return isGaze ? s_.left_eye.gaze_origin.available : s_.left_eye.eye_openness.available; };
+    auto addData = [&](Titta::gaze& s_)
+    {
+        // convert to own gaze data type
+        if (isGaze)
+        {
+            TittaConvert::toEyeData(s_.left_eye,  gaze_data_->left_eye);
+            TittaConvert::toEyeData(s_.right_eye, gaze_data_->right_eye);
+        }
+        else
+        {
+            convert(s_.left_eye.eye_openness , openness_data_, true);
+            convert(s_.right_eye.eye_openness, openness_data_, false);
+        }
+    };
+    auto makeSample = [&]()
+    {
+        Titta::gaze s{};
+        s.device_time_stamp = deviceTs;
+        s.system_time_stamp = systemTs;
+        addData(s);
+        return s;
+    };
+
+    if (!needStage)
     {
         // if any data in staging area but no longer expecting to merge, flush to output
-        auto l    = write_lock(_gazeStageMutex);
-        auto lOut = lockForWriting<Titta::gaze>();
-        _gaze.insert(_gaze.end(), std::make_move_iterator(_gazeStaging.begin()), std::make_move_iterator(_gazeStaging.end()));
-        _gazeStaging.clear();
-        _gazeStagingEmpty = true;
-    }
+        if (!_gazeStagingEmpty)
+            flushGazeStaging(false);
 
-    std::unique_lock<mutex_type> l(_gazeStageMutex, std::defer_lock);
-    if (needStage)
-        l.lock();
+        auto lOut = lockForIngest<Titta::gaze>();
+        pushToBuffer<gaze>(callbackTime_, makeSample());
+        return;
+    }
 
-    Titta::gaze* sample = nullptr;
-    std::deque<Titta::gaze> emitBuffer;
-    if (needStage)
+    auto l = write_lock(_gazeStageMutex);
+    // if the partner of this data was already output without it, discard it: it can't be merged anymore and
+    // outputting it would lead to two samples with the same timestamp. Forget samples whose partner is missing
+    while (!_gazeUnmerged.empty() && _gazeUnmerged.front().waitsForGaze == isGaze && _gazeUnmerged.front().deviceTimeStamp < deviceTs)
+        _gazeUnmerged.pop_front();
+    if (!_gazeUnmerged.empty() && _gazeUnmerged.front().waitsForGaze == isGaze && _gazeUnmerged.front().deviceTimeStamp == deviceTs)
     {
-        // find if there is already a corresponding sample in the staging area
-        for (auto it = _gazeStaging.begin(); it != _gazeStaging.end(); )
-        {
-            if ((!!gaze_data_     && it->device_time_stamp <     gaze_data_->device_time_stamp && it->left_eye.eye_openness.available) ||
-                (!!openness_data_ && it->device_time_stamp < openness_data_->device_time_stamp && it->left_eye.gaze_origin.available))
-            {
-                // We assume samples come in order. Here we have:
-                // 1. a sample older than this     gaze     sample for which eye openness is already available, or
-                // 2. a sample older than this eye openness sample for which     gaze     is already available;
-                // emit it, continue searching
-                emitBuffer.push_back(*it);
-                it = _gazeStaging.erase(it);
-            }
-            else if ((!!gaze_data_     && it->device_time_stamp ==     gaze_data_->device_time_stamp) ||
-                     (!!openness_data_ && it->device_time_stamp == openness_data_->device_time_stamp))
-            {
-                // found, this is the one we want. Move to output, take pointer to it as we'll be adding to it
-                emitBuffer.push_back(*it);
-                it = _gazeStaging.erase(it);
-                sample = &emitBuffer.back();
-                break;
-            }
-            else
-                ++it;
-        }
+        _gazeUnmerged.pop_front();
+        return;
     }
-    if (!sample)
+
+    // only lock output buffer once there is something to write to it
+    write_lock lOut(getMutex<gaze>(), std::defer_lock);
+    auto emit = [&](Titta::gaze&& s_, const int64_t sampleCallbackTime_)
     {
-        if (needStage)
-        {
-            _gazeStaging.push_back({});
-            sample = &_gazeStaging.back();
-        }
-        else
-        {
-            emitBuffer.push_back({});
-            sample = &emitBuffer.back();
-        }
+        if (!lOut.owns_lock())
+            lockForIngest<gaze>(lOut);
+        pushToBuffer<gaze>(sampleCallbackTime_, std::move(s_));
+    };
 
-        if (gaze_data_)
+    // We assume samples come in order, and since a staged sample is waiting for data from the stream that is
+    // behind, all samples in the staging area wait for the same stream. Emit samples from the front that:
+    // 1. are waiting for the data that is being delivered now, but are older than it. This data is missing and
+    //    will not arrive anymore, or
+    // 2. have been waiting longer than the maximum wait time since they arrived.
+    const auto maxWait = _gazeMergeMaxWait.load(std::memory_order_relaxed);
+    auto& counters = getBufferCounters<gaze>();
+    while (!_gazeStaging.empty())
+    {
+        auto& front = _gazeStaging.front();
+        const auto partnerMissing = !hasData(front.sample) && front.sample.device_time_stamp < deviceTs;
+        if (partnerMissing)
         {
-            sample->device_time_stamp = gaze_data_->device_time_stamp;
-            sample->system_time_stamp = gaze_data_->system_time_stamp;
+            emit(std::move(front.sample), front.callbackTime);
+            _gazeStaging.pop_front();
         }
-        else if (openness_data_)
+        else if (callbackTime_ - front.callbackTime > maxWait)
         {
-            sample->device_time_stamp = openness_data_->device_time_stamp;
-            sample->system_time_stamp = openness_data_->system_time_stamp;
+            counters.numMergeTimeouts.fetch_add(1, std::memory_order_relaxed);
+            emitUnmerged(lOut);
         }
+        else
+            break;
     }
 
-    if (gaze_data_)
+    if (!_gazeStaging.empty() && !hasData(_gazeStaging.front().sample))
     {
-        // convert to own gaze data type
-        convert(sample->left_eye,  gaze_data_->left_eye);
-        convert(sample->right_eye, gaze_data_->right_eye);
+        auto& front = _gazeStaging.front();
+        if (front.sample.device_time_stamp == deviceTs)
+        {
+            // found, this is the one we want. Complete it and output. Its commit latency includes the
+            // time it waited for this data
+            addData(front.sample);
+            counters.numMerged.fetch_add(1, std::memory_order_relaxed);
+            emit(std::move(front.sample), front.callbackTime);
+            _gazeStaging.pop_front();
+        }
+        else
+            // the other stream is already past this sample, its partner is missing. Output as is
+            emit(makeSample(), callbackTime_);
     }
-    else if (openness_data_)
+    else
     {
-        // convert to own gaze data type
-        convert(sample->left_eye.eye_openness , openness_data_, true);
-        convert(sample->right_eye.eye_openness, openness_data_, false);
+        // this stream is ahead, wait for the other stream to catch up
+        if (_gazeStaging.full())
+            emitUnmerged(lOut);
+        _gazeStaging.push_back({makeSample(), callbackTime_});
     }
-    if (needStage)
-        l.unlock();
+    _gazeStagingEmpty = _gazeStaging.empty();
+}
 
-    // output if anything
-    if (!emitBuffer.empty())
+void Titta::flushGazeStaging(const bool onlyStale_)
+{
+    if (_gazeStagingEmpty)
+        return;
+
+    auto l = write_lock(_gazeStageMutex);
+    write_lock lOut(getMutex<gaze>(), std::defer_lock);
+    // wait time is measured from when the sample arrived, not from when it was recorded, so that
+    // tracker-to-host latency does not count as waiting
+    const auto now      = onlyStale_ ? getSystemTimestamp() : 0;
+    const auto maxWait  = _gazeMergeMaxWait.load(std::memory_order_relaxed);
+    while (!_gazeStaging.empty() && (!onlyStale_ || now - _gazeStaging.front().callbackTime > maxWait))
     {
-        auto lOut = lockForWriting<Titta::gaze>();
-        _gaze.insert(_gaze.end(), std::make_move_iterator(emitBuffer.begin()), std::make_move_iterator(emitBuffer.end()));
+        if (onlyStale_)
+            getBufferCounters<gaze>().numMergeTimeouts.fetch_add(1, std::memory_order_relaxed);
+        emitUnmerged(lOut);
     }
+    _gazeStagingEmpty = _gazeStaging.empty();
+}
+void Titta::emitUnmerged(write_lock& lOut_)
+{
+    // !NB: caller must hold _gazeStageMutex
+    auto& front = _gazeStaging.front();
+    if (_gazeUnmerged.full())
+        _gazeUnmerged.pop_front();
+    _gazeUnmerged.push_back({front.sample.device_time_stamp, !front.sample.left_eye.gaze_origin.available});
+    if (!lOut_.owns_lock())
+        lockForIngest<gaze>(lOut_);
+    pushToBuffer<gaze>(front.callbackTime, std::move(front.sample));
+    _gazeStaging.pop_front();
 }
 
-bool Titta::isRecording(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/) const
+int64_t Titta::setGazeMergeMaxWait(const int64_t maxWait_)
 {
-    return isRecording(stringToStream(std::move(stream_), snake_case_on_stream_not_found));
+    if (maxWait_ < 0)
+        DoExitWithMsg("Titta::cpp::setGazeMergeMaxWait: maximum wait time should be zero or larger");
+
+    return _gazeMergeMaxWait.exchange(maxWait_);
 }
-bool Titta::isRecording(const Stream stream_) const
+int64_t Titta::getGazeMergeMaxWait() const
 {
-    switch (stream_)
+    return _gazeMergeMaxWait;
+}
+
+bool Titta::setUseIngestQueue(const bool useQueue_)
+{
+    const auto previous = _useIngestQueue.load();
+    if (useQueue_ == previous)
+        return previous;
+
+    // NB: notification stream is always on, and is therefore exempt from this check
+    if (_recordingGaze || _recordingEyeOpenness || _recordingEyeImages || _recordingExtSignal || _recordingTimeSync || _recordingPositioning)
+        DoExitWithMsg("Titta::cpp::setUseIngestQueue: Cannot change ingest queue mode while recording, stop all streams first.");
+
+    if (useQueue_)
     {
-        case Stream::Gaze:
+        _useIngestQueue = true;
+        _ingestDrainShouldStop = false;
+        _ingestDrainThread = std::thread(&Titta::ingestDrainThread, this);
+    }
+    else
+    {
+        _useIngestQueue = false;
+        stopIngestDrainThread();    // NB: does a final drain of the queues
+    }
+
+    return previous;
+}
+bool Titta::getUseIngestQueue() const
+{
+    return _useIngestQueue;
+}
+
+void Titta::ingestDrainThread()
+{
+    TittaTrace::setThreadName("Titta ingest");
+    while (!_ingestDrainShouldStop)
+    {
+        {
+            TittaTrace::scope trace("drain ingest queues", "ingest");
+            drainAllIngestQueues();
+        }
+        std::this_thread::sleep_for(defaults::ingestDrainInterval);
+    }
+    drainAllIngestQueues();
+}
+void Titta::stopIngestDrainThread()
+{
+    _ingestDrainShouldStop = true;
+    if (_ingestDrainThread.joinable())
+        _ingestDrainThread.join();
+}
+void Titta::drainAllIngestQueues()
+{
+    drainIngestQueue<gaze>();
+    drainIngestQueue<eyeImage>();
+    drainIngestQueue<extSignal>();
+    drainIngestQueue<timeSync>();
+    drainIngestQueue<positioning>();
+    drainIngestQueue<notification>();
+}
+void Titta::drainGazeIngestQueues()
+{
+    // !NB: caller must hold _ingestDrainMutex
+    // feed samples from both queues to the gaze + eye openness merger in order of their device
+    // timestamps, so it sees them in the same order as when they are received directly from the
+    // callbacks
+    while (true)
+    {
+        const auto gazeData     = _gazeIngestQueue.peek();
+        const auto opennessData = _eyeOpennessIngestQueue.peek();
+        if (!gazeData && !opennessData)
+            break;
+
+        if (gazeData && (!opennessData || gazeData->sample.device_time_stamp <= opennessData->sample.device_time_stamp))
+        {
+            receiveSample(&gazeData->sample, nullptr, gazeData->callbackTime);
+            _gazeIngestQueue.pop();
+        }
+        else
+        {
+            receiveSample(nullptr, &opennessData->sample, opennessData->callbackTime);
+            _eyeOpennessIngestQueue.pop();
+        }
+    }
+}
+
+void Titta::callbackTimer::add(const std::chrono::steady_clock::time_point start_)
+{
+    const auto duration = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_).count());
+    numCallbacks   .fetch_add(1, std::memory_order_relaxed);
+    totalDurationNs.fetch_add(duration, std::memory_order_relaxed);
+    if (duration > maxDurationNs.load(std::memory_order_relaxed))
+        maxDurationNs.store(duration, std::memory_order_relaxed);
+}
+Titta::callbackTimer& Titta::getCallbackTimer(const Stream stream_)
+{
+    return _callbackTimers[static_cast<size_t>(stream_)];
+}
+Titta::CallbackTimingStats Titta::getCallbackTimingStats(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/) const
+{
+    return getCallbackTimingStats(stringToStream(std::move(stream_), snake_case_on_stream_not_found));
+}
+Titta::CallbackTimingStats Titta::getCallbackTimingStats(const Stream stream_) const
+{
+    const auto& timer = _callbackTimers[static_cast<size_t>(stream_)];
+    CallbackTimingStats out;
+    out.numCallbacks = timer.numCallbacks;
+    if (out.numCallbacks)
+        out.meanDuration = static_cast<double>(timer.totalDurationNs) / static_cast<double>(out.numCallbacks) / 1000.;
+    out.maxDuration = static_cast<double>(timer.maxDurationNs) / 1000.;
+    return out;
+}
+
+template <typename T>
+Titta::StreamCounters Titta::getBufferCountersImpl()
+{
+    StreamCounters out;
+    const auto stream       = getStreamOfBuffer<T>();
+    const auto& counters    = getBufferCounters<T>();
+    out.numCallbacks        = getCallbackTimer(stream).numCallbacks.load(std::memory_order_relaxed);
+    out.numCommitted        = counters.numCommitted.load(std::memory_order_relaxed);
+    out.numDropped          = getBufferBounds<T>().nDropped.load(std::memory_order_relaxed);
+    {
+        auto l = lockForReading<T>();
+        out.numBuffered     = std::size(getBuffer<T>());
+        out.bufferBytes     = getBuffer<T>().allocatedBytes();
+    }
+    if constexpr (std::is_same_v<T, gaze>)
+        out.numQueued       = _gazeIngestQueue.size_approx();
+    else
+        out.numQueued       = getIngestQueue<T>().size_approx();
+    out.numLockWaits        = counters.numLockWaits.load(std::memory_order_relaxed);
+    out.lockWaitTime        = static_cast<double>(counters.lockWaitNs.load(std::memory_order_relaxed)) / 1000.;
+    out.numMerged           = counters.numMerged.load(std::memory_order_relaxed);
+    out.numMergeTimeouts    = counters.numMergeTimeouts.load(std::memory_order_relaxed);
+    out.numQueueDropped     = counters.numQueueDropped.load(std::memory_order_relaxed);
+    return out;
+}
+std::map<Titta::Stream, Titta::StreamCounters> Titta::getCounters()
+{
+    std::map<Stream, StreamCounters> out;
+    out[Stream::Gaze]           = getBufferCountersImpl<gaze>();
+    out[Stream::EyeImage]       = getBufferCountersImpl<eyeImage>();
+    out[Stream::ExtSignal]      = getBufferCountersImpl<extSignal>();
+    out[Stream::TimeSync]       = getBufferCountersImpl<timeSync>();
+    out[Stream::Positioning]    = getBufferCountersImpl<positioning>();
+    out[Stream::Notification]   = getBufferCountersImpl<notification>();
+    // eye openness samples are stored in the gaze buffer
+    auto& eyeOpenness           = out[Stream::EyeOpenness];
+    eyeOpenness.numCallbacks    = getCallbackTimer(Stream::EyeOpenness).numCallbacks.load(std::memory_order_relaxed);
+    eyeOpenness.numQueued       = _eyeOpennessIngestQueue.size_approx();
+    eyeOpenness.numQueueDropped = _bufferCounters[static_cast<size_t>(Stream::EyeOpenness)].numQueueDropped.load(std::memory_order_relaxed);
+    return out;
+}
+
+Titta::latencyHistograms& Titta::getLatencyHistograms(const Stream stream_)
+{
+    return _latencyHistograms[static_cast<size_t>(stream_)];
+}
+namespace
+{
+    // time at which a sample was recorded, as used for latency
+    template <typename T>
+    int64_t getLatencyTimeStamp(const T& sample_)
+    {
+        if constexpr (std::is_same_v<T, Titta::timeSync>)
+            return sample_.system_response_time_stamp;
+        else
+            return sample_.system_time_stamp;
+    }
+}
+template <typename T>
+void Titta::recordCommitLatency(const int64_t callbackTime_)
+{
+    if constexpr (!std::is_same_v<T, positioning>)
+        getLatencyHistograms(getStreamOfBuffer<T>()).commit.record(getSystemTimestamp() - callbackTime_);
+}
+template <typename T, typename It>
+void Titta::recordReadLatency(const It startIt_, const It endIt_)
+{
+    // sampled: only the age of the newest sample that is returned by a read is recorded
+    if constexpr (!std::is_same_v<T, positioning>)
+        if (startIt_ != endIt_)
+            getLatencyHistograms(getStreamOfBuffer<T>()).read.record(getSystemTimestamp() - getLatencyTimeStamp<T>(*std::prev(endIt_)));
+}
+Titta::LatencyStats Titta::getLatencyStats(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/) const
+{
+    return getLatencyStats(stringToStream(std::move(stream_), snake_case_on_stream_not_found));
+}
+Titta::LatencyStats Titta::getLatencyStats(const Stream stream_) const
+{
+    if (stream_ == Stream::Positioning)
+        DoExitWithMsg("Titta::cpp::getLatencyStats: latency is not available for the positioning stream, as its samples have no timestamp");
+    const auto& hists = _latencyHistograms[static_cast<size_t>(stream_)];
+    return {hists.callback.getStats(), hists.commit.getStats(), hists.read.getStats()};
+}
+
+TittaSimulator::replayStats Titta::getReplayStats() const
+{
+    const auto stats = _simulator ? _simulator->getReplayStats() : std::nullopt;
+    if (!stats)
+        DoExitWithMsg("Titta::cpp::getReplayStats: not connected to a replay of a recording");
+    return *stats;
+}
+
+bool Titta::isRecording(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/) const
+{
+    return isRecording(stringToStream(std::move(stream_), snake_case_on_stream_not_found));
+}
+bool Titta::isRecording(const Stream stream_) const
+{
+    switch (stream_)
+    {
+        case Stream::Gaze:
             return _recordingGaze;
         case Stream::EyeOpenness:
             return _recordingEyeOpenness;
@@ -1254,23 +1940,22 @@ bool Titta::isRecording(const Stream stream_) const
 }
 
 template <typename T>
-std::vector<T> consumeFromVec(std::vector<T>& buf_, typename std::vector<T>::iterator startIt_, typename std::vector<T>::iterator endIt_)
+std::vector<T> consumeFromBuffer(Titta::buffer_t<T>& buf_, typename Titta::buffer_t<T>::iterator startIt_, typename Titta::buffer_t<T>::iterator endIt_)
 {
     if (std::empty(buf_))
         return std::vector<T>{};
 
     // move out the indicated elements
+    std::vector<T> out;
+    out.reserve(std::distance(startIt_, endIt_));
+    out.insert(std::end(out), std::make_move_iterator(startIt_), std::make_move_iterator(endIt_));
+    // remove them from the buffer. For the common case of consuming from the start of the buffer,
+    // this only releases blocks and does not move the remaining elements
     if (startIt_==std::begin(buf_) && endIt_==std::end(buf_))
-        // whole buffer
-        return std::vector<T>(std::move(buf_));
+        buf_.clear();
     else
-    {
-        std::vector<T> out;
-        out.reserve(std::distance(startIt_, endIt_));
-        out.insert(std::end(out), std::make_move_iterator(startIt_), std::make_move_iterator(endIt_));
         buf_.erase(startIt_, endIt_);
-        return out;
-    }
+    return out;
 }
 template <typename T>
 std::vector<T> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_)
@@ -1279,11 +1964,14 @@ std::vector<T> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<Buffe
     const auto N    = NSamp_.value_or(defaults::consumeNSamp);
     const auto side = side_.value_or(defaults::consumeSide);
 
+    TittaTrace::scope trace("consumeN", "read", getTraceName<T>());
+    drainIngestQueue<T>();
     auto l          = lockForWriting<T>();  // NB: if C++ std gains upgrade_lock, replace this with upgrade lock that is converted to unique lock only after range is determined
     auto& buf       = getBuffer<T>();
 
     auto [startIt, endIt] = getIteratorsFromSampleAndSide<T>(N, side);
-    return consumeFromVec(buf, startIt, endIt);
+    recordReadLatency<T>(startIt, endIt);
+    return consumeFromBuffer(buf, startIt, endIt);
 }
 template <typename T>
 std::vector<T> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_)
@@ -1292,15 +1980,18 @@ std::vector<T> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::o
     const auto timeStart= timeStart_.value_or(defaults::consumeTimeRangeStart);
     const auto timeEnd  = timeEnd_  .value_or(defaults::consumeTimeRangeEnd);
 
+    TittaTrace::scope trace("consumeTimeRange", "read", getTraceName<T>());
+    drainIngestQueue<T>();
     auto l              = lockForWriting<T>();  // NB: if C++ std gains upgrade_lock, replace this with upgrade lock that is converted to unique lock only after range is determined
     auto& buf           = getBuffer<T>();
 
     auto [startIt, endIt, whole] = getIteratorsFromTimeRange<T>(timeStart, timeEnd);
-    return consumeFromVec(buf, startIt, endIt);
+    recordReadLatency<T>(startIt, endIt);
+    return consumeFromBuffer(buf, startIt, endIt);
 }
 
 template <typename T>
-std::vector<T> peekFromVec(const std::vector<T>& buf_, const typename std::vector<T>::const_iterator startIt_, const typename std::vector<T>::const_iterator endIt_)
+std::vector<T> peekFromBuffer(const Titta::buffer_t<T>& buf_, const typename Titta::buffer_t<T>::const_iterator startIt_, const typename Titta::buffer_t<T>::const_iterator endIt_)
 {
     if (std::empty(buf_))
         return std::vector<T>{};
@@ -1315,11 +2006,14 @@ std::vector<T> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSi
     const auto N    = NSamp_.value_or(defaults::peekNSamp);
     const auto side = side_.value_or(defaults::peekSide);
 
+    TittaTrace::scope trace("peekN", "read", getTraceName<T>());
+    drainIngestQueue<T>();
     auto l          = lockForReading<T>();
     auto& buf       = getBuffer<T>();
 
     auto [startIt, endIt] = getIteratorsFromSampleAndSide<T>(N, side);
-    return peekFromVec(buf, startIt, endIt);
+    recordReadLatency<T>(startIt, endIt);
+    return peekFromBuffer(buf, startIt, endIt);
 }
 template <typename T>
 std::vector<T> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_)
@@ -1328,16 +2022,630 @@ std::vector<T> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::opti
     const auto timeStart= timeStart_.value_or(defaults::peekTimeRangeStart);
     const auto timeEnd  = timeEnd_  .value_or(defaults::peekTimeRangeEnd);
 
+    TittaTrace::scope trace("peekTimeRange", "read", getTraceName<T>());
+    drainIngestQueue<T>();
     auto l              = lockForReading<T>();
     auto& buf           = getBuffer<T>();
 
     auto [startIt, endIt, whole] = getIteratorsFromTimeRange<T>(timeStart, timeEnd);
-    return peekFromVec(buf, startIt, endIt);
+    recordReadLatency<T>(startIt, endIt);
+    return peekFromBuffer(buf, startIt, endIt);
+}
+
+template <typename T>
+Titta::BufferLease<T> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_)
+{
+    // deal with default arguments
+    const auto N    = NSamp_.value_or(defaults::peekNSamp);
+    const auto side = side_.value_or(defaults::peekSide);
+
+    TittaTrace::scope trace("peekNLease", "read", getTraceName<T>());
+    drainIngestQueue<T>();
+    auto l          = lockForReading<T>();
+
+    auto [startIt, endIt] = getIteratorsFromSampleAndSide<T>(N, side);
+    recordReadLatency<T>(startIt, endIt);
+    return {std::move(l), startIt, endIt};
+}
+template <typename T>
+Titta::BufferLease<T> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_)
+{
+    // deal with default arguments
+    const auto timeStart= timeStart_.value_or(defaults::peekTimeRangeStart);
+    const auto timeEnd  = timeEnd_  .value_or(defaults::peekTimeRangeEnd);
+
+    TittaTrace::scope trace("peekTimeRangeLease", "read", getTraceName<T>());
+    drainIngestQueue<T>();
+    auto l              = lockForReading<T>();
+
+    auto [startIt, endIt, whole] = getIteratorsFromTimeRange<T>(timeStart, timeEnd);
+    recordReadLatency<T>(startIt, endIt);
+    return {std::move(l), startIt, endIt};
+}
+
+Titta::gazeColumns consumeColumnsFromBuffer(Titta::buffer_t<Titta::gaze>& buf_, Titta::buffer_t<Titta::gaze>::iterator startIt_, Titta::buffer_t<Titta::gaze>::iterator endIt_)
+{
+    if (std::empty(buf_))
+        return {};
+
+    auto out = TittaConvert::toColumns(startIt_, endIt_);
+    if (startIt_==std::begin(buf_) && endIt_==std::end(buf_))
+        buf_.clear();
+    else
+        buf_.erase(startIt_, endIt_);
+    return out;
+}
+Titta::gazeColumns Titta::consumeNColumns(std::optional<size_t> NSamp_, std::optional<BufferSide> side_)
+{
+    // deal with default arguments
+    const auto N    = NSamp_.value_or(defaults::consumeNSamp);
+    const auto side = side_.value_or(defaults::consumeSide);
+
+    TittaTrace::scope trace("consumeNColumns", "read", getTraceName<gaze>());
+    drainIngestQueue<gaze>();
+    auto l          = lockForWriting<gaze>();
+    auto& buf       = getBuffer<gaze>();
+
+    auto [startIt, endIt] = getIteratorsFromSampleAndSide<gaze>(N, side);
+    recordReadLatency<gaze>(startIt, endIt);
+    return consumeColumnsFromBuffer(buf, startIt, endIt);
+}
+Titta::gazeColumns Titta::consumeTimeRangeColumns(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_)
+{
+    // deal with default arguments
+    const auto timeStart= timeStart_.value_or(defaults::consumeTimeRangeStart);
+    const auto timeEnd  = timeEnd_  .value_or(defaults::consumeTimeRangeEnd);
+
+    TittaTrace::scope trace("consumeTimeRangeColumns", "read", getTraceName<gaze>());
+    drainIngestQueue<gaze>();
+    auto l              = lockForWriting<gaze>();
+    auto& buf           = getBuffer<gaze>();
+
+    auto [startIt, endIt, whole] = getIteratorsFromTimeRange<gaze>(timeStart, timeEnd);
+    recordReadLatency<gaze>(startIt, endIt);
+    return consumeColumnsFromBuffer(buf, startIt, endIt);
+}
+Titta::gazeColumns Titta::peekNColumns(std::optional<size_t> NSamp_, std::optional<BufferSide> side_)
+{
+    const auto lease = peekNLease<gaze>(NSamp_, side_);
+    return TittaConvert::toColumns(std::begin(lease), std::end(lease));
+}
+Titta::gazeColumns Titta::peekTimeRangeColumns(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_)
+{
+    const auto lease = peekTimeRangeLease<gaze>(timeStart_, timeEnd_);
+    return TittaConvert::toColumns(std::begin(lease), std::end(lease));
+}
+
+uint64_t Titta::openCursor(std::string stream_, std::optional<BufferSide> side_, std::optional<bool> reclaim_, const bool snake_case_on_stream_not_found /*= false*/)
+{
+    return openCursor(stringToStream(std::move(stream_), snake_case_on_stream_not_found), side_, reclaim_);
+}
+uint64_t Titta::openCursor(const Stream stream_, std::optional<BufferSide> side_, std::optional<bool> reclaim_)
+{
+    // deal with default arguments
+    const auto side    = side_.value_or(defaults::cursorSide);
+    const auto reclaim = reclaim_.value_or(defaults::cursorReclaim);
+    if (side != BufferSide::Start && side != BufferSide::End)
+        DoExitWithMsg("Titta::cpp::openCursor: unknown TittaMex::BufferSide provided.");
+
+    std::scoped_lock lck(_cursorsMutex);
+    const auto id = _nextCursorId++;
+    switch (stream_)
+    {
+        case Stream::Gaze:
+        case Stream::EyeOpenness:
+            openCursorImpl<gaze>(id, side, reclaim);
+            break;
+        case Stream::EyeImage:
+            openCursorImpl<eyeImage>(id, side, reclaim);
+            break;
+        case Stream::ExtSignal:
+            openCursorImpl<extSignal>(id, side, reclaim);
+            break;
+        case Stream::TimeSync:
+            openCursorImpl<timeSync>(id, side, reclaim);
+            break;
+        case Stream::Positioning:
+            openCursorImpl<positioning>(id, side, reclaim);
+            break;
+        case Stream::Notification:
+            openCursorImpl<notification>(id, side, reclaim);
+            break;
+        default:
+            DoExitWithMsg("Titta::cpp::openCursor: unknown stream provided.");
+    }
+    _cursors[id] = stream_;
+    return id;
+}
+template <typename T>
+void Titta::openCursorImpl(const uint64_t cursor_, const BufferSide side_, const bool reclaim_)
+{
+    drainIngestQueue<T>();
+    auto l      = lockForWriting<T>();
+    auto& buf   = getBuffer<T>();
+    buf.addCursor(cursor_, side_ == BufferSide::Start ? 0 : std::size(buf), reclaim_);
+}
+
+Titta::Stream Titta::getCursorStream(const uint64_t cursor_) const
+{
+    std::scoped_lock lck(_cursorsMutex);
+    const auto it = _cursors.find(cursor_);
+    if (it == _cursors.end())
+        DoExitWithMsg("Titta::cpp::getCursorStream: cursor " + std::to_string(cursor_) + " is not open.");
+    return it->second;
+}
+
+template <typename T>
+std::vector<T> Titta::readSince(const uint64_t cursor_, std::optional<size_t> NSamp_)
+{
+    // deal with default arguments
+    const auto N = NSamp_.value_or(defaults::readSinceNSamp);
+
+    // check cursor is for the right stream
+    const auto stream = getCursorStream(cursor_);
+    bool ok;
+    if constexpr (std::is_same_v<T, gaze>)
+        ok = stream == Stream::Gaze || stream == Stream::EyeOpenness;
+    else if constexpr (std::is_same_v<T, eyeImage>)
+        ok = stream == Stream::EyeImage;
+    else if constexpr (std::is_same_v<T, extSignal>)
+        ok = stream == Stream::ExtSignal;
+    else if constexpr (std::is_same_v<T, timeSync>)
+        ok = stream == Stream::TimeSync;
+    else if constexpr (std::is_same_v<T, positioning>)
+        ok = stream == Stream::Positioning;
+    else if constexpr (std::is_same_v<T, notification>)
+        ok = stream == Stream::Notification;
+    if (!ok)
+        DoExitWithMsg(
+            "Titta::cpp::readSince: cursor " + std::to_string(cursor_) + " is not open on the requested stream (it is open on the " + streamToString(stream) + " stream)."
+        );
+
+    TittaTrace::scope trace("readSince", "read", getTraceName<T>());
+    drainIngestQueue<T>();
+    auto l      = lockForWriting<T>();  // cursor position is stored in the buffer and may be updated
+    auto& buf   = getBuffer<T>();
+    if (!buf.hasCursor(cursor_))    // closed in the meantime
+        DoExitWithMsg("Titta::cpp::readSince: cursor " + std::to_string(cursor_) + " is not open.");
+
+    // copy the new samples and advance cursor. Cost is only proportional to the number of new samples
+    const auto first = buf.cursorPosition(cursor_);
+    const auto last  = first + std::min(N, std::size(buf) - first);
+    recordReadLatency<T>(buf.cbegin()+first, buf.cbegin()+last);
+    std::vector<T> out(buf.cbegin()+first, buf.cbegin()+last);
+    buf.setCursorPosition(cursor_, last);
+
+    // release samples that are no longer needed, if all cursors allow that
+    if (const auto n = buf.reclaimableCount())
+        buf.pop_front(n);
+
+    return out;
+}
+
+bool Titta::closeCursor(const uint64_t cursor_)
+{
+    std::scoped_lock lck(_cursorsMutex);
+    const auto it = _cursors.find(cursor_);
+    if (it == _cursors.end())
+        return false;
+
+    switch (it->second)
+    {
+        case Stream::Gaze:
+        case Stream::EyeOpenness:
+            closeCursorImpl<gaze>(cursor_);
+            break;
+        case Stream::EyeImage:
+            closeCursorImpl<eyeImage>(cursor_);
+            break;
+        case Stream::ExtSignal:
+            closeCursorImpl<extSignal>(cursor_);
+            break;
+        case Stream::TimeSync:
+            closeCursorImpl<timeSync>(cursor_);
+            break;
+        case Stream::Positioning:
+            closeCursorImpl<positioning>(cursor_);
+            break;
+        case Stream::Notification:
+            closeCursorImpl<notification>(cursor_);
+            break;
+    }
+    _cursors.erase(it);
+    return true;
+}
+template <typename T>
+bool Titta::closeCursorImpl(const uint64_t cursor_)
+{
+    auto l      = lockForWriting<T>();
+    auto& buf   = getBuffer<T>();
+    return buf.removeCursor(cursor_);
+}
+
+namespace
+{
+    template <typename T>
+    constexpr size_t journalIndex()
+    {
+        if constexpr (std::is_same_v<T, Titta::gaze>)
+            return 0;
+        else if constexpr (std::is_same_v<T, Titta::eyeImage>)
+            return 1;
+        else if constexpr (std::is_same_v<T, Titta::extSignal>)
+            return 2;
+        else if constexpr (std::is_same_v<T, Titta::timeSync>)
+            return 3;
+        else if constexpr (std::is_same_v<T, Titta::positioning>)
+            return 4;
+        else if constexpr (std::is_same_v<T, Titta::notification>)
+            return 5;
+    }
+    // journal stream ids in same order as journalIndex()
+    constexpr std::array journalStreamIds =
+    {
+        TittaJournal::StreamId::Gaze,
+        TittaJournal::StreamId::EyeImage,
+        TittaJournal::StreamId::ExtSignal,
+        TittaJournal::StreamId::TimeSync,
+        TittaJournal::StreamId::Positioning,
+        TittaJournal::StreamId::Notification
+    };
+}
+
+void Titta::startJournal(std::string filePath_, std::optional<size_t> inMemoryWindow_)
+{
+    if (isJournaling())
+        DoExitWithMsg("Titta::cpp::startJournal: already writing a journal to \"" + _journal->getFilePath() + "\", call stopJournal first.");
+
+    _journal        = std::make_unique<TittaJournal::writer>(filePath_);
+    _journalWindow  = inMemoryWindow_.value_or(defaults::journalInMemoryWindow);
+
+    // a cursor for each buffer, tracking which samples have been written to the journal. These are not
+    // registered as user cursors, so they cannot be closed from outside. Start at beginning of buffer, so
+    // that samples already recorded are included in the journal
+    {
+        std::scoped_lock lck(_cursorsMutex);
+        for (auto& c: _journalCursors)
+            c = _nextCursorId++;
+    }
+    openCursorImpl<gaze>        (_journalCursors[journalIndex<gaze>()],         BufferSide::Start, false);
+    openCursorImpl<eyeImage>    (_journalCursors[journalIndex<eyeImage>()],     BufferSide::Start, false);
+    openCursorImpl<extSignal>   (_journalCursors[journalIndex<extSignal>()],    BufferSide::Start, false);
+    openCursorImpl<timeSync>    (_journalCursors[journalIndex<timeSync>()],     BufferSide::Start, false);
+    openCursorImpl<positioning> (_journalCursors[journalIndex<positioning>()],  BufferSide::Start, false);
+    openCursorImpl<notification>(_journalCursors[journalIndex<notification>()], BufferSide::Start, false);
+
+    _journalShouldStop = false;
+    _journalError.clear();
+    _journalFailed = false;
+    _journalThread = std::thread(&Titta::journalThread, this);
+}
+bool Titta::stopJournal()
+{
+    if (!_journalThread.joinable())
+        return false;
+
+    if (auto error = stopJournalImpl(); !error.empty())
+        DoExitWithMsg(std::move(error));
+    return true;
+}
+std::string Titta::stopJournalImpl()
+{
+    if (!_journalThread.joinable())
+        return {};
+
+    {
+        std::scoped_lock lck(_journalMutex);
+        _journalShouldStop = true;
+    }
+    _journalStopCV.notify_all();
+    _journalThread.join();      // NB: thread does a final write
+
+    closeCursorImpl<gaze>        (_journalCursors[journalIndex<gaze>()]);
+    closeCursorImpl<eyeImage>    (_journalCursors[journalIndex<eyeImage>()]);
+    closeCursorImpl<extSignal>   (_journalCursors[journalIndex<extSignal>()]);
+    closeCursorImpl<timeSync>    (_journalCursors[journalIndex<timeSync>()]);
+    closeCursorImpl<positioning> (_journalCursors[journalIndex<positioning>()]);
+    closeCursorImpl<notification>(_journalCursors[journalIndex<notification>()]);
+
+    _journal.reset();
+    return std::exchange(_journalError, {});
+}
+bool Titta::isJournaling()
+{
+    // if the journal thread stopped because of an error, clean up and raise the error here, on the caller's thread
+    if (_journalFailed)
+        stopJournal();
+    return _journalThread.joinable();
+}
+TittaJournal::contents Titta::readJournal(std::string filePath_)
+{
+    return TittaJournal::read(filePath_);
+}
+
+template <typename T, typename Encode, typename Write>
+void Titta::exportBuffer(Encode&& encode_, Write&& write_)
+{
+    // two internal cursors delimit the samples still to be exported. Cursors keep pointing to the same
+    // sample when samples are removed from the buffer and are unaffected by new samples, so the buffer can be
+    // used as normal while it is unlocked
+    uint64_t first, last;
+    {
+        std::scoped_lock lck(_cursorsMutex);
+        first = _nextCursorId++;
+        last  = _nextCursorId++;
+    }
+    openCursorImpl<T>(first, BufferSide::Start, false);
+    openCursorImpl<T>(last,  BufferSide::End,   false);
+
+    try
+    {
+        while (true)
+        {
+            {
+                auto l      = lockForWriting<T>();
+                auto& buf   = getBuffer<T>();
+                const auto i = buf.cursorPosition(first);
+                const auto e = buf.cursorPosition(last);
+                if (i >= e)
+                    break;
+                buf.setCursorPosition(first, encode_(buf, i, e));
+            }
+
+            // write outside of buffer lock
+            write_();
+        }
+    }
+    catch (...)
+    {
+        closeCursorImpl<T>(first);
+        closeCursorImpl<T>(last);
+        throw;
+    }
+    closeCursorImpl<T>(first);
+    closeCursorImpl<T>(last);
+}
+
+void Titta::saveSession(std::string filePath_)
+{
+    TittaSession::writer w(filePath_);
+    // write directly from the buffers, one at a time
+    saveSessionStream<gaze>(w);
+    saveSessionStream<eyeImage>(w);
+    saveSessionStream<extSignal>(w);
+    saveSessionStream<timeSync>(w);
+    saveSessionStream<notification>(w);
+    w.finish();
+}
+template <typename T>
+void Titta::saveSessionStream(TittaSession::writer& w_)
+{
+    w_.beginStream(TittaSession::getStreamId<T>());
+    exportBuffer<T>(
+        [&w_](const auto& buf_, const size_t first_, const size_t last_)
+        {
+            return w_.encodeChunk(std::begin(buf_) + first_, std::begin(buf_) + last_).index();
+        },
+        [&w_] { w_.writeChunk(); });
+}
+void Titta::convertJournalToSession(std::string journalFilePath_, std::string sessionFilePath_)
+{
+    const auto data = TittaJournal::read(journalFilePath_);
+    TittaSession::writer w(sessionFilePath_);
+    w.writeStream(data.gaze);
+    w.writeStream(data.eyeImage);
+    w.writeStream(data.extSignal);
+    w.writeStream(data.timeSync);
+    w.writeStream(data.notification);
+    w.finish();
+}
+
+void Titta::saveParquet(std::string filePathBase_, std::optional<size_t> rowGroupSize_)
+{
+    const auto rowGroupSize = rowGroupSize_.value_or(defaults::parquetRowGroupSize);
+    if (!rowGroupSize)
+        DoExitWithMsg("Titta::cpp::saveParquet: row group size should be at least 1.");
+
+    // write directly from the buffers, one at a time
+    saveParquetStream<gaze>(filePathBase_, rowGroupSize);
+    saveParquetStream<eyeImage>(filePathBase_, rowGroupSize);
+    saveParquetStream<extSignal>(filePathBase_, rowGroupSize);
+    saveParquetStream<timeSync>(filePathBase_, rowGroupSize);
+    saveParquetStream<notification>(filePathBase_, rowGroupSize);
+}
+template <typename T>
+void Titta::saveParquetStream(const std::string& filePathBase_, const size_t rowGroupSize_)
+{
+    constexpr auto stream = TittaSession::getStreamId<T>();
+    TittaParquet::writer w(TittaParquet::getFilePath(filePathBase_, stream), stream);
+    TittaParquet::rowGroup rows(stream);
+    exportBuffer<T>(
+        [&rows, rowGroupSize_](const auto& buf_, size_t first_, const size_t last_)
+        {
+            // encode up to a row group of samples
+            for (; first_ < last_ && rows.getNumRows() < rowGroupSize_ && rows.getNumBytes() < defaults::parquetMaxRowGroupBytes; first_++)
+                rows.add(buf_[first_]);
+            return first_;
+        },
+        [&w, &rows]
+        {
+            w.writeRowGroup(rows);
+            rows.clear();
+        });
+    w.finish();
+}
+void Titta::startParquet(std::string filePathBase_, std::optional<size_t> rowGroupSize_)
+{
+    std::scoped_lock lck(_parquetMutex);
+    if (_parquetWriters[journalIndex<gaze>()])
+        DoExitWithMsg("Titta::cpp::startParquet: already writing parquet files (\"" + _parquetWriters[journalIndex<gaze>()]->getFilePath() + "\"), call stopParquet first.");
+    _parquetRowGroupSize = rowGroupSize_.value_or(defaults::parquetRowGroupSize);
+    if (!_parquetRowGroupSize)
+        DoExitWithMsg("Titta::cpp::startParquet: row group size should be at least 1.");
+
+    for (const auto s: {journalIndex<gaze>(), journalIndex<eyeImage>(), journalIndex<extSignal>(), journalIndex<timeSync>(), journalIndex<notification>()})
+        _parquetWriters[s] = std::make_unique<TittaParquet::writer>(TittaParquet::getFilePath(filePathBase_, journalStreamIds[s]), journalStreamIds[s]);
+
+    // a cursor for each buffer, tracking which samples have been exported, as for the journal
+    {
+        std::scoped_lock lck2(_cursorsMutex);
+        for (auto& c: _parquetCursors)
+            c = _nextCursorId++;
+    }
+    openCursorImpl<gaze>        (_parquetCursors[journalIndex<gaze>()],         BufferSide::Start, false);
+    openCursorImpl<eyeImage>    (_parquetCursors[journalIndex<eyeImage>()],     BufferSide::Start, false);
+    openCursorImpl<extSignal>   (_parquetCursors[journalIndex<extSignal>()],    BufferSide::Start, false);
+    openCursorImpl<timeSync>    (_parquetCursors[journalIndex<timeSync>()],     BufferSide::Start, false);
+    openCursorImpl<notification>(_parquetCursors[journalIndex<notification>()], BufferSide::Start, false);
+}
+void Titta::flushParquet()
+{
+    std::scoped_lock lck(_parquetMutex);
+    if (!_parquetWriters[journalIndex<gaze>()])
+        DoExitWithMsg("Titta::cpp::flushParquet: not writing parquet files, call startParquet first.");
+    writeParquet();
+}
+bool Titta::stopParquet()
+{
+    std::scoped_lock lck(_parquetMutex);
+    if (!_parquetWriters[journalIndex<gaze>()])
+        return false;
+
+    writeParquet();
+    for (auto& w: _parquetWriters)
+        if (w)
+            w->finish();
+
+    closeCursorImpl<gaze>        (_parquetCursors[journalIndex<gaze>()]);
+    closeCursorImpl<eyeImage>    (_parquetCursors[journalIndex<eyeImage>()]);
+    closeCursorImpl<extSignal>   (_parquetCursors[journalIndex<extSignal>()]);
+    closeCursorImpl<timeSync>    (_parquetCursors[journalIndex<timeSync>()]);
+    closeCursorImpl<notification>(_parquetCursors[journalIndex<notification>()]);
+
+    for (auto& w: _parquetWriters)
+        w.reset();
+    return true;
+}
+bool Titta::isWritingParquet() const
+{
+    std::scoped_lock lck(_parquetMutex);
+    return !!_parquetWriters[journalIndex<gaze>()];
+}
+
+void Titta::journalThread()
+{
+    TittaTrace::setThreadName("Titta journal");
+    // errors cannot be raised on this thread (DoExitWithMsg must run on the user's thread), so on error the
+    // message is stored, journaling stops, and the error is raised by isJournaling() or stopJournal()
+    try
+    {
+        std::unique_lock lck(_journalMutex);
+        bool ok = true;
+        while (ok && !_journalShouldStop)
+        {
+            {
+                TittaTrace::scope trace("write journal", "journal");
+                ok = writeJournal();
+            }
+            if (ok)
+                _journalStopCV.wait_for(lck, defaults::journalInterval, [this] { return _journalShouldStop; });
+        }
+        if (ok && writeJournal())
+            return;
+        _journalError = "Titta::cpp::journal: error writing to file \"" + _journal->getFilePath() + "\", journaling was stopped";
+    }
+    catch (const std::exception& e)
+    {
+        _journalError = std::string("Titta::cpp::journal: error while writing journal, journaling was stopped: ") + e.what();
+    }
+    catch (...)
+    {
+        _journalError = "Titta::cpp::journal: unknown error while writing journal, journaling was stopped";
+    }
+    _journalFailed = true;
+}
+bool Titta::writeJournal()
+{
+    return
+        writeJournalStream<gaze>() &&
+        writeJournalStream<eyeImage>() &&
+        writeJournalStream<extSignal>() &&
+        writeJournalStream<timeSync>() &&
+        writeJournalStream<positioning>() &&
+        writeJournalStream<notification>();
+}
+template <typename T>
+bool Titta::writeJournalStream()
+{
+    std::vector<uint8_t> payload;
+    size_t nSamples;
+
+    drainIngestQueue<T>();
+    {
+        auto l          = lockForWriting<T>();
+        auto& buf       = getBuffer<T>();
+        const auto c    = _journalCursors[journalIndex<T>()];
+
+        // serialize samples not yet in journal, advance cursor past them
+        const auto first = buf.cursorPosition(c);
+        nSamples = std::size(buf) - first;
+        for (auto i = first; i < std::size(buf); i++)
+            TittaJournal::serialize(payload, buf[i]);
+        buf.setCursorPosition(c, std::size(buf));
+
+        // all samples are now in the journal, only keep the requested number in memory. Samples that a cursor
+        // has not yet passed are kept
+        if (_journalWindow && std::size(buf) > _journalWindow)
+            buf.pop_front(std::min(std::size(buf) - _journalWindow, buf.passedCount()));
+    }
+
+    // write outside of buffer lock
+    if (!nSamples)
+        return true;
+    return _journal->writeChunk(journalStreamIds[journalIndex<T>()], static_cast<uint32_t>(nSamples), payload);
+}
+
+void Titta::writeParquet()
+{
+    writeParquetStream<gaze>();
+    writeParquetStream<eyeImage>();
+    writeParquetStream<extSignal>();
+    writeParquetStream<timeSync>();
+    writeParquetStream<notification>();
+}
+template <typename T>
+void Titta::writeParquetStream()
+{
+    auto& w         = *_parquetWriters[journalIndex<T>()];
+    const auto c    = _parquetCursors[journalIndex<T>()];
+    TittaParquet::rowGroup rows(TittaSession::getStreamId<T>());
+
+    drainIngestQueue<T>();
+    while (true)
+    {
+        {
+            auto l      = lockForWriting<T>();
+            auto& buf   = getBuffer<T>();
+
+            // encode up to a row group of samples not yet exported, advance cursor past them
+            auto i = buf.cursorPosition(c);
+            for (; i < std::size(buf) && rows.getNumRows() < _parquetRowGroupSize && rows.getNumBytes() < defaults::parquetMaxRowGroupBytes; i++)
+                rows.add(buf[i]);
+            buf.setCursorPosition(c, i);
+        }
+        if (!rows.getNumRows())
+            break;
+
+        // write outside of buffer lock
+        w.writeRowGroup(rows);
+        rows.clear();
+    }
 }
 
 template <typename T>
 void Titta::clearImpl(const int64_t timeStart_, const int64_t timeEnd_)
 {
+    drainIngestQueue<T>();
     auto l      = lockForWriting<T>();  // NB: if C++ std gains upgrade_lock, replace this with upgrade lock that is converted to unique lock only after range is determined
     auto& buf   = getBuffer<T>();
     if (std::empty(buf))
@@ -1359,6 +2667,7 @@ void Titta::clear(const Stream stream_)
 {
     if (stream_ == Stream::Positioning)
     {
+        drainIngestQueue<positioning>();
         auto l      = lockForWriting<positioning>();    // NB: if C++ std gains upgrade_lock, replace this with upgrade lock that is converted to unique lock only after range is determined
         auto& buf   = getBuffer<positioning>();
         if (std::empty(buf))
@@ -1417,37 +2726,49 @@ bool Titta::stop(const Stream stream_, std::optional<bool> clearBuffer_)
     switch (stream_)
     {
         case Stream::Gaze:
-            result = !_recordingGaze ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_gaze_data(_eyeTracker.et, TittaGazeCallback);
+            result = !_recordingGaze ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TittaGazeCallback) : tobii_research_unsubscribe_from_gaze_data(_eyeTracker.et, TittaGazeCallback);
             stateVar = &_recordingGaze;
             break;
         case Stream::EyeOpenness:
-            result = !_recordingEyeOpenness ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_eye_openness(_eyeTracker.et, TittaEyeOpennessCallback);
+            result = !_recordingEyeOpenness ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TittaEyeOpennessCallback) : tobii_research_unsubscribe_from_eye_openness(_eyeTracker.et, TittaEyeOpennessCallback);
             stateVar = &_recordingEyeOpenness;
             break;
         case Stream::EyeImage:
-            result = !_recordingEyeImages ? TOBII_RESEARCH_STATUS_OK : doUnsubscribeEyeImage(_eyeTracker.et, _eyeImIsGif);
+            result = !_recordingEyeImages ? TOBII_RESEARCH_STATUS_OK : doUnsubscribeEyeImage(_eyeTracker.et, _simulator.get(), _eyeImIsGif);
             stateVar = &_recordingEyeImages;
             break;
         case Stream::ExtSignal:
-            result = !_recordingExtSignal ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_external_signal_data(_eyeTracker.et, TittaExtSignalCallback);
+            result = !_recordingExtSignal ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TittaExtSignalCallback) : tobii_research_unsubscribe_from_external_signal_data(_eyeTracker.et, TittaExtSignalCallback);
             stateVar = &_recordingExtSignal;
             break;
         case Stream::TimeSync:
-            result = !_recordingTimeSync ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_time_synchronization_data(_eyeTracker.et, TittaTimeSyncCallback);
+            result = !_recordingTimeSync ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TittaTimeSyncCallback) : tobii_research_unsubscribe_from_time_synchronization_data(_eyeTracker.et, TittaTimeSyncCallback);
             stateVar = &_recordingTimeSync;
             break;
         case Stream::Positioning:
-            result = !_recordingPositioning ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_user_position_guide(_eyeTracker.et, TittaPositioningCallback);
+            result = !_recordingPositioning ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TittaPositioningCallback) : tobii_research_unsubscribe_from_user_position_guide(_eyeTracker.et, TittaPositioningCallback);
             stateVar = &_recordingPositioning;
             break;
         case Stream::Notification:
-            result = !_recordingNotification ? TOBII_RESEARCH_STATUS_OK : tobii_research_unsubscribe_from_notifications(_eyeTracker.et, TittaNotificationCallback);
+            result = !_recordingNotification ? TOBII_RESEARCH_STATUS_OK : _simulator ? _simulator->unsubscribe(TittaNotificationCallback) : tobii_research_unsubscribe_from_notifications(_eyeTracker.et, TittaNotificationCallback);
             stateVar = &_recordingNotification;
             break;
     }
 
+    // no longer merging gaze and eye openness, output any samples still waiting for their partner
+    if ((stream_==Stream::Gaze || stream_==Stream::EyeOpenness) && result == TOBII_RESEARCH_STATUS_OK)
+        flushGazeStaging(false);
+
     if (clearBuffer)
+    {
+        // make sure samples are written to the journal before they are deleted
+        if (isJournaling())
+        {
+            std::scoped_lock lck(_journalMutex);
+            writeJournal();
+        }
         clear(stream_);
+    }
 
     const bool success = result == TOBII_RESEARCH_STATUS_OK;
     if (stateVar && success)
@@ -1466,29 +2787,84 @@ bool Titta::stop(const Stream stream_, std::optional<bool> clearBuffer_)
     return success;
 }
 
+template <typename T>
+std::optional<T> Titta::getLatest() const
+{
+    // NB: deliberately does not touch the buffer or its mutex
+    if constexpr (std::is_same_v<T, gaze>)
+        return _gazeLatest.load();
+    if constexpr (std::is_same_v<T, extSignal>)
+        return _extSignalLatest.load();
+    if constexpr (std::is_same_v<T, timeSync>)
+        return _timeSyncLatest.load();
+    if constexpr (std::is_same_v<T, positioning>)
+        return _positioningLatest.load();
+}
+
+uint64_t Titta::getNumDroppedSamples(std::string stream_, const bool snake_case_on_stream_not_found /*= false*/)
+{
+    return getNumDroppedSamples(stringToStream(std::move(stream_), snake_case_on_stream_not_found));
+}
+uint64_t Titta::getNumDroppedSamples(const Stream stream_)
+{
+    switch (stream_)
+    {
+        case Stream::Gaze:
+        case Stream::EyeOpenness:
+            return getBufferBounds<gaze>().nDropped;
+        case Stream::EyeImage:
+            return getBufferBounds<eyeImage>().nDropped;
+        case Stream::ExtSignal:
+            return getBufferBounds<extSignal>().nDropped;
+        case Stream::TimeSync:
+            return getBufferBounds<timeSync>().nDropped;
+        case Stream::Positioning:
+            return getBufferBounds<positioning>().nDropped;
+        case Stream::Notification:
+            return getBufferBounds<notification>().nDropped;
+    }
+
+    return 0;
+}
+
 // gaze data (including eye openness), instantiate templated functions
 template std::vector<Titta::gaze> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::gaze> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 template std::vector<Titta::gaze> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::gaze> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template Titta::BufferLease<Titta::gaze> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
+template std::vector<Titta::gaze> Titta::readSince(uint64_t cursor_, std::optional<size_t> NSamp_);
+template Titta::BufferLease<Titta::gaze> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template std::optional<Titta::gaze> Titta::getLatest() const;
 
 // eye images, instantiate templated functions
 template std::vector<Titta::eyeImage> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::eyeImage> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 template std::vector<Titta::eyeImage> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::eyeImage> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template Titta::BufferLease<Titta::eyeImage> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
+template std::vector<Titta::eyeImage> Titta::readSince(uint64_t cursor_, std::optional<size_t> NSamp_);
+template Titta::BufferLease<Titta::eyeImage> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 
 // external signals, instantiate templated functions
 template std::vector<Titta::extSignal> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::extSignal> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 template std::vector<Titta::extSignal> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::extSignal> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template Titta::BufferLease<Titta::extSignal> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
+template std::vector<Titta::extSignal> Titta::readSince(uint64_t cursor_, std::optional<size_t> NSamp_);
+template Titta::BufferLease<Titta::extSignal> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template std::optional<Titta::extSignal> Titta::getLatest() const;
 
 // time sync data, instantiate templated functions
 template std::vector<Titta::timeSync> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::timeSync> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 template std::vector<Titta::timeSync> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::timeSync> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template Titta::BufferLease<Titta::timeSync> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
+template std::vector<Titta::timeSync> Titta::readSince(uint64_t cursor_, std::optional<size_t> NSamp_);
+template Titta::BufferLease<Titta::timeSync> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template std::optional<Titta::timeSync> Titta::getLatest() const;
 
 // positioning data, instantiate templated functions
 // NB: positioning data does not have timestamps, so the Time Range version of the below functions are not defined for the positioning stream
@@ -1496,9 +2872,16 @@ template std::vector<Titta::positioning> Titta::consumeN(std::optional<size_t> N
 //template std::vector<Titta::positioning> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 template std::vector<Titta::positioning> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 //template std::vector<Titta::positioning> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template Titta::BufferLease<Titta::positioning> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
+template std::vector<Titta::positioning> Titta::readSince(uint64_t cursor_, std::optional<size_t> NSamp_);
+//template Titta::BufferLease<Titta::positioning> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template std::optional<Titta::positioning> Titta::getLatest() const;
 
 // notifications, instantiate templated functions
 template std::vector<Titta::notification> Titta::consumeN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::notification> Titta::consumeTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
 template std::vector<Titta::notification> Titta::peekN(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
 template std::vector<Titta::notification> Titta::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
+template Titta::BufferLease<Titta::notification> Titta::peekNLease(std::optional<size_t> NSamp_, std::optional<BufferSide> side_);
+template std::vector<Titta::notification> Titta::readSince(uint64_t cursor_, std::optional<size_t> NSamp_);
+template Titta::BufferLease<Titta::notification> Titta::peekTimeRangeLease(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_);
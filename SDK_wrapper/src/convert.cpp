@@ -0,0 +1,244 @@
+#include "Titta/convert.h"
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+#if defined(TITTA_CONVERT_AVX2) || defined(TITTA_CONVERT_SSE2)
+#   include <immintrin.h>
+#endif
+
+namespace
+{
+    // layout assumptions of the conversions below
+    // 1. the floats of a packed eye are contiguous, and in the order of the columns
+    constexpr size_t nEyeFloats = 13;
+    static_assert(offsetof(TobiiTypes::eyeDataPacked, gaze_point_on_display_area) == 0);
+    static_assert(offsetof(TobiiTypes::eyeDataPacked, eye_openness_diameter) == (nEyeFloats-1)*sizeof(float));
+    // 2. positions of a point are contiguous
+    static_assert(sizeof(TobiiResearchPoint3D) == 3*sizeof(float) && sizeof(TobiiResearchNormalizedPoint2D) == 2*sizeof(float));
+
+    const float* getFloats(const TobiiTypes::eyeDataPacked& eye_)
+    {
+        return &eye_.gaze_point_on_display_area[0];
+    }
+
+    void eyeToColumns(TobiiTypes::eyeDataColumns& out_, const size_t offset_, const TobiiTypes::gazeDataPacked* const* samples_, const size_t n_, TobiiTypes::eyeDataPacked TobiiTypes::gazeDataPacked::* eye_)
+    {
+        // output columns, in the order of the floats of a packed eye, and of the flag bits
+        float* const fCols[nEyeFloats] = {
+            out_.gaze_point_on_display_area_x.data(), out_.gaze_point_on_display_area_y.data(),
+            out_.gaze_point_in_user_coordinates_x.data(), out_.gaze_point_in_user_coordinates_y.data(), out_.gaze_point_in_user_coordinates_z.data(),
+            out_.pupil_diameter.data(),
+            out_.gaze_origin_in_user_coordinates_x.data(), out_.gaze_origin_in_user_coordinates_y.data(), out_.gaze_origin_in_user_coordinates_z.data(),
+            out_.gaze_origin_in_track_box_coordinates_x.data(), out_.gaze_origin_in_track_box_coordinates_y.data(), out_.gaze_origin_in_track_box_coordinates_z.data(),
+            out_.eye_openness_diameter.data()
+        };
+        uint8_t* const bCols[8] = {
+            out_.gaze_point_valid.data(), out_.gaze_point_available.data(),
+            out_.pupil_valid.data(), out_.pupil_available.data(),
+            out_.gaze_origin_valid.data(), out_.gaze_origin_available.data(),
+            out_.eye_openness_valid.data(), out_.eye_openness_available.data()
+        };
+
+        // 1. floats: transpose blocks of samples x floats
+        size_t i = 0;
+#if defined(TITTA_CONVERT_AVX2)
+        // 8 samples at a time, floats 0-7 and 5-12 (overlapping so that all 13 are covered by two 8x8 blocks)
+        for (; i + 8 <= n_; i += 8)
+        {
+            for (const size_t f: {size_t{0}, nEyeFloats-8})
+            {
+                __m256 r[8];
+                for (size_t s = 0; s < 8; s++)
+                    r[s] = _mm256_loadu_ps(getFloats(samples_[i+s]->*eye_) + f);
+                const __m256 t0 = _mm256_unpacklo_ps(r[0], r[1]), t1 = _mm256_unpackhi_ps(r[0], r[1]);
+                const __m256 t2 = _mm256_unpacklo_ps(r[2], r[3]), t3 = _mm256_unpackhi_ps(r[2], r[3]);
+                const __m256 t4 = _mm256_unpacklo_ps(r[4], r[5]), t5 = _mm256_unpackhi_ps(r[4], r[5]);
+                const __m256 t6 = _mm256_unpacklo_ps(r[6], r[7]), t7 = _mm256_unpackhi_ps(r[6], r[7]);
+                const __m256 u0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), u1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+                const __m256 u2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), u3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+                const __m256 u4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), u5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+                const __m256 u6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), u7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+                _mm256_storeu_ps(fCols[f+0] + offset_ + i, _mm256_permute2f128_ps(u0, u4, 0x20));
+                _mm256_storeu_ps(fCols[f+1] + offset_ + i, _mm256_permute2f128_ps(u1, u5, 0x20));
+                _mm256_storeu_ps(fCols[f+2] + offset_ + i, _mm256_permute2f128_ps(u2, u6, 0x20));
+                _mm256_storeu_ps(fCols[f+3] + offset_ + i, _mm256_permute2f128_ps(u3, u7, 0x20));
+                _mm256_storeu_ps(fCols[f+4] + offset_ + i, _mm256_permute2f128_ps(u0, u4, 0x31));
+                _mm256_storeu_ps(fCols[f+5] + offset_ + i, _mm256_permute2f128_ps(u1, u5, 0x31));
+                _mm256_storeu_ps(fCols[f+6] + offset_ + i, _mm256_permute2f128_ps(u2, u6, 0x31));
+                _mm256_storeu_ps(fCols[f+7] + offset_ + i, _mm256_permute2f128_ps(u3, u7, 0x31));
+            }
+        }
+#elif defined(TITTA_CONVERT_SSE2)
+        // 4 samples at a time, floats 0-3, 4-7, 8-11 and 9-12 (overlapping)
+        for (; i + 4 <= n_; i += 4)
+        {
+            for (const size_t f: {size_t{0}, size_t{4}, size_t{8}, nEyeFloats-4})
+            {
+                __m128 r0 = _mm_loadu_ps(getFloats(samples_[i+0]->*eye_) + f);
+                __m128 r1 = _mm_loadu_ps(getFloats(samples_[i+1]->*eye_) + f);
+                __m128 r2 = _mm_loadu_ps(getFloats(samples_[i+2]->*eye_) + f);
+                __m128 r3 = _mm_loadu_ps(getFloats(samples_[i+3]->*eye_) + f);
+                _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                _mm_storeu_ps(fCols[f+0] + offset_ + i, r0);
+                _mm_storeu_ps(fCols[f+1] + offset_ + i, r1);
+                _mm_storeu_ps(fCols[f+2] + offset_ + i, r2);
+                _mm_storeu_ps(fCols[f+3] + offset_ + i, r3);
+            }
+        }
+#endif
+        for (; i < n_; i++)
+        {
+            const auto f = getFloats(samples_[i]->*eye_);
+            for (size_t c = 0; c < nEyeFloats; c++)
+                fCols[c][offset_ + i] = f[c];
+        }
+
+        // 2. flags: collect the flag bytes of a block of samples, then isolate each bit as 0 or 1
+        i = 0;
+#if defined(TITTA_CONVERT_SSE2)
+        const __m128i one = _mm_set1_epi8(1);
+        for (; i + 16 <= n_; i += 16)
+        {
+            alignas(16) uint8_t flags[16];
+            for (size_t s = 0; s < 16; s++)
+                flags[s] = (samples_[i+s]->*eye_).flags;
+            const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(flags));
+            for (int b = 0; b < 8; b++)
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(bCols[b] + offset_ + i), _mm_min_epu8(_mm_and_si128(v, _mm_set1_epi8(static_cast<char>(1<<b))), one));
+        }
+#endif
+        for (; i < n_; i++)
+        {
+            const auto flags = (samples_[i]->*eye_).flags;
+            for (int b = 0; b < 8; b++)
+                bCols[b][offset_ + i] = (flags >> b) & 1;
+        }
+    }
+
+    template <typename T>
+    void eyeToRow(T* out_, const TobiiTypes::eyeData& eye_)
+    {
+        const auto valid = [](const TobiiResearchValidity v_) { return static_cast<T>(v_ == TOBII_RESEARCH_VALIDITY_VALID); };
+#if defined(TITTA_CONVERT_SSE2)
+        if constexpr (std::is_same_v<T, double>)
+        {
+            // convert runs of floats two at a time
+            const __m128 gp = _mm_loadu_ps(&eye_.gaze_point.position_on_display_area.x);          // display x, y, user x, y
+            _mm_storeu_pd(out_ +  0, _mm_cvtps_pd(gp));
+            _mm_storeu_pd(out_ +  2, _mm_cvtps_pd(_mm_movehl_ps(gp, gp)));
+            const __m128 go = _mm_loadu_ps(&eye_.gaze_origin.position_in_user_coordinates.x);     // user x, y, z, track box x
+            _mm_storeu_pd(out_ + 10, _mm_cvtps_pd(go));
+            _mm_storeu_pd(out_ + 12, _mm_cvtps_pd(_mm_movehl_ps(go, go)));
+            _mm_storeu_pd(out_ + 14, _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&eye_.gaze_origin.position_in_track_box_coordinates.y)))));
+        }
+        else
+#endif
+        {
+            out_[ 0] = static_cast<T>(eye_.gaze_point.position_on_display_area.x);
+            out_[ 1] = static_cast<T>(eye_.gaze_point.position_on_display_area.y);
+            out_[ 2] = static_cast<T>(eye_.gaze_point.position_in_user_coordinates.x);
+            out_[ 3] = static_cast<T>(eye_.gaze_point.position_in_user_coordinates.y);
+            out_[10] = static_cast<T>(eye_.gaze_origin.position_in_user_coordinates.x);
+            out_[11] = static_cast<T>(eye_.gaze_origin.position_in_user_coordinates.y);
+            out_[12] = static_cast<T>(eye_.gaze_origin.position_in_user_coordinates.z);
+            out_[13] = static_cast<T>(eye_.gaze_origin.position_in_track_box_coordinates.x);
+            out_[14] = static_cast<T>(eye_.gaze_origin.position_in_track_box_coordinates.y);
+            out_[15] = static_cast<T>(eye_.gaze_origin.position_in_track_box_coordinates.z);
+        }
+        out_[ 4] = static_cast<T>(eye_.gaze_point.position_in_user_coordinates.z);
+        out_[ 5] = valid(eye_.gaze_point.validity);
+        out_[ 6] = static_cast<T>(eye_.gaze_point.available);
+        out_[ 7] = static_cast<T>(eye_.pupil.diameter);
+        out_[ 8] = valid(eye_.pupil.validity);
+        out_[ 9] = static_cast<T>(eye_.pupil.available);
+        out_[16] = valid(eye_.gaze_origin.validity);
+        out_[17] = static_cast<T>(eye_.gaze_origin.available);
+        out_[18] = static_cast<T>(eye_.eye_openness.diameter);
+        out_[19] = valid(eye_.eye_openness.validity);
+        out_[20] = static_cast<T>(eye_.eye_openness.available);
+    }
+}
+
+namespace TittaConvert
+{
+    const char* getInstructionSet()
+    {
+#if defined(TITTA_CONVERT_AVX2)
+        return "AVX2";
+#elif defined(TITTA_CONVERT_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+    void toColumns(TobiiTypes::gazeColumns& out_, const size_t offset_, const TobiiTypes::gazeDataPacked* const* samples_, const size_t n_)
+    {
+        for (size_t i = 0; i < n_; i++)
+        {
+            out_.device_time_stamp[offset_ + i] = samples_[i]->device_time_stamp;
+            out_.system_time_stamp[offset_ + i] = samples_[i]->system_time_stamp;
+        }
+        eyeToColumns(out_.left_eye , offset_, samples_, n_, &TobiiTypes::gazeDataPacked::left_eye);
+        eyeToColumns(out_.right_eye, offset_, samples_, n_, &TobiiTypes::gazeDataPacked::right_eye);
+    }
+
+    template <typename T>
+    void toRows(T* out_, const TobiiTypes::gazeData* samples_, const size_t n_)
+    {
+        for (size_t i = 0; i < n_; i++, out_ += rowSize)
+        {
+            eyeToRow(out_     , samples_[i].left_eye);
+            eyeToRow(out_ + 21, samples_[i].right_eye);
+            out_[42] = static_cast<T>(samples_[i].device_time_stamp) / static_cast<T>(1'000'000.);
+        }
+    }
+    template void toRows(float* out_, const TobiiTypes::gazeData* samples_, size_t n_);
+    template void toRows(double* out_, const TobiiTypes::gazeData* samples_, size_t n_);
+
+    void interleave(double* out_, const float* const* columns_, const size_t nColumns_, const size_t n_)
+    {
+        size_t i = 0;
+#if defined(TITTA_CONVERT_SSE2)
+        if (nColumns_ == 1)
+        {
+            for (; i + 4 <= n_; i += 4)
+            {
+                const __m128 v = _mm_loadu_ps(columns_[0] + i);
+                _mm_storeu_pd(out_ + i    , _mm_cvtps_pd(v));
+                _mm_storeu_pd(out_ + i + 2, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+            }
+        }
+        else if (nColumns_ == 2)
+        {
+            // convert 4 samples of both columns, then interleave them pairwise
+            for (; i + 4 <= n_; i += 4)
+            {
+                const __m128 x = _mm_loadu_ps(columns_[0] + i), y = _mm_loadu_ps(columns_[1] + i);
+                const __m128d xl = _mm_cvtps_pd(x), xh = _mm_cvtps_pd(_mm_movehl_ps(x, x));
+                const __m128d yl = _mm_cvtps_pd(y), yh = _mm_cvtps_pd(_mm_movehl_ps(y, y));
+                _mm_storeu_pd(out_ + 2*i    , _mm_unpacklo_pd(xl, yl));
+                _mm_storeu_pd(out_ + 2*i + 2, _mm_unpackhi_pd(xl, yl));
+                _mm_storeu_pd(out_ + 2*i + 4, _mm_unpacklo_pd(xh, yh));
+                _mm_storeu_pd(out_ + 2*i + 6, _mm_unpackhi_pd(xh, yh));
+            }
+        }
+        else if (nColumns_ == 3)
+        {
+            // convert 2 samples of each column, store as 3 pairs: (x0,y0), (z0,x1), (y1,z1)
+            for (; i + 2 <= n_; i += 2)
+            {
+                const __m128d x = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(columns_[0] + i))));
+                const __m128d y = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(columns_[1] + i))));
+                const __m128d z = _mm_cvtps_pd(_mm_castsi128_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(columns_[2] + i))));
+                _mm_storeu_pd(out_ + 3*i    , _mm_unpacklo_pd(x, y));
+                _mm_storeu_pd(out_ + 3*i + 2, _mm_shuffle_pd(z, x, 0b10));
+                _mm_storeu_pd(out_ + 3*i + 4, _mm_unpackhi_pd(y, z));
+            }
+        }
+#endif
+        for (; i < n_; i++)
+            for (size_t c = 0; c < nColumns_; c++)
+                out_[i*nColumns_ + c] = static_cast<double>(columns_[c][i]);
+    }
+}
@@ -0,0 +1,321 @@
+#include "Titta/journal.h"
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <type_traits>
+
+#include "Titta/utils.h"
+
+namespace
+{
+    constexpr std::array<char, 8>   fileMagic   = {'T','i','t','t','a','J','n','l'};
+    constexpr uint32_t              fileVersion = 1;
+    constexpr uint32_t              chunkMagic  = 0x4B4E4843;   // "CHNK"
+
+    // sizes of the samples that are stored as their in-memory representation. Stored in the file header so
+    // that a file written by a build with a different layout is rejected instead of misread
+    constexpr std::array<uint32_t, 4> rawSampleSizes =
+    {
+        static_cast<uint32_t>(sizeof(TobiiTypes::gazeData)),
+        static_cast<uint32_t>(sizeof(TobiiResearchExternalSignalData)),
+        static_cast<uint32_t>(sizeof(TobiiResearchTimeSynchronizationData)),
+        static_cast<uint32_t>(sizeof(TobiiResearchUserPositionGuide))
+    };
+    constexpr size_t fileHeaderSize  = sizeof(fileMagic) + sizeof(fileVersion) + sizeof(rawSampleSizes);
+    constexpr size_t chunkHeaderSize = sizeof(uint32_t) + sizeof(uint8_t) + 2*sizeof(uint32_t) + sizeof(uint64_t);  // magic, stream, nSamples, payload crc, payload size
+
+    // CRC-32 (IEEE 802.3)
+    constexpr auto crcTable = []()
+    {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = c & 1 ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    uint32_t crc32(const uint8_t* data_, const size_t nBytes_)
+    {
+        uint32_t c = 0xFFFFFFFFu;
+        for (size_t i = 0; i < nBytes_; i++)
+            c = crcTable[(c ^ data_[i]) & 0xFF] ^ (c >> 8);
+        return c ^ 0xFFFFFFFFu;
+    }
+
+    template <typename V>
+    void put(std::vector<uint8_t>& out_, const V& val_)
+    {
+        static_assert(std::is_trivially_copyable_v<V>);
+        const auto* p = reinterpret_cast<const uint8_t*>(&val_);
+        out_.insert(out_.end(), p, p + sizeof(V));
+    }
+    // reads value and advances p_, returns false if not enough data left
+    template <typename V>
+    bool get(const uint8_t*& p_, const uint8_t* end_, V& val_)
+    {
+        static_assert(std::is_trivially_copyable_v<V>);
+        if (static_cast<size_t>(end_ - p_) < sizeof(V))
+            return false;
+        std::memcpy(static_cast<void*>(&val_), p_, sizeof(V));
+        p_ += sizeof(V);
+        return true;
+    }
+
+    template <typename T>
+    bool readChunk(const uint8_t*& p_, const uint8_t* end_, const uint32_t nSamples_, std::vector<T>& out_)
+    {
+        const auto offset = out_.size();
+        out_.resize(offset + nSamples_);
+        for (uint32_t i = 0; i < nSamples_; i++)
+        {
+            if (!TittaJournal::deserialize(p_, end_, out_[offset+i]))
+            {
+                out_.resize(offset);
+                return false;
+            }
+        }
+        return p_ == end_;
+    }
+}
+
+namespace TittaJournal
+{
+    void serialize(std::vector<uint8_t>& out_, const TobiiTypes::gazeData& sample_)
+    {
+        put(out_, sample_);
+    }
+    void serialize(std::vector<uint8_t>& out_, const TobiiTypes::eyeImage& sample_)
+    {
+        put(out_, static_cast<uint8_t>(sample_.is_gif));
+        put(out_, sample_.device_time_stamp);
+        put(out_, sample_.system_time_stamp);
+        put(out_, sample_.bits_per_pixel);
+        put(out_, sample_.padding_per_pixel);
+        put(out_, sample_.width);
+        put(out_, sample_.height);
+        put(out_, sample_.region_id);
+        put(out_, sample_.region_top);
+        put(out_, sample_.region_left);
+        put(out_, static_cast<int32_t>(sample_.type));
+        put(out_, sample_.camera_id);
+        put(out_, static_cast<uint64_t>(sample_.data_size));
+        const auto* p = static_cast<const uint8_t*>(sample_.data());
+        out_.insert(out_.end(), p, p + sample_.data_size);
+    }
+    void serialize(std::vector<uint8_t>& out_, const TobiiResearchExternalSignalData& sample_)
+    {
+        put(out_, sample_);
+    }
+    void serialize(std::vector<uint8_t>& out_, const TobiiResearchTimeSynchronizationData& sample_)
+    {
+        put(out_, sample_);
+    }
+    void serialize(std::vector<uint8_t>& out_, const TobiiResearchUserPositionGuide& sample_)
+    {
+        put(out_, sample_);
+    }
+    void serialize(std::vector<uint8_t>& out_, const TobiiTypes::notification& sample_)
+    {
+        put(out_, sample_.system_time_stamp);
+        put(out_, static_cast<int32_t>(sample_.notification_type));
+        const uint8_t has = (sample_.output_frequency ? 1 : 0) | (sample_.display_area ? 2 : 0) | (sample_.errors_or_warnings ? 4 : 0);
+        put(out_, has);
+        if (sample_.output_frequency)
+            put(out_, *sample_.output_frequency);
+        if (sample_.display_area)
+            put(out_, *sample_.display_area);
+        if (sample_.errors_or_warnings)
+        {
+            put(out_, static_cast<uint32_t>(sample_.errors_or_warnings->size()));
+            out_.insert(out_.end(), sample_.errors_or_warnings->begin(), sample_.errors_or_warnings->end());
+        }
+    }
+
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiTypes::gazeData& sample_)
+    {
+        return get(p_, end_, sample_);
+    }
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiTypes::eyeImage& sample_)
+    {
+        uint8_t isGif;
+        int32_t type;
+        uint64_t dataSize;
+        if (!get(p_, end_, isGif) || !get(p_, end_, sample_.device_time_stamp) || !get(p_, end_, sample_.system_time_stamp) ||
+            !get(p_, end_, sample_.bits_per_pixel) || !get(p_, end_, sample_.padding_per_pixel) || !get(p_, end_, sample_.width) || !get(p_, end_, sample_.height) ||
+            !get(p_, end_, sample_.region_id) || !get(p_, end_, sample_.region_top) || !get(p_, end_, sample_.region_left) ||
+            !get(p_, end_, type) || !get(p_, end_, sample_.camera_id) || !get(p_, end_, dataSize))
+            return false;
+        if (static_cast<uint64_t>(end_ - p_) < dataSize)
+            return false;
+        sample_.is_gif = !!isGif;
+        sample_.type   = static_cast<TobiiResearchEyeImageType>(type);
+        sample_.setData(p_, static_cast<size_t>(dataSize));
+        p_ += dataSize;
+        return true;
+    }
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiResearchExternalSignalData& sample_)
+    {
+        return get(p_, end_, sample_);
+    }
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiResearchTimeSynchronizationData& sample_)
+    {
+        return get(p_, end_, sample_);
+    }
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiResearchUserPositionGuide& sample_)
+    {
+        return get(p_, end_, sample_);
+    }
+    bool deserialize(const uint8_t*& p_, const uint8_t* end_, TobiiTypes::notification& sample_)
+    {
+        int32_t type;
+        uint8_t has;
+        if (!get(p_, end_, sample_.system_time_stamp) || !get(p_, end_, type) || !get(p_, end_, has))
+            return false;
+        sample_.notification_type = static_cast<TobiiResearchNotificationType>(type);
+        if (has & 1)
+        {
+            float freq;
+            if (!get(p_, end_, freq))
+                return false;
+            sample_.output_frequency = freq;
+        }
+        if (has & 2)
+        {
+            TobiiResearchDisplayArea da;
+            if (!get(p_, end_, da))
+                return false;
+            sample_.display_area = da;
+        }
+        if (has & 4)
+        {
+            uint32_t len;
+            if (!get(p_, end_, len) || static_cast<size_t>(end_ - p_) < len)
+                return false;
+            sample_.errors_or_warnings = std::string(reinterpret_cast<const char*>(p_), len);
+            p_ += len;
+        }
+        return true;
+    }
+
+
+    writer::writer(const std::string& filePath_) :
+        _filePath(filePath_)
+    {
+#ifdef _WIN32
+        if (fopen_s(&_file, filePath_.c_str(), "wb"))
+            _file = nullptr;
+#else
+        _file = std::fopen(filePath_.c_str(), "wb");
+#endif
+        if (!_file)
+            DoExitWithMsg("Titta::cpp::journal: cannot open file \"" + filePath_ + "\" for writing");
+
+        std::vector<uint8_t> header;
+        header.insert(header.end(), fileMagic.begin(), fileMagic.end());
+        put(header, fileVersion);
+        put(header, rawSampleSizes);
+        if (!write(header.data(), header.size()) || std::fflush(_file))
+            DoExitWithMsg("Titta::cpp::journal: error writing to file \"" + filePath_ + "\"");
+    }
+    writer::~writer()
+    {
+        if (_file)
+            std::fclose(_file);
+    }
+
+    bool writer::writeChunk(const StreamId stream_, const uint32_t nSamples_, const std::vector<uint8_t>& payload_)
+    {
+        std::vector<uint8_t> header;
+        header.reserve(chunkHeaderSize);
+        put(header, chunkMagic);
+        put(header, static_cast<uint8_t>(stream_));
+        put(header, nSamples_);
+        put(header, crc32(payload_.data(), payload_.size()));
+        put(header, static_cast<uint64_t>(payload_.size()));
+        // hand chunk to the OS, so it survives a crash of this process
+        return write(header.data(), header.size()) && write(payload_.data(), payload_.size()) && !std::fflush(_file);
+    }
+
+    bool writer::write(const void* data_, const size_t nBytes_)
+    {
+        if (std::fwrite(data_, 1, nBytes_, _file) != nBytes_)
+            return false;
+        _nBytes += nBytes_;
+        return true;
+    }
+
+
+    contents read(const std::string& filePath_)
+    {
+        std::ifstream file(filePath_, std::ios::binary);
+        if (!file)
+            DoExitWithMsg("Titta::cpp::readJournal: cannot open file \"" + filePath_ + "\"");
+        const std::vector<uint8_t> data{std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+
+        // check header
+        const uint8_t* p   = data.data();
+        const uint8_t* end = data.data() + data.size();
+        std::array<char, 8> magic;
+        uint32_t version;
+        std::array<uint32_t, 4> sizes;
+        if (!get(p, end, magic) || magic != fileMagic)
+            DoExitWithMsg("Titta::cpp::readJournal: file \"" + filePath_ + "\" is not a Titta journal file");
+        if (!get(p, end, version) || version != fileVersion)
+            DoExitWithMsg("Titta::cpp::readJournal: file \"" + filePath_ + "\" has an unsupported version");
+        if (!get(p, end, sizes) || sizes != rawSampleSizes)
+            DoExitWithMsg("Titta::cpp::readJournal: file \"" + filePath_ + "\" was written with an incompatible data layout");
+
+        // read chunks until end of file, or until encountering an incomplete or damaged chunk
+        contents out;
+        while (p != end)
+        {
+            uint32_t magicChunk, nSamples, crc;
+            uint8_t stream;
+            uint64_t nBytes;
+            if (!get(p, end, magicChunk) || magicChunk != chunkMagic ||
+                !get(p, end, stream) || !get(p, end, nSamples) || !get(p, end, crc) || !get(p, end, nBytes) ||
+                static_cast<uint64_t>(end - p) < nBytes || crc32(p, static_cast<size_t>(nBytes)) != crc)
+            {
+                out.complete = false;
+                break;
+            }
+
+            const uint8_t* pc   = p;
+            const uint8_t* endc = p + nBytes;
+            bool ok = false;
+            switch (static_cast<StreamId>(stream))
+            {
+                case StreamId::Gaze:
+                    ok = readChunk(pc, endc, nSamples, out.gaze);
+                    break;
+                case StreamId::EyeImage:
+                    ok = readChunk(pc, endc, nSamples, out.eyeImage);
+                    break;
+                case StreamId::ExtSignal:
+                    ok = readChunk(pc, endc, nSamples, out.extSignal);
+                    break;
+                case StreamId::TimeSync:
+                    ok = readChunk(pc, endc, nSamples, out.timeSync);
+                    break;
+                case StreamId::Positioning:
+                    ok = readChunk(pc, endc, nSamples, out.positioning);
+                    break;
+                case StreamId::Notification:
+                    ok = readChunk(pc, endc, nSamples, out.notification);
+                    break;
+            }
+            if (!ok)
+            {
+                out.complete = false;
+                break;
+            }
+            p = endc;
+            out.nChunks++;
+        }
+        return out;
+    }
+}
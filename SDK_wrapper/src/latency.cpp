@@ -0,0 +1,57 @@
+#include "Titta/latency.h"
+#include <algorithm>
+#include <cmath>
+
+namespace TittaLatency
+{
+    double histogram::bucketValue(const size_t index_)
+    {
+        if (index_ < exactLimit)
+            return static_cast<double>(index_);
+        const auto offset       = index_ - exactLimit;
+        const auto magnitude    = static_cast<unsigned>(offset / numSubBuckets) + subBucketBits + 1;
+        const auto shift        = magnitude - subBucketBits;
+        const auto low          = static_cast<double>((numSubBuckets + offset % numSubBuckets) << shift);
+        const auto width        = static_cast<double>(uint64_t{1} << shift);
+        return low + (width - 1.) / 2.;
+    }
+
+    stats histogram::getStats() const
+    {
+        // take a snapshot. Recording may continue meanwhile, so use the total of the snapshot of the bins
+        // for the percentiles
+        std::array<uint64_t, numBuckets> counts;
+        uint64_t total = 0;
+        for (size_t i = 0; i < numBuckets; i++)
+        {
+            counts[i] = _counts[i].load(std::memory_order_relaxed);
+            total    += counts[i];
+        }
+
+        stats out;
+        out.count = _count.load(std::memory_order_relaxed);
+        if (!out.count || !total)
+            return out;
+        out.min  = static_cast<double>(_min.load(std::memory_order_relaxed));
+        out.max  = static_cast<double>(_max.load(std::memory_order_relaxed));
+        out.mean = static_cast<double>(_sum.load(std::memory_order_relaxed)) / static_cast<double>(out.count);
+
+        const auto percentile = [&](const double q_)
+        {
+            const auto rank = std::max(uint64_t{1}, static_cast<uint64_t>(std::ceil(q_ * static_cast<double>(total))));
+            uint64_t cumulative = 0;
+            for (size_t i = 0; i < numBuckets; i++)
+            {
+                cumulative += counts[i];
+                if (cumulative >= rank)
+                    return std::clamp(bucketValue(i), out.min, out.max);
+            }
+            return out.max;
+        };
+        out.p50  = percentile(.5);
+        out.p90  = percentile(.9);
+        out.p99  = percentile(.99);
+        out.p999 = percentile(.999);
+        return out;
+    }
+}
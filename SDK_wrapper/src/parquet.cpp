@@ -0,0 +1,614 @@
+#include "Titta/parquet.h"
+#include <array>
+#include <cstring>
+#include <limits>
+#include <optional>
+
+#include "Titta/utils.h"
+
+// File layout (see https://parquet.apache.org/docs/file-format/):
+// "PAR1", then for each row group for each column a single data page (page header followed by the PLAIN
+// encoded values), then the file metadata, its length (uint32) and "PAR1". Page headers and file metadata
+// are encoded with the Thrift compact protocol.
+namespace
+{
+    constexpr std::array<char, 4> fileMagic = {'P','A','R','1'};
+
+    // parquet.thrift enum values
+    namespace thrift
+    {
+        // Type
+        constexpr int32_t BOOLEAN           = 0;
+        constexpr int32_t INT32             = 1;
+        constexpr int32_t INT64             = 2;
+        constexpr int32_t DOUBLE            = 5;
+        constexpr int32_t BYTE_ARRAY        = 6;
+        // ConvertedType
+        constexpr int32_t UTF8              = 0;
+        constexpr int32_t UINT_8            = 11;
+        constexpr int32_t UINT_32           = 13;
+        // FieldRepetitionType
+        constexpr int32_t REQUIRED          = 0;
+        // Encoding
+        constexpr int32_t PLAIN             = 0;
+        constexpr int32_t RLE               = 3;
+        // CompressionCodec
+        constexpr int32_t UNCOMPRESSED      = 0;
+        // PageType
+        constexpr int32_t DATA_PAGE         = 0;
+    }
+
+    // minimal Thrift compact protocol encoder, supports the field types used in parquet.thrift
+    class compactWriter
+    {
+    public:
+        enum : uint8_t
+        {
+            I32     = 5,
+            I64     = 6,
+            BINARY  = 8,
+            LIST    = 9,
+            STRUCT  = 12
+        };
+
+        void i32(const int16_t id_, const int32_t value_)
+        {
+            fieldHeader(id_, I32);
+            varint((static_cast<uint32_t>(value_) << 1) ^ static_cast<uint32_t>(value_ >> 31));
+        }
+        void i64(const int16_t id_, const int64_t value_)
+        {
+            fieldHeader(id_, I64);
+            varint((static_cast<uint64_t>(value_) << 1) ^ static_cast<uint64_t>(value_ >> 63));
+        }
+        void string(const int16_t id_, const std::string_view value_)
+        {
+            fieldHeader(id_, BINARY);
+            string(value_);
+        }
+        void beginStruct(const int16_t id_)
+        {
+            fieldHeader(id_, STRUCT);
+            beginStruct();
+        }
+        void beginList(const int16_t id_, const uint8_t elementType_, const size_t size_)
+        {
+            fieldHeader(id_, LIST);
+            if (size_ < 15)
+                _out.push_back(static_cast<uint8_t>(size_ << 4 | elementType_));
+            else
+            {
+                _out.push_back(0xF0 | elementType_);
+                varint(size_);
+            }
+        }
+        // list elements
+        void i32(const int32_t value_)
+        {
+            varint((static_cast<uint32_t>(value_) << 1) ^ static_cast<uint32_t>(value_ >> 31));
+        }
+        void string(const std::string_view value_)
+        {
+            varint(value_.size());
+            _out.insert(_out.end(), value_.begin(), value_.end());
+        }
+        void beginStruct()
+        {
+            _lastIds.push_back(_lastId);
+            _lastId = 0;
+        }
+        void endStruct()
+        {
+            _out.push_back(0);      // stop field
+            _lastId = _lastIds.back();
+            _lastIds.pop_back();
+        }
+
+        const std::vector<uint8_t>& get() const { return _out; }
+
+    private:
+        void fieldHeader(const int16_t id_, const uint8_t type_)
+        {
+            if (id_ > _lastId && id_ - _lastId <= 15)
+                _out.push_back(static_cast<uint8_t>((id_ - _lastId) << 4 | type_));
+            else
+            {
+                _out.push_back(type_);
+                varint((static_cast<uint32_t>(id_) << 1) ^ static_cast<uint32_t>(id_ >> 15));
+            }
+            _lastId = id_;
+        }
+        void varint(uint64_t value_)
+        {
+            while (value_ >= 0x80)
+            {
+                _out.push_back(static_cast<uint8_t>(value_ | 0x80));
+                value_ >>= 7;
+            }
+            _out.push_back(static_cast<uint8_t>(value_));
+        }
+
+    private:
+        std::vector<uint8_t>    _out;
+        int16_t                 _lastId = 0;
+        std::vector<int16_t>    _lastIds;
+    };
+
+    int32_t physicalType(const TittaParquet::ColumnType type_)
+    {
+        switch (type_)
+        {
+            case TittaParquet::ColumnType::Boolean:
+                return thrift::BOOLEAN;
+            case TittaParquet::ColumnType::UInt8:
+            case TittaParquet::ColumnType::UInt32:
+                return thrift::INT32;
+            case TittaParquet::ColumnType::Int64:
+                return thrift::INT64;
+            case TittaParquet::ColumnType::Double:
+                return thrift::DOUBLE;
+            case TittaParquet::ColumnType::String:
+            case TittaParquet::ColumnType::Binary:
+                return thrift::BYTE_ARRAY;
+        }
+        return thrift::BYTE_ARRAY;
+    }
+    std::optional<int32_t> convertedType(const TittaParquet::ColumnType type_)
+    {
+        switch (type_)
+        {
+            case TittaParquet::ColumnType::UInt8:
+                return thrift::UINT_8;
+            case TittaParquet::ColumnType::UInt32:
+                return thrift::UINT_32;
+            case TittaParquet::ColumnType::String:
+                return thrift::UTF8;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    void addPointColumns(std::vector<TittaParquet::column>& out_, const std::string& name_, const size_t nDim_)
+    {
+        constexpr std::array<char, 3> dims = {'x','y','z'};
+        for (size_t d = 0; d < nDim_; d++)
+            out_.push_back({name_ + '_' + dims[d], TittaParquet::ColumnType::Double});
+    }
+    void addEyeColumns(std::vector<TittaParquet::column>& out_, const std::string& eye_)
+    {
+        using TittaParquet::ColumnType;
+        addPointColumns(out_, eye_ + "_gaze_point_on_display_area", 2);
+        addPointColumns(out_, eye_ + "_gaze_point_in_user_coords", 3);
+        out_.push_back({eye_ + "_gaze_point_valid",             ColumnType::Boolean});
+        out_.push_back({eye_ + "_gaze_point_available",         ColumnType::Boolean});
+        out_.push_back({eye_ + "_pupil_diameter",               ColumnType::Double});
+        out_.push_back({eye_ + "_pupil_valid",                  ColumnType::Boolean});
+        out_.push_back({eye_ + "_pupil_available",              ColumnType::Boolean});
+        addPointColumns(out_, eye_ + "_gaze_origin_in_user_coords", 3);
+        addPointColumns(out_, eye_ + "_gaze_origin_in_track_box_coords", 3);
+        out_.push_back({eye_ + "_gaze_origin_valid",            ColumnType::Boolean});
+        out_.push_back({eye_ + "_gaze_origin_available",        ColumnType::Boolean});
+        out_.push_back({eye_ + "_eye_openness_diameter",        ColumnType::Double});
+        out_.push_back({eye_ + "_eye_openness_valid",           ColumnType::Boolean});
+        out_.push_back({eye_ + "_eye_openness_available",       ColumnType::Boolean});
+    }
+    std::vector<TittaParquet::column> makeColumns(const TittaParquet::StreamId stream_)
+    {
+        using TittaParquet::ColumnType;
+        using TittaParquet::StreamId;
+        std::vector<TittaParquet::column> out;
+        switch (stream_)
+        {
+            case StreamId::Gaze:
+                out.push_back({"device_time_stamp",             ColumnType::Int64});
+                out.push_back({"system_time_stamp",             ColumnType::Int64});
+                addEyeColumns(out, "left");
+                addEyeColumns(out, "right");
+                break;
+            case StreamId::EyeImage:
+                // NB: region_i_d and camera_i_d are what Titta.saveDataToParquet makes of regionID and cameraID
+                out.push_back({"device_time_stamp",             ColumnType::Int64});
+                out.push_back({"system_time_stamp",             ColumnType::Int64});
+                out.push_back({"region_i_d",                    ColumnType::Double});
+                out.push_back({"region_top",                    ColumnType::Double});
+                out.push_back({"region_left",                   ColumnType::Double});
+                out.push_back({"bits_per_pixel",                ColumnType::Double});
+                out.push_back({"padding_per_pixel",             ColumnType::Double});
+                out.push_back({"width",                         ColumnType::Double});
+                out.push_back({"height",                        ColumnType::Double});
+                out.push_back({"type",                          ColumnType::String});
+                out.push_back({"camera_i_d",                    ColumnType::Double});
+                out.push_back({"is_gif",                        ColumnType::Boolean});
+                out.push_back({"image",                         ColumnType::Binary});
+                break;
+            case StreamId::ExtSignal:
+                out.push_back({"device_time_stamp",             ColumnType::Int64});
+                out.push_back({"system_time_stamp",             ColumnType::Int64});
+                out.push_back({"value",                         ColumnType::UInt32});
+                out.push_back({"change_type",                   ColumnType::UInt8});
+                break;
+            case StreamId::TimeSync:
+                out.push_back({"system_request_time_stamp",     ColumnType::Int64});
+                out.push_back({"device_time_stamp",             ColumnType::Int64});
+                out.push_back({"system_response_time_stamp",    ColumnType::Int64});
+                break;
+            case StreamId::Notification:
+                // the value field depends on the type of notification, each possible value gets its own columns
+                out.push_back({"system_time_stamp",             ColumnType::Int64});
+                out.push_back({"notification",                  ColumnType::String});
+                out.push_back({"explanation",                   ColumnType::String});
+                out.push_back({"value_output_frequency",        ColumnType::Double});
+                out.push_back({"value_display_area_height",     ColumnType::Double});
+                out.push_back({"value_display_area_width",      ColumnType::Double});
+                addPointColumns(out, "value_display_area_bottom_left", 3);
+                addPointColumns(out, "value_display_area_bottom_right", 3);
+                addPointColumns(out, "value_display_area_top_left", 3);
+                addPointColumns(out, "value_display_area_top_right", 3);
+                out.push_back({"value_errors_or_warnings",      ColumnType::String});
+                break;
+            default:
+                DoExitWithMsg("Titta::cpp::parquet: stream cannot be exported to parquet");
+        }
+        return out;
+    }
+
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    // PLAIN encoding of fixed size values: little endian
+    template <typename V>
+    void appendRaw(std::vector<uint8_t>& out_, const V& value_)
+    {
+        const auto p = reinterpret_cast<const uint8_t*>(&value_);
+        out_.insert(out_.end(), p, p + sizeof(V));
+    }
+}
+
+namespace TittaParquet
+{
+    const std::vector<column>& getColumns(const StreamId stream_)
+    {
+        static const std::vector<column> gaze           = makeColumns(StreamId::Gaze);
+        static const std::vector<column> eyeImage       = makeColumns(StreamId::EyeImage);
+        static const std::vector<column> extSignal      = makeColumns(StreamId::ExtSignal);
+        static const std::vector<column> timeSync       = makeColumns(StreamId::TimeSync);
+        static const std::vector<column> notification   = makeColumns(StreamId::Notification);
+        switch (stream_)
+        {
+            case StreamId::Gaze:
+                return gaze;
+            case StreamId::EyeImage:
+                return eyeImage;
+            case StreamId::ExtSignal:
+                return extSignal;
+            case StreamId::TimeSync:
+                return timeSync;
+            case StreamId::Notification:
+                return notification;
+            default:
+                DoExitWithMsg("Titta::cpp::parquet: stream cannot be exported to parquet");
+        }
+    }
+    std::string getFilePath(const std::string& filePathBase_, const StreamId stream_)
+    {
+        // same names as the fields of the data returned by Titta.ConsumeAllData
+        switch (stream_)
+        {
+            case StreamId::Gaze:
+                return filePathBase_ + "_gaze.parq";
+            case StreamId::EyeImage:
+                return filePathBase_ + "_eyeImages.parq";
+            case StreamId::ExtSignal:
+                return filePathBase_ + "_externalSignals.parq";
+            case StreamId::TimeSync:
+                return filePathBase_ + "_timeSync.parq";
+            case StreamId::Notification:
+                return filePathBase_ + "_notifications.parq";
+            default:
+                DoExitWithMsg("Titta::cpp::parquet: stream cannot be exported to parquet");
+        }
+    }
+
+
+    rowGroup::rowGroup(const StreamId stream_) :
+        _stream(stream_),
+        _columns(getColumns(stream_).size())
+    {}
+
+    void rowGroup::add(const TobiiTypes::gazeData& sample_)
+    {
+        beginRow(StreamId::Gaze);
+        put(sample_.device_time_stamp);
+        put(sample_.system_time_stamp);
+        put(sample_.left_eye);
+        put(sample_.right_eye);
+        endRow();
+    }
+    void rowGroup::add(const TobiiTypes::eyeImage& sample_)
+    {
+        beginRow(StreamId::EyeImage);
+        put(sample_.device_time_stamp);
+        put(sample_.system_time_stamp);
+        put(static_cast<double>(sample_.region_id));
+        put(static_cast<double>(sample_.region_top));
+        put(static_cast<double>(sample_.region_left));
+        put(static_cast<double>(sample_.bits_per_pixel));
+        put(static_cast<double>(sample_.padding_per_pixel));
+        put(static_cast<double>(sample_.width));
+        put(static_cast<double>(sample_.height));
+        put(std::string_view(TobiiResearchEyeImageToString(sample_.type)));
+        put(static_cast<double>(sample_.camera_id));
+        put(sample_.is_gif);
+        put(sample_.data(), sample_.data_size);
+        endRow();
+    }
+    void rowGroup::add(const TobiiResearchExternalSignalData& sample_)
+    {
+        beginRow(StreamId::ExtSignal);
+        put(sample_.device_time_stamp);
+        put(sample_.system_time_stamp);
+        put(sample_.value);
+        put(static_cast<uint8_t>(sample_.change_type));
+        endRow();
+    }
+    void rowGroup::add(const TobiiResearchTimeSynchronizationData& sample_)
+    {
+        beginRow(StreamId::TimeSync);
+        put(sample_.system_request_time_stamp);
+        put(sample_.device_time_stamp);
+        put(sample_.system_response_time_stamp);
+        endRow();
+    }
+    void rowGroup::add(const TobiiTypes::notification& sample_)
+    {
+        beginRow(StreamId::Notification);
+        put(sample_.system_time_stamp);
+        put(std::string_view(TobiiResearchNotificationToString(sample_.notification_type)));
+        put(std::string_view(TobiiResearchNotificationToExplanation(sample_.notification_type)));
+        put(sample_.output_frequency ? static_cast<double>(*sample_.output_frequency) : NaN);
+        if (sample_.display_area)
+        {
+            put(static_cast<double>(sample_.display_area->height));
+            put(static_cast<double>(sample_.display_area->width));
+            put(sample_.display_area->bottom_left);
+            put(sample_.display_area->bottom_right);
+            put(sample_.display_area->top_left);
+            put(sample_.display_area->top_right);
+        }
+        else
+            for (int i = 0; i < 14; i++)
+                put(NaN);
+        put(std::string_view(sample_.errors_or_warnings ? *sample_.errors_or_warnings : std::string()));
+        endRow();
+    }
+
+    void rowGroup::clear()
+    {
+        for (auto& c: _columns)
+            c.clear();
+        _nRows  = 0;
+        _nBytes = 0;
+    }
+
+    void rowGroup::beginRow(const StreamId stream_)
+    {
+        if (stream_ != _stream)
+            DoExitWithMsg("Titta::cpp::parquet: sample does not belong to the stream of this row group");
+        _column = 0;
+    }
+    void rowGroup::endRow()
+    {
+        ++_nRows;
+    }
+
+    void rowGroup::put(const bool value_)
+    {
+        // PLAIN encoding of booleans: bit packed, least significant bit first
+        auto& c = _columns[_column++];
+        const auto bit = _nRows % 8;
+        if (bit == 0)
+        {
+            c.push_back(0);
+            ++_nBytes;
+        }
+        if (value_)
+            c.back() |= static_cast<uint8_t>(1 << bit);
+    }
+    void rowGroup::put(const uint8_t value_)
+    {
+        put(static_cast<uint32_t>(value_));     // stored as INT32
+    }
+    void rowGroup::put(const uint32_t value_)
+    {
+        appendRaw(_columns[_column++], value_);
+        _nBytes += sizeof(value_);
+    }
+    void rowGroup::put(const int64_t value_)
+    {
+        appendRaw(_columns[_column++], value_);
+        _nBytes += sizeof(value_);
+    }
+    void rowGroup::put(const double value_)
+    {
+        appendRaw(_columns[_column++], value_);
+        _nBytes += sizeof(value_);
+    }
+    void rowGroup::put(const std::string_view value_)
+    {
+        put(value_.data(), value_.size());
+    }
+    void rowGroup::put(const void* data_, const size_t nBytes_)
+    {
+        // PLAIN encoding of byte arrays: length (uint32) followed by the bytes
+        auto& c = _columns[_column++];
+        appendRaw(c, static_cast<uint32_t>(nBytes_));
+        if (nBytes_)
+            c.insert(c.end(), static_cast<const uint8_t*>(data_), static_cast<const uint8_t*>(data_) + nBytes_);
+        _nBytes += sizeof(uint32_t) + nBytes_;
+    }
+    void rowGroup::put(const TobiiResearchNormalizedPoint2D& value_)
+    {
+        put(static_cast<double>(value_.x));
+        put(static_cast<double>(value_.y));
+    }
+    void rowGroup::put(const TobiiResearchPoint3D& value_)     // NB: same type as TobiiResearchNormalizedPoint3D
+    {
+        put(static_cast<double>(value_.x));
+        put(static_cast<double>(value_.y));
+        put(static_cast<double>(value_.z));
+    }
+    void rowGroup::put(const TobiiTypes::eyeData& value_)
+    {
+        // same order as addEyeColumns()
+        put(value_.gaze_point.position_on_display_area);
+        put(value_.gaze_point.position_in_user_coordinates);
+        put(value_.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        put(value_.gaze_point.available);
+        put(static_cast<double>(value_.pupil.diameter));
+        put(value_.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        put(value_.pupil.available);
+        put(value_.gaze_origin.position_in_user_coordinates);
+        put(value_.gaze_origin.position_in_track_box_coordinates);
+        put(value_.gaze_origin.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        put(value_.gaze_origin.available);
+        put(static_cast<double>(value_.eye_openness.diameter));
+        put(value_.eye_openness.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        put(value_.eye_openness.available);
+    }
+
+
+    writer::writer(const std::string& filePath_, const StreamId stream_) :
+        _filePath(filePath_),
+        _stream(stream_)
+    {
+        getColumns(stream_);    // check stream can be exported
+#ifdef _WIN32
+        if (fopen_s(&_file, filePath_.c_str(), "wb"))
+            _file = nullptr;
+#else
+        _file = std::fopen(filePath_.c_str(), "wb");
+#endif
+        if (!_file)
+            DoExitWithMsg("Titta::cpp::parquet: cannot open file \"" + filePath_ + "\" for writing");
+
+        write(fileMagic.data(), sizeof(fileMagic));
+    }
+    writer::~writer()
+    {
+        if (_file)
+            std::fclose(_file);
+    }
+
+    void writer::writeRowGroup(const rowGroup& rows_)
+    {
+        if (!_file)
+            DoExitWithMsg("Titta::cpp::parquet: file \"" + _filePath + "\" already finished");
+        if (rows_.getStream() != _stream)
+            DoExitWithMsg("Titta::cpp::parquet: row group does not belong to the stream of file \"" + _filePath + "\"");
+        if (!rows_.getNumRows())
+            return;
+
+        rowGroupInfo info{{}, rows_.getNumRows(), 0};
+        for (size_t c = 0; c < getColumns(_stream).size(); c++)
+        {
+            const auto& data = rows_.getColumnData(c);
+            if (data.size() > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+                DoExitWithMsg("Titta::cpp::parquet: column chunk too large, use a smaller row group size");
+            const auto nBytes = static_cast<int32_t>(data.size());
+
+            compactWriter h;
+            h.beginStruct();
+            h.i32(1, thrift::DATA_PAGE);                            // type
+            h.i32(2, nBytes);                                       // uncompressed_page_size
+            h.i32(3, nBytes);                                       // compressed_page_size
+            h.beginStruct(5);                                       // data_page_header
+            h.i32(1, static_cast<int32_t>(rows_.getNumRows()));     // num_values
+            h.i32(2, thrift::PLAIN);                                // encoding
+            h.i32(3, thrift::RLE);                                  // definition_level_encoding
+            h.i32(4, thrift::RLE);                                  // repetition_level_encoding
+            h.endStruct();
+            h.endStruct();
+
+            const auto offset = _nBytes;
+            write(h.get().data(), h.get().size());
+            write(data.data(), data.size());
+            info.columns.push_back({offset, _nBytes - offset});
+            info.nBytes += _nBytes - offset;
+        }
+        _rowGroups.push_back(std::move(info));
+        _nRows += rows_.getNumRows();
+    }
+
+    void writer::finish()
+    {
+        if (!_file)
+            return;
+
+        const auto& columns = getColumns(_stream);
+        compactWriter m;
+        m.beginStruct();
+        m.i32(1, 1);                                                // version
+        m.beginList(2, compactWriter::STRUCT, columns.size() + 1);  // schema
+        m.beginStruct();
+        m.string(4, "schema");                                      // name
+        m.i32(5, static_cast<int32_t>(columns.size()));             // num_children
+        m.endStruct();
+        for (const auto& c: columns)
+        {
+            m.beginStruct();
+            m.i32(1, physicalType(c.type));                         // type
+            m.i32(3, thrift::REQUIRED);                             // repetition_type
+            m.string(4, c.name);                                    // name
+            if (const auto ct = convertedType(c.type))
+                m.i32(6, *ct);                                      // converted_type
+            m.endStruct();
+        }
+        m.i64(3, static_cast<int64_t>(_nRows));                     // num_rows
+        m.beginList(4, compactWriter::STRUCT, _rowGroups.size());   // row_groups
+        for (const auto& rg: _rowGroups)
+        {
+            m.beginStruct();
+            m.beginList(1, compactWriter::STRUCT, columns.size());  // columns
+            for (size_t c = 0; c < columns.size(); c++)
+            {
+                const auto& cc = rg.columns[c];
+                m.beginStruct();
+                m.i64(2, static_cast<int64_t>(cc.offset));          // file_offset
+                m.beginStruct(3);                                   // meta_data
+                m.i32(1, physicalType(columns[c].type));            // type
+                m.beginList(2, compactWriter::I32, 1);              // encodings
+                m.i32(thrift::PLAIN);
+                m.beginList(3, compactWriter::BINARY, 1);           // path_in_schema
+                m.string(columns[c].name);
+                m.i32(4, thrift::UNCOMPRESSED);                     // codec
+                m.i64(5, static_cast<int64_t>(rg.nRows));           // num_values
+                m.i64(6, static_cast<int64_t>(cc.nBytes));          // total_uncompressed_size
+                m.i64(7, static_cast<int64_t>(cc.nBytes));          // total_compressed_size
+                m.i64(9, static_cast<int64_t>(cc.offset));          // data_page_offset
+                m.endStruct();
+                m.endStruct();
+            }
+            m.i64(2, static_cast<int64_t>(rg.nBytes));              // total_byte_size
+            m.i64(3, static_cast<int64_t>(rg.nRows));               // num_rows
+            m.endStruct();
+        }
+        m.string(6, "Titta");                                       // created_by
+        m.endStruct();
+
+        const auto metaSize = static_cast<uint32_t>(m.get().size());
+        write(m.get().data(), m.get().size());
+        write(&metaSize, sizeof(metaSize));
+        write(fileMagic.data(), sizeof(fileMagic));
+
+        const bool ok = std::fclose(_file) == 0;
+        _file = nullptr;
+        if (!ok)
+            DoExitWithMsg("Titta::cpp::parquet: error closing file \"" + _filePath + "\"");
+    }
+
+    void writer::write(const void* data_, const size_t nBytes_)
+    {
+        if (nBytes_ && std::fwrite(data_, 1, nBytes_, _file) != nBytes_)
+            DoExitWithMsg("Titta::cpp::parquet: error writing to file \"" + _filePath + "\"");
+        _nBytes += nBytes_;
+    }
+}
@@ -0,0 +1,315 @@
+#include "Titta/session.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#ifdef _WIN32
+#   define WIN32_LEAN_AND_MEAN
+#   define NOMINMAX
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+#include "Titta/utils.h"
+
+// File layout (all values little endian, chunks and index start at multiples of 8 bytes):
+// header:  magic (8 bytes), version (uint32), size of gaze, external signal and time sync samples (3x uint32)
+// chunks:  time stamps (nSamples x int64), offsets in payload (nSamples+1 x uint64), payload
+// index:   number of streams (uint32), padding (uint32), then for each stream:
+//              stream id (uint8), padding (3 bytes), number of chunks (uint32), then for each chunk:
+//                  first time stamp (int64), last time stamp (int64), offset (uint64), number of samples (uint32), padding (uint32)
+// trailer: position of index (uint64), magic (8 bytes)
+namespace
+{
+    constexpr std::array<char, 8>   fileMagic    = {'T','i','t','t','a','S','e','s'};
+    constexpr std::array<char, 8>   trailerMagic = {'T','i','t','t','a','E','n','d'};
+    constexpr uint32_t              fileVersion  = 1;
+    constexpr std::array<uint32_t, 3> rawSampleSizes =
+    {
+        static_cast<uint32_t>(sizeof(TobiiTypes::gazeData)),
+        static_cast<uint32_t>(sizeof(TobiiResearchExternalSignalData)),
+        static_cast<uint32_t>(sizeof(TobiiResearchTimeSynchronizationData))
+    };
+    constexpr size_t headerSize  = sizeof(fileMagic) + sizeof(fileVersion) + sizeof(rawSampleSizes);
+    constexpr size_t trailerSize = sizeof(uint64_t) + sizeof(trailerMagic);
+    static_assert(headerSize % 8 == 0);
+
+    template <typename V>
+    V readAt(const uint8_t* data_, const uint64_t offset_)
+    {
+        V out;
+        std::memcpy(static_cast<void*>(&out), data_ + offset_, sizeof(V));
+        return out;
+    }
+}
+
+namespace TittaSession
+{
+    writer::writer(const std::string& filePath_) :
+        _filePath(filePath_)
+    {
+#ifdef _WIN32
+        if (fopen_s(&_file, filePath_.c_str(), "wb"))
+            _file = nullptr;
+#else
+        _file = std::fopen(filePath_.c_str(), "wb");
+#endif
+        if (!_file)
+            DoExitWithMsg("Titta::cpp::session: cannot open file \"" + filePath_ + "\" for writing");
+
+        write(fileMagic.data(), sizeof(fileMagic));
+        write(&fileVersion, sizeof(fileVersion));
+        write(rawSampleSizes.data(), sizeof(rawSampleSizes));
+    }
+    writer::~writer()
+    {
+        if (_file)
+            std::fclose(_file);
+    }
+
+    void writer::beginStream(const StreamId stream_)
+    {
+        if (std::any_of(_streams.begin(), _streams.end(), [stream_](const streamInfo& s_) { return s_.stream == stream_; }))
+            DoExitWithMsg("Titta::cpp::session: stream already written to file \"" + _filePath + "\"");
+        if (!_file)
+            DoExitWithMsg("Titta::cpp::session: file \"" + _filePath + "\" already finished");
+        _streams.push_back({stream_, {}});
+    }
+
+    void writer::writeChunk()
+    {
+        const auto n = static_cast<uint32_t>(_timeStamps.size());
+        if (!n)
+            return;
+        if (_streams.empty())
+            DoExitWithMsg("Titta::cpp::session: writeChunk called before beginStream");
+        _streams.back().chunks.push_back({_timeStamps.front(), _timeStamps.back(), _nBytes, n});
+
+        write(_timeStamps.data(), n * sizeof(int64_t));
+        write(_offsets.data(), (n + 1) * sizeof(uint64_t));
+        write(_payload.data(), _payload.size());
+        // pad to multiple of 8 bytes, so the columns of the next chunk are aligned
+        constexpr std::array<uint8_t, 8> pad = {};
+        if (const auto rem = _nBytes % 8)
+            write(pad.data(), 8 - rem);
+    }
+
+    void writer::finish()
+    {
+        if (!_file)
+            return;
+
+        const uint64_t indexOffset = _nBytes;
+        const uint32_t nStreams = static_cast<uint32_t>(_streams.size());
+        const uint32_t pad = 0;
+        write(&nStreams, sizeof(nStreams));
+        write(&pad, sizeof(pad));
+        for (const auto& s: _streams)
+        {
+            const std::array<uint8_t, 4> id = {static_cast<uint8_t>(s.stream), 0, 0, 0};
+            const uint32_t nChunks = static_cast<uint32_t>(s.chunks.size());
+            write(id.data(), sizeof(id));
+            write(&nChunks, sizeof(nChunks));
+            for (const auto& c: s.chunks)
+            {
+                write(&c.firstTimeStamp, sizeof(c.firstTimeStamp));
+                write(&c.lastTimeStamp, sizeof(c.lastTimeStamp));
+                write(&c.offset, sizeof(c.offset));
+                write(&c.nSamples, sizeof(c.nSamples));
+                write(&pad, sizeof(pad));
+            }
+        }
+        write(&indexOffset, sizeof(indexOffset));
+        write(trailerMagic.data(), sizeof(trailerMagic));
+
+        const bool ok = std::fclose(_file) == 0;
+        _file = nullptr;
+        if (!ok)
+            DoExitWithMsg("Titta::cpp::session: error closing file \"" + _filePath + "\"");
+    }
+
+    void writer::write(const void* data_, const size_t nBytes_)
+    {
+        if (nBytes_ && std::fwrite(data_, 1, nBytes_, _file) != nBytes_)
+            DoExitWithMsg("Titta::cpp::session: error writing to file \"" + _filePath + "\"");
+        _nBytes += nBytes_;
+    }
+
+
+    reader::reader(const std::string& filePath_) :
+        _filePath(filePath_)
+    {
+        // map file
+#ifdef _WIN32
+        _fileHandle = CreateFileA(filePath_.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (_fileHandle == INVALID_HANDLE_VALUE)
+        {
+            _fileHandle = nullptr;
+            DoExitWithMsg("Titta::cpp::session: cannot open file \"" + filePath_ + "\"");
+        }
+        LARGE_INTEGER size;
+        GetFileSizeEx(_fileHandle, &size);
+        _size = static_cast<uint64_t>(size.QuadPart);
+        if (_size)
+        {
+            _mappingHandle = CreateFileMappingA(_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (_mappingHandle)
+                _data = static_cast<const uint8_t*>(MapViewOfFile(_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+            if (!_data)
+            {
+                unmap();
+                DoExitWithMsg("Titta::cpp::session: cannot map file \"" + filePath_ + "\"");
+            }
+        }
+#else
+        const int fd = open(filePath_.c_str(), O_RDONLY);
+        if (fd == -1)
+            DoExitWithMsg("Titta::cpp::session: cannot open file \"" + filePath_ + "\"");
+        struct stat st;
+        if (fstat(fd, &st) == 0)
+            _size = static_cast<uint64_t>(st.st_size);
+        if (_size)
+        {
+            void* p = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+                _data = static_cast<const uint8_t*>(p);
+        }
+        close(fd);  // mapping stays valid
+        if (_size && !_data)
+            DoExitWithMsg("Titta::cpp::session: cannot map file \"" + filePath_ + "\"");
+#endif
+
+        // check header and trailer
+        auto fail = [this](const std::string& msg_)
+        {
+            const auto path = _filePath;
+            unmap();
+            DoExitWithMsg("Titta::cpp::session: file \"" + path + "\" " + msg_);
+        };
+        if (_size < headerSize + trailerSize || readAt<std::array<char, 8>>(_data, 0) != fileMagic || readAt<std::array<char, 8>>(_data, _size - sizeof(trailerMagic)) != trailerMagic)
+            fail("is not a Titta session file, or it was not properly closed");
+        if (readAt<uint32_t>(_data, sizeof(fileMagic)) != fileVersion)
+            fail("has an unsupported version");
+        if (readAt<std::array<uint32_t, 3>>(_data, sizeof(fileMagic) + sizeof(fileVersion)) != rawSampleSizes)
+            fail("was written with an incompatible data layout");
+
+        // read index
+        const auto indexEnd = _size - trailerSize;
+        auto pos = readAt<uint64_t>(_data, indexEnd);
+        if (pos < headerSize || pos + 8 > indexEnd)
+            fail("has a damaged index");
+        const auto nStreams = readAt<uint32_t>(_data, pos);
+        pos += 8;
+        for (uint32_t s = 0; s < nStreams; s++)
+        {
+            if (pos + 8 > indexEnd)
+                fail("has a damaged index");
+            const auto id      = readAt<uint8_t>(_data, pos);
+            const auto nChunks = readAt<uint32_t>(_data, pos + 4);
+            pos += 8;
+            if (id >= _chunks.size() || pos + static_cast<uint64_t>(nChunks) * 32 > indexEnd)
+                fail("has a damaged index");
+
+            auto& chunks = _chunks[id].emplace();
+            chunks.reserve(nChunks);
+            for (uint32_t c = 0; c < nChunks; c++, pos += 32)
+            {
+                chunkInfo ci{readAt<int64_t>(_data, pos), readAt<int64_t>(_data, pos + 8), readAt<uint64_t>(_data, pos + 16), readAt<uint32_t>(_data, pos + 24)};
+                // columns must be within the data part of the file
+                if (ci.offset % 8 || ci.offset + (2 * static_cast<uint64_t>(ci.nSamples) + 1) * 8 > indexEnd)
+                    fail("has a damaged index");
+                chunks.push_back(ci);
+            }
+        }
+    }
+    reader::~reader()
+    {
+        unmap();
+    }
+    void reader::unmap()
+    {
+#ifdef _WIN32
+        if (_data)
+            UnmapViewOfFile(_data);
+        if (_mappingHandle)
+            CloseHandle(_mappingHandle);
+        if (_fileHandle)
+            CloseHandle(_fileHandle);
+        _mappingHandle = _fileHandle = nullptr;
+#else
+        if (_data)
+            munmap(const_cast<uint8_t*>(_data), _size);
+#endif
+        _data = nullptr;
+    }
+
+    const std::vector<chunkInfo>* reader::getChunks(const StreamId stream_) const
+    {
+        const auto idx = static_cast<size_t>(stream_);
+        if (idx >= _chunks.size() || !_chunks[idx])
+            return nullptr;
+        return &*_chunks[idx];
+    }
+    bool reader::hasStream(const StreamId stream_) const
+    {
+        return getChunks(stream_) != nullptr;
+    }
+    uint64_t reader::getNumSamples(const StreamId stream_) const
+    {
+        const auto chunks = getChunks(stream_);
+        if (!chunks)
+            return 0;
+        uint64_t n = 0;
+        for (const auto& c: *chunks)
+            n += c.nSamples;
+        return n;
+    }
+
+    template <typename T>
+    std::vector<T> reader::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_) const
+    {
+        // deal with default arguments
+        const auto timeStart = timeStart_.value_or(0);
+        const auto timeEnd   = timeEnd_  .value_or(std::numeric_limits<int64_t>::max());
+
+        std::vector<T> out;
+        const auto chunks = getChunks(getStreamId<T>());
+        if (!chunks)
+            return out;
+
+        // first chunk that may contain samples in the range, then all chunks until one that starts after the range
+        auto c = std::lower_bound(chunks->begin(), chunks->end(), timeStart, [](const chunkInfo& a_, const int64_t& b_) { return a_.lastTimeStamp < b_; });
+        for (; c != chunks->end() && c->firstTimeStamp <= timeEnd; ++c)
+        {
+            // the columns of the chunk. Chunk offset is a multiple of 8 and mapping is page aligned, so aligned access is ok
+            const auto* ts      = reinterpret_cast<const int64_t*>(_data + c->offset);
+            const auto* offsets = reinterpret_cast<const uint64_t*>(ts + c->nSamples);
+            const auto* payload = reinterpret_cast<const uint8_t*>(offsets + c->nSamples + 1);
+            const auto maxBytes = static_cast<uint64_t>(_data + _size - trailerSize - payload);
+
+            // find samples within range, both sides inclusive
+            const auto first = std::lower_bound(ts, ts + c->nSamples, timeStart) - ts;
+            const auto last  = std::upper_bound(ts, ts + c->nSamples, timeEnd) - ts;
+            for (auto i = first; i < last; i++)
+            {
+                if (offsets[i] > offsets[i + 1] || offsets[i + 1] > maxBytes)
+                    DoExitWithMsg("Titta::cpp::session: file \"" + _filePath + "\" has a damaged chunk");
+                const uint8_t* p = payload + offsets[i];
+                if (!TittaJournal::deserialize(p, payload + offsets[i + 1], out.emplace_back()))
+                    DoExitWithMsg("Titta::cpp::session: file \"" + _filePath + "\" has a damaged chunk");
+            }
+        }
+        return out;
+    }
+
+    // explicit instantiations
+    template std::vector<TobiiTypes::gazeData>                  reader::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_) const;
+    template std::vector<TobiiTypes::eyeImage>                  reader::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_) const;
+    template std::vector<TobiiResearchExternalSignalData>       reader::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_) const;
+    template std::vector<TobiiResearchTimeSynchronizationData>  reader::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_) const;
+    template std::vector<TobiiTypes::notification>              reader::peekTimeRange(std::optional<int64_t> timeStart_, std::optional<int64_t> timeEnd_) const;
+}
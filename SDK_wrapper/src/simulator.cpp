@@ -0,0 +1,1029 @@
+#include "Titta/simulator.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numbers>
+#include <chrono>
+#include <fstream>
+
+#include "Titta/session.h"
+#include "Titta/convert.h"
+#include "Titta/trace.h"
+#include "Titta/utils.h"
+
+namespace
+{
+    constexpr float invalid = std::numeric_limits<float>::quiet_NaN();
+
+    // geometry of the simulated setup, in the user coordinate system (mm): a 24" 16:9 display standing
+    // upright behind the eye tracker, and a participant sitting 65 cm in front of it
+    constexpr TobiiResearchDisplayArea displayArea =
+    {
+        .bottom_left  = {-264.f,  20.f, 0.f},
+        .bottom_right = { 264.f,  20.f, 0.f},
+        .height       = 297.f,
+        .top_left     = {-264.f, 317.f, 0.f},
+        .top_right    = { 264.f, 317.f, 0.f},
+        .width        = 528.f
+    };
+    constexpr TobiiResearchTrackBox trackBox =
+    {
+        .back_lower_left   = {-220.f,  60.f, 850.f},
+        .back_lower_right  = { 220.f,  60.f, 850.f},
+        .back_upper_left   = {-220.f, 420.f, 850.f},
+        .back_upper_right  = { 220.f, 420.f, 850.f},
+        .front_lower_left  = {-150.f, 120.f, 500.f},
+        .front_lower_right = { 150.f, 120.f, 500.f},
+        .front_upper_left  = {-150.f, 360.f, 500.f},
+        .front_upper_right = { 150.f, 360.f, 500.f}
+    };
+    constexpr double headDistance       = 650.;     // mm
+    constexpr double headHeight         = 250.;     // mm
+    constexpr double interOcularDist    = 63.;      // mm
+
+    constexpr std::array<float, 8>  baseFrequencies = {30.f, 60.f, 120.f, 150.f, 250.f, 300.f, 600.f, 1200.f};
+    const std::vector<std::string>  trackingModes   = {"human", "monkey", "great_ape"};
+
+    constexpr int                   eyeImageWidth   = 160;
+    constexpr int                   eyeImageHeight  = 120;
+
+    constexpr std::array<char, 4>   calibrationMagic = {'T','S','C','1'};
+
+    // first bytes of session and journal files (see session.cpp and journal.cpp)
+    constexpr std::array<char, 8>   sessionMagic    = {'T','i','t','t','a','S','e','s'};
+    constexpr std::array<char, 8>   journalMagic    = {'T','i','t','t','a','J','n','l'};
+
+    int64_t getSystemTimestamp()
+    {
+        int64_t ts = 0;
+        tobii_research_get_system_time_stamp(&ts);
+        return ts;
+    }
+
+    TobiiResearchPoint3D displayToUser(const double x_, const double y_)
+    {
+        const auto& tl = displayArea.top_left, tr = displayArea.top_right, bl = displayArea.bottom_left;
+        return {
+            static_cast<float>(tl.x + x_*(tr.x-tl.x) + y_*(bl.x-tl.x)),
+            static_cast<float>(tl.y + x_*(tr.y-tl.y) + y_*(bl.y-tl.y)),
+            static_cast<float>(tl.z + x_*(tr.z-tl.z) + y_*(bl.z-tl.z))
+        };
+    }
+    TobiiResearchNormalizedPoint3D userToTrackBox(const TobiiResearchPoint3D& p_)
+    {
+        // (0,0,0) is the front upper right corner, track box widens linearly from front to back
+        const float z     = (p_.z - trackBox.front_upper_right.z) / (trackBox.back_upper_right.z - trackBox.front_upper_right.z);
+        const float right = trackBox.front_upper_right.x + z*(trackBox.back_upper_right.x - trackBox.front_upper_right.x);
+        const float left  = trackBox.front_upper_left .x + z*(trackBox.back_upper_left .x - trackBox.front_upper_left .x);
+        const float upper = trackBox.front_upper_right.y + z*(trackBox.back_upper_right.y - trackBox.front_upper_right.y);
+        const float lower = trackBox.front_lower_right.y + z*(trackBox.back_lower_right.y - trackBox.front_lower_right.y);
+        return {(right - p_.x) / (right - left), (upper - p_.y) / (upper - lower), z};
+    }
+
+    // GIF with 128 gray levels, stored without compression: with 7 bit pixels every LZW code is 8 bits wide,
+    // as long as the code table is cleared before it grows beyond 8 bit codes
+    void encodeGif(std::vector<uint8_t>& out_, const std::vector<uint8_t>& image_, const int width_, const int height_)
+    {
+        const auto put16 = [&](const int v_) { out_.push_back(static_cast<uint8_t>(v_ & 0xFF)); out_.push_back(static_cast<uint8_t>(v_ >> 8)); };
+        constexpr uint8_t clearCode = 128, endCode = 129;
+        constexpr size_t  maxRun    = 126;
+
+        out_.clear();
+        out_.insert(out_.end(), {'G','I','F','8','9','a'});
+        put16(width_);
+        put16(height_);
+        out_.insert(out_.end(), {0xE6, 0, 0});          // global color table of 128 entries, 7 bit color resolution
+        for (int i = 0; i < 128; i++)
+        {
+            const auto g = static_cast<uint8_t>(i*255/127);
+            out_.insert(out_.end(), {g, g, g});
+        }
+        out_.push_back(0x2C);                           // image descriptor
+        put16(0);
+        put16(0);
+        put16(width_);
+        put16(height_);
+        out_.push_back(0);
+        out_.push_back(7);                              // LZW minimum code size
+
+        std::array<uint8_t, 255> block;
+        size_t nBlock = 0;
+        const auto putCode = [&](const uint8_t c_)
+        {
+            block[nBlock++] = c_;
+            if (nBlock == block.size())
+            {
+                out_.push_back(static_cast<uint8_t>(nBlock));
+                out_.insert(out_.end(), block.begin(), block.end());
+                nBlock = 0;
+            }
+        };
+        for (size_t i = 0; i < image_.size(); i++)
+        {
+            if (i % maxRun == 0)
+                putCode(clearCode);
+            putCode(image_[i] >> 1);
+        }
+        putCode(endCode);
+        if (nBlock)
+        {
+            out_.push_back(static_cast<uint8_t>(nBlock));
+            out_.insert(out_.end(), block.begin(), block.begin() + static_cast<std::ptrdiff_t>(nBlock));
+        }
+        out_.push_back(0);                              // end of image data
+        out_.push_back(0x3B);                           // trailer
+    }
+
+    template <typename Callback>
+    TobiiResearchStatus removeSubscriptions(std::vector<Callback>& subs_, decltype(subs_[0].callback) callback_)
+    {
+        const auto n = std::erase_if(subs_, [callback_](const auto& s_) { return s_.callback == callback_; });
+        return n ? TOBII_RESEARCH_STATUS_OK : TOBII_RESEARCH_STATUS_SE_NOT_SUBSCRIBED;
+    }
+    template <typename Sub, typename Sample>
+    void deliver(const std::vector<Sub>& subs_, Sample& sample_)
+    {
+        for (const auto& s : subs_)
+            s.callback(&sample_, s.userData);
+    }
+}
+
+namespace TittaSimulator
+{
+    bool isSimulatorAddress(const std::string_view address_)
+    {
+        return address_.starts_with(addressPrefix) || address_.starts_with(replayAddressPrefix);
+    }
+
+    settings settings::fromAddress(const std::string_view address_)
+    {
+        if (!isSimulatorAddress(address_))
+            DoExitWithMsg("Titta::cpp::simulator: address \"" + std::string(address_) + "\" is not a simulated eye tracker, it should start with \"" + std::string(addressPrefix) + "\" or \"" + std::string(replayAddressPrefix) + "\"");
+
+        settings out;
+        const bool isReplay = address_.starts_with(replayAddressPrefix);
+        auto query = address_.substr(isReplay ? replayAddressPrefix.size() : addressPrefix.size());
+        if (isReplay)
+        {
+            const auto sep = query.find('?');
+            out.replayFile = std::string(query.substr(0, sep));
+            query = sep == std::string_view::npos ? std::string_view{} : query.substr(sep);
+            if (out.replayFile.empty())
+                DoExitWithMsg("Titta::cpp::simulator: address \"" + std::string(address_) + "\" does not contain the path of the file to replay");
+        }
+        if (query.starts_with('?'))
+            query.remove_prefix(1);
+        while (!query.empty())
+        {
+            const auto sep   = query.find('&');
+            const auto param = query.substr(0, sep);
+            query = sep == std::string_view::npos ? std::string_view{} : query.substr(sep + 1);
+            if (param.empty())
+                continue;
+
+            const auto eq   = param.find('=');
+            const auto name = std::string(param.substr(0, eq));
+            double value    = 0.;
+            try
+            {
+                if (eq == std::string_view::npos)
+                    throw std::invalid_argument("no value");
+                const auto valStr = std::string(param.substr(eq + 1));
+                size_t nParsed = 0;
+                value = std::stod(valStr, &nParsed);
+                if (nParsed != valStr.size())
+                    throw std::invalid_argument("trailing characters");
+            }
+            catch (const std::exception&)
+            {
+                DoExitWithMsg("Titta::cpp::simulator: parameter \"" + name + "\" in address \"" + std::string(address_) + "\" does not have a valid numeric value");
+            }
+
+            if (isReplay)
+            {
+                if      (name == "speed")   out.replaySpeed = value;
+                else if (name == "delay")   out.replayDelay = value;
+                else if (name == "loop")    out.replayLoop  = value != 0.;
+                else
+                    DoExitWithMsg("Titta::cpp::simulator: unknown parameter \"" + name + "\" in address \"" + std::string(address_) + "\", possible parameters for replay are speed, delay and loop");
+                continue;
+            }
+
+            if      (name == "frequency")           out.frequency           = static_cast<float>(value);
+            else if (name == "fixationDuration")    out.fixationDuration    = value;
+            else if (name == "saccadeDuration")     out.saccadeDuration     = value;
+            else if (name == "noise")               out.noise               = value;
+            else if (name == "pupilDiameter")       out.pupilDiameter       = value;
+            else if (name == "eyeOpenness")         out.eyeOpenness         = value;
+            else if (name == "blinkRate")           out.blinkRate           = value;
+            else if (name == "blinkDuration")       out.blinkDuration       = value;
+            else if (name == "lossRate")            out.lossRate            = value;
+            else if (name == "lossDuration")        out.lossDuration        = value;
+            else if (name == "dropProbability")     out.dropProbability     = value;
+            else if (name == "eyeImageFrequency")   out.eyeImageFrequency   = static_cast<float>(value);
+            else if (name == "extSignalInterval")   out.extSignalInterval   = value;
+            else if (name == "timeSyncInterval")    out.timeSyncInterval    = value;
+            else if (name == "seed")                out.seed                = static_cast<uint32_t>(value);
+            else
+                DoExitWithMsg("Titta::cpp::simulator: unknown parameter \"" + name + "\" in address \"" + std::string(address_) + "\"");
+        }
+
+        if (!(out.frequency > 0.f))
+            DoExitWithMsg("Titta::cpp::simulator: frequency must be larger than zero");
+        if (!(out.fixationDuration > 0.) || !(out.blinkDuration > 0.) || !(out.lossDuration > 0.) || out.saccadeDuration < 0.)
+            DoExitWithMsg("Titta::cpp::simulator: fixationDuration, blinkDuration and lossDuration must be larger than zero, saccadeDuration cannot be negative");
+        if (out.noise < 0. || out.blinkRate < 0. || out.lossRate < 0. || out.eyeImageFrequency < 0.f || out.extSignalInterval < 0. || !(out.timeSyncInterval > 0.))
+            DoExitWithMsg("Titta::cpp::simulator: noise, blinkRate, lossRate, eyeImageFrequency and extSignalInterval cannot be negative, timeSyncInterval must be larger than zero");
+        if (out.dropProbability < 0. || out.dropProbability > 1.)
+            DoExitWithMsg("Titta::cpp::simulator: dropProbability must be between 0 and 1");
+        if (out.replaySpeed < 0. || out.replayDelay < 0.)
+            DoExitWithMsg("Titta::cpp::simulator: speed and delay cannot be negative");
+        return out;
+    }
+
+    tracker::tracker(settings settings_, std::string address_ /*= std::string(addressPrefix)*/) :
+        _settings(settings_),
+        _address(std::move(address_)),
+        _frequency(_settings.frequency),
+        _supportedFrequencies(baseFrequencies.begin(), baseFrequencies.end()),
+        _rng(_settings.seed ? _settings.seed : std::random_device{}())
+    {
+        if (!_settings.replayFile.empty())
+        {
+            loadRecording();
+            _deviceName = "Titta replay";
+            _supportedFrequencies = {_frequency};
+        }
+        else if (std::ranges::find(_supportedFrequencies, _frequency) == _supportedFrequencies.end())
+        {
+            _supportedFrequencies.push_back(_frequency);
+            std::ranges::sort(_supportedFrequencies);
+        }
+        // device clock started 10 s before the simulator
+        _deviceClockOffset = 10'000'000 - getSystemTimestamp();
+
+        _thread = std::thread(&tracker::run, this);
+    }
+    tracker::~tracker()
+    {
+        {
+            auto l = std::lock_guard(_mutex);
+            _shouldStop = true;
+        }
+        _cv.notify_all();
+        if (_thread.joinable())
+            _thread.join();
+    }
+
+    TobiiTypes::eyeTracker tracker::getInfo() const
+    {
+        auto l = std::lock_guard(_mutex);
+        const auto capabilities = static_cast<TobiiResearchCapabilities>(
+            TOBII_RESEARCH_CAPABILITIES_HAS_EXTERNAL_SIGNAL | TOBII_RESEARCH_CAPABILITIES_HAS_EYE_IMAGES | TOBII_RESEARCH_CAPABILITIES_HAS_GAZE_DATA |
+            TOBII_RESEARCH_CAPABILITIES_CAN_DO_SCREEN_BASED_CALIBRATION | TOBII_RESEARCH_CAPABILITIES_CAN_DO_MONOCULAR_CALIBRATION |
+            TOBII_RESEARCH_CAPABILITIES_HAS_EYE_OPENNESS_DATA);
+        const bool isReplay = !_settings.replayFile.empty();
+        return {_deviceName, isReplay ? "TR-00000000" : "TS-00000000", isReplay ? "Titta replay" : "Titta simulator", "1.0.0", "1.0.0", _address,
+                _frequency, _trackingMode, capabilities, _supportedFrequencies, trackingModes};
+    }
+    TobiiResearchTrackBox tracker::getTrackBox() const
+    {
+        return trackBox;
+    }
+    TobiiResearchDisplayArea tracker::getDisplayArea() const
+    {
+        return displayArea;
+    }
+    std::optional<replayStats> tracker::getReplayStats() const
+    {
+        if (_settings.replayFile.empty())
+            return std::nullopt;
+
+        auto l = std::lock_guard(_mutex);
+        auto out = _replayStats;
+        if (_replayStart >= 0)
+        {
+            const auto end  = out.finished ? _replayEnd : getSystemTimestamp();
+            out.elapsedTime = std::max(static_cast<double>(end - _replayStart) / 1e6, 0.);
+            if (out.elapsedTime > 0.)
+                out.speed   = out.recordingDuration / out.elapsedTime;
+        }
+        return out;
+    }
+
+    TobiiResearchStatus tracker::setDeviceName(std::string deviceName_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _deviceName = std::move(deviceName_);
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::setGazeOutputFrequency(const float frequency_)
+    {
+        auto l = std::lock_guard(_mutex);
+        if (std::ranges::find(_supportedFrequencies, frequency_) == _supportedFrequencies.end())
+            return TOBII_RESEARCH_STATUS_SE_INVALID_PARAMETER;
+        if (frequency_ != _frequency)
+        {
+            _frequency = frequency_;
+            queueNotification(TOBII_RESEARCH_NOTIFICATION_GAZE_OUTPUT_FREQUENCY_CHANGED, _frequency);
+        }
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::setEyeTrackingMode(std::string trackingMode_)
+    {
+        auto l = std::lock_guard(_mutex);
+        if (std::ranges::find(trackingModes, trackingMode_) == trackingModes.end())
+            return TOBII_RESEARCH_STATUS_SE_INVALID_PARAMETER;
+        if (trackingMode_ != _trackingMode)
+        {
+            _trackingMode = std::move(trackingMode_);
+            queueNotification(TOBII_RESEARCH_NOTIFICATION_EYE_TRACKING_MODE_CHANGED);
+        }
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::applyLicenses(const size_t nLicenses_, TobiiResearchLicenseValidationResult* validationResults_)
+    {
+        std::fill_n(validationResults_, nLicenses_, TOBII_RESEARCH_LICENSE_VALIDATION_RESULT_OK);
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+
+    // subscriptions
+    TobiiResearchStatus tracker::subscribe(tobii_research_gaze_data_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _gazeSubs.push_back({callback_, userData_});
+        subscribed();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_eye_openness_data_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _eyeOpennessSubs.push_back({callback_, userData_});
+        subscribed();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_eye_image_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _eyeImageSubs.push_back({callback_, userData_});
+        subscribed();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_eye_image_as_gif_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _eyeImageGifSubs.push_back({callback_, userData_});
+        subscribed();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_external_signal_data_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _extSignalSubs.push_back({callback_, userData_});
+        _extSignalInitial = _settings.replayFile.empty();   // like the Tobii SDK, start with the current value
+        subscribed();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_time_synchronization_data_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _timeSyncSubs.push_back({callback_, userData_});
+        subscribed();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_user_position_guide_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _positioningSubs.push_back({callback_, userData_});
+        _cv.notify_all();
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::subscribe(tobii_research_notification_callback callback_, void* userData_)
+    {
+        auto l = std::lock_guard(_mutex);
+        _notificationSubs.push_back({callback_, userData_});
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_gaze_data_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_gazeSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_eye_openness_data_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_eyeOpennessSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_eye_image_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_eyeImageSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_eye_image_as_gif_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_eyeImageGifSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_external_signal_data_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_extSignalSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_time_synchronization_data_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_timeSyncSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_user_position_guide_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_positioningSubs, callback_);
+    }
+    TobiiResearchStatus tracker::unsubscribe(tobii_research_notification_callback callback_)
+    {
+        auto l = std::lock_guard(_mutex);
+        return removeSubscriptions(_notificationSubs, callback_);
+    }
+
+    // calibration
+    TobiiResearchStatus tracker::enterCalibrationMode()
+    {
+        auto l = std::lock_guard(_mutex);
+        if (_inCalibrationMode)
+            return TOBII_RESEARCH_STATUS_SE_CALIBRATION_ALREADY_STARTED;
+        _inCalibrationMode = true;
+        _calibrationPoints.clear();
+        queueNotification(TOBII_RESEARCH_NOTIFICATION_CALIBRATION_MODE_ENTERED);
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::leaveCalibrationMode()
+    {
+        auto l = std::lock_guard(_mutex);
+        if (!_inCalibrationMode)
+            return TOBII_RESEARCH_STATUS_SE_CALIBRATION_NOT_STARTED;
+        _inCalibrationMode = false;
+        queueNotification(TOBII_RESEARCH_NOTIFICATION_CALIBRATION_MODE_LEFT);
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::calibrationCollectData(const float x_, const float y_, const std::optional<TobiiResearchSelectedEye> eye_ /*= std::nullopt*/)
+    {
+        auto l = std::lock_guard(_mutex);
+        if (!_inCalibrationMode)
+            return TOBII_RESEARCH_STATUS_SE_CALIBRATION_NOT_STARTED;
+
+        auto it = std::ranges::find_if(_calibrationPoints, [&](const calibrationPoint& p_) { return p_.x == x_ && p_.y == y_; });
+        if (it == _calibrationPoints.end())
+            it = _calibrationPoints.insert(it, {x_, y_, false, false});
+        it->left  = it->left  || !eye_ || *eye_ != TOBII_RESEARCH_SELECTED_EYE_RIGHT;
+        it->right = it->right || !eye_ || *eye_ != TOBII_RESEARCH_SELECTED_EYE_LEFT;
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::calibrationDiscardData(const float x_, const float y_, const std::optional<TobiiResearchSelectedEye> eye_ /*= std::nullopt*/)
+    {
+        auto l = std::lock_guard(_mutex);
+        if (!_inCalibrationMode)
+            return TOBII_RESEARCH_STATUS_SE_CALIBRATION_NOT_STARTED;
+
+        const auto it = std::ranges::find_if(_calibrationPoints, [&](const calibrationPoint& p_) { return p_.x == x_ && p_.y == y_; });
+        if (it != _calibrationPoints.end())
+        {
+            it->left  = it->left  && eye_ && *eye_ == TOBII_RESEARCH_SELECTED_EYE_RIGHT;
+            it->right = it->right && eye_ && *eye_ == TOBII_RESEARCH_SELECTED_EYE_LEFT;
+            if (!it->left && !it->right)
+                _calibrationPoints.erase(it);
+        }
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::calibrationComputeAndApply(TobiiTypes::CalibrationResult& result_)
+    {
+        auto l = std::lock_guard(_mutex);
+        if (!_inCalibrationMode)
+            return TOBII_RESEARCH_STATUS_SE_CALIBRATION_NOT_STARTED;
+
+        const bool hasLeft  = std::ranges::any_of(_calibrationPoints, [](const calibrationPoint& p_) { return p_.left; });
+        const bool hasRight = std::ranges::any_of(_calibrationPoints, [](const calibrationPoint& p_) { return p_.right; });
+        result_ = {};
+        if (!hasLeft && !hasRight)
+            return TOBII_RESEARCH_STATUS_OK;    // status of result is failure
+        result_.status = hasLeft && hasRight ? TOBII_RESEARCH_CALIBRATION_SUCCESS : hasLeft ? TOBII_RESEARCH_CALIBRATION_SUCCESS_LEFT_EYE : TOBII_RESEARCH_CALIBRATION_SUCCESS_RIGHT_EYE;
+
+        // a few samples per point, each eye with its own small offset from the point
+        std::normal_distribution<float> offset(0.f, static_cast<float>(std::max(_settings.noise, .001)));
+        const auto makeEye = [&](const calibrationPoint& p_, const bool has_) -> TobiiResearchCalibrationEyeData
+        {
+            if (!has_)
+                return {{invalid, invalid}, TOBII_RESEARCH_CALIBRATION_EYE_VALIDITY_INVALID_AND_NOT_USED};
+            return {{p_.x + offset(_rng), p_.y + offset(_rng)}, TOBII_RESEARCH_CALIBRATION_EYE_VALIDITY_VALID_AND_USED};
+        };
+        constexpr size_t nSamplesPerPoint = 8;
+        for (const auto& p : _calibrationPoints)
+        {
+            TobiiTypes::CalibrationPoint point;
+            point.position_on_display_area = {p.x, p.y};
+            for (size_t i = 0; i < nSamplesPerPoint; i++)
+                point.calibration_samples.push_back({makeEye(p, p.left), makeEye(p, p.right)});
+            result_.calibration_points.push_back(std::move(point));
+        }
+
+        // store as the applied calibration
+        _calibrationData.assign(calibrationMagic.begin(), calibrationMagic.end());
+        for (const auto& p : _calibrationPoints)
+        {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(&p.x);
+            _calibrationData.insert(_calibrationData.end(), bytes, bytes + sizeof(float));
+            bytes = reinterpret_cast<const uint8_t*>(&p.y);
+            _calibrationData.insert(_calibrationData.end(), bytes, bytes + sizeof(float));
+            _calibrationData.push_back(static_cast<uint8_t>(p.left | p.right << 1));
+        }
+        queueNotification(TOBII_RESEARCH_NOTIFICATION_CALIBRATION_CHANGED);
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::retrieveCalibrationData(std::vector<uint8_t>& data_)
+    {
+        auto l = std::lock_guard(_mutex);
+        data_ = _calibrationData;
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+    TobiiResearchStatus tracker::applyCalibrationData(const std::vector<uint8_t>& data_)
+    {
+        constexpr size_t pointSize = 2*sizeof(float) + 1;
+        if (data_.size() < calibrationMagic.size() || !std::equal(calibrationMagic.begin(), calibrationMagic.end(), data_.begin()) || (data_.size() - calibrationMagic.size()) % pointSize)
+            return TOBII_RESEARCH_STATUS_SE_INVALID_PARAMETER;
+
+        auto l = std::lock_guard(_mutex);
+        _calibrationData = data_;
+        queueNotification(TOBII_RESEARCH_NOTIFICATION_CALIBRATION_CHANGED);
+        return TOBII_RESEARCH_STATUS_OK;
+    }
+
+    void tracker::queueNotification(const TobiiResearchNotificationType type_, const float frequency_ /*= 0.f*/)
+    {
+        TobiiResearchNotification n{};
+        n.system_time_stamp = getSystemTimestamp();
+        n.notification_type = type_;
+        if (type_ == TOBII_RESEARCH_NOTIFICATION_GAZE_OUTPUT_FREQUENCY_CHANGED)
+            n.value.output_frequency = frequency_;
+        _pendingNotifications.push_back(n);
+        _cv.notify_all();
+    }
+
+    void tracker::run()
+    {
+        TittaTrace::setThreadName("Titta simulator");
+        auto l = std::unique_lock(_mutex);
+        _startTime          = getSystemTimestamp();
+        _nextGazeTime       = static_cast<double>(_startTime);
+        _nextEyeImageTime   = static_cast<double>(_startTime);
+        _nextTimeSyncTime   = static_cast<double>(_startTime);
+        _nextExtSignalTime  = static_cast<double>(_startTime) + _settings.extSignalInterval*1e6;
+        std::exponential_distribution<double> interval;
+        _fixationEnd        = 0.;
+        _nextBlink          = _settings.blinkRate > 0. ? interval(_rng)/_settings.blinkRate : std::numeric_limits<double>::infinity();
+        for (size_t e = 0; e < 2; e++)
+            _nextLoss[e]    = _settings.lossRate  > 0. ? interval(_rng)/_settings.lossRate  : std::numeric_limits<double>::infinity();
+
+        while (!_shouldStop)
+        {
+            const auto now     = static_cast<double>(getSystemTimestamp());
+            const auto nextDue = _settings.replayFile.empty() ? generate(now) : replay(now);
+
+            // notifications
+            for (auto& n : _pendingNotifications)
+                deliver(_notificationSubs, n);
+            _pendingNotifications.clear();
+
+            if (nextDue <= now)
+            {
+                // more samples to deliver right away, but let others (e.g. unsubscribe) have a go at the lock first
+                l.unlock();
+                std::this_thread::yield();
+                l.lock();
+            }
+            else
+                // wait until next sample is due, or something changes
+                _cv.wait_for(l, std::chrono::microseconds(static_cast<int64_t>(nextDue - now)));
+        }
+    }
+
+    double tracker::generate(const double now_)
+    {
+        constexpr double maxLag = 1e6;      // us, if further behind (e.g. process was suspended), samples are skipped
+        std::uniform_real_distribution<double> uniform;
+        double nextDue = now_ + 100'000.;
+
+        // gaze, eye openness and positioning
+        const auto gazePeriod = 1e6/_frequency;
+        if (!_gazeSubs.empty() || !_eyeOpennessSubs.empty() || !_positioningSubs.empty())
+        {
+            if (now_ - _nextGazeTime > maxLag)
+                _nextGazeTime = now_;
+            for (; _nextGazeTime <= now_; _nextGazeTime += gazePeriod)
+                makeGazeSample(static_cast<int64_t>(_nextGazeTime));
+            nextDue = std::min(nextDue, _nextGazeTime);
+        }
+        else
+            _nextGazeTime = std::max(_nextGazeTime, now_);
+
+        // eye images
+        if (_settings.eyeImageFrequency > 0.f && (!_eyeImageSubs.empty() || !_eyeImageGifSubs.empty()))
+        {
+            if (now_ - _nextEyeImageTime > maxLag)
+                _nextEyeImageTime = now_;
+            for (; _nextEyeImageTime <= now_; _nextEyeImageTime += 1e6/_settings.eyeImageFrequency)
+                makeEyeImage(static_cast<int64_t>(_nextEyeImageTime));
+            nextDue = std::min(nextDue, _nextEyeImageTime);
+        }
+        else
+            _nextEyeImageTime = std::max(_nextEyeImageTime, now_);
+
+        // external signal
+        if (_settings.extSignalInterval > 0.)
+        {
+            for (; _nextExtSignalTime <= now_; _nextExtSignalTime += _settings.extSignalInterval*1e6)
+            {
+                _extSignalValue = !_extSignalValue;
+                const auto ts = static_cast<int64_t>(_nextExtSignalTime);
+                TobiiResearchExternalSignalData sample{toDeviceTime(ts), ts, _extSignalValue, TOBII_RESEARCH_EXTERNAL_SIGNAL_VALUE_CHANGED};
+                deliver(_extSignalSubs, sample);
+                _extSignalInitial = false;
+            }
+            nextDue = std::min(nextDue, _nextExtSignalTime);
+        }
+        if (_extSignalInitial)
+        {
+            const auto ts = static_cast<int64_t>(now_);
+            TobiiResearchExternalSignalData sample{toDeviceTime(ts), ts, _extSignalValue, TOBII_RESEARCH_EXTERNAL_SIGNAL_INITIAL_VALUE};
+            deliver(_extSignalSubs, sample);
+            _extSignalInitial = false;
+        }
+
+        // time synchronization
+        if (!_timeSyncSubs.empty())
+        {
+            for (; _nextTimeSyncTime <= now_; _nextTimeSyncTime += _settings.timeSyncInterval*1e6)
+            {
+                const auto response = static_cast<int64_t>(_nextTimeSyncTime);
+                const auto request  = response - 150 - static_cast<int64_t>(200.*uniform(_rng));
+                TobiiResearchTimeSynchronizationData sample{request, toDeviceTime((request+response)/2), response};
+                deliver(_timeSyncSubs, sample);
+            }
+            nextDue = std::min(nextDue, _nextTimeSyncTime);
+        }
+        else
+            _nextTimeSyncTime = std::max(_nextTimeSyncTime, now_);
+
+        return nextDue;
+    }
+
+    void tracker::subscribed()
+    {
+        if (!_settings.replayFile.empty() && _replayStart < 0)
+            _replayStart = getSystemTimestamp() + static_cast<int64_t>(_settings.replayDelay*1e6);
+        _cv.notify_all();
+    }
+
+    void tracker::loadRecording()
+    {
+        const auto& path = _settings.replayFile;
+        std::array<char, 8> magic{};
+        {
+            std::ifstream file(path, std::ios::binary);
+            if (!file)
+                DoExitWithMsg("Titta::cpp::simulator: cannot open file \"" + path + "\" for replay");
+            file.read(magic.data(), magic.size());
+        }
+        if (magic == sessionMagic)
+        {
+            const TittaSession::reader reader(path);
+            _recording.gaze      = reader.peekTimeRange<TobiiTypes::gazeData>();
+            _recording.eyeImage  = reader.peekTimeRange<TobiiTypes::eyeImage>();
+            _recording.extSignal = reader.peekTimeRange<TobiiResearchExternalSignalData>();
+            _recording.timeSync  = reader.peekTimeRange<TobiiResearchTimeSynchronizationData>();
+        }
+        else if (magic == journalMagic)
+            _recording = TittaJournal::read(path);
+        else
+            DoExitWithMsg("Titta::cpp::simulator: file \"" + path + "\" is not a Titta session or journal file, cannot replay it");
+
+        // order all samples by time
+        const auto addEvents = [&](const auto& samples_, const TittaJournal::StreamId stream_)
+        {
+            for (uint32_t i = 0; i < static_cast<uint32_t>(samples_.size()); i++)
+                _replayEvents.push_back({TittaSession::getTimeStamp(samples_[i]), i, stream_});
+        };
+        addEvents(_recording.gaze,      TittaJournal::StreamId::Gaze);
+        addEvents(_recording.eyeImage,  TittaJournal::StreamId::EyeImage);
+        addEvents(_recording.extSignal, TittaJournal::StreamId::ExtSignal);
+        addEvents(_recording.timeSync,  TittaJournal::StreamId::TimeSync);
+        if (_replayEvents.empty())
+            DoExitWithMsg("Titta::cpp::simulator: file \"" + path + "\" contains no samples that can be replayed");
+        std::ranges::stable_sort(_replayEvents, {}, &replayEvent::timeStamp);
+
+        // sampling frequency: from median interval between gaze samples
+        int64_t gazePeriod = 0;
+        if (_recording.gaze.size() > 1)
+        {
+            std::vector<int64_t> intervals;
+            for (size_t i = 1; i < std::min(_recording.gaze.size(), size_t{1001}); i++)
+                intervals.push_back(_recording.gaze[i].system_time_stamp - _recording.gaze[i-1].system_time_stamp);
+            std::ranges::nth_element(intervals, intervals.begin() + static_cast<std::ptrdiff_t>(intervals.size()/2));
+            gazePeriod = intervals[intervals.size()/2];
+            if (gazePeriod > 0)
+                _frequency = std::round(1e6f / static_cast<float>(gazePeriod));
+        }
+        // when looping, the next round starts one sample after the end of the recording
+        _replayLoopDuration = _replayEvents.back().timeStamp - _replayEvents.front().timeStamp + std::max(gazePeriod, int64_t{1});
+    }
+
+    double tracker::replay(const double now_)
+    {
+        if (_replayStart < 0 || _replayStats.finished)
+            return now_ + 100'000.;
+        if (now_ < static_cast<double>(_replayStart))
+            return static_cast<double>(_replayStart);
+
+        // deliver in batches, so that the lock is released regularly when replaying as fast as possible
+        constexpr size_t maxBatch   = 256;
+        const auto firstTimeStamp   = _replayEvents.front().timeStamp;
+        const auto speed            = _settings.replaySpeed;
+        for (size_t n = 0; n < maxBatch; n++)
+        {
+            if (_replayPos == _replayEvents.size())
+            {
+                if (!_settings.replayLoop)
+                {
+                    _replayStats.finished = true;
+                    _replayEnd = getSystemTimestamp();
+                    return now_ + 100'000.;
+                }
+                _replayPos = 0;
+                _replayLoopOffset += _replayLoopDuration;
+            }
+
+            const auto& event = _replayEvents[_replayPos];
+            const auto recTime = event.timeStamp - firstTimeStamp + _replayLoopOffset;     // us since start of recording
+            // the sample is stamped with the time it is due, or when replaying as fast as possible, the time it
+            // is delivered. That way its system time stamp is in step with the system clock, like for live data
+            int64_t replayTime = 0;
+            if (speed > 0.)
+            {
+                const auto due = static_cast<double>(_replayStart) + static_cast<double>(recTime)/speed;
+                if (due > now_)
+                    return due;
+                _replayStats.maxLag = std::max(_replayStats.maxLag, (now_ - due)/1e6);
+                replayTime = std::llround(due);
+            }
+            else
+                replayTime = getSystemTimestamp();
+            replaySample(event, replayTime - event.timeStamp, _replayLoopOffset);
+            _replayStats.recordingDuration = static_cast<double>(recTime)/1e6;
+            _replayPos++;
+        }
+        return now_;
+    }
+
+    void tracker::replaySample(const replayEvent& event_, const int64_t timeOffset_, const int64_t loopOffset_)
+    {
+        // system time stamps are shifted to when the sample is replayed, device time stamps keep the recorded
+        // spacing and only move forward when looping
+        const auto start = std::chrono::steady_clock::now();
+        switch (event_.stream)
+        {
+            case TittaJournal::StreamId::Gaze:
+            {
+                const auto& s = _recording.gaze[event_.index];
+                const auto sysTs = s.system_time_stamp + timeOffset_, devTs = s.device_time_stamp + loopOffset_;
+                if (!_gazeSubs.empty() && (s.left_eye.gaze_point.available || s.right_eye.gaze_point.available))
+                {
+                    TobiiResearchGazeData sample;
+                    TittaConvert::toTobiiEyeData(sample.left_eye , s.left_eye);
+                    TittaConvert::toTobiiEyeData(sample.right_eye, s.right_eye);
+                    sample.device_time_stamp = devTs;
+                    sample.system_time_stamp = sysTs;
+                    deliver(_gazeSubs, sample);
+                    _replayStats.numGaze++;
+                }
+                if (!_eyeOpennessSubs.empty() && (s.left_eye.eye_openness.available || s.right_eye.eye_openness.available))
+                {
+                    TobiiResearchEyeOpennessData sample{devTs, sysTs,
+                        s.left_eye .eye_openness.validity, s.left_eye .eye_openness.diameter,
+                        s.right_eye.eye_openness.validity, s.right_eye.eye_openness.diameter};
+                    deliver(_eyeOpennessSubs, sample);
+                    _replayStats.numEyeOpenness++;
+                }
+                break;
+            }
+            case TittaJournal::StreamId::EyeImage:
+            {
+                const auto& s = _recording.eyeImage[event_.index];
+                if (s.is_gif && !_eyeImageGifSubs.empty())
+                {
+                    TobiiResearchEyeImageGif sample{s.device_time_stamp + loopOffset_, s.system_time_stamp + timeOffset_, s.type, s.camera_id,
+                        s.data_size, s.data(), s.region_id, s.region_top, s.region_left};
+                    deliver(_eyeImageGifSubs, sample);
+                    _replayStats.numEyeImages++;
+                }
+                else if (!s.is_gif && !_eyeImageSubs.empty())
+                {
+                    TobiiResearchEyeImage sample{s.device_time_stamp + loopOffset_, s.system_time_stamp + timeOffset_, s.bits_per_pixel, s.padding_per_pixel,
+                        s.width, s.height, s.type, s.camera_id, s.data_size, s.data(), s.region_id, s.region_top, s.region_left};
+                    deliver(_eyeImageSubs, sample);
+                    _replayStats.numEyeImages++;
+                }
+                break;
+            }
+            case TittaJournal::StreamId::ExtSignal:
+            {
+                if (_extSignalSubs.empty())
+                    break;
+                auto sample = _recording.extSignal[event_.index];
+                sample.device_time_stamp += loopOffset_;
+                sample.system_time_stamp += timeOffset_;
+                deliver(_extSignalSubs, sample);
+                _replayStats.numExtSignals++;
+                break;
+            }
+            case TittaJournal::StreamId::TimeSync:
+            {
+                if (_timeSyncSubs.empty())
+                    break;
+                auto sample = _recording.timeSync[event_.index];
+                sample.system_request_time_stamp  += timeOffset_;
+                sample.device_time_stamp          += loopOffset_;
+                sample.system_response_time_stamp += timeOffset_;
+                deliver(_timeSyncSubs, sample);
+                _replayStats.numTimeSyncs++;
+                break;
+            }
+            default:
+                break;
+        }
+        _replayStats.callbackTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void tracker::makeGazeSample(const int64_t timeStamp_)
+    {
+        constexpr double pi = std::numbers::pi;
+        const double t = static_cast<double>(timeStamp_ - _startTime) / 1e6;
+        std::normal_distribution<double>        normal;
+        std::uniform_real_distribution<double>  uniform;
+        std::exponential_distribution<double>   interval;
+
+        // fixations at random positions, connected by saccades
+        if (t >= _fixationEnd)
+        {
+            _saccadeFrom  = _gazePos;
+            _gazePos      = {.1 + .8*uniform(_rng), .1 + .8*uniform(_rng)};
+            _saccadeStart = t;
+            _fixationEnd  = t + _settings.saccadeDuration + std::max(.05, interval(_rng)*_settings.fixationDuration);
+        }
+        auto pos = _gazePos;
+        if (t < _saccadeStart + _settings.saccadeDuration)
+        {
+            const double p = (t - _saccadeStart) / _settings.saccadeDuration;
+            const double s = p*p*(3.-2.*p);
+            for (size_t i = 0; i < 2; i++)
+                pos[i] = _saccadeFrom[i] + s*(_gazePos[i] - _saccadeFrom[i]);
+        }
+
+        // blinks: eye closes and opens again
+        if (t >= _nextBlink)
+        {
+            _blinkStart = t;
+            _nextBlink  = t + _settings.blinkDuration + interval(_rng)/_settings.blinkRate;
+        }
+        double openness = 1.;
+        if (_blinkStart >= 0. && t < _blinkStart + _settings.blinkDuration)
+            openness = 1. - std::sin(pi * (t - _blinkStart) / _settings.blinkDuration);
+
+        // data loss episodes, per eye
+        std::array<bool, 2> tracked;
+        for (size_t e = 0; e < 2; e++)
+        {
+            if (t >= _nextLoss[e])
+            {
+                _lossEnd[e]  = t + interval(_rng)*_settings.lossDuration;
+                _nextLoss[e] = _lossEnd[e] + interval(_rng)/_settings.lossRate;
+            }
+            tracked[e] = t >= _lossEnd[e];
+        }
+        if (_settings.dropProbability > 0. && uniform(_rng) < _settings.dropProbability)
+            return;
+
+        // head sways slowly in front of the eye tracker
+        const double headX = 10.*std::sin(2.*pi*t/5.3), headY = headHeight + 5.*std::sin(2.*pi*t/7.1), headZ = headDistance + 15.*std::sin(2.*pi*t/11.);
+
+        TobiiResearchGazeData           gaze;
+        TobiiResearchEyeOpennessData    eyeOpenness;
+        TobiiResearchUserPositionGuide  positioning;
+        gaze.system_time_stamp = eyeOpenness.system_time_stamp = timeStamp_;
+        gaze.device_time_stamp = eyeOpenness.device_time_stamp = toDeviceTime(timeStamp_);
+        for (size_t e = 0; e < 2; e++)
+        {
+            auto& eye       = e == 0 ? gaze.left_eye : gaze.right_eye;
+            auto& userPos   = e == 0 ? positioning.left_eye : positioning.right_eye;
+            auto& openValid = e == 0 ? eyeOpenness.left_eye_validity : eyeOpenness.right_eye_validity;
+            auto& openValue = e == 0 ? eyeOpenness.left_eye_openness_value : eyeOpenness.right_eye_openness_value;
+
+            const TobiiResearchPoint3D eyePos = {static_cast<float>(headX + (e == 0 ? -.5 : .5)*interOcularDist), static_cast<float>(headY), static_cast<float>(headZ)};
+            const auto eyePosTB = userToTrackBox(eyePos);
+            if (tracked[e] && openness > .5)
+            {
+                const double x = pos[0] + _settings.noise*normal(_rng), y = pos[1] + _settings.noise*normal(_rng);
+                eye.gaze_point.position_on_display_area         = {static_cast<float>(x), static_cast<float>(y)};
+                eye.gaze_point.position_in_user_coordinates     = displayToUser(x, y);
+                eye.gaze_point.validity                         = TOBII_RESEARCH_VALIDITY_VALID;
+                eye.pupil_data.diameter                         = static_cast<float>(_settings.pupilDiameter*(1. + .08*std::sin(2.*pi*t/9. + static_cast<double>(e)*.3)) + .02*normal(_rng));
+                eye.pupil_data.validity                         = TOBII_RESEARCH_VALIDITY_VALID;
+                eye.gaze_origin.position_in_user_coordinates    = eyePos;
+                eye.gaze_origin.position_in_track_box_coordinates = eyePosTB;
+                eye.gaze_origin.validity                        = TOBII_RESEARCH_VALIDITY_VALID;
+            }
+            else
+            {
+                eye.gaze_point.position_on_display_area         = {invalid, invalid};
+                eye.gaze_point.position_in_user_coordinates     = {invalid, invalid, invalid};
+                eye.gaze_point.validity                         = TOBII_RESEARCH_VALIDITY_INVALID;
+                eye.pupil_data.diameter                         = invalid;
+                eye.pupil_data.validity                         = TOBII_RESEARCH_VALIDITY_INVALID;
+                eye.gaze_origin.position_in_user_coordinates    = {invalid, invalid, invalid};
+                eye.gaze_origin.position_in_track_box_coordinates = {invalid, invalid, invalid};
+                eye.gaze_origin.validity                        = TOBII_RESEARCH_VALIDITY_INVALID;
+            }
+
+            // eye openness and position are also measured during a blink
+            if (tracked[e])
+            {
+                openValid           = TOBII_RESEARCH_VALIDITY_VALID;
+                openValue           = static_cast<float>(std::max(_settings.eyeOpenness*openness + .1*normal(_rng), 0.));
+                userPos.user_position = eyePosTB;
+                userPos.validity    = TOBII_RESEARCH_VALIDITY_VALID;
+            }
+            else
+            {
+                openValid           = TOBII_RESEARCH_VALIDITY_INVALID;
+                openValue           = invalid;
+                userPos.user_position = {invalid, invalid, invalid};
+                userPos.validity    = TOBII_RESEARCH_VALIDITY_INVALID;
+            }
+        }
+
+        deliver(_gazeSubs, gaze);
+        deliver(_eyeOpennessSubs, eyeOpenness);
+        deliver(_positioningSubs, positioning);
+    }
+
+    void tracker::makeEyeImage(const int64_t timeStamp_)
+    {
+        // cropped image of an eye: iris and pupil that move with gaze, and a corneal reflection
+        _eyeImage.resize(static_cast<size_t>(eyeImageWidth*eyeImageHeight));
+        const double cx = eyeImageWidth /2. + (_gazePos[0]-.5)*40.;
+        const double cy = eyeImageHeight/2. + (_gazePos[1]-.5)*30.;
+        const double pupilRadius = 3.*_settings.pupilDiameter;
+        for (int y = 0; y < eyeImageHeight; y++)
+            for (int x = 0; x < eyeImageWidth; x++)
+            {
+                const double d2 = (x-cx)*(x-cx) + (y-cy)*(y-cy);
+                const double g2 = (x-cx-6.)*(x-cx-6.) + (y-cy+5.)*(y-cy+5.);
+                uint8_t v = 150;
+                if (g2 < 6.)
+                    v = 255;
+                else if (d2 < pupilRadius*pupilRadius)
+                    v = 20;
+                else if (d2 < 900.)
+                    v = 90;
+                _eyeImage[static_cast<size_t>(y*eyeImageWidth + x)] = v;
+            }
+
+        if (!_eyeImageSubs.empty())
+        {
+            TobiiResearchEyeImage image{};
+            image.system_time_stamp = timeStamp_;
+            image.device_time_stamp = toDeviceTime(timeStamp_);
+            image.bits_per_pixel    = 8;
+            image.padding_per_pixel = 0;
+            image.width             = eyeImageWidth;
+            image.height            = eyeImageHeight;
+            image.type              = TOBII_RESEARCH_EYE_IMAGE_TYPE_CROPPED;
+            image.camera_id         = _eyeImageCamera;
+            image.data_size         = _eyeImage.size();
+            image.data              = _eyeImage.data();
+            deliver(_eyeImageSubs, image);
+        }
+        if (!_eyeImageGifSubs.empty())
+        {
+            encodeGif(_eyeImageGif, _eyeImage, eyeImageWidth, eyeImageHeight);
+            TobiiResearchEyeImageGif image{};
+            image.system_time_stamp = timeStamp_;
+            image.device_time_stamp = toDeviceTime(timeStamp_);
+            image.type              = TOBII_RESEARCH_EYE_IMAGE_TYPE_CROPPED;
+            image.camera_id         = _eyeImageCamera;
+            image.image_size        = _eyeImageGif.size();
+            image.image_data        = _eyeImageGif.data();
+            deliver(_eyeImageGifSubs, image);
+        }
+        // images of the two cameras alternate
+        _eyeImageCamera = !_eyeImageCamera;
+    }
+}
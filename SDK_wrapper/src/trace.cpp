@@ -0,0 +1,213 @@
+#include "Titta/trace.h"
+#include <array>
+#include <cinttypes>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "Titta/utils.h"
+
+namespace TittaTrace
+{
+    namespace
+    {
+        struct event
+        {
+            const char* name;
+            const char* category;
+            const char* stream;
+            int64_t     begin;
+            int64_t     end;
+        };
+
+        // written only by its thread. Events are published by incrementing size, so they can be read while
+        // the thread continues recording
+        struct threadBuffer
+        {
+            std::unique_ptr<event[]>    events;
+            size_t                      capacity    = 0;
+            std::atomic<size_t>         size        = 0;
+            std::atomic<uint64_t>       numDropped  = 0;
+            uint32_t                    tid         = 0;
+            std::string                 name;       // guarded by g_registryMutex
+        };
+
+        std::mutex                                  g_registryMutex;
+        std::vector<std::shared_ptr<threadBuffer>>  g_registry;         // buffers of the current trace
+        std::atomic<uint64_t>                       g_generation = 0;   // incremented by each start()
+        size_t                                      g_eventsPerThread = defaultEventsPerThread;
+        std::atomic<int64_t>                        g_startTime = 0;
+
+        struct threadState
+        {
+            std::shared_ptr<threadBuffer>   buffer;
+            uint64_t                        generation = 0;
+            std::string                     name;
+            // shared locks held by this thread
+            std::array<std::pair<const void*, int64_t>, 16> sharedHolds{};
+            size_t                          numSharedHolds = 0;
+        };
+        thread_local threadState t_state;
+
+        // buffer of the calling thread for the current trace, registered on first use
+        threadBuffer* getThreadBuffer()
+        {
+            if (t_state.generation != g_generation.load(std::memory_order_acquire))
+            {
+                std::scoped_lock l(g_registryMutex);
+                auto buffer         = std::make_shared<threadBuffer>();
+                buffer->events      = std::make_unique<event[]>(g_eventsPerThread);
+                buffer->capacity    = g_eventsPerThread;
+                buffer->tid         = static_cast<uint32_t>(g_registry.size()) + 1;
+                buffer->name        = t_state.name.empty() ? "thread " + std::to_string(buffer->tid) : t_state.name;
+                g_registry.push_back(buffer);
+                t_state.buffer          = std::move(buffer);
+                t_state.generation      = g_generation.load(std::memory_order_relaxed);
+                t_state.numSharedHolds  = 0;
+            }
+            return t_state.buffer.get();
+        }
+
+        void appendEscaped(std::string& out_, const char* str_)
+        {
+            for (; *str_; ++str_)
+            {
+                if (*str_ == '"' || *str_ == '\\')
+                    out_ += '\\';
+                out_ += *str_;
+            }
+        }
+        void appendTime(std::string& out_, const int64_t ns_)
+        {
+            // trace event times are in us
+            char buf[32];
+            std::snprintf(buf, sizeof(buf), "%" PRId64 ".%03d", ns_/1000, static_cast<int>(ns_%1000));
+            out_ += buf;
+        }
+    }
+
+    void start(std::optional<size_t> eventsPerThread_ /*= std::nullopt*/)
+    {
+        std::scoped_lock l(g_registryMutex);
+        _isTracing = false;
+        g_registry.clear();     // threads still writing to their old buffer keep it alive
+        g_eventsPerThread = eventsPerThread_ ? *eventsPerThread_ : defaultEventsPerThread;
+        g_startTime.store(now(), std::memory_order_relaxed);
+        g_generation.fetch_add(1, std::memory_order_release);
+        _isTracing = true;
+    }
+    void stop()
+    {
+        _isTracing = false;
+    }
+
+    void setThreadName(const char* name_)
+    {
+        t_state.name = name_;
+        std::scoped_lock l(g_registryMutex);
+        if (t_state.buffer && t_state.generation == g_generation.load(std::memory_order_relaxed))
+            t_state.buffer->name = name_;
+    }
+
+    void record(const char* name_, const char* category_, const char* stream_, const int64_t begin_, const int64_t end_)
+    {
+        if (begin_ < g_startTime.load(std::memory_order_relaxed))  // started before this trace
+            return;
+        auto buffer = getThreadBuffer();
+        const auto n = buffer->size.load(std::memory_order_relaxed);
+        if (n == buffer->capacity)
+        {
+            buffer->numDropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        buffer->events[n] = {name_, category_, stream_, begin_, end_};
+        buffer->size.store(n + 1, std::memory_order_release);
+    }
+
+    void pushSharedHold(const void* mutex_, const int64_t begin_)
+    {
+        getThreadBuffer();      // ensure holds left over from a previous trace are discarded
+        if (t_state.numSharedHolds < t_state.sharedHolds.size())
+            t_state.sharedHolds[t_state.numSharedHolds++] = {mutex_, begin_};
+    }
+    int64_t popSharedHold(const void* mutex_)
+    {
+        // most recently taken first. Not found if tracing started while the lock was held
+        for (auto i = t_state.numSharedHolds; i-- > 0;)
+        {
+            if (t_state.sharedHolds[i].first != mutex_)
+                continue;
+            const auto begin = t_state.sharedHolds[i].second;
+            for (; i + 1 < t_state.numSharedHolds; i++)
+                t_state.sharedHolds[i] = t_state.sharedHolds[i + 1];
+            t_state.numSharedHolds--;
+            return begin;
+        }
+        return -1;
+    }
+
+    std::string toChromeTrace()
+    {
+        std::vector<std::shared_ptr<threadBuffer>> buffers;
+        std::vector<std::string> names;
+        int64_t startTime;
+        {
+            std::scoped_lock l(g_registryMutex);
+            buffers   = g_registry;
+            startTime = g_startTime.load(std::memory_order_relaxed);
+            for (const auto& b : buffers)
+                names.push_back(b->name);
+        }
+
+        std::string out = R"({"displayTimeUnit":"ms","traceEvents":[)";
+        uint64_t numDropped = 0;
+        bool first = true;
+        for (size_t b = 0; b < buffers.size(); b++)
+        {
+            const auto& buffer = *buffers[b];
+            const auto tid = std::to_string(buffer.tid);
+            out += first ? "\n" : ",\n";
+            first = false;
+            out += R"({"name":"thread_name","ph":"M","pid":1,"tid":)" + tid + R"(,"args":{"name":")";
+            appendEscaped(out, names[b].c_str());
+            out += R"("}})";
+
+            const auto n = buffer.size.load(std::memory_order_acquire);
+            for (size_t i = 0; i < n; i++)
+            {
+                const auto& e = buffer.events[i];
+                out += ",\n{\"name\":\"";
+                appendEscaped(out, e.name);
+                out += R"(","cat":")";
+                appendEscaped(out, e.category);
+                out += R"(","ph":"X","pid":1,"tid":)" + tid + R"(,"ts":)";
+                appendTime(out, e.begin - startTime);
+                out += R"(,"dur":)";
+                appendTime(out, e.end - e.begin);
+                if (e.stream)
+                {
+                    out += R"(,"args":{"stream":")";
+                    appendEscaped(out, e.stream);
+                    out += R"("})";
+                }
+                out += '}';
+            }
+            numDropped += buffer.numDropped.load(std::memory_order_relaxed);
+        }
+        out += "\n],\"otherData\":{\"droppedEvents\":" + std::to_string(numDropped) + "}}\n";
+        return out;
+    }
+
+    void writeChromeTrace(const std::string& filePath_)
+    {
+        std::ofstream file(filePath_, std::ios::binary | std::ios::trunc);
+        if (!file)
+            DoExitWithMsg("Titta::cpp::writeTrace: cannot open file \"" + filePath_ + "\" for writing");
+        const auto trace = toChromeTrace();
+        file.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+        if (!file)
+            DoExitWithMsg("Titta::cpp::writeTrace: error writing to file \"" + filePath_ + "\"");
+    }
+}
@@ -1,4 +1,7 @@
 #include "Titta/types.h"
+#include <bit>
+#include <cstdlib>
+#include <new>
 
 #include "Titta/utils.h"
 
@@ -146,4 +149,250 @@ namespace TobiiTypes
             // a single option is specified but unknown, emit error
             DoExitWithMsg(string_format("Titta::cpp::eyeTracker::refreshInfo: Option %s unknown.", paramToRefresh_->c_str()));
     }
-}
\ No newline at end of file
+
+    namespace
+    {
+        // size classes: class 0 holds blocks up to 256 bytes, above that there are four classes per power of two
+        constexpr size_t minBlockLog2   = 8;
+        constexpr size_t nSizeClasses   = 1+4*(sizeof(size_t)*8-minBlockLog2);
+
+        size_t sizeToClass(const size_t nBytes_)
+        {
+            if (nBytes_ <= (size_t{1}<<minBlockLog2))
+                return 0;
+            const size_t e      = std::bit_width(nBytes_-1)-1;  // 2^e < nBytes_ <= 2^(e+1)
+            const size_t step   = size_t{1}<<(e-2);
+            const size_t nSteps = (nBytes_+step-1)/step;        // 5, 6, 7 or 8
+            return 1 + (e-minBlockLog2)*4 + (nSteps-5);
+        }
+        size_t classToSize(const size_t sizeClass_)
+        {
+            if (sizeClass_ == 0)
+                return size_t{1}<<minBlockLog2;
+            const size_t e      = (sizeClass_-1)/4+minBlockLog2;
+            const size_t nSteps = (sizeClass_-1)%4+5;
+            return nSteps*(size_t{1}<<(e-2));
+        }
+
+        struct poolState
+        {
+            std::mutex                                      mutex;
+            std::array<std::vector<void*>, nSizeClasses>    idle;
+            uint64_t                                        numRequests     = 0;
+            uint64_t                                        numHits         = 0;
+            size_t                                          residentBytes   = 0;
+            size_t                                          idleBytes       = 0;
+        };
+        poolState& getPoolState()
+        {
+            // deliberately leaked: blocks may be released during static destruction (e.g. when buffers
+            // holding eye images are destroyed at unload), the pool must outlive them
+            static auto* state = new poolState;
+            return *state;
+        }
+    }
+
+    imagePool::block::block(const size_t nBytes_)
+    {
+        if (!nBytes_)
+            return;
+
+        _sizeClass = sizeToClass(nBytes_);
+        auto& pool = getPoolState();
+        {
+            std::lock_guard<std::mutex> l(pool.mutex);
+            ++pool.numRequests;
+            auto& idle = pool.idle[_sizeClass];
+            if (!idle.empty())
+            {
+                _ptr = idle.back();
+                idle.pop_back();
+                ++pool.numHits;
+                pool.idleBytes -= classToSize(_sizeClass);
+                return;
+            }
+        }
+
+        // nothing available, allocate outside of the lock
+        const auto size = classToSize(_sizeClass);
+        _ptr = std::malloc(size);
+        if (!_ptr)
+            throw std::bad_alloc();
+        std::lock_guard<std::mutex> l(pool.mutex);
+        pool.residentBytes += size;
+    }
+
+    void imagePool::block::reset()
+    {
+        if (!_ptr)
+            return;
+
+        const auto size = classToSize(_sizeClass);
+        auto& pool = getPoolState();
+        {
+            std::lock_guard<std::mutex> l(pool.mutex);
+            if (pool.idleBytes + size <= maxIdleBytes)
+            {
+                pool.idle[_sizeClass].push_back(_ptr);
+                pool.idleBytes += size;
+                _ptr = nullptr;
+                return;
+            }
+            pool.residentBytes -= size;
+        }
+        std::free(_ptr);
+        _ptr = nullptr;
+    }
+
+    imagePool::stats imagePool::getStats()
+    {
+        auto& pool = getPoolState();
+        std::lock_guard<std::mutex> l(pool.mutex);
+        stats out;
+        out.numRequests     = pool.numRequests;
+        out.numHits         = pool.numHits;
+        out.hitRate         = pool.numRequests ? static_cast<double>(pool.numHits)/static_cast<double>(pool.numRequests) : 0.;
+        out.residentBytes   = pool.residentBytes;
+        out.idleBytes       = pool.idleBytes;
+        return out;
+    }
+
+
+    namespace
+    {
+        uint8_t packFlags(const TobiiResearchValidity validity_, const bool available_, const eyeDataPacked::flag valid_, const eyeDataPacked::flag avail_)
+        {
+            return (validity_ == TOBII_RESEARCH_VALIDITY_VALID ? valid_ : 0) | (available_ ? avail_ : 0);
+        }
+        TobiiResearchValidity toValidity(const bool valid_)
+        {
+            return valid_ ? TOBII_RESEARCH_VALIDITY_VALID : TOBII_RESEARCH_VALIDITY_INVALID;
+        }
+    }
+
+    eyeDataPacked::eyeDataPacked(const eyeData& data_) :
+        gaze_point_on_display_area          { data_.gaze_point.position_on_display_area.x, data_.gaze_point.position_on_display_area.y },
+        gaze_point_in_user_coordinates      { data_.gaze_point.position_in_user_coordinates.x, data_.gaze_point.position_in_user_coordinates.y, data_.gaze_point.position_in_user_coordinates.z },
+        pupil_diameter                      ( data_.pupil.diameter ),
+        gaze_origin_in_user_coordinates     { data_.gaze_origin.position_in_user_coordinates.x, data_.gaze_origin.position_in_user_coordinates.y, data_.gaze_origin.position_in_user_coordinates.z },
+        gaze_origin_in_track_box_coordinates{ data_.gaze_origin.position_in_track_box_coordinates.x, data_.gaze_origin.position_in_track_box_coordinates.y, data_.gaze_origin.position_in_track_box_coordinates.z },
+        eye_openness_diameter               ( data_.eye_openness.diameter ),
+        flags(static_cast<uint8_t>(
+            packFlags(data_.gaze_point.validity  , data_.gaze_point.available  , GazePointValid  , GazePointAvailable  ) |
+            packFlags(data_.pupil.validity       , data_.pupil.available       , PupilValid      , PupilAvailable      ) |
+            packFlags(data_.gaze_origin.validity , data_.gaze_origin.available , GazeOriginValid , GazeOriginAvailable ) |
+            packFlags(data_.eye_openness.validity, data_.eye_openness.available, EyeOpennessValid, EyeOpennessAvailable)))
+    {}
+    eyeDataPacked::operator eyeData() const
+    {
+        eyeData out;
+        out.gaze_point.position_on_display_area                 = { gaze_point_on_display_area[0], gaze_point_on_display_area[1] };
+        out.gaze_point.position_in_user_coordinates             = { gaze_point_in_user_coordinates[0], gaze_point_in_user_coordinates[1], gaze_point_in_user_coordinates[2] };
+        out.gaze_point.validity                                 = toValidity(has(GazePointValid));
+        out.gaze_point.available                                = has(GazePointAvailable);
+        out.pupil.diameter                                      = pupil_diameter;
+        out.pupil.validity                                      = toValidity(has(PupilValid));
+        out.pupil.available                                     = has(PupilAvailable);
+        out.gaze_origin.position_in_user_coordinates            = { gaze_origin_in_user_coordinates[0], gaze_origin_in_user_coordinates[1], gaze_origin_in_user_coordinates[2] };
+        out.gaze_origin.position_in_track_box_coordinates       = { gaze_origin_in_track_box_coordinates[0], gaze_origin_in_track_box_coordinates[1], gaze_origin_in_track_box_coordinates[2] };
+        out.gaze_origin.validity                                = toValidity(has(GazeOriginValid));
+        out.gaze_origin.available                               = has(GazeOriginAvailable);
+        out.eye_openness.diameter                               = eye_openness_diameter;
+        out.eye_openness.validity                               = toValidity(has(EyeOpennessValid));
+        out.eye_openness.available                              = has(EyeOpennessAvailable);
+        return out;
+    }
+
+    gazeDataPacked::gazeDataPacked(const gazeData& sample_) :
+        device_time_stamp(sample_.device_time_stamp),
+        system_time_stamp(sample_.system_time_stamp),
+        left_eye(sample_.left_eye),
+        right_eye(sample_.right_eye)
+    {}
+    gazeDataPacked::operator gazeData() const
+    {
+        gazeData out;
+        out.left_eye            = static_cast<eyeData>(left_eye);
+        out.right_eye           = static_cast<eyeData>(right_eye);
+        out.device_time_stamp   = device_time_stamp;
+        out.system_time_stamp   = system_time_stamp;
+        return out;
+    }
+
+
+    void eyeDataColumns::reserve(const size_t n_)
+    {
+        for (auto c: {&gaze_point_on_display_area_x, &gaze_point_on_display_area_y,
+                      &gaze_point_in_user_coordinates_x, &gaze_point_in_user_coordinates_y, &gaze_point_in_user_coordinates_z,
+                      &pupil_diameter,
+                      &gaze_origin_in_user_coordinates_x, &gaze_origin_in_user_coordinates_y, &gaze_origin_in_user_coordinates_z,
+                      &gaze_origin_in_track_box_coordinates_x, &gaze_origin_in_track_box_coordinates_y, &gaze_origin_in_track_box_coordinates_z,
+                      &eye_openness_diameter})
+            c->reserve(n_);
+        for (auto c: {&gaze_point_valid, &gaze_point_available, &pupil_valid, &pupil_available,
+                      &gaze_origin_valid, &gaze_origin_available, &eye_openness_valid, &eye_openness_available})
+            c->reserve(n_);
+    }
+    void eyeDataColumns::resize(const size_t n_)
+    {
+        for (auto c: {&gaze_point_on_display_area_x, &gaze_point_on_display_area_y,
+                      &gaze_point_in_user_coordinates_x, &gaze_point_in_user_coordinates_y, &gaze_point_in_user_coordinates_z,
+                      &pupil_diameter,
+                      &gaze_origin_in_user_coordinates_x, &gaze_origin_in_user_coordinates_y, &gaze_origin_in_user_coordinates_z,
+                      &gaze_origin_in_track_box_coordinates_x, &gaze_origin_in_track_box_coordinates_y, &gaze_origin_in_track_box_coordinates_z,
+                      &eye_openness_diameter})
+            c->resize(n_);
+        for (auto c: {&gaze_point_valid, &gaze_point_available, &pupil_valid, &pupil_available,
+                      &gaze_origin_valid, &gaze_origin_available, &eye_openness_valid, &eye_openness_available})
+            c->resize(n_);
+    }
+    void eyeDataColumns::push_back(const eyeData& sample_)
+    {
+        gaze_point_on_display_area_x.push_back(sample_.gaze_point.position_on_display_area.x);
+        gaze_point_on_display_area_y.push_back(sample_.gaze_point.position_on_display_area.y);
+        gaze_point_in_user_coordinates_x.push_back(sample_.gaze_point.position_in_user_coordinates.x);
+        gaze_point_in_user_coordinates_y.push_back(sample_.gaze_point.position_in_user_coordinates.y);
+        gaze_point_in_user_coordinates_z.push_back(sample_.gaze_point.position_in_user_coordinates.z);
+        gaze_point_valid.push_back(sample_.gaze_point.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        gaze_point_available.push_back(sample_.gaze_point.available);
+
+        pupil_diameter.push_back(sample_.pupil.diameter);
+        pupil_valid.push_back(sample_.pupil.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        pupil_available.push_back(sample_.pupil.available);
+
+        gaze_origin_in_user_coordinates_x.push_back(sample_.gaze_origin.position_in_user_coordinates.x);
+        gaze_origin_in_user_coordinates_y.push_back(sample_.gaze_origin.position_in_user_coordinates.y);
+        gaze_origin_in_user_coordinates_z.push_back(sample_.gaze_origin.position_in_user_coordinates.z);
+        gaze_origin_in_track_box_coordinates_x.push_back(sample_.gaze_origin.position_in_track_box_coordinates.x);
+        gaze_origin_in_track_box_coordinates_y.push_back(sample_.gaze_origin.position_in_track_box_coordinates.y);
+        gaze_origin_in_track_box_coordinates_z.push_back(sample_.gaze_origin.position_in_track_box_coordinates.z);
+        gaze_origin_valid.push_back(sample_.gaze_origin.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        gaze_origin_available.push_back(sample_.gaze_origin.available);
+
+        eye_openness_diameter.push_back(sample_.eye_openness.diameter);
+        eye_openness_valid.push_back(sample_.eye_openness.validity == TOBII_RESEARCH_VALIDITY_VALID);
+        eye_openness_available.push_back(sample_.eye_openness.available);
+    }
+
+    void gazeColumns::reserve(const size_t n_)
+    {
+        device_time_stamp.reserve(n_);
+        system_time_stamp.reserve(n_);
+        left_eye.reserve(n_);
+        right_eye.reserve(n_);
+    }
+    void gazeColumns::resize(const size_t n_)
+    {
+        device_time_stamp.resize(n_);
+        system_time_stamp.resize(n_);
+        left_eye.resize(n_);
+        right_eye.resize(n_);
+    }
+    void gazeColumns::push_back(const gazeData& sample_)
+    {
+        device_time_stamp.push_back(sample_.device_time_stamp);
+        system_time_stamp.push_back(sample_.system_time_stamp);
+        left_eye.push_back(sample_.left_eye);
+        right_eye.push_back(sample_.right_eye);
+    }
+}
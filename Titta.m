@@ -2364,6 +2364,11 @@ classdef Titta < handle
             %    etc) to the specified FILENAMEBASE if the destination
             %    files already exist. Default: false.
             %
+            %    The stream data can also be written to the same Parquet
+            %    files directly from the buffers with
+            %    Titta.buffer.saveParquet, which avoids first converting all
+            %    of it to MATLAB structs.
+            %
             %    See also TITTA.SAVEDATA, TITTA.COLLECTSESSIONDATA, TITTA.GETFILENAME
             
             % get filename and path